@@ -0,0 +1,80 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <geometric_tools/Intersections/2D/LinearToLinear.h>
+#include <geometric_tools/Intersections/2D/SegmentBatch.h>
+using namespace std;
+
+using namespace GeometricTools::Math;
+using namespace GeometricTools::Primitives;
+using namespace GeometricTools::Intersections;
+
+//THROUGHPUT OF SCALAR VS BATCHED SEGMENT INTERSECTION
+
+int main(int argc, char *argv[])
+{
+    const unsigned int walls_n = 100000, queries_n = 100;
+    mt19937 gen(1);
+    uniform_real_distribution<double> U(-100.0, 100.0);
+    vector<Segment<2> > walls;
+    for(unsigned int i=0;i<walls_n;i++)
+    {
+        Vector<2> p(U(gen), U(gen));
+        walls.push_back(Segment<2>(p, p+Vector<2>(U(gen), U(gen))/10.0));
+    }
+    vector<Segment<2> > queries;
+    for(unsigned int i=0;i<queries_n;i++)
+        queries.push_back(Segment<2>(Vector<2>(U(gen), U(gen)), Vector<2>(U(gen), U(gen))));
+
+    // scalar
+    unsigned int scalar_hits = 0;
+    auto t0 = chrono::steady_clock::now();
+    for(unsigned int q=0;q<queries_n;q++)
+    {
+        for(unsigned int i=0;i<walls_n;i++)
+        {
+            Intersection2DInfo* info = intersect(queries[q], walls[i]);
+            if(info!=nullptr)
+            {
+                scalar_hits++;
+                delete info;
+            }
+        }
+    }
+    auto t1 = chrono::steady_clock::now();
+
+    // batched
+    SegmentArray array(walls);
+    SegmentHits hits;
+    unsigned int batch_hits = 0;
+    auto t2 = chrono::steady_clock::now();
+    for(unsigned int q=0;q<queries_n;q++)
+        batch_hits += intersectBatch(queries[q], array, hits);
+    auto t3 = chrono::steady_clock::now();
+
+    double pairs = double(walls_n)*double(queries_n);
+    double scalar_time = chrono::duration<double>(t1-t0).count();
+    double batch_time = chrono::duration<double>(t3-t2).count();
+    cout<<"Pairs tested: "<<pairs<<endl;
+    cout<<"Scalar: "<<scalar_hits<<" hits, "<<pairs/scalar_time/1e6<<" Mpairs/s"<<endl;
+    cout<<"Batch:  "<<batch_hits<<" hits, "<<pairs/batch_time/1e6<<" Mpairs/s"<<endl;
+    cout<<"Speedup: "<<scalar_time/batch_time<<"x"<<endl;
+    return 0;
+}
@@ -0,0 +1,79 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <geometric_tools/Primitives/1D/HermitePiecewiseCurve.h>
+#include <geometric_tools/Primitives/1D/PiecewisePolynomialCurve.h>
+using namespace std;
+
+using namespace GeometricTools::Math;
+using namespace GeometricTools::Primitives;
+
+//THROUGHPUT OF VIRTUAL VS STATIC (FLAT STORAGE) PIECEWISE CURVE EVALUATION
+
+template<class Function>
+double timeIt(Function f)
+{
+    auto t0 = chrono::steady_clock::now();
+    f();
+    auto t1 = chrono::steady_clock::now();
+    return chrono::duration<double>(t1-t0).count();
+}
+
+int main(int argc, char *argv[])
+{
+    const unsigned int pieces = 10000, samples = 4000000;
+    mt19937 gen(1);
+    uniform_real_distribution<double> U(-10.0, 10.0);
+    HermitePiecewiseCurve hermite;
+    for(unsigned int i=0;i<=pieces;i++)
+        hermite.addDotPoint({U(gen), U(gen)});
+    PiecewiseCubicCurve flat(hermite);
+
+    vector<double> sorted(samples), shuffled(samples), out(samples);
+    for(unsigned int i=0;i<samples;i++)
+        sorted[i] = double(i)/double(samples-1);
+    shuffled = sorted;
+    shuffle(shuffled.begin(), shuffled.end(), gen);
+
+    const char* names[2] = {"sorted", "shuffled"};
+    const vector<double>* params[2] = {&sorted, &shuffled};
+    for(unsigned int k=0;k<2;k++)
+    {
+        const vector<double>& u = *params[k];
+        double sum_v = 0.0, sum_s = 0.0;
+        double virtual_time = timeIt([&]() {
+            for(unsigned int i=0;i<samples;i++)
+                sum_v += hermite.getPoint(u[i]);
+        });
+        double virtual_batch_time = timeIt([&]() { hermite.getPoints(u.data(), out.data(), samples); });
+        double static_time = timeIt([&]() {
+            for(unsigned int i=0;i<samples;i++)
+                sum_s += flat.getPoint(u[i]);
+        });
+        double static_batch_time = timeIt([&]() { flat.getPoints(u.data(), out.data(), samples); });
+        cout<<"Parameters "<<names[k]<<" ("<<samples<<" samples, "<<pieces<<" pieces, checksum difference "<<std::abs(sum_v-sum_s)<<")"<<endl;
+        cout<<"  Virtual getPoint:  "<<samples/virtual_time/1e6<<" Msamples/s"<<endl;
+        cout<<"  Virtual getPoints: "<<samples/virtual_batch_time/1e6<<" Msamples/s"<<endl;
+        cout<<"  Static getPoint:   "<<samples/static_time/1e6<<" Msamples/s"<<endl;
+        cout<<"  Static getPoints:  "<<samples/static_batch_time/1e6<<" Msamples/s"<<endl;
+    }
+    return 0;
+}
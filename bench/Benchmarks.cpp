@@ -0,0 +1,1623 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#include <benchmark/benchmark.h>
+#include "Datasets.h"
+
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Math/Matrix.h>
+#include <geometric_tools/Math/LinearSystems/SolveGauss.h>
+#include <geometric_tools/Math/LinearSystems/SolveLU.h>
+#include <geometric_tools/Math/LinearSystems/SolveLinear.h>
+#include <geometric_tools/Math/LinearSystems/SolveTridiagonal.h>
+#include <geometric_tools/Math/LinearSystems/LUDecomposition.h>
+#include <geometric_tools/Math/LinearSystems/QRDecomposition.h>
+#include <geometric_tools/Math/LinearSystems/LeastSquares.h>
+#include <geometric_tools/Math/LinearSystems/SolveCholesky.h>
+#include <geometric_tools/Math/LinearSystems/SVDDecomposition.h>
+#include <geometric_tools/Math/LinearSystems/EigenDecomposition.h>
+#include <geometric_tools/Math/LinearSystems/SolveIterative.h>
+#include <geometric_tools/Math/Numerical Optimization/1D/GoldenSearchMinimization.h>
+#include <geometric_tools/Math/Numerical Optimization/ND/NelderMead.h>
+#include <geometric_tools/Math/Numerical Optimization/ND/LBFGS.h>
+#include <geometric_tools/Math/Numerical Optimization/ND/MultiStart.h>
+#include <geometric_tools/Math/Numerical Optimization/ND/LevenbergMarquardt.h>
+#include <geometric_tools/Math/Transformations/2D/Homogeneous.h>
+#include <geometric_tools/Math/DynMatrix.h>
+#include <geometric_tools/Primitives/Tools/BoundingBox.h>
+#include <geometric_tools/Primitives/Tools/Triangulation.h>
+#include <geometric_tools/Primitives/Tools/CurveSubdivision.h>
+#include <geometric_tools/Primitives/Tools/ArcLength.h>
+#include <geometric_tools/Primitives/2D/Circle.h>
+#include <geometric_tools/Primitives/2D/PlaneCurve.h>
+#include <geometric_tools/Primitives/1D/HermitePiecewiseCurve.h>
+#include <geometric_tools/Primitives/1D/PiecewisePolynomialCurve.h>
+#include <geometric_tools/Primitives/1D/BezierCurve.h>
+#include <geometric_tools/Primitives/1D/BSplineCurve.h>
+#include <geometric_tools/Intersections/2D/LinearToLinear.h>
+#include <geometric_tools/Intersections/2D/LinearToPolygon.h>
+#include <geometric_tools/Intersections/2D/RectangleToRectangle.h>
+#include <geometric_tools/Intersections/2D/PointInPolygon.h>
+#include <geometric_tools/Intersections/2D/SegmentSweep.h>
+#include <geometric_tools/Intersections/2D/SegmentBatch.h>
+#include <geometric_tools/Intersections/2D/RayScene.h>
+#include <geometric_tools/Intersections/2D/CurveToCurve.h>
+#include <geometric_tools/Intersections/ConvexToConvex.h>
+#include <geometric_tools/Distances/PointToLinear.h>
+#include <geometric_tools/Distances/LinearToLinear.h>
+#include <geometric_tools/Distances/LinearToPolyline.h>
+#include <geometric_tools/Distances/PolylineToPolyline.h>
+#include <geometric_tools/Distances/2D/PointToPolyline.h>
+#include <geometric_tools/Distances/2D/PolygonToPolygon.h>
+#include <geometric_tools/Distances/PointToCurve.h>
+#include <geometric_tools/SpacePartitioning/2D/QuadTree.h>
+
+#include <vector>
+#include <string>
+#include <cstring>
+
+#ifdef GEOMETRIC_TOOLS_USE_LAPACK
+extern "C" int dgesvd_(char *jobu, char *jobvt, int *m, int *n, double *a, int *lda, double *s, double *u, int *ldu,
+                       double *vt, int *ldvt, double *work, int *lwork, int *info);
+#endif
+
+using namespace GeometricTools::Math;
+using namespace GeometricTools::Math::LinearSystems;
+using namespace GeometricTools::Primitives;
+using namespace GeometricTools::Intersections;
+using namespace GeometricTools::Distances;
+using namespace GeometricTools::SpacePartitioning;
+using std::vector;
+
+// Inputs are drawn from a fixed-size pool and cycled, so that the measurement
+// is not a single (branch predicted, cache resident) call repeated forever
+static const unsigned int POOL = 1024;
+
+/**
+* Vector arithmetic
+**/
+template<unsigned int N>
+static void BM_VectorAdd(benchmark::State& state)
+{
+    std::mt19937 gen(1);
+    Vector<N> a = Datasets::randomVector<N>(gen), b = Datasets::randomVector<N>(gen);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        Vector<N> c = a+b;
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK_TEMPLATE(BM_VectorAdd, 2);
+BENCHMARK_TEMPLATE(BM_VectorAdd, 3);
+BENCHMARK_TEMPLATE(BM_VectorAdd, 4);
+BENCHMARK_TEMPLATE(BM_VectorAdd, 16);
+
+template<unsigned int N>
+static void BM_VectorDot(benchmark::State& state)
+{
+    std::mt19937 gen(2);
+    Vector<N> a = Datasets::randomVector<N>(gen), b = Datasets::randomVector<N>(gen);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a*b);
+    }
+}
+BENCHMARK_TEMPLATE(BM_VectorDot, 2);
+BENCHMARK_TEMPLATE(BM_VectorDot, 3);
+BENCHMARK_TEMPLATE(BM_VectorDot, 4);
+BENCHMARK_TEMPLATE(BM_VectorDot, 16);
+
+template<unsigned int N>
+static void BM_VectorLength(benchmark::State& state)
+{
+    std::mt19937 gen(3);
+    Vector<N> a = Datasets::randomVector<N>(gen);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a.length());
+    }
+}
+BENCHMARK_TEMPLATE(BM_VectorLength, 2);
+BENCHMARK_TEMPLATE(BM_VectorLength, 3);
+BENCHMARK_TEMPLATE(BM_VectorLength, 4);
+BENCHMARK_TEMPLATE(BM_VectorLength, 16);
+
+/**
+* Matrix arithmetic
+**/
+template<unsigned int N>
+static void BM_MatrixAdd(benchmark::State& state)
+{
+    Matrix<N,N> a = Datasets::randomMatrix<N>(1), b = Datasets::randomMatrix<N>(2);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        Matrix<N,N> c = a+b;
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK_TEMPLATE(BM_MatrixAdd, 2);
+BENCHMARK_TEMPLATE(BM_MatrixAdd, 3);
+BENCHMARK_TEMPLATE(BM_MatrixAdd, 4);
+BENCHMARK_TEMPLATE(BM_MatrixAdd, 16);
+
+template<unsigned int N>
+static void BM_MatrixMultiply(benchmark::State& state)
+{
+    Matrix<N,N> a = Datasets::randomMatrix<N>(3), b = Datasets::randomMatrix<N>(4);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        Matrix<N,N> c = a*b;
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK_TEMPLATE(BM_MatrixMultiply, 2);
+BENCHMARK_TEMPLATE(BM_MatrixMultiply, 3);
+BENCHMARK_TEMPLATE(BM_MatrixMultiply, 4);
+BENCHMARK_TEMPLATE(BM_MatrixMultiply, 16);
+
+template<unsigned int N>
+static void BM_MatrixVector(benchmark::State& state)
+{
+    std::mt19937 gen(5);
+    Matrix<N,N> a = Datasets::randomMatrix<N>(5);
+    Vector<N> v = Datasets::randomVector<N>(gen);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        Vector<N> c = a*v;
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK_TEMPLATE(BM_MatrixVector, 2);
+BENCHMARK_TEMPLATE(BM_MatrixVector, 3);
+BENCHMARK_TEMPLATE(BM_MatrixVector, 4);
+BENCHMARK_TEMPLATE(BM_MatrixVector, 16);
+
+template<unsigned int N>
+static void BM_MatrixTranspose(benchmark::State& state)
+{
+    Matrix<N,N> a = Datasets::randomMatrix<N>(6);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        Matrix<N,N> c = a.transpose();
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK_TEMPLATE(BM_MatrixTranspose, 2);
+BENCHMARK_TEMPLATE(BM_MatrixTranspose, 3);
+BENCHMARK_TEMPLATE(BM_MatrixTranspose, 4);
+BENCHMARK_TEMPLATE(BM_MatrixTranspose, 16);
+
+template<unsigned int N>
+static void BM_Inverse(benchmark::State& state)
+{
+    Matrix<N,N> a = Datasets::randomMatrix<N>(7);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        Matrix<N,N> c = inverse(a);
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK_TEMPLATE(BM_Inverse, 2);
+BENCHMARK_TEMPLATE(BM_Inverse, 3);
+BENCHMARK_TEMPLATE(BM_Inverse, 4);
+BENCHMARK_TEMPLATE(BM_Inverse, 16);
+
+template<unsigned int N>
+static void BM_Determinant(benchmark::State& state)
+{
+    Matrix<N,N> a = Datasets::randomMatrix<N>(8);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(determinant(a));
+    }
+}
+BENCHMARK_TEMPLATE(BM_Determinant, 2);
+BENCHMARK_TEMPLATE(BM_Determinant, 3);
+BENCHMARK_TEMPLATE(BM_Determinant, 4);
+BENCHMARK_TEMPLATE(BM_Determinant, 16);
+
+/**
+* Linear systems
+**/
+template<unsigned int N>
+static void BM_SolveGauss(benchmark::State& state)
+{
+    std::mt19937 gen(9);
+    Matrix<N,N> a = Datasets::randomMatrix<N>(9);
+    Vector<N> b = Datasets::randomVector<N>(gen);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        Vector<N> x = solveGauss(a, b);
+        benchmark::DoNotOptimize(x);
+    }
+}
+BENCHMARK_TEMPLATE(BM_SolveGauss, 2);
+BENCHMARK_TEMPLATE(BM_SolveGauss, 3);
+BENCHMARK_TEMPLATE(BM_SolveGauss, 4);
+BENCHMARK_TEMPLATE(BM_SolveGauss, 16);
+
+template<unsigned int N>
+static void BM_SolveLU(benchmark::State& state)
+{
+    std::mt19937 gen(10);
+    Matrix<N,N> a = Datasets::randomMatrix<N>(10);
+    Vector<N> b = Datasets::randomVector<N>(gen);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        Vector<N> x = solveLU(a, b);
+        benchmark::DoNotOptimize(x);
+    }
+}
+BENCHMARK_TEMPLATE(BM_SolveLU, 2);
+BENCHMARK_TEMPLATE(BM_SolveLU, 3);
+BENCHMARK_TEMPLATE(BM_SolveLU, 4);
+BENCHMARK_TEMPLATE(BM_SolveLU, 16);
+
+template<unsigned int N>
+static void BM_SolveLinear(benchmark::State& state)
+{
+    std::mt19937 gen(11);
+    Matrix<N,N> a = Datasets::randomMatrix<N>(11);
+    Vector<N> b = Datasets::randomVector<N>(gen);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        Vector<N> x = solveLinear(a, b);
+        benchmark::DoNotOptimize(x);
+    }
+}
+BENCHMARK_TEMPLATE(BM_SolveLinear, 2);
+BENCHMARK_TEMPLATE(BM_SolveLinear, 3);
+BENCHMARK_TEMPLATE(BM_SolveLinear, 4);
+BENCHMARK_TEMPLATE(BM_SolveLinear, 16);
+
+template<unsigned int N>
+static void BM_SolveCholesky(benchmark::State& state)
+{
+    std::mt19937 gen(35);
+    Matrix<N,N> r = Datasets::randomMatrix<N>(35);
+    Matrix<N,N> a = r.transpose()*r;
+    Vector<N> b = Datasets::randomVector<N>(gen);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        Vector<N> x = solveCholesky(a, b);
+        benchmark::DoNotOptimize(x);
+    }
+}
+BENCHMARK_TEMPLATE(BM_SolveCholesky, 2);
+BENCHMARK_TEMPLATE(BM_SolveCholesky, 3);
+BENCHMARK_TEMPLATE(BM_SolveCholesky, 4);
+BENCHMARK_TEMPLATE(BM_SolveCholesky, 16);
+
+template<unsigned int N>
+static void BM_SolveLDLT(benchmark::State& state)
+{
+    std::mt19937 gen(36);
+    Matrix<N,N> r = Datasets::randomMatrix<N>(36);
+    Matrix<N,N> a = r.transpose()*r;
+    Vector<N> b = Datasets::randomVector<N>(gen);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        Vector<N> x = solveLDLT(a, b);
+        benchmark::DoNotOptimize(x);
+    }
+}
+BENCHMARK_TEMPLATE(BM_SolveLDLT, 3);
+BENCHMARK_TEMPLATE(BM_SolveLDLT, 16);
+
+template<unsigned int N>
+static void BM_CholeskyUpdate(benchmark::State& state)
+{
+    std::mt19937 gen(37);
+    Matrix<N,N> r = Datasets::randomMatrix<N>(37), L;
+    CholeskyDecomposition(r.transpose()*r, L);
+    Vector<N> v = 0.01*Datasets::randomVector<N>(gen, 1.0);
+    for(auto _ : state)
+    {
+        choleskyUpdate(L, v);
+        benchmark::DoNotOptimize(L);
+    }
+}
+BENCHMARK_TEMPLATE(BM_CholeskyUpdate, 3);
+BENCHMARK_TEMPLATE(BM_CholeskyUpdate, 16);
+
+template<unsigned int N>
+static void BM_CholeskyBatch(benchmark::State& state)
+{
+    std::mt19937 gen(38);
+    const unsigned int n = state.range(0);
+    CholeskyBatch<N> batch(n);
+    vector<Matrix<N,N> > a(n);
+    vector<Vector<N> > b(n);
+    for(unsigned int s=0;s<n;s++)
+    {
+        Matrix<N,N> r = Datasets::randomMatrix<N>(s);
+        a[s] = r.transpose()*r;
+        b[s] = Datasets::randomVector<N>(gen);
+    }
+    for(auto _ : state)
+    {
+        for(unsigned int s=0;s<n;s++)
+            batch.set(s, a[s], b[s]);
+        benchmark::DoNotOptimize(batch.solve(1));
+    }
+    state.SetItemsProcessed(state.iterations()*n);
+}
+BENCHMARK_TEMPLATE(BM_CholeskyBatch, 3)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_CholeskyBatch, 6)->Arg(4096);
+
+template<unsigned int N>
+static void BM_CholeskyLoop(benchmark::State& state)
+{
+    std::mt19937 gen(38);
+    const unsigned int n = state.range(0);
+    vector<Matrix<N,N> > a(n);
+    vector<Vector<N> > b(n), x(n);
+    for(unsigned int s=0;s<n;s++)
+    {
+        Matrix<N,N> r = Datasets::randomMatrix<N>(s);
+        a[s] = r.transpose()*r;
+        b[s] = Datasets::randomVector<N>(gen);
+    }
+    for(auto _ : state)
+    {
+        for(unsigned int s=0;s<n;s++)
+            x[s] = solveCholesky(a[s], b[s]);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.SetItemsProcessed(state.iterations()*n);
+}
+BENCHMARK_TEMPLATE(BM_CholeskyLoop, 3)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_CholeskyLoop, 6)->Arg(4096);
+
+template<unsigned int N>
+static void BM_LUDecomposition(benchmark::State& state)
+{
+    Matrix<N,N> a = Datasets::randomMatrix<N>(12), L, U, P;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        LUDecomposition(a, L, U, P);
+        benchmark::DoNotOptimize(U);
+    }
+}
+BENCHMARK_TEMPLATE(BM_LUDecomposition, 2);
+BENCHMARK_TEMPLATE(BM_LUDecomposition, 3);
+BENCHMARK_TEMPLATE(BM_LUDecomposition, 4);
+BENCHMARK_TEMPLATE(BM_LUDecomposition, 16);
+
+template<unsigned int N>
+static void BM_QRDecomposition(benchmark::State& state)
+{
+    Matrix<N,N> a = Datasets::randomMatrix<N>(12), Q, R;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        QRDecomposition(a, Q, R);
+        benchmark::DoNotOptimize(R);
+    }
+}
+BENCHMARK_TEMPLATE(BM_QRDecomposition, 2);
+BENCHMARK_TEMPLATE(BM_QRDecomposition, 3);
+BENCHMARK_TEMPLATE(BM_QRDecomposition, 4);
+BENCHMARK_TEMPLATE(BM_QRDecomposition, 16);
+
+template<unsigned int N>
+static void BM_SVDDecomposition(benchmark::State& state)
+{
+    Matrix<N,N> a = Datasets::randomMatrix<N>(39), U, V;
+    Vector<N> s;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        SVDDecomposition(a, U, s, V);
+        benchmark::DoNotOptimize(s);
+    }
+}
+BENCHMARK_TEMPLATE(BM_SVDDecomposition, 2);
+BENCHMARK_TEMPLATE(BM_SVDDecomposition, 3);
+BENCHMARK_TEMPLATE(BM_SVDDecomposition, 4);
+BENCHMARK_TEMPLATE(BM_SVDDecomposition, 16);
+
+#ifdef GEOMETRIC_TOOLS_USE_LAPACK
+// reference: LAPACK dgesvd_ with U and V^T, workspace allocated once outside the loop
+template<unsigned int N>
+static void BM_SVDLapack(benchmark::State& state)
+{
+    Matrix<N,N> a = Datasets::randomMatrix<N>(39), t, U, Vt;
+    Vector<N> s;
+    int n = N, info = 0, lwork = -1;
+    char job = 'A';
+    double query = 0.0;
+    dgesvd_(&job, &job, &n, &n, t.data(), &n, s.data(), U.data(), &n, Vt.data(), &n, &query, &lwork, &info);
+    lwork = int(query);
+    vector<double> work(lwork);
+    for(auto _ : state)
+    {
+        t = a;
+        dgesvd_(&job, &job, &n, &n, t.data(), &n, s.data(), U.data(), &n, Vt.data(), &n, work.data(), &lwork, &info);
+        benchmark::DoNotOptimize(s);
+    }
+}
+BENCHMARK_TEMPLATE(BM_SVDLapack, 2);
+BENCHMARK_TEMPLATE(BM_SVDLapack, 3);
+BENCHMARK_TEMPLATE(BM_SVDLapack, 4);
+BENCHMARK_TEMPLATE(BM_SVDLapack, 16);
+#endif
+
+static void BM_Eigen3ClosedForm(benchmark::State& state)
+{
+    Matrix<3,3> r = Datasets::randomMatrix<3>(40), V;
+    Matrix<3,3> a = r.transpose()*r;
+    Vector<3> w;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        EigenDecomposition(a, w, V);
+        benchmark::DoNotOptimize(w);
+    }
+}
+BENCHMARK(BM_Eigen3ClosedForm);
+
+template<unsigned int N>
+static void BM_EigenJacobi(benchmark::State& state)
+{
+    Matrix<N,N> r = Datasets::randomMatrix<N>(40), V;
+    Matrix<N,N> a = r.transpose()*r;
+    Vector<N> w;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        EigenDecomposition<N>(a, w, V);
+        benchmark::DoNotOptimize(w);
+    }
+}
+BENCHMARK_TEMPLATE(BM_EigenJacobi, 3);
+BENCHMARK_TEMPLATE(BM_EigenJacobi, 4);
+BENCHMARK_TEMPLATE(BM_EigenJacobi, 16);
+
+/**
+* Dynamic matrices (the blocked kernels, or BLAS/LAPACK above the backend threshold)
+**/
+static void BM_DynMatrixMultiply(benchmark::State& state)
+{
+    const unsigned int n = state.range(0);
+    DynMatrix a = Datasets::randomDynMatrix(n, n, 30), b = Datasets::randomDynMatrix(n, n, 31);
+    for(auto _ : state)
+    {
+        DynMatrix c = a*b;
+        benchmark::DoNotOptimize(c.data());
+    }
+    state.counters["FLOPS"] = benchmark::Counter(2.0*n*n*n, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_DynMatrixMultiply)->Arg(64)->Arg(256)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+static void BM_DynSolveLU(benchmark::State& state)
+{
+    const unsigned int n = state.range(0);
+    DynMatrix a = Datasets::randomDynMatrix(n, n, 32, 2.0*n);
+    DynVector b(n, 1.0);
+    for(auto _ : state)
+    {
+        DynVector x = solveLU(a, b);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.counters["FLOPS"] = benchmark::Counter(2.0/3.0*n*n*n, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_DynSolveLU)->Arg(64)->Arg(256)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+static void BM_DynSolveCholesky(benchmark::State& state)
+{
+    const unsigned int n = state.range(0);
+    DynMatrix r = Datasets::randomDynMatrix(n, n, 33);
+    DynMatrix a = r.transpose()*r+DynMatrix::identity(n);
+    DynVector b(n, 1.0);
+    for(auto _ : state)
+    {
+        DynVector x = solveCholesky(a, b);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.counters["FLOPS"] = benchmark::Counter(1.0/3.0*n*n*n, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_DynSolveCholesky)->Arg(64)->Arg(256)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+static void BM_DynSolveQR(benchmark::State& state)
+{
+    const unsigned int n = state.range(0);
+    DynMatrix a = Datasets::randomDynMatrix(2*n, n, 34);
+    DynVector b(2*n, 1.0);
+    for(auto _ : state)
+    {
+        DynVector x = solveQR(a, b);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.counters["FLOPS"] = benchmark::Counter(2.0*n*n*(2.0*n-n/3.0), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_DynSolveQR)->Arg(64)->Arg(256)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+/**
+* Sparse matrices (grid Laplacian with m*m unknowns)
+**/
+static void BM_SparseAssemble(benchmark::State& state)
+{
+    const unsigned int m = state.range(0);
+    for(auto _ : state)
+    {
+        SparseMatrix A = Datasets::gridLaplacian(m);
+        benchmark::DoNotOptimize(A.values().data());
+    }
+    state.SetItemsProcessed(state.iterations()*(5*m*m-4*m));
+}
+BENCHMARK(BM_SparseAssemble)->Arg(100)->Arg(316)->Unit(benchmark::kMicrosecond);
+
+static void BM_SparseMultiply(benchmark::State& state)
+{
+    const unsigned int m = state.range(0);
+    SparseMatrix A = Datasets::gridLaplacian(m);
+    DynVector x(m*m, 1.0), y(m*m);
+    for(auto _ : state)
+    {
+        A.multiply(x.data(), y.data(), state.range(1));
+        benchmark::DoNotOptimize(y.data());
+    }
+    state.counters["FLOPS"] = benchmark::Counter(2.0*A.nonZeros(), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_SparseMultiply)->Args({100, 1})->Args({316, 1})->Args({316, 0})->Unit(benchmark::kMicrosecond);
+
+// 0: none, 1: Jacobi, 2: IC(0) (the factorization is included in the timing)
+static void BM_SparseSolveCG(benchmark::State& state)
+{
+    const unsigned int m = state.range(0);
+    SparseMatrix A = Datasets::gridLaplacian(m, 0.01);
+    DynVector b(m*m, 1.0);
+    IterativeInfo info;
+    for(auto _ : state)
+    {
+        DynVector x;
+        if(state.range(1)==0)
+            info = solveCG(A, b, x, 1e-8);
+        else if(state.range(1)==1)
+            info = solveCG(A, b, x, JacobiPreconditioner(A), 1e-8);
+        else
+            info = solveCG(A, b, x, IC0Preconditioner(A), 1e-8);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.counters["iterations"] = info.iterations;
+}
+BENCHMARK(BM_SparseSolveCG)->Args({100, 0})->Args({100, 1})->Args({100, 2})->Args({316, 0})->Args({316, 2})->Unit(benchmark::kMillisecond);
+
+static void BM_SparseSolveBiCGSTAB(benchmark::State& state)
+{
+    const unsigned int m = state.range(0);
+    SparseMatrix A = Datasets::gridLaplacian(m, 0.01);
+    DynVector b(m*m, 1.0);
+    IterativeInfo info;
+    for(auto _ : state)
+    {
+        DynVector x;
+        if(state.range(1)==0)
+            info = solveBiCGSTAB(A, b, x, 1e-8);
+        else
+            info = solveBiCGSTAB(A, b, x, IC0Preconditioner(A), 1e-8);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.counters["iterations"] = info.iterations;
+}
+BENCHMARK(BM_SparseSolveBiCGSTAB)->Args({100, 0})->Args({100, 2})->Unit(benchmark::kMillisecond);
+
+/**
+* 1D minimization: closest approach of random points to the parabola (t, t^2), bracket included
+**/
+static void BM_GoldenSearchMinimize(benchmark::State& state)
+{
+    vector<Vector<2> > points = Datasets::randomPoints(256, 41, 2.0);
+    unsigned int k = 0;
+    for(auto _ : state)
+    {
+        const Vector<2>& p = points[k++%points.size()];
+        auto dist = [&p](double t) {return (t-p[0])*(t-p[0])+(t*t-p[1])*(t*t-p[1]);};
+        double a, b, c;
+        std::tie(a, b, c) = NumericalOptimization::getBracket(dist, 0.0, 0.1);
+        benchmark::DoNotOptimize(NumericalOptimization::goldenSearchMinimize(dist, a, b, c, 1e-12));
+    }
+}
+BENCHMARK(BM_GoldenSearchMinimize);
+
+static void BM_BrentMinimize(benchmark::State& state)
+{
+    vector<Vector<2> > points = Datasets::randomPoints(256, 41, 2.0);
+    unsigned int k = 0;
+    for(auto _ : state)
+    {
+        const Vector<2>& p = points[k++%points.size()];
+        auto dist = [&p](double t) {return (t-p[0])*(t-p[0])+(t*t-p[1])*(t*t-p[1]);};
+        double a, b, c;
+        std::tie(a, b, c) = NumericalOptimization::getBracket(dist, 0.0, 0.1);
+        benchmark::DoNotOptimize(NumericalOptimization::brentMinimize(dist, a, b, c, 1e-12));
+    }
+}
+BENCHMARK(BM_BrentMinimize);
+
+/**
+* Multi-dimensional minimization: chained Rosenbrock function from the standard starting point (-1.2, 1, -1.2, ...)
+**/
+static double rosenbrock(const double* x, double* g, const unsigned int& n)
+{
+    double f = 0.0;
+    for(unsigned int i=0;i<n;i++)
+        g[i] = 0.0;
+    for(unsigned int i=0;i+1<n;i++)
+    {
+        double a = x[i+1]-x[i]*x[i], b = 1.0-x[i];
+        f += 100.0*a*a+b*b;
+        g[i] += -400.0*a*x[i]-2.0*b;
+        g[i+1] += 200.0*a;
+    }
+    return f;
+}
+
+static DynVector rosenbrockStart(const unsigned int& n)
+{
+    DynVector x(n);
+    for(unsigned int i=0;i<n;i++)
+        x[i] = (i%2)? 1.0 : -1.2;
+    return x;
+}
+
+static void BM_LBFGS(benchmark::State& state)
+{
+    const unsigned int n = state.range(0);
+    auto f = [](const DynVector& x, DynVector& g) {return rosenbrock(x.data(), g.data(), x.size());};
+    NumericalOptimization::MinimizeInfo info;
+    for(auto _ : state)
+    {
+        DynVector x = rosenbrockStart(n);
+        info = NumericalOptimization::lbfgsMinimize(f, x);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.counters["evaluations"] = info.evaluations;
+}
+BENCHMARK(BM_LBFGS)->Arg(2)->Arg(10)->Arg(50)->Unit(benchmark::kMicrosecond);
+
+static void BM_LBFGSFixed(benchmark::State& state)
+{
+    auto f = [](const Vector<2>& x, Vector<2>& g) {return rosenbrock(x.data(), g.data(), 2);};
+    for(auto _ : state)
+    {
+        Vector<2> x(-1.2, 1.0);
+        benchmark::DoNotOptimize(NumericalOptimization::lbfgsMinimize(f, x));
+    }
+}
+BENCHMARK(BM_LBFGSFixed)->Unit(benchmark::kMicrosecond);
+
+static void BM_NelderMead(benchmark::State& state)
+{
+    const unsigned int n = state.range(0);
+    DynVector g(n);
+    auto f = [&g](const DynVector& x) {return rosenbrock(x.data(), g.data(), x.size());};
+    NumericalOptimization::MinimizeInfo info;
+    for(auto _ : state)
+    {
+        DynVector x = rosenbrockStart(n);
+        info = NumericalOptimization::nelderMeadMinimize(f, x, 0.5);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.counters["evaluations"] = info.evaluations;
+}
+BENCHMARK(BM_NelderMead)->Arg(2)->Arg(4)->Arg(10)->Unit(benchmark::kMicrosecond);
+
+// 64 starts of L-BFGS on a 10-dimensional Rosenbrock function, arg = threads (0 means all the hardware threads)
+static void BM_MultiStart(benchmark::State& state)
+{
+    auto f = [](const DynVector& x, DynVector& g) {return rosenbrock(x.data(), g.data(), x.size());};
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> U(-2.0, 2.0);
+    vector<DynVector> starts(64, DynVector(10));
+    for(unsigned int s=0;s<starts.size();s++)
+        for(unsigned int i=0;i<10;i++)
+            starts[s][i] = U(gen);
+    for(auto _ : state)
+    {
+        vector<DynVector> x0 = starts;
+        DynVector best;
+        benchmark::DoNotOptimize(NumericalOptimization::multiStartMinimize([&](DynVector& x) {return NumericalOptimization::lbfgsMinimize(f, x);}, x0, best, state.range(0)));
+    }
+}
+BENCHMARK(BM_MultiStart)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond);
+
+// 2D scan registration (pose = angle, tx, ty) with 10% outliers and a Cauchy loss, args = points, threads
+static void BM_LevenbergMarquardt(benchmark::State& state)
+{
+    const unsigned int n = state.range(0);
+    Matrix<3,3> T = Transformations2D::translation(0.7, -1.2)*Transformations2D::rotation(0.4);
+    vector<Vector<2> > scan = Datasets::randomPoints(n, 43, 10.0), noise = Datasets::randomPoints(n, 44, 1.0);
+    vector<Vector<3> > p(n), q(n);
+    for(unsigned int i=0;i<n;i++)
+    {
+        p[i] = Vector<3>(scan[i][0], scan[i][1], 1.0);
+        q[i] = T*p[i]+((i%10==0)? 5.0 : 0.01)*Vector<3>(noise[i][0], noise[i][1], 0.0);
+    }
+    auto residual = [&](unsigned int i, const Vector<3>& x, double* r, double* J) {
+        const double c = std::cos(x[0]), s = std::sin(x[0]);
+        r[0] = c*p[i][0]-s*p[i][1]+x[1]-q[i][0];
+        r[1] = s*p[i][0]+c*p[i][1]+x[2]-q[i][1];
+        J[0] = -s*p[i][0]-c*p[i][1]; J[1] = 1.0; J[2] = 0.0;
+        J[3] = c*p[i][0]-s*p[i][1];  J[4] = 0.0; J[5] = 1.0;
+    };
+    NumericalOptimization::MinimizeInfo info;
+    for(auto _ : state)
+    {
+        Vector<3> x;
+        info = NumericalOptimization::levenbergMarquardt(residual, n, 2, x, NumericalOptimization::RobustLoss(NumericalOptimization::RobustLoss::Cauchy, 0.1),
+                                                         1e-10, 100, state.range(1));
+        benchmark::DoNotOptimize(x);
+    }
+    state.counters["iterations"] = info.iterations;
+    state.SetItemsProcessed(state.iterations()*n);
+}
+BENCHMARK(BM_LevenbergMarquardt)->Args({1000, 1})->Args({100000, 1})->Args({100000, 0})->Unit(benchmark::kMicrosecond);
+
+static void BM_SolveTridiagonal(benchmark::State& state)
+{
+    const unsigned int n = state.range(0);
+    std::mt19937 gen(13);
+    std::uniform_real_distribution<double> U(-1.0, 1.0);
+    vector<double> a(n), b(n), c(n), d(n), x(n), scratch(n);
+    for(unsigned int i=0;i<n;i++)
+    {
+        a[i] = U(gen);
+        c[i] = U(gen);
+        b[i] = 4.0+U(gen);
+        d[i] = U(gen);
+    }
+    for(auto _ : state)
+    {
+        x = d;
+        solveTridiagonal(a.data(), b.data(), c.data(), x.data(), scratch.data(), n);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.SetItemsProcessed(state.iterations()*n);
+}
+BENCHMARK(BM_SolveTridiagonal)->Arg(64)->Arg(4096)->Arg(1<<18);
+
+static void BM_SolveCyclicTridiagonal(benchmark::State& state)
+{
+    const unsigned int n = state.range(0);
+    std::mt19937 gen(14);
+    std::uniform_real_distribution<double> U(-1.0, 1.0);
+    vector<double> a(n), b(n), c(n), d(n);
+    for(unsigned int i=0;i<n;i++)
+    {
+        a[i] = U(gen);
+        c[i] = U(gen);
+        b[i] = 4.0+U(gen);
+        d[i] = U(gen);
+    }
+    for(auto _ : state)
+    {
+        vector<double> x = solveCyclicTridiagonal(a, b, c, d);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.SetItemsProcessed(state.iterations()*n);
+}
+BENCHMARK(BM_SolveCyclicTridiagonal)->Arg(64)->Arg(4096)->Arg(1<<18);
+
+// streaming least squares, banded rows of width 4 (cubic B-spline fit)
+static void BM_LeastSquaresBanded(benchmark::State& state)
+{
+    const unsigned int n = state.range(0), rows = 8*n, w = 4;
+    std::mt19937 gen(15);
+    std::uniform_real_distribution<double> U(-1.0, 1.0);
+    vector<double> a(rows*w), b(rows);
+    for(unsigned int i=0;i<rows*w;i++)
+        a[i] = U(gen);
+    for(unsigned int i=0;i<rows;i++)
+        b[i] = U(gen);
+    LeastSquares ls(n, 1, w);
+    vector<double> x(n);
+    for(auto _ : state)
+    {
+        ls.clear();
+        for(unsigned int i=0;i<rows;i++)
+            ls.addRow((i*(n-w+1))/rows, &a[i*w], &b[i]);
+        benchmark::DoNotOptimize(ls.solve(x.data()));
+    }
+    state.SetItemsProcessed(state.iterations()*rows);
+}
+BENCHMARK(BM_LeastSquaresBanded)->Arg(64)->Arg(4096);
+
+static void BM_BandedNormalEquations(benchmark::State& state)
+{
+    const unsigned int n = state.range(0), rows = 8*n, w = 4;
+    std::mt19937 gen(16);
+    std::uniform_real_distribution<double> U(-1.0, 1.0);
+    vector<double> a(rows*w), b(rows);
+    for(unsigned int i=0;i<rows*w;i++)
+        a[i] = U(gen);
+    for(unsigned int i=0;i<rows;i++)
+        b[i] = U(gen);
+    BandedNormalEquations ne(n, 1, w);
+    vector<double> x(n);
+    for(auto _ : state)
+    {
+        ne.clear();
+        for(unsigned int i=0;i<rows;i++)
+            ne.addRow((i*(n-w+1))/rows, &a[i*w], &b[i]);
+        benchmark::DoNotOptimize(ne.solve(x.data()));
+    }
+    state.SetItemsProcessed(state.iterations()*rows);
+}
+BENCHMARK(BM_BandedNormalEquations)->Arg(64)->Arg(4096);
+
+static void BM_LeastSquaresDense(benchmark::State& state)
+{
+    const unsigned int n = state.range(0), rows = 4*n;
+    std::mt19937 gen(17);
+    std::uniform_real_distribution<double> U(-1.0, 1.0);
+    vector<double> a(rows*n), b(rows);
+    for(unsigned int i=0;i<rows*n;i++)
+        a[i] = U(gen);
+    for(unsigned int i=0;i<rows;i++)
+        b[i] = U(gen);
+    LeastSquares ls(n);
+    vector<double> x(n);
+    for(auto _ : state)
+    {
+        ls.clear();
+        for(unsigned int i=0;i<rows;i++)
+            ls.addRow(&a[i*n], &b[i]);
+        benchmark::DoNotOptimize(ls.solve(x.data()));
+    }
+    state.SetItemsProcessed(state.iterations()*rows);
+}
+BENCHMARK(BM_LeastSquaresDense)->Arg(4)->Arg(16)->Arg(64);
+
+/**
+* Polygons and bounding boxes
+**/
+static void BM_PolygonArea(benchmark::State& state)
+{
+    Polygon poly = Datasets::randomPolygon(state.range(0), 18);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(poly.area());
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_PolygonArea)->Arg(3)->Arg(64)->Arg(4096);
+
+static void BM_BoundingBoxPoints(benchmark::State& state)
+{
+    vector<Vector<2> > points = Datasets::randomPoints(state.range(0), 19);
+    for(auto _ : state)
+    {
+        Rectangle r = boundingBox(points);
+        benchmark::DoNotOptimize(r);
+    }
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_BoundingBoxPoints)->Arg(3)->Arg(64)->Arg(4096);
+
+static void BM_BoundingBoxPolyline(benchmark::State& state)
+{
+    Polyline<2> line = Datasets::randomPolyline(state.range(0), 20);
+    for(auto _ : state)
+    {
+        Rectangle r = boundingBox(line);
+        benchmark::DoNotOptimize(r);
+    }
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_BoundingBoxPolyline)->Arg(3)->Arg(64)->Arg(4096);
+
+static void BM_TriangulateEarClipping(benchmark::State& state)
+{
+    Polygon poly = Datasets::randomPolygon(state.range(0), 61);
+    vector<TriangleIndices> triangles;
+    for(auto _ : state)
+    {
+        triangles.clear();
+        triangulateEarClipping(poly.vertices(), triangles);
+        benchmark::DoNotOptimize(triangles.data());
+    }
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_TriangulateEarClipping)->Arg(64)->Arg(4096);
+
+static void BM_TriangulateMonotone(benchmark::State& state)
+{
+    Polygon poly = Datasets::randomPolygon(state.range(0), 61);
+    vector<TriangleIndices> triangles;
+    for(auto _ : state)
+    {
+        triangles.clear();
+        triangulateMonotone(poly.vertices(), triangles);
+        benchmark::DoNotOptimize(triangles.data());
+    }
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_TriangulateMonotone)->Arg(64)->Arg(4096)->Arg(65536);
+
+static void BM_Triangulate(benchmark::State& state)
+{
+    Polygon poly = Datasets::randomPolygon(state.range(0), 61);
+    for(auto _ : state)
+    {
+        vector<TriangleIndices> triangles = triangulate(poly);
+        benchmark::DoNotOptimize(triangles.data());
+    }
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_Triangulate)->Arg(64)->Arg(512)->Arg(4096)->Arg(65536);
+
+static void BM_TriangulateConvex(benchmark::State& state)
+{
+    Polygon poly = Datasets::randomPolygon(state.range(0), 62, Vector<2>(0.0, 0.0), 10.0, true);
+    for(auto _ : state)
+    {
+        vector<TriangleIndices> triangles = triangulate(poly);
+        benchmark::DoNotOptimize(triangles.data());
+    }
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_TriangulateConvex)->Arg(4096)->Arg(65536);
+
+/**
+* Intersections
+**/
+static void BM_IntersectSegmentSegment(benchmark::State& state)
+{
+    vector<Segment<2> > s1 = Datasets::randomSegments(POOL, 21, 10.0), s2 = Datasets::randomSegments(POOL, 22, 10.0);
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        Intersection2DInfo* info = intersect(s1[i], s2[i]);
+        benchmark::DoNotOptimize(info);
+        delete info;
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_IntersectSegmentSegment);
+
+static void BM_IntersectSegmentPolygon(benchmark::State& state)
+{
+    vector<Segment<2> > segments = Datasets::randomSegments(POOL, 23, 15.0, 20.0);
+    Polygon poly = Datasets::randomPolygon(state.range(0), 24);
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        Intersection2DInfo* info = intersect(segments[i], poly);
+        benchmark::DoNotOptimize(info);
+        delete info;
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_IntersectSegmentPolygon)->Arg(8)->Arg(256);
+
+static void BM_IntersectPolylinePolygon(benchmark::State& state)
+{
+    Polyline<2> line = Datasets::randomPolyline(state.range(0), 25);
+    Polygon poly = Datasets::randomPolygon(state.range(0), 26);
+    for(auto _ : state)
+    {
+        Intersection2DInfo* info = intersect(line, poly);
+        benchmark::DoNotOptimize(info);
+        delete info;
+    }
+}
+BENCHMARK(BM_IntersectPolylinePolygon)->Arg(8)->Arg(256);
+
+static void BM_IntersectRectangleRectangle(benchmark::State& state)
+{
+    vector<Rectangle> r1 = Datasets::randomRectangles(POOL, 27, 10.0), r2 = Datasets::randomRectangles(POOL, 28, 10.0);
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        Intersection2DInfo* info = intersect(r1[i], r2[i]);
+        benchmark::DoNotOptimize(info);
+        delete info;
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_IntersectRectangleRectangle);
+
+static void BM_OverlapRectangleRectangle(benchmark::State& state)
+{
+    vector<Rectangle> r1 = Datasets::randomRectangles(POOL, 29, 10.0), r2 = Datasets::randomRectangles(POOL, 30, 10.0);
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(overlap(r1[i], r2[i]));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_OverlapRectangleRectangle);
+
+static void BM_IntersectConvexPolygons(benchmark::State& state)
+{
+    std::mt19937 gen(31);
+    vector<Polygon> p1, p2;
+    for(unsigned int i=0;i<POOL;i++)
+    {
+        p1.push_back(Datasets::randomPolygon(state.range(0), gen(), Datasets::randomVector<2>(gen, 10.0), 5.0, true));
+        p2.push_back(Datasets::randomPolygon(state.range(0), gen(), Datasets::randomVector<2>(gen, 10.0), 5.0, true));
+    }
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        Intersection2DInfo* info = intersect(p1[i], p2[i]);
+        benchmark::DoNotOptimize(info);
+        delete info;
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_IntersectConvexPolygons)->Arg(8)->Arg(64);
+
+static void BM_IntersectCirclePolygon(benchmark::State& state)
+{
+    std::mt19937 gen(32);
+    std::uniform_real_distribution<double> R(1.0, 5.0);
+    vector<Polygon> polys;
+    vector<Circle> circles;
+    for(unsigned int i=0;i<POOL;i++)
+    {
+        polys.push_back(Datasets::randomPolygon(16, gen(), Datasets::randomVector<2>(gen, 10.0), 5.0, true));
+        circles.push_back(Circle(Datasets::randomVector<2>(gen, 10.0), R(gen)));
+    }
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        Intersection2DInfo* info = intersect(circles[i], polys[i]);
+        benchmark::DoNotOptimize(info);
+        delete info;
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_IntersectCirclePolygon);
+
+static void BM_IntersectCircleCircle(benchmark::State& state)
+{
+    std::mt19937 gen(33);
+    std::uniform_real_distribution<double> R(1.0, 5.0);
+    vector<Circle> c1, c2;
+    for(unsigned int i=0;i<POOL;i++)
+    {
+        c1.push_back(Circle(Datasets::randomVector<2>(gen, 10.0), R(gen)));
+        c2.push_back(Circle(Datasets::randomVector<2>(gen, 10.0), R(gen)));
+    }
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        Intersection2DInfo* info = intersect(c1[i], c2[i]);
+        benchmark::DoNotOptimize(info);
+        delete info;
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_IntersectCircleCircle);
+
+static void BM_IntersectAllSweep(benchmark::State& state)
+{
+    vector<Segment<2> > segments = Datasets::randomSegments(state.range(0), 34, 100.0, 5.0);
+    vector<SegmentIntersection> result;
+    for(auto _ : state)
+    {
+        result.clear();
+        benchmark::DoNotOptimize(intersectAll(segments, result));
+    }
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_IntersectAllSweep)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_IntersectBatch(benchmark::State& state)
+{
+    SegmentArray segments(Datasets::randomSegments(state.range(0), 35));
+    vector<Segment<2> > queries = Datasets::randomSegments(POOL, 36, 100.0, 50.0);
+    SegmentHits hits;
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(intersectBatch(queries[i], segments, hits));
+        i = (i+1)%POOL;
+    }
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_IntersectBatch)->Arg(1000)->Arg(100000);
+
+static void BM_RaySceneCast(benchmark::State& state)
+{
+    std::mt19937 gen(37);
+    vector<Polygon> polygons;
+    for(int i=0;i<state.range(0);i++)
+        polygons.push_back(Datasets::randomPolygon(8, gen(), Datasets::randomVector<2>(gen, 100.0), 1.0));
+    RayScene scene(polygons);
+    vector<Ray<2> > rays = Datasets::randomRays(POOL, 38);
+    RayHit hit;
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(scene.castRay(rays[i], hit));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_RaySceneCast)->Arg(1000)->Arg(100000);
+
+static void BM_PointInPolygon(benchmark::State& state)
+{
+    Polygon poly = Datasets::randomPolygon(state.range(0), 39);
+    vector<Vector<2> > points = Datasets::randomPoints(POOL, 40, 10.0);
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(contains(poly, points[i]));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_PointInPolygon)->Arg(8)->Arg(256)->Arg(4096);
+
+static void BM_PreparedPointInPolygon(benchmark::State& state)
+{
+    PreparedPolygon poly(Datasets::randomPolygon(state.range(0), 39));
+    vector<Vector<2> > points = Datasets::randomPoints(POOL, 40, 10.0);
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(poly.contains(points[i]));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_PreparedPointInPolygon)->Arg(8)->Arg(256)->Arg(4096);
+
+static void BM_IntersectCurves(benchmark::State& state)
+{
+    PlaneCurve<CubicBSplineCurve,CubicBSplineCurve> a, b;
+    Datasets::randomCurve(a, state.range(0), 41);
+    Datasets::randomCurve(b, state.range(0), 42);
+    vector<CurveIntersection> result;
+    for(auto _ : state)
+    {
+        result.clear();
+        benchmark::DoNotOptimize(intersect(a, b, result));
+    }
+}
+BENCHMARK(BM_IntersectCurves)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+/**
+* Distances
+**/
+static void BM_DistancePointLine(benchmark::State& state)
+{
+    vector<Vector<2> > points = Datasets::randomPoints(POOL, 43, 10.0);
+    vector<Segment<2> > s = Datasets::randomSegments(POOL, 44, 10.0);
+    vector<Line<2> > lines;
+    for(unsigned int i=0;i<POOL;i++)
+        lines.push_back(Line<2>(s[i].P0(), s[i].d()));
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(distanceSq(points[i], lines[i]));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_DistancePointLine);
+
+static void BM_DistancePointRay(benchmark::State& state)
+{
+    vector<Vector<2> > points = Datasets::randomPoints(POOL, 45, 10.0);
+    vector<Ray<2> > rays = Datasets::randomRays(POOL, 46, 10.0);
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(distanceSq(points[i], rays[i]));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_DistancePointRay);
+
+static void BM_DistancePointSegment(benchmark::State& state)
+{
+    vector<Vector<2> > points = Datasets::randomPoints(POOL, 47, 10.0);
+    vector<Segment<2> > segments = Datasets::randomSegments(POOL, 48, 10.0);
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(distanceSq(points[i], segments[i]));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_DistancePointSegment);
+
+static void BM_DistanceLineLine(benchmark::State& state)
+{
+    vector<Segment<2> > s1 = Datasets::randomSegments(POOL, 49, 10.0), s2 = Datasets::randomSegments(POOL, 50, 10.0);
+    vector<Line<2> > l1, l2;
+    for(unsigned int i=0;i<POOL;i++)
+    {
+        l1.push_back(Line<2>(s1[i].P0(), s1[i].d()));
+        l2.push_back(Line<2>(s2[i].P0(), s2[i].d()));
+    }
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(distanceSq(l1[i], l2[i]));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_DistanceLineLine);
+
+static void BM_DistanceLineRay(benchmark::State& state)
+{
+    vector<Segment<2> > s = Datasets::randomSegments(POOL, 51, 10.0);
+    vector<Ray<2> > rays = Datasets::randomRays(POOL, 52, 10.0);
+    vector<Line<2> > lines;
+    for(unsigned int i=0;i<POOL;i++)
+        lines.push_back(Line<2>(s[i].P0(), s[i].d()));
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(distanceSq(lines[i], rays[i]));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_DistanceLineRay);
+
+static void BM_DistanceLineSegment(benchmark::State& state)
+{
+    vector<Segment<2> > s = Datasets::randomSegments(POOL, 53, 10.0), segments = Datasets::randomSegments(POOL, 54, 10.0);
+    vector<Line<2> > lines;
+    for(unsigned int i=0;i<POOL;i++)
+        lines.push_back(Line<2>(s[i].P0(), s[i].d()));
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(distanceSq(lines[i], segments[i]));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_DistanceLineSegment);
+
+static void BM_DistanceSegmentSegment(benchmark::State& state)
+{
+    vector<Segment<2> > s1 = Datasets::randomSegments(POOL, 55, 10.0), s2 = Datasets::randomSegments(POOL, 56, 10.0);
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(distanceSq(s1[i], s2[i]));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_DistanceSegmentSegment);
+
+static void BM_DistanceRaySegment(benchmark::State& state)
+{
+    vector<Ray<2> > rays = Datasets::randomRays(POOL, 57, 10.0);
+    vector<Segment<2> > segments = Datasets::randomSegments(POOL, 58, 10.0);
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(distanceSq(rays[i], segments[i]));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_DistanceRaySegment);
+
+static void BM_DistanceSegmentPolyline(benchmark::State& state)
+{
+    vector<Segment<2> > segments = Datasets::randomSegments(POOL, 59, 10.0);
+    Polyline<2> line = Datasets::randomPolyline(state.range(0), 60);
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(distanceSq(segments[i], line));
+        i = (i+1)%POOL;
+    }
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_DistanceSegmentPolyline)->Arg(16)->Arg(1024);
+
+static void BM_DistancePointPolyline(benchmark::State& state)
+{
+    vector<Vector<2> > points = Datasets::randomPoints(POOL, 61, 10.0);
+    Polyline<2> line = Datasets::randomPolyline(state.range(0), 62);
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(distanceSq(points[i], line));
+        i = (i+1)%POOL;
+    }
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_DistancePointPolyline)->Arg(16)->Arg(1024);
+
+static void BM_DistancePolylinePolyline(benchmark::State& state)
+{
+    Polyline<2> l1 = Datasets::randomPolyline(state.range(0), 63), l2 = Datasets::randomPolyline(state.range(0), 64);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(distanceSq(l1, l2));
+    state.SetItemsProcessed(state.iterations()*state.range(0)*state.range(0));
+}
+BENCHMARK(BM_DistancePolylinePolyline)->Arg(16)->Arg(256);
+
+static void BM_DistancePolygonPolygon(benchmark::State& state)
+{
+    Polygon p1 = Datasets::randomPolygon(state.range(0), 65, Vector<2>(-15.0, 0.0)), p2 = Datasets::randomPolygon(state.range(0), 66, Vector<2>(15.0, 0.0));
+    for(auto _ : state)
+        benchmark::DoNotOptimize(distanceSq(p1, p2));
+}
+BENCHMARK(BM_DistancePolygonPolygon)->Arg(8)->Arg(256);
+
+static void BM_DistanceConvex(benchmark::State& state)
+{
+    std::mt19937 gen(67);
+    vector<Polygon> p1, p2;
+    for(unsigned int i=0;i<POOL;i++)
+    {
+        p1.push_back(Datasets::randomPolygon(state.range(0), gen(), Datasets::randomVector<2>(gen, 10.0), 3.0, true));
+        p2.push_back(Datasets::randomPolygon(state.range(0), gen(), Datasets::randomVector<2>(gen, 10.0), 3.0, true));
+    }
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(convexDistanceSq(p1[i], p2[i]));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_DistanceConvex)->Arg(8)->Arg(64);
+
+static void BM_DistancePointCurve(benchmark::State& state)
+{
+    PlaneCurve<CubicBSplineCurve,CubicBSplineCurve> curve;
+    Datasets::randomCurve(curve, state.range(0), 68);
+    BezierPieces pieces;
+    pieces.build(curve);
+    vector<Vector<2> > points = Datasets::randomPoints(POOL, 69, 10.0);
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        CurvePoint c = closestPoint(pieces, points[i]);
+        benchmark::DoNotOptimize(c);
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_DistancePointCurve)->Arg(10)->Arg(100);
+
+/**
+* QuadTree
+**/
+// the tree deepens until every leaf holds a handful of the (small) triangles
+static const unsigned int QUADTREE_LEVELS = 12, QUADTREE_OBJECTS = 8;
+
+static void BM_QuadTreeInsert(benchmark::State& state)
+{
+    vector<Polygon> triangles = Datasets::randomTriangles(state.range(0), 70);
+    for(auto _ : state)
+    {
+        // QuadTree does not free its nodes, keep the iteration count low for the large sizes
+        QuadTree tree(Rectangle(Vector<2>(0.0, 0.0), 200.0, 200.0), 0, QUADTREE_LEVELS, QUADTREE_OBJECTS);
+        for(unsigned int i=0;i<triangles.size();i++)
+            benchmark::DoNotOptimize(tree.addObject(triangles[i]));
+    }
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_QuadTreeInsert)->Arg(1000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond)->Iterations(3);
+
+static void BM_QuadTreeQueryRange(benchmark::State& state)
+{
+    vector<Polygon> triangles = Datasets::randomTriangles(state.range(0), 70);
+    QuadTree tree(Rectangle(Vector<2>(0.0, 0.0), 200.0, 200.0), 0, QUADTREE_LEVELS, QUADTREE_OBJECTS);
+    for(unsigned int i=0;i<triangles.size();i++)
+        tree.addObject(triangles[i]);
+    vector<Rectangle> ranges = Datasets::randomRectangles(POOL, 71, 100.0, 2.0);
+    vector<Polygon> found;
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        found.clear();
+        benchmark::DoNotOptimize(tree.queryRange(ranges[i], found));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_QuadTreeQueryRange)->Arg(1000)->Arg(100000)->Arg(1000000);
+
+static void BM_QuadTreeQueryPoint(benchmark::State& state)
+{
+    vector<Polygon> triangles = Datasets::randomTriangles(state.range(0), 70);
+    QuadTree tree(Rectangle(Vector<2>(0.0, 0.0), 200.0, 200.0), 0, QUADTREE_LEVELS, QUADTREE_OBJECTS);
+    for(unsigned int i=0;i<triangles.size();i++)
+        tree.addObject(triangles[i]);
+    vector<Vector<2> > points = Datasets::randomPoints(POOL, 72);
+    vector<Polygon> found;
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        found.clear();
+        benchmark::DoNotOptimize(tree.queryPoint(points[i], found));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_QuadTreeQueryPoint)->Arg(1000)->Arg(100000)->Arg(1000000);
+
+/**
+* Curve evaluation and subdivision
+**/
+static void BM_HermiteGetPoint(benchmark::State& state)
+{
+    HermitePiecewiseCurve curve;
+    std::mt19937 gen(73);
+    for(int i=0;i<=state.range(0);i++)
+        curve.addDotPoint(Datasets::randomVector<2>(gen, 10.0));
+    vector<double> u = Datasets::randomParameters(POOL, 74);
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(curve.getPoint(u[i]));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_HermiteGetPoint)->Arg(10)->Arg(10000);
+
+static void BM_PiecewiseCubicGetPoints(benchmark::State& state)
+{
+    HermitePiecewiseCurve hermite;
+    std::mt19937 gen(75);
+    for(int i=0;i<=state.range(0);i++)
+        hermite.addDotPoint(Datasets::randomVector<2>(gen, 10.0));
+    PiecewiseCubicCurve curve(hermite);
+    vector<double> u = Datasets::randomParameters(1<<16, 76), out(u.size());
+    for(auto _ : state)
+    {
+        curve.getPoints(u.data(), out.data(), u.size());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations()*u.size());
+}
+BENCHMARK(BM_PiecewiseCubicGetPoints)->Arg(10)->Arg(10000);
+
+static void BM_BezierGetPoints(benchmark::State& state)
+{
+    CubicBezierCurve curve;
+    std::mt19937 gen(77);
+    std::uniform_real_distribution<double> U(-10.0, 10.0);
+    for(int i=0;i<4;i++)
+        curve.addPoint(U(gen));
+    vector<double> u = Datasets::randomParameters(1<<16, 78), out(u.size());
+    for(auto _ : state)
+    {
+        curve.getPoints(u.data(), out.data(), u.size());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations()*u.size());
+}
+BENCHMARK(BM_BezierGetPoints);
+
+static void BM_BSplineGetPoint(benchmark::State& state)
+{
+    PlaneCurve<CubicBSplineCurve,CubicBSplineCurve> curve;
+    Datasets::randomCurve(curve, state.range(0), 79);
+    vector<double> u = Datasets::randomParameters(POOL, 80);
+    unsigned int i = 0;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(curve.getPoint(u[i]));
+        i = (i+1)%POOL;
+    }
+}
+BENCHMARK(BM_BSplineGetPoint)->Arg(10)->Arg(10000);
+
+static void BM_BSplineGetPoints(benchmark::State& state)
+{
+    PlaneCurve<CubicBSplineCurve,CubicBSplineCurve> curve;
+    Datasets::randomCurve(curve, state.range(0), 81);
+    vector<double> u = Datasets::randomParameters(1<<16, 82), x(u.size()), y(u.size());
+    for(auto _ : state)
+    {
+        curve.getPoints(u.data(), x.data(), y.data(), u.size());
+        benchmark::DoNotOptimize(x.data());
+        benchmark::DoNotOptimize(y.data());
+    }
+    state.SetItemsProcessed(state.iterations()*u.size());
+}
+BENCHMARK(BM_BSplineGetPoints)->Arg(10)->Arg(10000);
+
+static void BM_UniformSubdivision(benchmark::State& state)
+{
+    PlaneCurve<CubicBSplineCurve,CubicBSplineCurve> curve;
+    Datasets::randomCurve(curve, 50, 83);
+    for(auto _ : state)
+    {
+        Polyline<2> line = uniformSubdivision(curve, state.range(0));
+        benchmark::DoNotOptimize(line);
+    }
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_UniformSubdivision)->Arg(100)->Arg(10000);
+
+static void BM_AdaptiveSubdivision(benchmark::State& state)
+{
+    PlaneCurve<CubicBSplineCurve,CubicBSplineCurve> curve;
+    Datasets::randomCurve(curve, 50, 84);
+    Polyline<2> line;
+    const double tolerance = std::pow(10.0, -double(state.range(0)));
+    for(auto _ : state)
+        benchmark::DoNotOptimize(adaptiveSubdivision(curve, tolerance, line));
+}
+BENCHMARK(BM_AdaptiveSubdivision)->Arg(2)->Arg(4)->Arg(6);
+
+static void BM_ArcLengthSubdivision(benchmark::State& state)
+{
+    PlaneCurve<CubicBSplineCurve,CubicBSplineCurve> curve;
+    Datasets::randomCurve(curve, 50, 85);
+    for(auto _ : state)
+    {
+        Polyline<2> line = arcLengthSubdivision(curve, state.range(0));
+        benchmark::DoNotOptimize(line);
+    }
+}
+BENCHMARK(BM_ArcLengthSubdivision)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+static void BM_BSplineSplit(benchmark::State& state)
+{
+    CubicBSplineCurve curve(CubicBSplineCurve::ClampedUniform);
+    std::mt19937 gen(86);
+    std::uniform_real_distribution<double> U(-10.0, 10.0);
+    for(int i=0;i<state.range(0);i++)
+        curve.addPoint(U(gen));
+    CubicBSplineCurve left, right;
+    for(auto _ : state)
+    {
+        curve.split(0.37, left, right);
+        benchmark::DoNotOptimize(left);
+    }
+}
+BENCHMARK(BM_BSplineSplit)->Arg(10)->Arg(1000);
+
+/**
+* Main
+* Results are written to GeometricTools_bench.json (JSON) unless --benchmark_out is given on the command line
+**/
+int main(int argc, char** argv)
+{
+    vector<char*> args(argv, argv+argc);
+    bool has_out = false;
+    for(int i=1;i<argc;i++)
+        if(std::strncmp(argv[i], "--benchmark_out=", 16)==0)
+            has_out = true;
+    char out[] = "--benchmark_out=GeometricTools_bench.json", format[] = "--benchmark_out_format=json";
+    if(!has_out)
+    {
+        args.insert(args.begin()+1, format);
+        args.insert(args.begin()+1, out);
+    }
+    int n = args.size();
+    benchmark::Initialize(&n, args.data());
+    if(benchmark::ReportUnrecognizedArguments(n, args.data()))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
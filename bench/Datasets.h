@@ -0,0 +1,322 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#ifndef GEOMETRIC_TOOLS_BENCH_DATASETS_H
+#define GEOMETRIC_TOOLS_BENCH_DATASETS_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Math/Matrix.h>
+#include <geometric_tools/Math/DynMatrix.h>
+#include <geometric_tools/Math/SparseMatrix.h>
+#include <geometric_tools/Primitives/LinearShapes.h>
+#include <geometric_tools/Primitives/Polyline.h>
+#include <geometric_tools/Primitives/2D/Polygon.h>
+#include <geometric_tools/Primitives/2D/Triangle.h>
+#include <geometric_tools/Primitives/2D/Rectangle.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+/**
+* Reproducible datasets for the benchmarks
+* Every generator takes an explicit seed so that two runs (or two machines) measure the same inputs
+**/
+namespace Datasets {
+
+using std::vector;
+using GeometricTools::Math::Vector;
+using GeometricTools::Math::Matrix;
+using GeometricTools::Math::DynMatrix;
+using GeometricTools::Math::SparseMatrix;
+using GeometricTools::Math::TripletBuilder;
+using GeometricTools::Primitives::Segment;
+using GeometricTools::Primitives::Ray;
+using GeometricTools::Primitives::Line;
+using GeometricTools::Primitives::Polyline;
+using GeometricTools::Primitives::Polygon;
+using GeometricTools::Primitives::Triangle;
+using GeometricTools::Primitives::Rectangle;
+
+/**
+* Random vector with coordinates in [-extent, extent]
+* @param gen - random generator
+* @param extent - half size of the sampling box
+* @return Vector<N> - the vector
+**/
+template<unsigned int N>
+Vector<N> randomVector(std::mt19937& gen, const double& extent = 1.0)
+{
+    std::uniform_real_distribution<double> U(-extent, extent);
+    Vector<N> v;
+    for(unsigned int i=0;i<N;i++)
+        v[i] = U(gen);
+    return v;
+}
+
+/**
+* Random diagonally dominant matrix (well conditioned, so every solver succeeds)
+* @param seed - random seed
+* @return Matrix<N,N> - the matrix
+**/
+template<unsigned int N>
+Matrix<N,N> randomMatrix(const unsigned int& seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> U(-1.0, 1.0);
+    Matrix<N,N> m;
+    for(unsigned int i=0;i<N;i++)
+        for(unsigned int j=0;j<N;j++)
+            m(i,j) = U(gen);
+    for(unsigned int i=0;i<N;i++)
+        m(i,i) += double(N);
+    return m;
+}
+
+/**
+* Random rows x cols matrix with entries in [-1, 1]
+* @param rows - number of rows
+* @param cols - number of columns
+* @param seed - random seed
+* @param shift - added to the diagonal (rows+cols keeps square matrices well conditioned)
+* @return DynMatrix - the matrix
+**/
+inline DynMatrix randomDynMatrix(const unsigned int& rows, const unsigned int& cols, const unsigned int& seed, const double& shift = 0.0)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> U(-1.0, 1.0);
+    DynMatrix m(rows, cols);
+    for(unsigned int i=0;i<rows;i++)
+        for(unsigned int j=0;j<cols;j++)
+            m(i,j) = U(gen);
+    for(unsigned int i=0;i<std::min(rows, cols);i++)
+        m(i,i) += shift;
+    return m;
+}
+
+/**
+* 5-point Laplacian of an m x m grid (Dirichlet boundary) plus shift*I - the SPD system of Laplacian smoothing
+* @param m - grid size (m*m unknowns)
+* @param shift - added to the diagonal
+* @return SparseMatrix - the matrix
+**/
+inline SparseMatrix gridLaplacian(const unsigned int& m, const double& shift = 0.0)
+{
+    TripletBuilder T(m*m, m*m);
+    T.reserve(5*m*m);
+    for(unsigned int i=0;i<m;i++)
+        for(unsigned int j=0;j<m;j++)
+        {
+            unsigned int k = i*m+j;
+            T.add(k, k, 4.0+shift);
+            if(j>0)
+                T.add(k, k-1, -1.0);
+            if(j+1<m)
+                T.add(k, k+1, -1.0);
+            if(i>0)
+                T.add(k, k-m, -1.0);
+            if(i+1<m)
+                T.add(k, k+m, -1.0);
+        }
+    return T.build();
+}
+
+/**
+* Random points uniformly distributed in [-extent, extent]^2
+* @param n - number of points
+* @param seed - random seed
+* @param extent - half size of the sampling box
+* @return vector<Vector<2> > - the points
+**/
+inline vector<Vector<2> > randomPoints(const unsigned int& n, const unsigned int& seed, const double& extent = 100.0)
+{
+    std::mt19937 gen(seed);
+    vector<Vector<2> > points;
+    points.reserve(n);
+    for(unsigned int i=0;i<n;i++)
+        points.push_back(randomVector<2>(gen, extent));
+    return points;
+}
+
+/**
+* Random segments with uniformly distributed midpoints and bounded length
+* @param n - number of segments
+* @param seed - random seed
+* @param extent - half size of the sampling box
+* @param length - maximum segment length
+* @return vector<Segment<2> > - the segments
+**/
+inline vector<Segment<2> > randomSegments(const unsigned int& n, const unsigned int& seed, const double& extent = 100.0, const double& length = 10.0)
+{
+    std::mt19937 gen(seed);
+    vector<Segment<2> > segments;
+    segments.reserve(n);
+    for(unsigned int i=0;i<n;i++)
+    {
+        Vector<2> c = randomVector<2>(gen, extent), d = randomVector<2>(gen, length/2.0);
+        segments.push_back(Segment<2>(c-d, c+d));
+    }
+    return segments;
+}
+
+/**
+* Random rays (unit directions) starting inside [-extent, extent]^2
+* @param n - number of rays
+* @param seed - random seed
+* @param extent - half size of the sampling box
+* @return vector<Ray<2> > - the rays
+**/
+inline vector<Ray<2> > randomRays(const unsigned int& n, const unsigned int& seed, const double& extent = 100.0)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> A(0.0, 2.0*M_PI);
+    vector<Ray<2> > rays;
+    rays.reserve(n);
+    for(unsigned int i=0;i<n;i++)
+    {
+        Vector<2> p = randomVector<2>(gen, extent);
+        double a = A(gen);
+        rays.push_back(Ray<2>(p, Vector<2>(std::cos(a), std::sin(a))));
+    }
+    return rays;
+}
+
+/**
+* Random walk polyline
+* @param n - number of vertices
+* @param seed - random seed
+* @param step - maximum step between consecutive vertices
+* @return Polyline<2> - the polyline
+**/
+inline Polyline<2> randomPolyline(const unsigned int& n, const unsigned int& seed, const double& step = 1.0)
+{
+    std::mt19937 gen(seed);
+    Polyline<2> line;
+    line.reserve(n);
+    Vector<2> p = randomVector<2>(gen, 10.0);
+    for(unsigned int i=0;i<n;i++)
+    {
+        line.addPoint(p);
+        p = p+randomVector<2>(gen, step);
+    }
+    return line;
+}
+
+/**
+* Random simple (star shaped) polygon around a center
+* Vertices are placed at sorted angles with random radii, so the polygon never self-intersects
+* @param n - number of vertices (n>=3)
+* @param seed - random seed
+* @param center - center of the polygon
+* @param radius - maximum radius
+* @param convex - if true all the radii are equal (convex polygon)
+* @return Polygon - the polygon (counter-clockwise)
+**/
+inline Polygon randomPolygon(const unsigned int& n, const unsigned int& seed, const Vector<2>& center = Vector<2>(0.0, 0.0), const double& radius = 10.0, const bool& convex = false)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> A(0.0, 2.0*M_PI), R(0.3*radius, radius);
+    vector<double> angles(n);
+    for(unsigned int i=0;i<n;i++)
+        angles[i] = A(gen);
+    std::sort(angles.begin(), angles.end());
+    Polygon poly;
+    for(unsigned int i=0;i<n;i++)
+    {
+        double r = convex ? radius : R(gen);
+        poly.addPoint(Vector<2>(center[0]+r*std::cos(angles[i]), center[1]+r*std::sin(angles[i])));
+    }
+    return poly;
+}
+
+/**
+* Random small triangles inside [-extent, extent]^2
+* @param n - number of triangles
+* @param seed - random seed
+* @param extent - half size of the sampling box
+* @param size - maximum distance of the vertices from the triangle center
+* @return vector<Polygon> - the triangles
+**/
+inline vector<Polygon> randomTriangles(const unsigned int& n, const unsigned int& seed, const double& extent = 100.0, const double& size = 0.1)
+{
+    std::mt19937 gen(seed);
+    vector<Polygon> triangles;
+    triangles.reserve(n);
+    for(unsigned int i=0;i<n;i++)
+    {
+        Vector<2> c = randomVector<2>(gen, extent-size);
+        triangles.push_back(Triangle(c+randomVector<2>(gen, size), c+randomVector<2>(gen, size), c+randomVector<2>(gen, size)));
+    }
+    return triangles;
+}
+
+/**
+* Random axis aligned rectangles inside [-extent, extent]^2
+* @param n - number of rectangles
+* @param seed - random seed
+* @param extent - half size of the sampling box
+* @param size - maximum side length
+* @return vector<Rectangle> - the rectangles
+**/
+inline vector<Rectangle> randomRectangles(const unsigned int& n, const unsigned int& seed, const double& extent = 100.0, const double& size = 10.0)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> S(0.1*size, size);
+    vector<Rectangle> rectangles;
+    rectangles.reserve(n);
+    for(unsigned int i=0;i<n;i++)
+        rectangles.push_back(Rectangle(randomVector<2>(gen, extent), S(gen), S(gen)));
+    return rectangles;
+}
+
+/**
+* Fill a plane curve with random control/interpolation points
+* @param curve - the curve (PlaneCurve is not copyable, so it is filled in place)
+* @param n - number of points
+* @param seed - random seed
+* @param extent - half size of the sampling box
+**/
+template<class CurveType>
+void randomCurve(CurveType& curve, const unsigned int& n, const unsigned int& seed, const double& extent = 10.0)
+{
+    std::mt19937 gen(seed);
+    for(unsigned int i=0;i<n;i++)
+        curve.addPoint(randomVector<2>(gen, extent));
+}
+
+/**
+* Sorted parameters in [0,1]
+* @param n - number of parameters
+* @param seed - random seed
+* @return vector<double> - the parameters
+**/
+inline vector<double> randomParameters(const unsigned int& n, const unsigned int& seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> U(0.0, 1.0);
+    vector<double> u(n);
+    for(unsigned int i=0;i<n;i++)
+        u[i] = U(gen);
+    std::sort(u.begin(), u.end());
+    return u;
+}
+
+}
+
+#endif
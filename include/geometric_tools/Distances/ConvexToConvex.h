@@ -0,0 +1,316 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_DISTANCES_CONVEX_TO_CONVEX_H
+#define GEOMETRIC_TOOLS_DISTANCES_CONVEX_TO_CONVEX_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Primitives/Tools/SupportFunction.h>
+#include <limits>
+#include <cmath>
+
+namespace GeometricTools {
+
+using Math::Vector;
+using Primitives::ShapeDimension;
+
+namespace Distances {
+
+/**
+* GJK Simplex
+* Vertices of the GJK simplex (points of the Minkowski difference A-B and the support points on A and B)
+* Keep one simplex per pair of shapes and pass it to successive queries to warm-start GJK
+* (the last separating direction is re-used, which makes temporally coherent queries converge in 1-2 iterations)
+**/
+template<unsigned int N>
+struct GJKSimplex
+{
+    // points of the Minkowski difference (a-b)
+    Vector<N> w[N+1];
+    // support points on shape A
+    Vector<N> a[N+1];
+    // support points on shape B
+    Vector<N> b[N+1];
+    // barycentric coordinates of the closest point
+    double lambda[N+1];
+    // number of vertices
+    unsigned int size;
+    // last closest point of A-B (search direction) - used for warm-starting
+    Vector<N> direction;
+
+    GJKSimplex(): size(0) {}
+};
+
+/**
+* GJK Query Info
+* intersect - whether the shapes overlap
+* distanceSq - squared distance of the shapes (zero if they overlap)
+* pointA, pointB - closest points on the two shapes
+* iterations - iterations needed
+**/
+template<unsigned int N>
+struct GJKInfo
+{
+    bool intersect;
+    double distanceSq;
+    Vector<N> pointA;
+    Vector<N> pointB;
+    unsigned int iterations;
+};
+
+/**
+* Solve small dense linear system (Gauss elimination with partial pivoting)
+* @param A - augmented (n)x(n+1) matrix - destroyed
+* @param n - size of the system
+* @param x - solution
+* @return bool - false if the system is (numerically) singular
+**/
+template<unsigned int M>
+bool gjkSolveSmall(double A[M][M+1], unsigned int n, double* x)
+{
+    double scale = 0.0;
+    for(unsigned int i=0;i<n;i++)
+        scale = std::max(scale, std::abs(A[i][i]));
+    if(scale<=0.0)
+        return false;
+    for(unsigned int i=0;i<n;i++)
+    {
+        unsigned int p = i;
+        for(unsigned int r=i+1;r<n;r++)
+            if(std::abs(A[r][i])>std::abs(A[p][i]))
+                p = r;
+        if(std::abs(A[p][i])<1e-14*scale)
+            return false;
+        if(p!=i)
+        {
+            for(unsigned int c=i;c<=n;c++)
+                std::swap(A[i][c], A[p][c]);
+        }
+        for(unsigned int r=i+1;r<n;r++)
+        {
+            double f = A[r][i]/A[i][i];
+            for(unsigned int c=i;c<=n;c++)
+                A[r][c] -= f*A[i][c];
+        }
+    }
+    for(int i=int(n)-1;i>=0;i--)
+    {
+        double s = A[i][n];
+        for(unsigned int c=i+1;c<n;c++)
+            s -= A[i][c]*x[c];
+        x[i] = s/A[i][i];
+    }
+    return true;
+}
+
+/**
+* Closest point of the simplex to the origin
+* Checks the projection of the origin on the affine hull of every sub-simplex and keeps the closest one
+* that lies inside its sub-simplex; the simplex is then reduced to that sub-simplex
+* @param s - the simplex (reduced in place)
+* @param v - the closest point (returns)
+**/
+template<unsigned int N>
+void gjkClosestOnSimplex(GJKSimplex<N>& s, Vector<N>& v)
+{
+    unsigned int k = s.size;
+    double best = std::numeric_limits<double>::infinity();
+    unsigned int best_mask = 1;
+    double best_lambda[N+1];
+    best_lambda[0] = 1.0;
+    for(unsigned int mask=1;mask<(1u<<k);mask++)
+    {
+        unsigned int idx[N+1], m = 0;
+        for(unsigned int i=0;i<k;i++)
+            if(mask&(1u<<i))
+                idx[m++] = i;
+        double lambda[N+1];
+        lambda[0] = 1.0;
+        if(m>1)
+        {
+            double G[N][N+1], mu[N];
+            for(unsigned int j=1;j<m;j++)
+            {
+                Vector<N> ej = s.w[idx[j]]-s.w[idx[0]];
+                for(unsigned int l=1;l<m;l++)
+                    G[j-1][l-1] = ej*(s.w[idx[l]]-s.w[idx[0]]);
+                G[j-1][m-1] = -(ej*s.w[idx[0]]);
+            }
+            if(!gjkSolveSmall<N>(G, m-1, mu))
+                continue;
+            bool inside = true;
+            for(unsigned int j=1;j<m;j++)
+            {
+                lambda[j] = mu[j-1];
+                lambda[0] -= mu[j-1];
+                if(lambda[j]<=0.0)
+                    inside = false;
+            }
+            if(!inside || lambda[0]<=0.0)
+                continue;
+        }
+        Vector<N> p;
+        for(unsigned int j=0;j<m;j++)
+            p += lambda[j]*s.w[idx[j]];
+        double d = p.lengthSq();
+        if(d<best)
+        {
+            best = d;
+            best_mask = mask;
+            for(unsigned int j=0;j<m;j++)
+                best_lambda[j] = lambda[j];
+            v = p;
+        }
+    }
+    // reduce simplex
+    unsigned int m = 0;
+    for(unsigned int i=0;i<k;i++)
+    {
+        if(best_mask&(1u<<i))
+        {
+            s.w[m] = s.w[i];
+            s.a[m] = s.a[i];
+            s.b[m] = s.b[i];
+            s.lambda[m] = best_lambda[m];
+            m++;
+        }
+    }
+    s.size = m;
+}
+
+/**
+* GJK distance query between two convex shapes
+* Shapes are only accessed through their support functions (see Primitives/Tools/SupportFunction.h)
+* @param a - first convex shape
+* @param b - second convex shape
+* @param info - the result of the query (returns)
+* @param cache - simplex of the previous query of this pair (warm-start) - can be nullptr
+* @param max_iterations - maximum number of iterations
+* @param tolerance - relative tolerance for convergence
+* @return bool - true if the shapes overlap
+**/
+template<class ShapeA, class ShapeB, unsigned int N>
+bool gjk(const ShapeA& a, const ShapeB& b, GJKInfo<N>& info, GJKSimplex<N>* cache = nullptr,
+         const unsigned int& max_iterations = 64, const double& tolerance = 1e-10)
+{
+    using Primitives::support;
+    GJKSimplex<N> local;
+    GJKSimplex<N>& s = (cache!=nullptr)? *cache : local;
+
+    Vector<N> d = s.direction;
+    if(d.lengthSq()<std::numeric_limits<double>::epsilon())
+        d = Vector<N>::e(0);
+
+    s.size = 1;
+    s.a[0] = support(a, d*(-1.0));
+    s.b[0] = support(b, d);
+    s.w[0] = s.a[0]-s.b[0];
+    s.lambda[0] = 1.0;
+    Vector<N> v = s.w[0];
+
+    info.intersect = false;
+    unsigned int it;
+    for(it=0;it<max_iterations;it++)
+    {
+        double vv = v*v;
+        double scale = 0.0;
+        for(unsigned int i=0;i<s.size;i++)
+            scale = std::max(scale, s.w[i].lengthSq());
+        if(vv<=tolerance*tolerance*scale)
+        {
+            info.intersect = true;
+            break;
+        }
+        Vector<N> pa = support(a, v*(-1.0));
+        Vector<N> pb = support(b, v);
+        Vector<N> w = pa-pb;
+        // no more progress along v - v is the closest point
+        if((vv-v*w)<=tolerance*vv)
+            break;
+        bool duplicate = false;
+        for(unsigned int i=0;i<s.size;i++)
+            if((s.w[i]-w).lengthSq()<=tolerance*tolerance*scale)
+                duplicate = true;
+        if(duplicate)
+            break;
+        s.w[s.size] = w;
+        s.a[s.size] = pa;
+        s.b[s.size] = pb;
+        s.size++;
+        gjkClosestOnSimplex(s, v);
+        if(s.size==N+1)
+        {
+            // origin strictly inside a full dimensional simplex
+            info.intersect = true;
+            v = Vector<N>();
+            break;
+        }
+        if((v*v)>=vv)
+            break;
+    }
+    info.iterations = it;
+    info.pointA = Vector<N>();
+    info.pointB = Vector<N>();
+    for(unsigned int i=0;i<s.size;i++)
+    {
+        info.pointA += s.lambda[i]*s.a[i];
+        info.pointB += s.lambda[i]*s.b[i];
+    }
+    if(info.intersect)
+    {
+        info.distanceSq = 0.0;
+    }
+    else
+    {
+        info.distanceSq = v*v;
+        s.direction = v;
+    }
+    return info.intersect;
+}
+
+/**
+* Computes Convex Shape to Convex Shape Distance Squared (GJK)
+* @param a - first convex shape
+* @param b - second convex shape
+* @param cache - simplex of the previous query of this pair (warm-start) - can be nullptr
+**/
+template<class ShapeA, class ShapeB>
+double convexDistanceSq(const ShapeA& a, const ShapeB& b, GJKSimplex<ShapeDimension<ShapeA>::value>* cache = nullptr)
+{
+    GJKInfo<ShapeDimension<ShapeA>::value> info;
+    gjk(a, b, info, cache);
+    return info.distanceSq;
+}
+
+/**
+* Computes Convex Shape to Convex Shape Distance (GJK)
+* @param a - first convex shape
+* @param b - second convex shape
+* @param cache - simplex of the previous query of this pair (warm-start) - can be nullptr
+**/
+template<class ShapeA, class ShapeB>
+double convexDistance(const ShapeA& a, const ShapeB& b, GJKSimplex<ShapeDimension<ShapeA>::value>* cache = nullptr)
+{
+    return sqrt(convexDistanceSq(a, b, cache));
+}
+
+} }
+
+#endif
@@ -0,0 +1,279 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_DISTANCES_POINT_TO_CURVE_H
+#define GEOMETRIC_TOOLS_DISTANCES_POINT_TO_CURVE_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Math/Polynomial.h>
+#include <geometric_tools/Primitives/2D/PlaneCurve.h>
+#include <geometric_tools/Primitives/Tools/BezierPieces.h>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+using std::vector;
+
+namespace GeometricTools {
+
+using Math::Vector;
+using Primitives::PlaneCurve;
+using Primitives::BezierPieces;
+
+namespace Distances {
+
+/**
+* Closest point on a curve
+* u - curve parameter of the closest point
+* point - the closest point
+* distance - distance to the query point
+**/
+struct CurvePoint
+{
+    double u;
+    Vector<2> point;
+    double distance;
+};
+
+/**
+* Squared distance of a point from the box of a set of control points
+**/
+inline double controlBoxDistanceSq(const double* x, const double* y, const unsigned int& m, const Vector<2>& p)
+{
+    double x0 = x[0], x1 = x[0], y0 = y[0], y1 = y[0];
+    for(unsigned int j=1;j<m;j++)
+    {
+        x0 = std::min(x0, x[j]);
+        x1 = std::max(x1, x[j]);
+        y0 = std::min(y0, y[j]);
+        y1 = std::max(y1, y[j]);
+    }
+    double dx = std::max(std::max(x0-p[0], p[0]-x1), 0.0);
+    double dy = std::max(std::max(y0-p[1], p[1]-y1), 0.0);
+    return dx*dx+dy*dy;
+}
+
+/**
+* Closest point on a curve given by its Bezier pieces
+* Pieces (and sub-pieces) whose control box is farther than the best point found so far are pruned.
+* For the others the stationary condition g(s) = (C(s)-p).C'(s) is written in Bernstein form:
+* no sign change means no interior extremum, one sign change isolates a single root that is refined
+* with safeguarded Newton iterations, otherwise the piece is split in half.
+* @param pieces - the curve
+* @param point - query point
+* @param tolerance - accuracy of the local parameter of the root
+* @return CurvePoint - the closest point (distance is infinite for an empty curve)
+**/
+inline CurvePoint closestPoint(const BezierPieces& pieces, const Vector<2>& point, const double& tolerance = 1e-14)
+{
+    CurvePoint best;
+    best.u = 0.0;
+    best.distance = std::numeric_limits<double>::infinity();
+    const unsigned int P = pieces.pieces(), n = pieces.degree(), M = n+1;
+    if(P==0)
+        return best;
+
+    double best_sq = std::numeric_limits<double>::infinity();
+    unsigned int best_piece = 0;
+    double best_s = 0.0;
+    auto candidate = [&](const unsigned int& i, const double& s, const double& x, const double& y) {
+        double d = (x-point[0])*(x-point[0])+(y-point[1])*(y-point[1]);
+        if(d<best_sq)
+        {
+            best_sq = d;
+            best_piece = i;
+            best_s = s;
+        }
+    };
+
+    // piece end points and pieces ordered by their lower bound
+    vector<std::pair<double,unsigned int> > order(P);
+    for(unsigned int i=0;i<P;i++)
+    {
+        const double* x = pieces.x(i);
+        const double* y = pieces.y(i);
+        candidate(i, 0.0, x[0], y[0]);
+        candidate(i, 1.0, x[n], y[n]);
+        order[i] = std::make_pair(controlBoxDistanceSq(x, y, M, point), i);
+    }
+    std::sort(order.begin(), order.end());
+
+    if(n>=1)
+    {
+        // binomials for the Bernstein product (C-p).C' of degree 2n-1
+        const unsigned int G = 2*n-1;
+        vector<double> bn(M), bd(n), bg(G+1);
+        bn[0] = bd[0] = bg[0] = 1.0;
+        for(unsigned int k=1;k<=n;k++)
+            bn[k] = bn[k-1]*double(n-k+1)/double(k);
+        for(unsigned int k=1;k<n;k++)
+            bd[k] = bd[k-1]*double(n-k)/double(k);
+        for(unsigned int k=1;k<=G;k++)
+            bg[k] = bg[k-1]*double(G-k+1)/double(k);
+
+        // explicit stack of records [piece, s0, s1, x0..xn, y0..yn]
+        const unsigned int R = 3+2*M;
+        vector<double> stack, g(G+1), dg(G), l(M), r(M);
+        for(unsigned int o=P;o>0;o--)
+        {
+            unsigned int i = order[o-1].second;
+            if(order[o-1].first>=best_sq)
+                continue;
+            stack.push_back(i);
+            stack.push_back(0.0);
+            stack.push_back(1.0);
+            stack.insert(stack.end(), pieces.x(i), pieces.x(i)+M);
+            stack.insert(stack.end(), pieces.y(i), pieces.y(i)+M);
+        }
+
+        vector<double> rec(R);
+        while(!stack.empty())
+        {
+            std::copy(stack.end()-R, stack.end(), rec.begin());
+            stack.resize(stack.size()-R);
+            const unsigned int i = (unsigned int)rec[0];
+            const double s0 = rec[1], s1 = rec[2];
+            double* x = &rec[3];
+            double* y = &rec[3+M];
+            if(controlBoxDistanceSq(x, y, M, point)>=best_sq)
+                continue;
+
+            // g = (X-px)X'+(Y-py)Y' in Bernstein form (up to the positive factor n)
+            std::fill(g.begin(), g.end(), 0.0);
+            for(unsigned int a=0;a<=n;a++)
+                for(unsigned int b=0;b<n;b++)
+                    g[a+b] += bn[a]*bd[b]*((x[a]-point[0])*(x[b+1]-x[b])+(y[a]-point[1])*(y[b+1]-y[b]));
+            unsigned int changes = 0;
+            int sign = 0;
+            for(unsigned int k=0;k<=G;k++)
+            {
+                g[k] /= bg[k];
+                int sk = (g[k]>0.0)-(g[k]<0.0);
+                if(sk!=0 && sign!=0 && sk!=sign)
+                    changes++;
+                if(sk!=0)
+                    sign = sk;
+            }
+            if(changes==0)
+                continue;
+
+            if(changes==1 || s1-s0<=tolerance)
+            {
+                // single root: safeguarded Newton on the bracket [0,1]
+                double a = 0.0, b = 1.0, t = 0.5;
+                if(changes==1)
+                {
+                    for(unsigned int k=0;k<G;k++)
+                        dg[k] = double(G)*(g[k+1]-g[k]);
+                    double ga = g[0];
+                    for(unsigned int it=0;it<100 && b-a>tolerance;it++)
+                    {
+                        double gt = Math::bernstein(g.data(), G, t);
+                        if(gt==0.0)
+                            break;
+                        if((gt<0.0)==(ga<0.0))
+                            a = t, ga = gt;
+                        else
+                            b = t;
+                        double d = Math::bernstein(dg.data(), G-1, t);
+                        double tn = (d!=0.0)? t-gt/d : 0.5*(a+b);
+                        if(!(tn>a && tn<b))
+                            tn = 0.5*(a+b);
+                        if(std::abs(tn-t)<=0.5*tolerance)
+                        {
+                            t = tn;
+                            break;
+                        }
+                        t = tn;
+                    }
+                }
+                candidate(i, s0+t*(s1-s0), Math::bernstein(x, n, t), Math::bernstein(y, n, t));
+                continue;
+            }
+
+            // several candidate roots: split in half
+            Math::bernsteinSubdivide(x, n, 0.5, l.data(), x);
+            Math::bernsteinSubdivide(y, n, 0.5, r.data(), y);
+            double sm = 0.5*(s0+s1);
+            candidate(i, sm, x[0], y[0]);
+            // right half (x,y now hold it), then left half on top of the stack
+            stack.push_back(i);
+            stack.push_back(sm);
+            stack.push_back(s1);
+            stack.insert(stack.end(), x, x+M);
+            stack.insert(stack.end(), y, y+M);
+            stack.push_back(i);
+            stack.push_back(s0);
+            stack.push_back(sm);
+            stack.insert(stack.end(), l.begin(), l.end());
+            stack.insert(stack.end(), r.begin(), r.end());
+        }
+    }
+
+    best.u = pieces.parameter(best_piece, best_s);
+    best.point = pieces.point(best_piece, best_s);
+    best.distance = std::sqrt(best_sq);
+    return best;
+}
+
+/**
+* Closest point on a plane curve
+* Decomposes the curve first - use the BezierPieces overload for repeated queries on the same curve
+* @param curve - the curve
+* @param point - query point
+* @return CurvePoint - the closest point
+**/
+template<class CurveA, class CurveB>
+CurvePoint closestPoint(const PlaneCurve<CurveA,CurveB>& curve, const Vector<2>& point)
+{
+    return closestPoint(BezierPieces(curve), point);
+}
+
+/**
+* Computes Point to Curve Distance
+* @param point
+* @param curve
+**/
+inline double distance(const Vector<2>& point, const BezierPieces& curve)
+{
+    return closestPoint(curve, point).distance;
+}
+
+inline double distance(const BezierPieces& curve, const Vector<2>& point)
+{
+    return distance(point, curve);
+}
+
+template<class CurveA, class CurveB>
+double distance(const Vector<2>& point, const PlaneCurve<CurveA,CurveB>& curve)
+{
+    return closestPoint(curve, point).distance;
+}
+
+template<class CurveA, class CurveB>
+double distance(const PlaneCurve<CurveA,CurveB>& curve, const Vector<2>& point)
+{
+    return distance(point, curve);
+}
+
+} }
+
+#endif
@@ -0,0 +1,329 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_INTERSECTIONS_2D_CURVE_TO_CURVE_H
+#define GEOMETRIC_TOOLS_INTERSECTIONS_2D_CURVE_TO_CURVE_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Math/Polynomial.h>
+#include <geometric_tools/Primitives/2D/PlaneCurve.h>
+#include <geometric_tools/Primitives/Tools/BezierPieces.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+using std::vector;
+
+namespace GeometricTools {
+
+using Math::Vector;
+using Primitives::PlaneCurve;
+using Primitives::BezierPieces;
+
+namespace Intersections {
+
+/**
+* Curve Intersection
+* point - the intersection point
+* u, v - parameters of the point on the first and the second curve
+**/
+struct CurveIntersection
+{
+    Vector<2> point;
+    double u;
+    double v;
+};
+
+/**
+* Control box of a Bezier piece
+* @return Vector<4> - (min x, min y, max x, max y)
+**/
+inline Vector<4> controlBox(const double* x, const double* y, const unsigned int& m)
+{
+    Vector<4> b(x[0], y[0], x[0], y[0]);
+    for(unsigned int j=1;j<m;j++)
+    {
+        b[0] = std::min(b[0], x[j]);
+        b[1] = std::min(b[1], y[j]);
+        b[2] = std::max(b[2], x[j]);
+        b[3] = std::max(b[3], y[j]);
+    }
+    return b;
+}
+
+inline bool boxesOverlap(const Vector<4>& a, const Vector<4>& b, const double& tolerance)
+{
+    return a[0]<=b[2]+tolerance && b[0]<=a[2]+tolerance && a[1]<=b[3]+tolerance && b[1]<=a[3]+tolerance;
+}
+
+/**
+* Newton iterations on A(s)-B(t) = 0 for two Bezier pieces
+* @return bool - true if converged to a point with |A(s)-B(t)|<=tolerance, s and t in [0,1]
+**/
+inline bool refineIntersection(const BezierPieces& a, const unsigned int& i, const BezierPieces& b, const unsigned int& j,
+                               double& s, double& t, const double& tolerance)
+{
+    for(unsigned int it=0;it<32;it++)
+    {
+        Vector<2> f = a.point(i, s)-b.point(j, t);
+        Vector<2> da = a.derivative(i, s), db = b.derivative(j, t);
+        // solve [da -db] [ds dt]^T = -f
+        double det = -da[0]*db[1]+db[0]*da[1];
+        if(std::abs(det)<1e-300)
+            break;
+        double ds = (-f[0]*(-db[1])+db[0]*(-f[1]))/det;
+        double dt = (da[0]*(-f[1])-da[1]*(-f[0]))/det;
+        s = std::min(std::max(s+ds, 0.0), 1.0);
+        t = std::min(std::max(t+dt, 0.0), 1.0);
+        if(std::abs(ds)+std::abs(dt)<1e-15)
+            break;
+    }
+    return (a.point(i, s)-b.point(j, t)).length()<=tolerance;
+}
+
+/**
+* Distance between two segments given by start point and direction
+**/
+inline double segmentDistance(const double& ax, const double& ay, const double& ex, const double& ey,
+                              const double& bx, const double& by, const double& gx, const double& gy)
+{
+    auto pointDist = [](double px, double py, double x0, double y0, double dx, double dy) {
+        double l2 = dx*dx+dy*dy;
+        double t = (l2>0.0)? std::min(std::max(((px-x0)*dx+(py-y0)*dy)/l2, 0.0), 1.0) : 0.0;
+        double ux = x0+t*dx-px, uy = y0+t*dy-py;
+        return std::sqrt(ux*ux+uy*uy);
+    };
+    // crossing segments are handled by the caller - otherwise the distance is attained at an end point
+    return std::min(std::min(pointDist(ax, ay, bx, by, gx, gy), pointDist(ax+ex, ay+ey, bx, by, gx, gy)),
+                    std::min(pointDist(bx, by, ax, ay, ex, ey), pointDist(bx+gx, by+gy, ax, ay, ex, ey)));
+}
+
+inline void addIntersection(vector<CurveIntersection>& found, const BezierPieces& a, const unsigned int& i, const double& s,
+                            const BezierPieces& b, const unsigned int& j, const double& t)
+{
+    CurveIntersection info;
+    info.u = a.parameter(i, s);
+    info.v = b.parameter(j, t);
+    info.point = 0.5*(a.point(i, s)+b.point(j, t));
+    found.push_back(info);
+}
+
+/**
+* Find the intersections of two curves given by their Bezier pieces
+* Pairs of (sub-)pieces with overlapping control boxes are split in half (the larger one) until both are
+* flat; the chords then give a start point for Newton iterations on the original pieces. Pieces that shrink
+* below the tolerance without converging (tangential contact) are reported at their midpoints and
+* collinear overlaps at the end points of the overlap.
+* Intersections closer than the tolerance are merged.
+* @param a - first curve
+* @param b - second curve
+* @param result - buffer for the intersections (cleared first - re-use it between calls to avoid allocations)
+* @param tolerance - distance tolerance
+* @return unsigned int - number of intersections
+**/
+inline unsigned int intersect(const BezierPieces& a, const BezierPieces& b, vector<CurveIntersection>& result, const double& tolerance = 1e-10)
+{
+    result.clear();
+    const unsigned int na = a.degree(), nb = b.degree(), ma = na+1, mb = nb+1;
+    const unsigned int PA = a.pieces(), PB = b.pieces();
+    if(PA==0 || PB==0)
+        return 0;
+
+    // broad phase: sweep over the pieces of b sorted by their min x
+    vector<Vector<4> > boxa(PA), boxb(PB);
+    for(unsigned int i=0;i<PA;i++)
+        boxa[i] = controlBox(a.x(i), a.y(i), ma);
+    vector<std::pair<double,unsigned int> > order(PB);
+    for(unsigned int j=0;j<PB;j++)
+    {
+        boxb[j] = controlBox(b.x(j), b.y(j), mb);
+        order[j] = std::make_pair(boxb[j][0], j);
+    }
+    std::sort(order.begin(), order.end());
+
+    // record: [i, s0, s1, xa(ma), ya(ma), j, t0, t1, xb(mb), yb(mb)]
+    const unsigned int OA = 3, OB = 3+2*ma, R = OB+3+2*mb;
+    vector<double> stack, rec(R), l(std::max(ma, mb)), r(std::max(ma, mb));
+    auto push = [&](const double* ra, const double* rb) {
+        stack.insert(stack.end(), ra, ra+OB);
+        stack.insert(stack.end(), rb, rb+3+2*mb);
+    };
+    vector<double> ra(OB), rb(3+2*mb);
+    for(unsigned int i=0;i<PA;i++)
+    {
+        ra[0] = i;
+        ra[1] = 0.0;
+        ra[2] = 1.0;
+        std::copy(a.x(i), a.x(i)+ma, ra.begin()+OA);
+        std::copy(a.y(i), a.y(i)+ma, ra.begin()+OA+ma);
+        for(unsigned int k=0;k<PB && order[k].first<=boxa[i][2]+tolerance;k++)
+        {
+            unsigned int j = order[k].second;
+            if(!boxesOverlap(boxa[i], boxb[j], tolerance))
+                continue;
+            rb[0] = j;
+            rb[1] = 0.0;
+            rb[2] = 1.0;
+            std::copy(b.x(j), b.x(j)+mb, rb.begin()+3);
+            std::copy(b.y(j), b.y(j)+mb, rb.begin()+3+mb);
+            push(ra.data(), rb.data());
+        }
+    }
+
+    // flatness: distance of the control points from the chord
+    auto flatness = [](const double* x, const double* y, const unsigned int& m) {
+        double dx = x[m-1]-x[0], dy = y[m-1]-y[0];
+        double len = std::sqrt(dx*dx+dy*dy);
+        double d = 0.0;
+        for(unsigned int k=1;k+1<m;k++)
+        {
+            double px = x[k]-x[0], py = y[k]-y[0];
+            d = std::max(d, (len>0.0)? std::abs(px*dy-py*dx)/len : std::sqrt(px*px+py*py));
+        }
+        return d;
+    };
+
+    vector<CurveIntersection> found;
+    while(!stack.empty())
+    {
+        std::copy(stack.end()-R, stack.end(), rec.begin());
+        stack.resize(stack.size()-R);
+        double* xa = &rec[OA];
+        double* ya = &rec[OA+ma];
+        double* xb = &rec[OB+3];
+        double* yb = &rec[OB+3+mb];
+        Vector<4> ba = controlBox(xa, ya, ma), bb = controlBox(xb, yb, mb);
+        if(!boxesOverlap(ba, bb, tolerance))
+            continue;
+        const unsigned int i = (unsigned int)rec[0], j = (unsigned int)rec[OB];
+        double sizea = std::max(ba[2]-ba[0], ba[3]-ba[1]), sizeb = std::max(bb[2]-bb[0], bb[3]-bb[1]);
+        double fa = flatness(xa, ya, ma), fb = flatness(xb, yb, mb);
+
+        if(fa<=1e-3*sizea+tolerance && fb<=1e-3*sizeb+tolerance)
+        {
+            double ex = xa[na]-xa[0], ey = ya[na]-ya[0], gx = xb[nb]-xb[0], gy = yb[nb]-yb[0];
+            double wx = xb[0]-xa[0], wy = yb[0]-ya[0];
+            double det = ex*gy-ey*gx;
+            double lena = std::sqrt(ex*ex+ey*ey), lenb = std::sqrt(gx*gx+gy*gy);
+            if(std::abs(det)>1e-12*lena*lenb)
+            {
+                // chords cross: start point for Newton on the whole pieces
+                double p = (wx*gy-wy*gx)/det, q = (wx*ey-wy*ex)/det;
+                if(p>=-0.1 && p<=1.1 && q>=-0.1 && q<=1.1)
+                {
+                    double s = rec[1]+std::min(std::max(p, 0.0), 1.0)*(rec[2]-rec[1]);
+                    double t = rec[OB+1]+std::min(std::max(q, 0.0), 1.0)*(rec[OB+2]-rec[OB+1]);
+                    if(refineIntersection(a, i, b, j, s, t, tolerance))
+                    {
+                        addIntersection(found, a, i, s, b, j, t);
+                        continue;
+                    }
+                }
+                else if(segmentDistance(xa[0], ya[0], ex, ey, xb[0], yb[0], gx, gy)>fa+fb+tolerance)
+                    continue;
+            }
+            else if(segmentDistance(xa[0], ya[0], ex, ey, xb[0], yb[0], gx, gy)>fa+fb+tolerance)
+                continue;
+            else if(lena>tolerance && lenb>tolerance)
+            {
+                // (nearly) collinear overlap: report the end points of the overlap, like SegmentSweep
+                for(unsigned int e=0;e<2;e++)
+                {
+                    double p = ((wx+e*gx)*ex+(wy+e*gy)*ey)/(lena*lena);
+                    if(p>=0.0 && p<=1.0)
+                        addIntersection(found, a, i, rec[1]+p*(rec[2]-rec[1]), b, j, rec[OB+1]+e*(rec[OB+2]-rec[OB+1]));
+                    double q = ((-wx+e*ex)*gx+(-wy+e*ey)*gy)/(lenb*lenb);
+                    if(q>=0.0 && q<=1.0)
+                        addIntersection(found, a, i, rec[1]+e*(rec[2]-rec[1]), b, j, rec[OB+1]+q*(rec[OB+2]-rec[OB+1]));
+                }
+                continue;
+            }
+        }
+        if(sizea<=tolerance && sizeb<=tolerance)
+        {
+            // tangential contact that Newton could not resolve
+            addIntersection(found, a, i, 0.5*(rec[1]+rec[2]), b, j, 0.5*(rec[OB+1]+rec[OB+2]));
+            continue;
+        }
+        // split the larger piece in half
+        if(sizea>=sizeb)
+        {
+            Math::bernsteinSubdivide(xa, na, 0.5, l.data(), xa);
+            Math::bernsteinSubdivide(ya, na, 0.5, r.data(), ya);
+            double sm = 0.5*(rec[1]+rec[2]), s1 = rec[2];
+            rec[1] = sm;
+            stack.insert(stack.end(), rec.begin(), rec.end());
+            rec[1] = rec[1]-(s1-sm);
+            rec[2] = sm;
+            std::copy(l.begin(), l.begin()+ma, rec.begin()+OA);
+            std::copy(r.begin(), r.begin()+ma, rec.begin()+OA+ma);
+            stack.insert(stack.end(), rec.begin(), rec.end());
+        }
+        else
+        {
+            Math::bernsteinSubdivide(xb, nb, 0.5, l.data(), xb);
+            Math::bernsteinSubdivide(yb, nb, 0.5, r.data(), yb);
+            double tm = 0.5*(rec[OB+1]+rec[OB+2]), t1 = rec[OB+2];
+            rec[OB+1] = tm;
+            stack.insert(stack.end(), rec.begin(), rec.end());
+            rec[OB+1] = tm-(t1-tm);
+            rec[OB+2] = tm;
+            std::copy(l.begin(), l.begin()+mb, rec.begin()+OB+3);
+            std::copy(r.begin(), r.begin()+mb, rec.begin()+OB+3+mb);
+            stack.insert(stack.end(), rec.begin(), rec.end());
+        }
+    }
+
+    // merge duplicates (shared piece boundaries, tangential clusters)
+    std::sort(found.begin(), found.end(), [](const CurveIntersection& p, const CurveIntersection& q) { return p.u<q.u; });
+    for(unsigned int k=0;k<found.size();k++)
+    {
+        bool duplicate = false;
+        for(unsigned int m=result.size();m>0 && !duplicate;m--)
+        {
+            if((result[m-1].point-found[k].point).length()<=10.0*tolerance)
+                duplicate = true;
+            else if(found[k].u-result[m-1].u>1e-6)
+                break;
+        }
+        if(!duplicate)
+            result.push_back(found[k]);
+    }
+    return result.size();
+}
+
+/**
+* Find the intersections of two plane curves
+* Decomposes the curves first - use the BezierPieces overload for repeated queries on the same curves
+* @param a - first curve
+* @param b - second curve
+* @param result - buffer for the intersections (cleared first)
+* @param tolerance - distance tolerance
+* @return unsigned int - number of intersections
+**/
+template<class CurveA, class CurveB, class CurveC, class CurveD>
+unsigned int intersect(const PlaneCurve<CurveA,CurveB>& a, const PlaneCurve<CurveC,CurveD>& b, vector<CurveIntersection>& result, const double& tolerance = 1e-10)
+{
+    return intersect(BezierPieces(a), BezierPieces(b), result, tolerance);
+}
+
+} }
+
+#endif
@@ -37,7 +37,6 @@ namespace Intersections {
 
 inline Intersection2DInfo* intersect(const Segment<2>& seg1, const Segment<2>& seg2)
 {
-    Intersection2DInfo* info = new Intersection2DInfo;
     double epsilon = std::numeric_limits<double>::epsilon();
     Vector<2> u = seg1.d();
     Vector<2> v = seg2.d();
@@ -48,12 +47,16 @@ inline Intersection2DInfo* intersect(const Segment<2>& seg1, const Segment<2>& s
     {
         if(std::abs(tmp1)>epsilon || std::abs(tmp2)>epsilon)
             return nullptr;
+        Intersection2DInfo* info = new Intersection2DInfo;
         double du = u*u;
         double dv = v*v;
         if(du<epsilon && dv<epsilon)
         {
             if(std::abs(du-dv)>epsilon)
+            {
+                delete info;
                 return nullptr;
+            }
             info->point = seg1.P0();
             return info;
         }
@@ -85,10 +88,13 @@ inline Intersection2DInfo* intersect(const Segment<2>& seg1, const Segment<2>& s
         {
             double t = t0;
             t0 = t1;
-            t1 = t0;
+            t1 = t;
         }
         if(t0>1 || t1 < 0)
+        {
+            delete info;
             return nullptr;
+        }
         t0 = (t0<0)? 0 : t0;
         t1 = (t1>1)? 1 : t1;
         if((t1-t0)<epsilon)
@@ -100,13 +106,15 @@ inline Intersection2DInfo* intersect(const Segment<2>& seg1, const Segment<2>& s
         info->delta = (seg2.P0()+t1*v)-info->point;
         return info;
     }
-    double sI = tmp1/D;
+    // sI - parameter on seg1, tI - parameter on seg2
+    double sI = tmp2/D;
     if(sI<0.0 || sI>1.0)
         return nullptr;
-    double tI = tmp2/D;
+    double tI = tmp1/D;
     if(tI<0.0 || tI>1.0)
         return nullptr;
 
+    Intersection2DInfo* info = new Intersection2DInfo;
     info->point = seg1.P0()+sI*u;
     return info;
 }
@@ -39,27 +39,35 @@ using Primitives::Polyline;
 
 namespace Intersections {
 
+/**
+* Segment-Polygon intersection (Cyrus-Beck clipping, polygon assumed convex)
+* @param seg - segment
+* @param poly - polygon
+* @return Intersection2DInfo* - entry point and delta to the exit point (nullptr if there is no intersection)
+**/
 inline Intersection2DInfo* intersect(const Segment<2>& seg, const Polygon& poly)
 {
-    Intersection2DInfo* info = new Intersection2DInfo;
     if(seg.P0()==seg.P1())
     {
         //TODO: test for inclusion of seg.P0 in the poly
+        Intersection2DInfo* info = new Intersection2DInfo;
         info->point = seg.P0();
         info->delta = seg.d();
         return info;
     }
     double tE = 0.0, tL = 1.0;
     double t, N, D;
-    int n = poly.vertices().size();
-    Vector<2> dS = seg.d();
+    const vector<Vector<2> >& vertices = poly.vertices();
+    int n = vertices.size();
+    Vector<2> P0 = seg.P0(), dS = seg.d();
     for(int i=0;i<n;i++)
     {
-        int i_p = (i+1)%n;
-        Vector<2> e = poly.vertices()[i_p]-poly.vertices()[i];
-        Vector<2> tmp = seg.P0()-poly.vertices()[i];
-        N = e[0]*tmp[1]-e[1]*tmp[0];
-        D = -(e[0]*dS[1]-e[1]*dS[0]);
+        const Vector<2>& v0 = vertices[i];
+        const Vector<2>& v1 = vertices[(i+1)%n];
+        double ex = v1[0]-v0[0], ey = v1[1]-v0[1];
+        double px = P0[0]-v0[0], py = P0[1]-v0[1];
+        N = ex*py-ey*px;
+        D = -(ex*dS[1]-ey*dS[0]);
         if(std::abs(D)<std::numeric_limits<double>::epsilon())
         {
             if(N<0)
@@ -87,8 +95,9 @@ inline Intersection2DInfo* intersect(const Segment<2>& seg, const Polygon& poly)
             }
         }
     }
-    info->point = seg.P0()+tE*dS;
-    info->delta = (seg.P0()+tL*dS)-info->point;
+    Intersection2DInfo* info = new Intersection2DInfo;
+    info->point = P0+tE*dS;
+    info->delta = (tL-tE)*dS;
     return info;
 }
 
@@ -0,0 +1,449 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_INTERSECTIONS_2D_POINT_IN_POLYGON_H
+#define GEOMETRIC_TOOLS_INTERSECTIONS_2D_POINT_IN_POLYGON_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Primitives/2D/Polygon.h>
+#include <geometric_tools/Misc/Parallel.h>
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+
+using std::vector;
+
+namespace GeometricTools {
+
+using Math::Vector;
+using Primitives::Polygon;
+
+namespace Intersections {
+
+/**
+* Orientation of point (px,py) relative to the directed line a->b
+* @return double - >0 if the point is on the left, <0 if on the right, 0 if collinear
+**/
+inline double orientation(const double& ax, const double& ay, const double& bx, const double& by, const double& px, const double& py)
+{
+    return (bx-ax)*(py-ay)-(by-ay)*(px-ax);
+}
+
+/**
+* Check if point (px,py) lies on segment a->b (endpoints included)
+**/
+inline bool onSegment(const double& ax, const double& ay, const double& bx, const double& by, const double& px, const double& py)
+{
+    return orientation(ax, ay, bx, by, px, py)==0.0 &&
+        px>=std::min(ax, bx) && px<=std::max(ax, bx) &&
+        py>=std::min(ay, by) && py<=std::max(ay, by);
+}
+
+/**
+* Winding number of a polygon around a point (Sunday's crossing rules, no trigonometry)
+* Edges are taken between consecutive vertices and from the last vertex back to the first
+* @param poly - polygon
+* @param p - point
+* @return int - winding number (positive for counter-clockwise loops around the point)
+**/
+inline int windingNumber(const Polygon& poly, const Vector<2>& p)
+{
+    const vector<Vector<2> >& v = poly.vertices();
+    unsigned int n = v.size();
+    int w = 0;
+    for(unsigned int i=0;i<n;i++)
+    {
+        const Vector<2>& a = v[i];
+        const Vector<2>& b = v[(i+1)%n];
+        if(a[1]<=p[1])
+        {
+            if(b[1]>p[1] && orientation(a[0], a[1], b[0], b[1], p[0], p[1])>0.0)
+                w++;
+        }
+        else if(b[1]<=p[1] && orientation(a[0], a[1], b[0], b[1], p[0], p[1])<0.0)
+            w--;
+    }
+    return w;
+}
+
+/**
+* Check if a point is inside a polygon (non-zero winding rule; points on the boundary count as inside)
+* @param poly - polygon
+* @param p - point
+* @return bool - true if p is inside poly or on its boundary
+**/
+inline bool contains(const Polygon& poly, const Vector<2>& p)
+{
+    const vector<Vector<2> >& v = poly.vertices();
+    unsigned int n = v.size();
+    for(unsigned int i=0;i<n;i++)
+    {
+        const Vector<2>& a = v[i];
+        const Vector<2>& b = v[(i+1)%n];
+        if(onSegment(a[0], a[1], b[0], b[1], p[0], p[1]))
+            return true;
+    }
+    return windingNumber(poly, p)!=0;
+}
+
+/**
+* PreparedPolygon Class
+* Polygon preprocessed for repeated containment queries
+* Edges are bucketed in a uniform grid over the bounding box and every cell stores the winding number of a
+* reference point inside it; a query only crosses the segment reference->point with the edges of its cell,
+* so the cost does not depend on the size of the polygon (cells without edges are answered directly)
+**/
+class PreparedPolygon
+{
+protected:
+    //edges (a->b)
+    vector<double> ax_, ay_, bx_, by_;
+    //grid
+    double min_x_, min_y_, max_x_, max_y_;
+    double cell_w_, cell_h_;
+    unsigned int nx_, ny_;
+    //cell c holds edges cell_edges_[cell_start_[c]..cell_start_[c+1])
+    vector<unsigned int> cell_start_, cell_edges_;
+    //reference point and its winding number per cell
+    vector<double> ref_x_, ref_y_;
+    vector<int> ref_w_;
+
+    /**
+    * Change of the winding number when moving from c to p along a straight line
+    * Uses only the given edges; vertices exactly on the line c-p are consistently treated as being on its left side
+    **/
+    int crossings(const unsigned int* edges, const unsigned int& count, const double& cx, const double& cy, const double& px, const double& py) const
+    {
+        int w = 0;
+        for(unsigned int k=0;k<count;k++)
+        {
+            unsigned int i = edges[k];
+            bool sa = orientation(cx, cy, px, py, ax_[i], ay_[i])>=0.0;
+            bool sb = orientation(cx, cy, px, py, bx_[i], by_[i])>=0.0;
+            if(sa==sb)
+                continue;
+            double oc = orientation(ax_[i], ay_[i], bx_[i], by_[i], cx, cy);
+            double op = orientation(ax_[i], ay_[i], bx_[i], by_[i], px, py);
+            if(oc<0.0 && op>0.0)
+                w++;
+            else if(oc>0.0 && op<0.0)
+                w--;
+        }
+        return w;
+    }
+
+    unsigned int cellX(const double& x) const
+    {
+        int ix = int((x-min_x_)/cell_w_);
+        return std::min(std::max(ix, 0), int(nx_)-1);
+    }
+
+    unsigned int cellY(const double& y) const
+    {
+        int iy = int((y-min_y_)/cell_h_);
+        return std::min(std::max(iy, 0), int(ny_)-1);
+    }
+
+    /**
+    * Call f(cell) for every cell touched by edge i (conservatively, row by row)
+    **/
+    template<class Function>
+    void rasterize(const unsigned int& i, Function f) const
+    {
+        double eps_x = 1e-9*cell_w_, eps_y = 1e-9*cell_h_;
+        double y0 = std::min(ay_[i], by_[i]), y1 = std::max(ay_[i], by_[i]);
+        unsigned int r0 = cellY(y0-eps_y), r1 = cellY(y1+eps_y);
+        double dy = by_[i]-ay_[i], dx = bx_[i]-ax_[i];
+        for(unsigned int r=r0;r<=r1;r++)
+        {
+            double lo = std::max(y0, min_y_+r*cell_h_), hi = std::min(y1, min_y_+(r+1)*cell_h_);
+            double xa, xb;
+            if(dy==0.0 || lo>=hi)
+            {
+                xa = std::min(ax_[i], bx_[i]);
+                xb = std::max(ax_[i], bx_[i]);
+            }
+            else
+            {
+                xa = ax_[i]+dx*(lo-ay_[i])/dy;
+                xb = ax_[i]+dx*(hi-ay_[i])/dy;
+                if(xa>xb)
+                    std::swap(xa, xb);
+            }
+            unsigned int c0 = cellX(xa-eps_x), c1 = cellX(xb+eps_x);
+            for(unsigned int c=c0;c<=c1;c++)
+                f(r*nx_+c);
+        }
+    }
+
+    /**
+    * Check if (x,y) lies on one of the given edges
+    **/
+    bool onEdges(const unsigned int* edges, const unsigned int& count, const double& x, const double& y) const
+    {
+        for(unsigned int k=0;k<count;k++)
+        {
+            unsigned int i = edges[k];
+            if(onSegment(ax_[i], ay_[i], bx_[i], by_[i], x, y))
+                return true;
+        }
+        return false;
+    }
+
+    /**
+    * Distance from (x,y) to the closest of the given edges (infinity if there are none)
+    **/
+    double clearance(const unsigned int* edges, const unsigned int& count, const double& x, const double& y) const
+    {
+        double best = std::numeric_limits<double>::infinity();
+        for(unsigned int k=0;k<count;k++)
+        {
+            unsigned int i = edges[k];
+            double ex = bx_[i]-ax_[i], ey = by_[i]-ay_[i];
+            double px = x-ax_[i], py = y-ay_[i];
+            double t = std::min(std::max((px*ex+py*ey)/(ex*ex+ey*ey), 0.0), 1.0);
+            double dx = px-t*ex, dy = py-t*ey;
+            best = std::min(best, std::sqrt(dx*dx+dy*dy));
+        }
+        return best;
+    }
+
+    void build(const unsigned int& cells_per_edge)
+    {
+        unsigned int m = ax_.size();
+        min_x_ = min_y_ = std::numeric_limits<double>::infinity();
+        max_x_ = max_y_ = -std::numeric_limits<double>::infinity();
+        for(unsigned int i=0;i<m;i++)
+        {
+            min_x_ = std::min(min_x_, std::min(ax_[i], bx_[i]));
+            max_x_ = std::max(max_x_, std::max(ax_[i], bx_[i]));
+            min_y_ = std::min(min_y_, std::min(ay_[i], by_[i]));
+            max_y_ = std::max(max_y_, std::max(ay_[i], by_[i]));
+        }
+        nx_ = ny_ = 1;
+        cell_w_ = cell_h_ = 1.0;
+        if(m==0)
+        {
+            min_x_ = min_y_ = 1.0;
+            max_x_ = max_y_ = 0.0;
+            cell_start_.assign(2, 0);
+            return;
+        }
+        double w = std::max(max_x_-min_x_, std::numeric_limits<double>::min());
+        double h = std::max(max_y_-min_y_, std::numeric_limits<double>::min());
+        double s = std::sqrt(w*h/(double(m)*std::max(1u, cells_per_edge)));
+        nx_ = std::max(1u, std::min(2048u, (unsigned int)std::ceil(w/s)));
+        ny_ = std::max(1u, std::min(2048u, (unsigned int)std::ceil(h/s)));
+        cell_w_ = w/nx_;
+        cell_h_ = h/ny_;
+
+        unsigned int cells = nx_*ny_;
+        vector<unsigned int> count(cells+1, 0);
+        for(unsigned int i=0;i<m;i++)
+            rasterize(i, [&](unsigned int c) { count[c+1]++; });
+        for(unsigned int c=0;c<cells;c++)
+            count[c+1] += count[c];
+        cell_start_ = count;
+        cell_edges_.resize(count[cells]);
+        for(unsigned int i=0;i<m;i++)
+            rasterize(i, [&](unsigned int c) { cell_edges_[count[c]++] = i; });
+
+        //reference points: cell center, or the candidate farthest from the edges of the cell
+        ref_x_.resize(cells);
+        ref_y_.resize(cells);
+        ref_w_.resize(cells);
+        const double offsets[6][2] = {{0.5, 0.5}, {0.3716, 0.5879}, {0.6283, 0.4452}, {0.4137, 0.3341}, {0.5723, 0.6917}, {0.2912, 0.4065}};
+        double good = 1e-3*std::min(cell_w_, cell_h_);
+        for(unsigned int c=0;c<cells;c++)
+        {
+            unsigned int ix = c%nx_, iy = c/nx_;
+            double best = -1.0;
+            for(unsigned int k=0;k<6 && best<good;k++)
+            {
+                double x = min_x_+(ix+offsets[k][0])*cell_w_, y = min_y_+(iy+offsets[k][1])*cell_h_;
+                double d = clearance(cell_edges_.data()+cell_start_[c], cell_start_[c+1]-cell_start_[c], x, y);
+                if(d>best)
+                {
+                    best = d;
+                    ref_x_[c] = x;
+                    ref_y_[c] = y;
+                }
+            }
+        }
+
+        //winding numbers: first column with a full test, then walk every row from cell to cell
+        vector<unsigned int> stamp(m, 0), both;
+        for(unsigned int iy=0;iy<ny_;iy++)
+        {
+            unsigned int c = iy*nx_;
+            int wn = 0;
+            for(unsigned int i=0;i<m;i++)
+            {
+                if(ay_[i]<=ref_y_[c])
+                {
+                    if(by_[i]>ref_y_[c] && orientation(ax_[i], ay_[i], bx_[i], by_[i], ref_x_[c], ref_y_[c])>0.0)
+                        wn++;
+                }
+                else if(by_[i]<=ref_y_[c] && orientation(ax_[i], ay_[i], bx_[i], by_[i], ref_x_[c], ref_y_[c])<0.0)
+                    wn--;
+            }
+            ref_w_[c] = wn;
+            for(unsigned int ix=1;ix<nx_;ix++)
+            {
+                unsigned int prev = c;
+                c++;
+                unsigned int tag = c+1;
+                both.clear();
+                for(unsigned int k=cell_start_[prev];k<cell_start_[prev+1];k++)
+                {
+                    stamp[cell_edges_[k]] = tag;
+                    both.push_back(cell_edges_[k]);
+                }
+                for(unsigned int k=cell_start_[c];k<cell_start_[c+1];k++)
+                {
+                    if(stamp[cell_edges_[k]]!=tag)
+                        both.push_back(cell_edges_[k]);
+                }
+                ref_w_[c] = ref_w_[prev]+crossings(both.data(), both.size(), ref_x_[prev], ref_y_[prev], ref_x_[c], ref_y_[c]);
+            }
+        }
+    }
+
+public:
+    /**
+    * Constructor
+    * @param poly - polygon to prepare (edges i -> i+1 and last -> first)
+    * @param cells_per_edge - grid resolution (number of cells per edge, 4 is a good trade-off between memory and speed)
+    **/
+    PreparedPolygon(const Polygon& poly, const unsigned int& cells_per_edge = 4)
+    {
+        const vector<Vector<2> >& v = poly.vertices();
+        unsigned int n = v.size();
+        for(unsigned int i=0;i<n;i++)
+        {
+            const Vector<2>& a = v[i];
+            const Vector<2>& b = v[(i+1)%n];
+            if(a==b)
+                continue;
+            ax_.push_back(a[0]);
+            ay_.push_back(a[1]);
+            bx_.push_back(b[0]);
+            by_.push_back(b[1]);
+        }
+        build(cells_per_edge);
+    }
+
+    /**
+    * Winding number of the polygon around a point
+    * @param x - x coordinate of the point
+    * @param y - y coordinate of the point
+    * @return int - winding number
+    **/
+    int windingNumber(const double& x, const double& y) const
+    {
+        if(!(x>=min_x_ && x<=max_x_ && y>=min_y_ && y<=max_y_))
+            return 0;
+        unsigned int c = cellY(y)*nx_+cellX(x);
+        unsigned int n = cell_start_[c+1]-cell_start_[c];
+        if(n==0)
+            return ref_w_[c];
+        return ref_w_[c]+crossings(cell_edges_.data()+cell_start_[c], n, ref_x_[c], ref_y_[c], x, y);
+    }
+
+    /**
+    * Check if a point is inside the polygon (non-zero winding rule; points on the boundary count as inside)
+    * @param x - x coordinate of the point
+    * @param y - y coordinate of the point
+    * @return bool - true if the point is inside or on the boundary
+    **/
+    bool contains(const double& x, const double& y) const
+    {
+        if(!(x>=min_x_ && x<=max_x_ && y>=min_y_ && y<=max_y_))
+            return false;
+        unsigned int c = cellY(y)*nx_+cellX(x);
+        const unsigned int* edges = cell_edges_.data()+cell_start_[c];
+        unsigned int n = cell_start_[c+1]-cell_start_[c];
+        if(n==0)
+            return ref_w_[c]!=0;
+        if(onEdges(edges, n, x, y))
+            return true;
+        return (ref_w_[c]+crossings(edges, n, ref_x_[c], ref_y_[c], x, y))!=0;
+    }
+
+    bool contains(const Vector<2>& p) const {return contains(p[0], p[1]);}
+
+    /**
+    * Batched containment test (multi-threaded)
+    * @param x - x coordinates of the points
+    * @param y - y coordinates of the points
+    * @param n - number of points
+    * @param inside - output flags (1 if inside, 0 otherwise), at least n elements
+    * @param threads - number of threads (0 means all the hardware threads)
+    * @return unsigned int - number of points inside
+    **/
+    unsigned int containsBatch(const double* x, const double* y, const unsigned int& n, unsigned char* inside, const unsigned int& threads = 0) const
+    {
+        vector<unsigned int> counts(Helper::threadCount(threads), 0);
+        Helper::parallelChunks(0, n, [&](unsigned int chunk, unsigned int b, unsigned int e) {
+            unsigned int cnt = 0;
+            for(unsigned int i=b;i<e;i++)
+            {
+                inside[i] = contains(x[i], y[i]);
+                cnt += inside[i];
+            }
+            counts[chunk] = cnt;
+        }, threads);
+        unsigned int total = 0;
+        for(unsigned int k=0;k<counts.size();k++)
+            total += counts[k];
+        return total;
+    }
+
+    /**
+    * Batched containment test (multi-threaded)
+    * @param points - the points
+    * @param inside - output flags (resized to points.size())
+    * @param threads - number of threads (0 means all the hardware threads)
+    * @return unsigned int - number of points inside
+    **/
+    unsigned int containsBatch(const vector<Vector<2> >& points, vector<unsigned char>& inside, const unsigned int& threads = 0) const
+    {
+        inside.resize(points.size());
+        vector<unsigned int> counts(Helper::threadCount(threads), 0);
+        Helper::parallelChunks(0, points.size(), [&](unsigned int chunk, unsigned int b, unsigned int e) {
+            unsigned int cnt = 0;
+            for(unsigned int i=b;i<e;i++)
+            {
+                inside[i] = contains(points[i][0], points[i][1]);
+                cnt += inside[i];
+            }
+            counts[chunk] = cnt;
+        }, threads);
+        unsigned int total = 0;
+        for(unsigned int k=0;k<counts.size();k++)
+            total += counts[k];
+        return total;
+    }
+};
+
+} }
+
+#endif
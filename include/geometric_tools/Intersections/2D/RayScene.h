@@ -0,0 +1,315 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_INTERSECTIONS_2D_RAY_SCENE_H
+#define GEOMETRIC_TOOLS_INTERSECTIONS_2D_RAY_SCENE_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Primitives/LinearShapes.h>
+#include <geometric_tools/Primitives/2D/Polygon.h>
+#include <geometric_tools/Misc/Parallel.h>
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+
+using std::vector;
+
+namespace GeometricTools {
+
+using Math::Vector;
+using Primitives::Ray;
+using Primitives::Polygon;
+
+namespace Intersections {
+
+/**
+* RayHit struct
+* Nearest hit of a ray against a RayScene
+**/
+struct RayHit
+{
+    //true if the ray hit something
+    bool hit;
+    //distance along the (unit) ray direction
+    double distance;
+    //index of the polygon and of its edge (edge i goes from vertex i to vertex i+1)
+    unsigned int polygon, edge;
+    //hit point
+    Vector<2> point;
+
+    RayHit():hit(false), distance(std::numeric_limits<double>::infinity()), polygon(0), edge(0) {}
+};
+
+/**
+* RayScene Class
+* Static set of polygons prepared for nearest-hit ray queries
+* Edges are flattened (Structure of Arrays) and bucketed in a uniform grid (CSR layout);
+* rays walk the grid cells in order (2D DDA (Amanatides-Woo)) and stop at the first cell that contains a hit
+* The scene is immutable after construction, so queries are thread-safe
+**/
+class RayScene
+{
+protected:
+    //edges (parametric form X(s) = P+s*d, sE[0,1])
+    vector<double> x_, y_, dx_, dy_;
+    vector<unsigned int> polygon_, edge_;
+    //grid
+    double min_x_, min_y_, max_x_, max_y_;
+    double cell_w_, cell_h_;
+    unsigned int nx_, ny_;
+    //cell c holds edges cell_edges_[cell_start_[c]..cell_start_[c+1])
+    vector<unsigned int> cell_start_, cell_edges_;
+
+    /**
+    * Walk the cells crossed by X(t) = (ox,oy)+t*(dx,dy), tE[t0,t1] (assumed inside the grid)
+    * @param visit - callable visit(cell, t_exit) returning false to stop the walk
+    **/
+    template<class Visitor>
+    void walk(const double& ox, const double& oy, const double& dx, const double& dy, const double& t0, const double& t1, Visitor visit) const
+    {
+        double inf = std::numeric_limits<double>::infinity();
+        double sx = ox+t0*dx, sy = oy+t0*dy;
+        int ix = std::min(std::max(int((sx-min_x_)/cell_w_), 0), int(nx_)-1);
+        int iy = std::min(std::max(int((sy-min_y_)/cell_h_), 0), int(ny_)-1);
+        int step_x = (dx>0)? 1 : -1, step_y = (dy>0)? 1 : -1;
+        double t_max_x = inf, t_max_y = inf, t_delta_x = inf, t_delta_y = inf;
+        if(dx!=0.0)
+        {
+            double bx = min_x_+(ix+(dx>0? 1 : 0))*cell_w_;
+            t_max_x = (bx-ox)/dx;
+            t_delta_x = cell_w_/std::abs(dx);
+        }
+        if(dy!=0.0)
+        {
+            double by = min_y_+(iy+(dy>0? 1 : 0))*cell_h_;
+            t_max_y = (by-oy)/dy;
+            t_delta_y = cell_h_/std::abs(dy);
+        }
+        while(true)
+        {
+            double t_exit = std::min(std::min(t_max_x, t_max_y), t1);
+            if(!visit(iy*nx_+ix, t_exit) || t_exit>=t1)
+                return;
+            if(t_max_x<t_max_y)
+            {
+                ix += step_x;
+                t_max_x += t_delta_x;
+            }
+            else
+            {
+                iy += step_y;
+                t_max_y += t_delta_y;
+            }
+            if(ix<0 || iy<0 || ix>=int(nx_) || iy>=int(ny_))
+                return;
+        }
+    }
+
+    /**
+    * Clip X(t) = (ox,oy)+t*(dx,dy), tE[t0,t1] to the grid bounds (slab test)
+    * @return bool - false if the line misses the grid
+    **/
+    bool clip(const double& ox, const double& oy, const double& dx, const double& dy, double& t0, double& t1) const
+    {
+        double o[2] = {ox, oy}, d[2] = {dx, dy};
+        double lo[2] = {min_x_, min_y_}, hi[2] = {max_x_, max_y_};
+        for(unsigned int k=0;k<2;k++)
+        {
+            if(d[k]==0.0)
+            {
+                if(o[k]<lo[k] || o[k]>hi[k])
+                    return false;
+                continue;
+            }
+            double ta = (lo[k]-o[k])/d[k], tb = (hi[k]-o[k])/d[k];
+            if(ta>tb)
+                std::swap(ta, tb);
+            t0 = std::max(t0, ta);
+            t1 = std::min(t1, tb);
+            if(t0>t1)
+                return false;
+        }
+        return true;
+    }
+
+    void build(const double& cell_size)
+    {
+        unsigned int m = x_.size();
+        nx_ = ny_ = 1;
+        cell_w_ = cell_h_ = 1.0;
+        cell_start_.assign(2, 0);
+        cell_edges_.clear();
+        if(m==0)
+            return;
+        min_x_ = min_y_ = std::numeric_limits<double>::infinity();
+        max_x_ = max_y_ = -std::numeric_limits<double>::infinity();
+        for(unsigned int i=0;i<m;i++)
+        {
+            min_x_ = std::min(min_x_, std::min(x_[i], x_[i]+dx_[i]));
+            max_x_ = std::max(max_x_, std::max(x_[i], x_[i]+dx_[i]));
+            min_y_ = std::min(min_y_, std::min(y_[i], y_[i]+dy_[i]));
+            max_y_ = std::max(max_y_, std::max(y_[i], y_[i]+dy_[i]));
+        }
+        //pad the bounds so that boundary edges lie strictly inside the grid
+        double pad = 1e-9*std::max(1.0, std::max(max_x_-min_x_, max_y_-min_y_));
+        min_x_ -= pad; min_y_ -= pad; max_x_ += pad; max_y_ += pad;
+        double w = max_x_-min_x_, h = max_y_-min_y_;
+        if(cell_size>0.0)
+        {
+            nx_ = std::max(1u, (unsigned int)std::ceil(w/cell_size));
+            ny_ = std::max(1u, (unsigned int)std::ceil(h/cell_size));
+        }
+        else
+        {
+            //about one edge per cell
+            double s = std::sqrt(w*h/m);
+            nx_ = std::max(1u, std::min(1024u, (unsigned int)std::ceil(w/s)));
+            ny_ = std::max(1u, std::min(1024u, (unsigned int)std::ceil(h/s)));
+        }
+        cell_w_ = w/nx_;
+        cell_h_ = h/ny_;
+
+        //two passes: count, then fill
+        unsigned int cells = nx_*ny_;
+        vector<unsigned int> count(cells+1, 0);
+        for(unsigned int i=0;i<m;i++)
+            walk(x_[i], y_[i], dx_[i], dy_[i], 0.0, 1.0, [&](unsigned int c, double) { count[c+1]++; return true; });
+        for(unsigned int c=0;c<cells;c++)
+            count[c+1] += count[c];
+        cell_start_ = count;
+        cell_edges_.resize(count[cells]);
+        for(unsigned int i=0;i<m;i++)
+            walk(x_[i], y_[i], dx_[i], dy_[i], 0.0, 1.0, [&](unsigned int c, double) { cell_edges_[count[c]++] = i; return true; });
+    }
+
+public:
+    /**
+    * Constructor
+    * @param polygons - polygons of the scene (copied; each polygon contributes its edges i -> i+1)
+    * @param cell_size - size of the grid cells (<=0 picks it so that there is about one edge per cell)
+    **/
+    RayScene(const vector<Polygon>& polygons, const double& cell_size = 0.0)
+    {
+        for(unsigned int p=0;p<polygons.size();p++)
+        {
+            const vector<Vector<2> >& v = polygons[p].vertices();
+            unsigned int n = v.size();
+            for(unsigned int i=0;i<n;i++)
+            {
+                const Vector<2>& a = v[i];
+                const Vector<2>& b = v[(i+1)%n];
+                if(a==b)
+                    continue;
+                x_.push_back(a[0]);
+                y_.push_back(a[1]);
+                dx_.push_back(b[0]-a[0]);
+                dy_.push_back(b[1]-a[1]);
+                polygon_.push_back(p);
+                edge_.push_back(i);
+            }
+        }
+        build(cell_size);
+    }
+
+    /**
+    * Get the number of edges of the scene
+    * @return unsigned int - number of edges
+    **/
+    unsigned int edges() const {return x_.size();}
+
+    /**
+    * Cast a ray against the scene and find the nearest hit
+    * @param ray - the ray
+    * @param hit - nearest hit (hit.hit is false if nothing is hit within max_distance)
+    * @param max_distance - maximum distance along the ray
+    * @return bool - true if something was hit
+    **/
+    bool castRay(const Ray<2>& ray, RayHit& hit, const double& max_distance = std::numeric_limits<double>::infinity()) const
+    {
+        hit = RayHit();
+        if(x_.empty())
+            return false;
+        Vector<2> P = ray.p(), d = ray.d();
+        double ox = P[0], oy = P[1], rdx = d[0], rdy = d[1];
+        double t0 = 0.0, t1 = max_distance;
+        if(!clip(ox, oy, rdx, rdy, t0, t1))
+            return false;
+        double best = max_distance;
+        unsigned int best_edge = 0;
+        bool found = false;
+        walk(ox, oy, rdx, rdy, t0, t1, [&](unsigned int c, double t_exit) {
+            for(unsigned int k=cell_start_[c];k<cell_start_[c+1];k++)
+            {
+                unsigned int i = cell_edges_[k];
+                double D = rdx*dy_[i]-rdy*dx_[i];
+                if(D==0.0)
+                    continue;
+                double px = x_[i]-ox, py = y_[i]-oy;
+                double t = (px*dy_[i]-py*dx_[i])/D;
+                double s = (px*rdy-py*rdx)/D;
+                if(t>=0.0 && t<=best && s>=0.0 && s<=1.0 && (!found || t<best || i<best_edge))
+                {
+                    best = t;
+                    best_edge = i;
+                    found = true;
+                }
+            }
+            //a hit inside the current cell cannot be beaten by later cells
+            return !(found && best<=t_exit);
+        });
+        if(!found)
+            return false;
+        hit.hit = true;
+        hit.distance = best;
+        hit.polygon = polygon_[best_edge];
+        hit.edge = edge_[best_edge];
+        hit.point = P+best*d;
+        return true;
+    }
+
+    /**
+    * Cast a batch of rays (multi-threaded)
+    * @param rays - the rays
+    * @param hits - nearest hit per ray (resized to rays.size())
+    * @param max_distance - maximum distance along the rays
+    * @param threads - number of threads (0 means all the hardware threads)
+    * @return unsigned int - number of rays that hit something
+    **/
+    unsigned int castRays(const vector<Ray<2> >& rays, vector<RayHit>& hits, const double& max_distance = std::numeric_limits<double>::infinity(), const unsigned int& threads = 0) const
+    {
+        hits.resize(rays.size());
+        vector<unsigned int> counts(Helper::threadCount(threads), 0);
+        Helper::parallelChunks(0, rays.size(), [&](unsigned int chunk, unsigned int b, unsigned int e) {
+            unsigned int cnt = 0;
+            for(unsigned int i=b;i<e;i++)
+                cnt += castRay(rays[i], hits[i], max_distance);
+            counts[chunk] = cnt;
+        }, threads);
+        unsigned int total = 0;
+        for(unsigned int k=0;k<counts.size();k++)
+            total += counts[k];
+        return total;
+    }
+};
+
+} }
+
+#endif
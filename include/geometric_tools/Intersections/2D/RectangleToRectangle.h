@@ -33,10 +33,21 @@ using Primitives::Rectangle;
 
 namespace Intersections {
 
-inline Intersection2DInfo* intersect(const Rectangle& r1, const Rectangle& r2)
+/**
+* Check if two axis aligned rectangles overlap (touching counts as overlapping)
+* @param r1 - first rectangle
+* @param r2 - second rectangle
+* @return bool - true if they overlap
+**/
+inline bool overlap(const Rectangle& r1, const Rectangle& r2)
 {
-    Intersection2DInfo* info = new Intersection2DInfo;
+    Vector<2> dC = r2.center()-r1.center();
+    Vector<2> half1 = r1.half(), half2 = r2.half();
+    return std::abs(dC[0])<=half1[0]+half2[0] && std::abs(dC[1])<=half1[1]+half2[1];
+}
 
+inline Intersection2DInfo* intersect(const Rectangle& r1, const Rectangle& r2)
+{
     Vector<2> center1 = r1.center();
 
     Vector<2> center2 = r2.center();
@@ -71,6 +82,7 @@ inline Intersection2DInfo* intersect(const Rectangle& r1, const Rectangle& r2)
         p = Vector<2>(center2[0], center1[1]+half1y*sy);
         n = Vector<2>(0.0, sy*py);
     }
+    Intersection2DInfo* info = new Intersection2DInfo;
     info->point = p;
     info->delta = n;
     return info;
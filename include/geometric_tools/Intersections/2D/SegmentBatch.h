@@ -0,0 +1,239 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_INTERSECTIONS_2D_SEGMENT_BATCH_H
+#define GEOMETRIC_TOOLS_INTERSECTIONS_2D_SEGMENT_BATCH_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Primitives/LinearShapes.h>
+#include <geometric_tools/Intersections/IntersectionInfo.h>
+#include <geometric_tools/Intersections/2D/LinearToLinear.h>
+#include <vector>
+#include <limits>
+#include <cmath>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+using std::vector;
+
+namespace GeometricTools {
+
+using Math::Vector;
+using Primitives::Segment;
+
+namespace Intersections {
+
+/**
+* SegmentArray Class
+* 2D segments stored as Structure of Arrays (parametric form X(t) = P+t*d, tE[0,1])
+* Used by the batched intersection kernels
+**/
+class SegmentArray
+{
+protected:
+    vector<double> x_, y_;
+    vector<double> dx_, dy_;
+public:
+    SegmentArray() {}
+
+    /**
+    * Constructor
+    * @param segments - segments to copy
+    **/
+    SegmentArray(const vector<Segment<2> >& segments)
+    {
+        reserve(segments.size());
+        for(unsigned int i=0;i<segments.size();i++)
+            addSegment(segments[i]);
+    }
+
+    void reserve(const unsigned int& n)
+    {
+        x_.reserve(n);
+        y_.reserve(n);
+        dx_.reserve(n);
+        dy_.reserve(n);
+    }
+
+    void addSegment(const Segment<2>& seg)
+    {
+        Vector<2> p = seg.P0(), d = seg.d();
+        x_.push_back(p[0]);
+        y_.push_back(p[1]);
+        dx_.push_back(d[0]);
+        dy_.push_back(d[1]);
+    }
+
+    void clear()
+    {
+        x_.clear();
+        y_.clear();
+        dx_.clear();
+        dy_.clear();
+    }
+
+    unsigned int size() const { return x_.size(); }
+
+    Segment<2> segment(const unsigned int& i) const
+    {
+        return Segment<2>(Vector<2>(x_[i], y_[i]), Vector<2>(x_[i]+dx_[i], y_[i]+dy_[i]));
+    }
+
+    const double* x() const { return x_.data(); }
+    const double* y() const { return y_.data(); }
+    const double* dx() const { return dx_.data(); }
+    const double* dy() const { return dy_.data(); }
+};
+
+/**
+* SegmentHits Class
+* Results of a batched intersection query (one entry per segment of the batch)
+* hit - 1 if the query segment intersects the i-th segment
+* s - parameter of the intersection on the query segment
+* t - parameter of the intersection on the i-th segment
+* x, y - the intersection point (first point of the overlap for collinear segments)
+* Re-use it between queries - the buffers only grow
+**/
+struct SegmentHits
+{
+    vector<unsigned char> hit;
+    vector<double> s, t;
+    vector<double> x, y;
+
+    void resize(const unsigned int& n)
+    {
+        hit.resize(n);
+        s.resize(n);
+        t.resize(n);
+        x.resize(n);
+        y.resize(n);
+    }
+};
+
+/**
+* Intersect a segment with a batch of segments
+* Same results as intersect(const Segment<2>&, const Segment<2>&) without allocating per pair;
+* vectorized with AVX2 when compiled with it (ENABLE_AVX2), parallel/collinear pairs go through the scalar routine
+* @param query - the query segment
+* @param segments - the batch of segments
+* @param hits - the results (returns)
+* @return unsigned int - number of intersecting segments
+**/
+inline unsigned int intersectBatch(const Segment<2>& query, const SegmentArray& segments, SegmentHits& hits)
+{
+    const unsigned int n = segments.size();
+    hits.resize(n);
+    if(n==0)
+        return 0;
+    const double eps = std::numeric_limits<double>::epsilon();
+    Vector<2> P = query.P0(), U = query.d();
+    const double px = P[0], py = P[1], ux = U[0], uy = U[1];
+    const double* X = segments.x();
+    const double* Y = segments.y();
+    const double* DX = segments.dx();
+    const double* DY = segments.dy();
+    unsigned char* hit = hits.hit.data();
+    double* S = hits.s.data();
+    double* T = hits.t.data();
+    double* HX = hits.x.data();
+    double* HY = hits.y.data();
+    unsigned int i = 0;
+    bool parallel = false;
+#ifdef __AVX2__
+    const __m256d vpx = _mm256_set1_pd(px), vpy = _mm256_set1_pd(py);
+    const __m256d vux = _mm256_set1_pd(ux), vuy = _mm256_set1_pd(uy);
+    const __m256d zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+    const __m256d veps = _mm256_set1_pd(eps);
+    const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    for(;i+4<=n;i+=4)
+    {
+        __m256d vx = _mm256_loadu_pd(DX+i), vy = _mm256_loadu_pd(DY+i);
+        __m256d wx = _mm256_sub_pd(vpx, _mm256_loadu_pd(X+i));
+        __m256d wy = _mm256_sub_pd(vpy, _mm256_loadu_pd(Y+i));
+        __m256d D = _mm256_sub_pd(_mm256_mul_pd(vux, vy), _mm256_mul_pd(vuy, vx));
+        __m256d ns = _mm256_sub_pd(_mm256_mul_pd(vx, wy), _mm256_mul_pd(vy, wx));
+        __m256d nt = _mm256_sub_pd(_mm256_mul_pd(vux, wy), _mm256_mul_pd(vuy, wx));
+        __m256d par = _mm256_cmp_pd(_mm256_and_pd(D, abs_mask), veps, _CMP_LT_OQ);
+        __m256d s = _mm256_div_pd(ns, D);
+        __m256d t = _mm256_div_pd(nt, D);
+        __m256d in = _mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(s, zero, _CMP_GE_OQ), _mm256_cmp_pd(s, one, _CMP_LE_OQ)),
+                                   _mm256_and_pd(_mm256_cmp_pd(t, zero, _CMP_GE_OQ), _mm256_cmp_pd(t, one, _CMP_LE_OQ)));
+        in = _mm256_andnot_pd(par, in);
+        _mm256_storeu_pd(S+i, s);
+        _mm256_storeu_pd(T+i, t);
+#ifdef __FMA__
+        _mm256_storeu_pd(HX+i, _mm256_fmadd_pd(s, vux, vpx));
+        _mm256_storeu_pd(HY+i, _mm256_fmadd_pd(s, vuy, vpy));
+#else
+        _mm256_storeu_pd(HX+i, _mm256_add_pd(vpx, _mm256_mul_pd(s, vux)));
+        _mm256_storeu_pd(HY+i, _mm256_add_pd(vpy, _mm256_mul_pd(s, vuy)));
+#endif
+        int in_mask = _mm256_movemask_pd(in);
+        hit[i] = (in_mask&1);
+        hit[i+1] = (in_mask>>1)&1;
+        hit[i+2] = (in_mask>>2)&1;
+        hit[i+3] = (in_mask>>3)&1;
+        if(_mm256_movemask_pd(par))
+            parallel = true;
+    }
+#endif
+    // portable kernel (branch-free - vectorized by the compiler) and AVX2 remainder
+    for(;i<n;i++)
+    {
+        double vx = DX[i], vy = DY[i];
+        double wx = px-X[i], wy = py-Y[i];
+        double D = ux*vy-uy*vx;
+        double s = (vx*wy-vy*wx)/D;
+        double t = (ux*wy-uy*wx)/D;
+        bool par = (std::abs(D)<eps);
+        parallel = parallel || par;
+        S[i] = s;
+        T[i] = t;
+        HX[i] = px+s*ux;
+        HY[i] = py+s*uy;
+        hit[i] = (!par && s>=0.0 && s<=1.0 && t>=0.0 && t<=1.0);
+    }
+    // parallel or collinear pairs - rare, use the scalar routine
+    for(i=0;parallel && i<n;i++)
+    {
+        if(std::abs(ux*DY[i]-uy*DX[i])>=eps)
+            continue;
+        hit[i] = 0;
+        Intersection2DInfo* info = intersect(query, segments.segment(i));
+        if(info==nullptr)
+            continue;
+        hit[i] = 1;
+        HX[i] = info->point[0];
+        HY[i] = info->point[1];
+        double uu = ux*ux+uy*uy, vv = DX[i]*DX[i]+DY[i]*DY[i];
+        S[i] = (uu>eps)? ((HX[i]-px)*ux+(HY[i]-py)*uy)/uu : 0.0;
+        T[i] = (vv>eps)? ((HX[i]-X[i])*DX[i]+(HY[i]-Y[i])*DY[i])/vv : 0.0;
+        delete info;
+    }
+    unsigned int count = 0;
+    for(i=0;i<n;i++)
+        count += hit[i];
+    return count;
+}
+
+} }
+
+#endif
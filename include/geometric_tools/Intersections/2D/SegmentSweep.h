@@ -0,0 +1,399 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_INTERSECTIONS_2D_SEGMENT_SWEEP_H
+#define GEOMETRIC_TOOLS_INTERSECTIONS_2D_SEGMENT_SWEEP_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Primitives/LinearShapes.h>
+#include <geometric_tools/Primitives/Polyline.h>
+#include <geometric_tools/Primitives/2D/Polygon.h>
+#include <vector>
+#include <set>
+#include <map>
+#include <limits>
+#include <cmath>
+
+using std::vector;
+
+namespace GeometricTools {
+
+using Math::Vector;
+using Primitives::Segment;
+using Primitives::Polyline;
+using Primitives::Polygon;
+
+namespace Intersections {
+
+/**
+* Segment Intersection
+* point - the intersection point
+* first, second - indices of the intersecting segments (first<second)
+**/
+struct SegmentIntersection
+{
+    Vector<2> point;
+    unsigned int first;
+    unsigned int second;
+};
+
+/**
+* SegmentSweep Class
+* Bentley-Ottmann sweep-line for finding all the intersections among a set of 2D segments in O((n+k)logn)
+* The sweep line moves left to right (ties broken bottom to top); at every event point the callback
+* gets all the segments passing through it. Collinear overlapping segments are reported at the endpoints of the overlap.
+**/
+class SegmentSweep
+{
+protected:
+    struct SweepPoint
+    {
+        double x, y;
+    };
+
+    struct SweepSegment
+    {
+        // left (lexicographically smaller) and right endpoints
+        SweepPoint p, q;
+        double slope;
+        bool vertical;
+        bool degenerate;
+    };
+
+    struct EventLess
+    {
+        double eps;
+        bool operator()(const SweepPoint& a, const SweepPoint& b) const
+        {
+            if(std::abs(a.x-b.x)>eps)
+                return a.x<b.x;
+            if(std::abs(a.y-b.y)>eps)
+                return a.y<b.y;
+            return false;
+        }
+    };
+
+    struct StatusLess
+    {
+        const SegmentSweep* sweep;
+        bool operator()(const unsigned int& a, const unsigned int& b) const
+        {
+            return sweep->below(a, b);
+        }
+    };
+
+    typedef std::set<unsigned int, StatusLess> Status;
+    typedef std::map<SweepPoint, vector<unsigned int>, EventLess> EventQueue;
+
+    vector<SweepSegment> segments_;
+    double eps_;
+    // current event point
+    SweepPoint sweep_;
+    // index used for searching the status with the sweep point
+    unsigned int probe_;
+    Status status_;
+    vector<Status::iterator> handles_;
+    EventQueue events_;
+    // buffers re-used between events
+    vector<unsigned int> upper_, lower_, contain_, all_;
+
+    /**
+    * Height of segment at the current sweep position
+    **/
+    double height(const unsigned int& i) const
+    {
+        if(i==probe_)
+            return sweep_.y;
+        const SweepSegment& s = segments_[i];
+        if(s.vertical)
+            return std::min(std::max(sweep_.y, s.p.y), s.q.y);
+        return s.p.y+(sweep_.x-s.p.x)*s.slope;
+    }
+
+    /**
+    * Status order - segment a is below segment b just right of the sweep point
+    **/
+    bool below(const unsigned int& a, const unsigned int& b) const
+    {
+        if(a==b)
+            return false;
+        double ya = height(a), yb = height(b);
+        if(std::abs(ya-yb)>eps_)
+            return ya<yb;
+        double sa = (a==probe_)? -std::numeric_limits<double>::infinity() : segments_[a].slope;
+        double sb = (b==probe_)? -std::numeric_limits<double>::infinity() : segments_[b].slope;
+        if(sa!=sb)
+            return sa<sb;
+        return a<b;
+    }
+
+    bool samePoint(const SweepPoint& a, const SweepPoint& b) const
+    {
+        return (std::abs(a.x-b.x)<=eps_ && std::abs(a.y-b.y)<=eps_);
+    }
+
+    /**
+    * Schedule the intersection of segments a and b if it lies after the current event
+    **/
+    void checkIntersection(const unsigned int& a, const unsigned int& b)
+    {
+        const SweepSegment& s1 = segments_[a];
+        const SweepSegment& s2 = segments_[b];
+        double ux = s1.q.x-s1.p.x, uy = s1.q.y-s1.p.y;
+        double vx = s2.q.x-s2.p.x, vy = s2.q.y-s2.p.y;
+        double wx = s1.p.x-s2.p.x, wy = s1.p.y-s2.p.y;
+        double D = ux*vy-uy*vx;
+        if(std::abs(D)<=std::numeric_limits<double>::epsilon()*(std::abs(ux*vy)+std::abs(uy*vx)))
+            return;
+        double s = (vx*wy-vy*wx)/D;
+        double t = (ux*wy-uy*wx)/D;
+        double tol = 1e-12;
+        if(s<-tol || s>1.0+tol || t<-tol || t>1.0+tol)
+            return;
+        s = std::min(std::max(s, 0.0), 1.0);
+        SweepPoint pt = {s1.p.x+s*ux, s1.p.y+s*uy};
+        if(!events_.key_comp()(sweep_, pt))
+            return;
+        events_[pt];
+    }
+
+public:
+    SegmentSweep(): eps_(0.0), probe_(0), status_(StatusLess()) {}
+
+    /**
+    * Run the sweep
+    * @param segments - the segments
+    * @param callback - called as callback(point, indices) for every point where 2 or more segments meet;
+    *                   indices are the segments passing through the point; return false to stop the sweep
+    **/
+    template<class Callback>
+    void run(const vector<Segment<2> >& segments, Callback callback)
+    {
+        unsigned int n = segments.size();
+        segments_.resize(n);
+        probe_ = n;
+        double extent = 1.0;
+        for(unsigned int i=0;i<n;i++)
+        {
+            Vector<2> a = segments[i].P0(), b = segments[i].P1();
+            extent = std::max(extent, std::max(std::max(std::abs(a[0]), std::abs(a[1])), std::max(std::abs(b[0]), std::abs(b[1]))));
+        }
+        eps_ = 1e-10*extent;
+        EventLess less = {eps_};
+        events_ = EventQueue(less);
+        StatusLess status_less = {this};
+        status_ = Status(status_less);
+        handles_.assign(n, status_.end());
+
+        for(unsigned int i=0;i<n;i++)
+        {
+            Vector<2> a = segments[i].P0(), b = segments[i].P1();
+            SweepPoint pa = {a[0], a[1]}, pb = {b[0], b[1]};
+            SweepSegment& s = segments_[i];
+            if(less(pb, pa))
+                std::swap(pa, pb);
+            s.p = pa;
+            s.q = pb;
+            s.degenerate = samePoint(pa, pb);
+            s.vertical = (std::abs(pb.x-pa.x)<=eps_);
+            s.slope = (s.vertical)? std::numeric_limits<double>::infinity() : (pb.y-pa.y)/(pb.x-pa.x);
+            events_[pa].push_back(i);
+            if(!s.degenerate)
+                events_[pb];
+        }
+
+        while(!events_.empty())
+        {
+            EventQueue::iterator ev = events_.begin();
+            sweep_ = ev->first;
+            upper_.swap(ev->second);
+            events_.erase(ev);
+
+            // segments containing the event point
+            lower_.clear();
+            contain_.clear();
+            Status::iterator it = status_.lower_bound(probe_);
+            while(it!=status_.end() && std::abs(height(*it)-sweep_.y)<=eps_)
+            {
+                if(samePoint(segments_[*it].q, sweep_))
+                    lower_.push_back(*it);
+                else
+                    contain_.push_back(*it);
+                ++it;
+            }
+
+            all_.clear();
+            all_.insert(all_.end(), upper_.begin(), upper_.end());
+            all_.insert(all_.end(), lower_.begin(), lower_.end());
+            all_.insert(all_.end(), contain_.begin(), contain_.end());
+            if(all_.size()>1)
+            {
+                Vector<2> point(sweep_.x, sweep_.y);
+                if(!callback(point, all_))
+                    break;
+            }
+
+            for(unsigned int i=0;i<lower_.size();i++)
+            {
+                status_.erase(handles_[lower_[i]]);
+                handles_[lower_[i]] = status_.end();
+            }
+            for(unsigned int i=0;i<contain_.size();i++)
+                status_.erase(handles_[contain_[i]]);
+
+            // re-insert with the order just right of the event point
+            bool inserted = false;
+            unsigned int lowest = probe_, highest = probe_;
+            for(unsigned int k=0;k<upper_.size()+contain_.size();k++)
+            {
+                unsigned int i = (k<upper_.size())? upper_[k] : contain_[k-upper_.size()];
+                if(segments_[i].degenerate)
+                    continue;
+                handles_[i] = status_.insert(i).first;
+                if(!inserted || below(i, lowest))
+                    lowest = i;
+                if(!inserted || below(highest, i))
+                    highest = i;
+                inserted = true;
+            }
+
+            if(!inserted)
+            {
+                Status::iterator up = status_.lower_bound(probe_);
+                if(up!=status_.end() && up!=status_.begin())
+                {
+                    Status::iterator down = up;
+                    --down;
+                    checkIntersection(*down, *up);
+                }
+                continue;
+            }
+            Status::iterator lo = handles_[lowest];
+            if(lo!=status_.begin())
+            {
+                Status::iterator down = lo;
+                --down;
+                checkIntersection(*down, lowest);
+            }
+            Status::iterator hi = handles_[highest];
+            ++hi;
+            if(hi!=status_.end())
+                checkIntersection(highest, *hi);
+        }
+        status_.clear();
+        events_.clear();
+    }
+};
+
+/**
+* Find all the intersections among a set of segments (Bentley-Ottmann)
+* @param segments - the segments
+* @param result - buffer for the intersections (cleared first - re-use it between calls to avoid allocations)
+* @return unsigned int - number of intersections
+**/
+inline unsigned int intersectAll(const vector<Segment<2> >& segments, vector<SegmentIntersection>& result)
+{
+    result.clear();
+    SegmentSweep sweep;
+    sweep.run(segments, [&result](const Vector<2>& point, const vector<unsigned int>& ids) {
+        for(unsigned int i=0;i<ids.size();i++)
+        {
+            for(unsigned int j=i+1;j<ids.size();j++)
+            {
+                SegmentIntersection info;
+                info.point = point;
+                info.first = std::min(ids[i], ids[j]);
+                info.second = std::max(ids[i], ids[j]);
+                result.push_back(info);
+            }
+        }
+        return true;
+    });
+    return result.size();
+}
+
+/**
+* Find the self-intersections of a polyline
+* Consecutive segments meeting at their common vertex are not reported
+* @param poly - the polyline (segment i goes from vertex i to vertex i+1)
+* @param result - buffer for the intersections (cleared first)
+* @return unsigned int - number of intersections
+**/
+inline unsigned int selfIntersections(const Polyline<2>& poly, vector<SegmentIntersection>& result)
+{
+    result.clear();
+    const vector<Vector<2> >& v = poly.vertices();
+    if(v.size()<3)
+        return 0;
+    vector<Segment<2> > segments;
+    segments.reserve(v.size()-1);
+    for(unsigned int i=0;i+1<v.size();i++)
+        segments.push_back(Segment<2>(v[i], v[i+1]));
+    intersectAll(segments, result);
+    unsigned int k = 0;
+    for(unsigned int i=0;i<result.size();i++)
+    {
+        const SegmentIntersection& info = result[i];
+        if(info.second==info.first+1 && info.point==v[info.second])
+            continue;
+        result[k++] = info;
+    }
+    result.resize(k);
+    return k;
+}
+
+/**
+* Check if a polygon is simple (non-adjacent edges do not intersect) using the sweep-line
+* Stops at the first intersection found
+* @param poly - the polygon
+* @return bool - true if the polygon is simple
+**/
+inline bool isSimple(const Polygon& poly)
+{
+    vector<Vector<2> > v = poly.vertices();
+    if(v.size()>1 && v.front()==v.back())
+        v.pop_back();
+    unsigned int n = v.size();
+    if(n<3)
+        return false;
+    vector<Segment<2> > edges;
+    edges.reserve(n);
+    for(unsigned int i=0;i<n;i++)
+        edges.push_back(Segment<2>(v[i], v[(i+1)%n]));
+    bool simple = true;
+    SegmentSweep sweep;
+    sweep.run(edges, [&](const Vector<2>& point, const vector<unsigned int>& ids) {
+        if(ids.size()==2)
+        {
+            unsigned int a = std::min(ids[0], ids[1]), b = std::max(ids[0], ids[1]);
+            if(b==a+1 && point==v[b])
+                return true;
+            if(a==0 && b==n-1 && point==v[0])
+                return true;
+        }
+        simple = false;
+        return false;
+    });
+    return simple;
+}
+
+} }
+
+#endif
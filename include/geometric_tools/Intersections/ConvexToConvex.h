@@ -0,0 +1,399 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_INTERSECTIONS_CONVEX_TO_CONVEX_H
+#define GEOMETRIC_TOOLS_INTERSECTIONS_CONVEX_TO_CONVEX_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Primitives/Tools/SupportFunction.h>
+#include <geometric_tools/Distances/ConvexToConvex.h>
+#include <geometric_tools/Intersections/IntersectionInfo.h>
+#include <vector>
+#include <limits>
+#include <cmath>
+
+using std::vector;
+
+namespace GeometricTools {
+
+using Math::Vector;
+using Primitives::Polygon;
+using Primitives::Circle;
+using Primitives::ShapeDimension;
+using Distances::GJKSimplex;
+using Distances::GJKInfo;
+using Distances::gjk;
+
+namespace Intersections {
+
+/**
+* Penetration Info
+* intersect - whether the shapes overlap
+* depth - penetration depth
+* normal - penetration direction (unit) - translating B by depth*normal separates the shapes
+* pointA, pointB - deepest points of A and B
+**/
+template<unsigned int N>
+struct PenetrationInfo
+{
+    bool intersect;
+    double depth;
+    Vector<N> normal;
+    Vector<N> pointA;
+    Vector<N> pointB;
+};
+
+/**
+* EPA Vertex
+* Point of the Minkowski difference A-B with the support points that created it
+**/
+template<unsigned int N>
+struct EPAVertex
+{
+    Vector<N> w;
+    Vector<N> a;
+    Vector<N> b;
+};
+
+/**
+* Expanding Polytope Algorithm
+* Specialized for 2D and 3D
+**/
+template<unsigned int N>
+struct EPA;
+
+/**
+* Make the GJK simplex full dimensional by adding support points along extra directions
+* Needed when GJK terminates with the origin on a vertex/edge/face of the simplex (touching contact)
+* @return bool - false if the Minkowski difference is degenerate (flat)
+**/
+template<class ShapeA, class ShapeB, unsigned int N>
+bool epaInitialSimplex(const ShapeA& a, const ShapeB& b, const GJKSimplex<N>& s, vector<EPAVertex<N> >& verts)
+{
+    using Primitives::support;
+    verts.clear();
+    for(unsigned int i=0;i<s.size;i++)
+    {
+        EPAVertex<N> vert = {s.w[i], s.a[i], s.b[i]};
+        verts.push_back(vert);
+    }
+    double scale = 0.0;
+    for(unsigned int i=0;i<verts.size();i++)
+        scale = std::max(scale, verts[i].w.lengthSq());
+    double eps = 1e-10*std::max(scale, 1e-300);
+    while(verts.size()<N+1)
+    {
+        bool added = false;
+        for(unsigned int k=0;k<2*N && !added;k++)
+        {
+            Vector<N> d = Vector<N>::e(k/2);
+            if(k%2)
+                d = d*(-1.0);
+            EPAVertex<N> vert;
+            vert.a = support(a, d);
+            vert.b = support(b, d*(-1.0));
+            vert.w = vert.a-vert.b;
+            // distance of the new point from the affine hull of the current vertices (Gram-Schmidt)
+            Vector<N> r = vert.w-verts[0].w;
+            vector<Vector<N> > basis;
+            for(unsigned int i=1;i<verts.size();i++)
+            {
+                Vector<N> e = verts[i].w-verts[0].w;
+                for(unsigned int j=0;j<basis.size();j++)
+                    e = e-(e*basis[j])*basis[j];
+                e.normalize();
+                basis.push_back(e);
+            }
+            for(unsigned int j=0;j<basis.size();j++)
+                r = r-(r*basis[j])*basis[j];
+            if(r.lengthSq()>eps)
+            {
+                verts.push_back(vert);
+                added = true;
+            }
+        }
+        if(!added)
+            return false;
+    }
+    return true;
+}
+
+/**
+* 2D EPA - the polytope is a counter-clockwise polygon
+**/
+template<>
+struct EPA<2>
+{
+    template<class ShapeA, class ShapeB>
+    static void run(const ShapeA& a, const ShapeB& b, vector<EPAVertex<2> >& verts, PenetrationInfo<2>& info,
+                    const unsigned int& max_iterations, const double& tolerance)
+    {
+        using Primitives::support;
+        Vector<2> e1 = verts[1].w-verts[0].w, e2 = verts[2].w-verts[0].w;
+        if((e1[0]*e2[1]-e1[1]*e2[0])<0.0)
+            std::swap(verts[1], verts[2]);
+        unsigned int best = 0;
+        double dist = 0.0;
+        Vector<2> n;
+        for(unsigned int it=0;it<max_iterations;it++)
+        {
+            dist = std::numeric_limits<double>::infinity();
+            for(unsigned int i=0;i<verts.size();i++)
+            {
+                unsigned int i_p = (i+1)%verts.size();
+                Vector<2> e = verts[i_p].w-verts[i].w;
+                Vector<2> normal(e[1], -e[0]);
+                if(normal.lengthSq()<std::numeric_limits<double>::epsilon()*std::numeric_limits<double>::epsilon())
+                    continue;
+                normal.normalize();
+                double d = normal*verts[i].w;
+                if(d<dist)
+                {
+                    dist = d;
+                    best = i;
+                    n = normal;
+                }
+            }
+            EPAVertex<2> vert;
+            vert.a = support(a, n);
+            vert.b = support(b, n*(-1.0));
+            vert.w = vert.a-vert.b;
+            if((vert.w*n-dist)<=tolerance*std::max(1.0, std::abs(dist)))
+                break;
+            verts.insert(verts.begin()+best+1, vert);
+        }
+        unsigned int best_p = (best+1)%verts.size();
+        Vector<2> e = verts[best_p].w-verts[best].w;
+        double t = 0.0;
+        if(e.lengthSq()>0.0)
+            t = std::min(1.0, std::max(0.0, -(verts[best].w*e)/(e*e)));
+        info.depth = dist;
+        info.normal = n;
+        info.pointA = verts[best].a+t*(verts[best_p].a-verts[best].a);
+        info.pointB = verts[best].b+t*(verts[best_p].b-verts[best].b);
+    }
+};
+
+/**
+* 3D EPA - the polytope is a triangle mesh with outward normals
+**/
+template<>
+struct EPA<3>
+{
+    struct Face
+    {
+        unsigned int i, j, k;
+        Vector<3> n;
+        double dist;
+        bool alive;
+    };
+
+    static Face makeFace(const vector<EPAVertex<3> >& verts, unsigned int i, unsigned int j, unsigned int k)
+    {
+        Face f;
+        f.i = i; f.j = j; f.k = k;
+        f.alive = true;
+        f.n = Math::cross(verts[j].w-verts[i].w, verts[k].w-verts[i].w);
+        double l = f.n.length();
+        if(l<std::numeric_limits<double>::epsilon()*std::numeric_limits<double>::epsilon())
+        {
+            f.dist = std::numeric_limits<double>::infinity();
+            return f;
+        }
+        f.n /= l;
+        f.dist = f.n*verts[i].w;
+        return f;
+    }
+
+    template<class ShapeA, class ShapeB>
+    static void run(const ShapeA& a, const ShapeB& b, vector<EPAVertex<3> >& verts, PenetrationInfo<3>& info,
+                    const unsigned int& max_iterations, const double& tolerance)
+    {
+        using Primitives::support;
+        vector<Face> faces;
+        Vector<3> centroid = (verts[0].w+verts[1].w+verts[2].w+verts[3].w)/4.0;
+        unsigned int tet[4][3] = {{0,1,2}, {0,3,1}, {0,2,3}, {1,3,2}};
+        for(unsigned int f=0;f<4;f++)
+        {
+            Face face = makeFace(verts, tet[f][0], tet[f][1], tet[f][2]);
+            if(face.n*(verts[tet[f][0]].w-centroid)<0.0)
+                face = makeFace(verts, tet[f][0], tet[f][2], tet[f][1]);
+            faces.push_back(face);
+        }
+
+        vector<std::pair<unsigned int, unsigned int> > horizon;
+        unsigned int best = 0;
+        for(unsigned int it=0;it<max_iterations;it++)
+        {
+            double dist = std::numeric_limits<double>::infinity();
+            for(unsigned int f=0;f<faces.size();f++)
+            {
+                if(faces[f].alive && faces[f].dist<dist)
+                {
+                    dist = faces[f].dist;
+                    best = f;
+                }
+            }
+            Vector<3> n = faces[best].n;
+            EPAVertex<3> vert;
+            vert.a = support(a, n);
+            vert.b = support(b, n*(-1.0));
+            vert.w = vert.a-vert.b;
+            if((vert.w*n-dist)<=tolerance*std::max(1.0, std::abs(dist)))
+                break;
+            // remove the faces visible from the new point and collect the horizon
+            unsigned int q = verts.size();
+            verts.push_back(vert);
+            horizon.clear();
+            for(unsigned int f=0;f<faces.size();f++)
+            {
+                if(!faces[f].alive || (faces[f].n*(vert.w-verts[faces[f].i].w))<=0.0)
+                    continue;
+                faces[f].alive = false;
+                unsigned int e[3][2] = {{faces[f].i, faces[f].j}, {faces[f].j, faces[f].k}, {faces[f].k, faces[f].i}};
+                for(unsigned int k=0;k<3;k++)
+                {
+                    bool shared = false;
+                    for(unsigned int h=0;h<horizon.size();h++)
+                    {
+                        if(horizon[h].first==e[k][1] && horizon[h].second==e[k][0])
+                        {
+                            horizon.erase(horizon.begin()+h);
+                            shared = true;
+                            break;
+                        }
+                    }
+                    if(!shared)
+                        horizon.push_back(std::make_pair(e[k][0], e[k][1]));
+                }
+            }
+            for(unsigned int h=0;h<horizon.size();h++)
+                faces.push_back(makeFace(verts, horizon[h].first, horizon[h].second, q));
+        }
+
+        const Face& f = faces[best];
+        // barycentric coordinates of the projection of the origin on the closest face
+        Vector<3> p = f.n*f.dist;
+        Vector<3> v0 = verts[f.j].w-verts[f.i].w, v1 = verts[f.k].w-verts[f.i].w, v2 = p-verts[f.i].w;
+        double d00 = v0*v0, d01 = v0*v1, d11 = v1*v1, d20 = v2*v0, d21 = v2*v1;
+        double denom = d00*d11-d01*d01;
+        double l1 = 0.0, l2 = 0.0;
+        if(std::abs(denom)>0.0)
+        {
+            l1 = (d11*d20-d01*d21)/denom;
+            l2 = (d00*d21-d01*d20)/denom;
+        }
+        double l0 = 1.0-l1-l2;
+        info.depth = f.dist;
+        info.normal = f.n;
+        info.pointA = l0*verts[f.i].a+l1*verts[f.j].a+l2*verts[f.k].a;
+        info.pointB = l0*verts[f.i].b+l1*verts[f.j].b+l2*verts[f.k].b;
+    }
+};
+
+/**
+* Penetration query between two convex shapes (GJK + EPA)
+* @param a - first convex shape
+* @param b - second convex shape
+* @param info - the result of the query (returns)
+* @param cache - simplex of the previous query of this pair (warm-start) - can be nullptr
+* @param max_iterations - maximum number of iterations (for each of GJK and EPA)
+* @param tolerance - relative tolerance for convergence
+* @return bool - true if the shapes overlap
+**/
+template<class ShapeA, class ShapeB, unsigned int N>
+bool penetration(const ShapeA& a, const ShapeB& b, PenetrationInfo<N>& info, GJKSimplex<N>* cache = nullptr,
+                 const unsigned int& max_iterations = 64, const double& tolerance = 1e-10)
+{
+    GJKSimplex<N> local;
+    GJKSimplex<N>& s = (cache!=nullptr)? *cache : local;
+    GJKInfo<N> gjk_info;
+    info.intersect = gjk(a, b, gjk_info, &s, max_iterations, tolerance);
+    info.depth = 0.0;
+    info.normal = Vector<N>();
+    info.pointA = gjk_info.pointA;
+    info.pointB = gjk_info.pointB;
+    if(!info.intersect)
+        return false;
+    vector<EPAVertex<N> > verts;
+    verts.reserve(max_iterations+N+1);
+    // flat Minkowski difference - shapes are just touching
+    if(!epaInitialSimplex(a, b, s, verts))
+        return true;
+    EPA<N>::run(a, b, verts, info, max_iterations, tolerance);
+    return true;
+}
+
+/**
+* Checks whether two convex shapes overlap (GJK)
+* @param a - first convex shape
+* @param b - second convex shape
+* @param cache - simplex of the previous query of this pair (warm-start) - can be nullptr
+**/
+template<class ShapeA, class ShapeB>
+bool overlap(const ShapeA& a, const ShapeB& b, GJKSimplex<ShapeDimension<ShapeA>::value>* cache = nullptr)
+{
+    GJKInfo<ShapeDimension<ShapeA>::value> info;
+    return gjk(a, b, info, cache);
+}
+
+/**
+* Convex 2D shapes intersection
+* point - deepest point of the first shape
+* delta - penetration vector (translating the second shape by delta separates the shapes)
+**/
+template<class ShapeA, class ShapeB>
+Intersection2DInfo* intersectConvex(const ShapeA& a, const ShapeB& b)
+{
+    PenetrationInfo<2> pen;
+    if(!penetration(a, b, pen))
+        return nullptr;
+    Intersection2DInfo* info = new Intersection2DInfo;
+    info->point = pen.pointA;
+    info->delta = pen.depth*pen.normal;
+    return info;
+}
+
+/**
+* Polygon to Polygon intersection - assumes convex polygons (concave ones are treated as their convex hull)
+**/
+inline Intersection2DInfo* intersect(const Polygon& poly1, const Polygon& poly2)
+{
+    return intersectConvex(poly1, poly2);
+}
+
+inline Intersection2DInfo* intersect(const Circle& circle, const Polygon& poly)
+{
+    return intersectConvex(circle, poly);
+}
+
+inline Intersection2DInfo* intersect(const Polygon& poly, const Circle& circle)
+{
+    return intersectConvex(poly, circle);
+}
+
+inline Intersection2DInfo* intersect(const Circle& circle1, const Circle& circle2)
+{
+    return intersectConvex(circle1, circle2);
+}
+
+} }
+
+#endif
@@ -0,0 +1,405 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#ifndef GEOMETRIC_TOOLS_MATH_DYN_MATRIX_H
+#define GEOMETRIC_TOOLS_MATH_DYN_MATRIX_H
+
+/**
+* Includes
+**/
+#include <iostream>
+#include <limits>
+#include <cmath>
+#include <vector>
+#include <initializer_list>
+#include <geometric_tools/Math/Matrix.h>
+#include <geometric_tools/Math/DynVector.h>
+#include <geometric_tools/Math/Kernels.h>
+#include <geometric_tools/Misc/AlignedBuffer.h>
+
+namespace GeometricTools { namespace Math {
+
+/**
+* MatrixView Struct
+* Non-owning row-major window (rows x cols, leading dimension ld) onto the storage of a DynMatrix or of a fixed-size Matrix
+* The viewed storage must outlive the view
+**/
+struct MatrixView
+{
+    double* data;
+    unsigned int rows, cols, ld;
+
+    MatrixView(double* d, const unsigned int& r, const unsigned int& c, const unsigned int& l): data(d), rows(r), cols(c), ld(l) {}
+
+    /**
+    * View of a whole fixed-size Matrix
+    * @param m - Matrix to view
+    **/
+    template<unsigned int R, unsigned int C>
+    MatrixView(Matrix<R,C>& m): data(m.data()), rows(R), cols(C), ld(C) {}
+
+    double& operator()(const unsigned int& i, const unsigned int& j) const {return data[size_t(i)*ld+j];}
+};
+
+/**
+* Dynamic Matrix Class
+* Heap allocated (64-byte aligned), row-major matrix whose dimensions are only known at runtime
+* Products go through Kernels::gemm (BLAS-3 for large operands when GEOMETRIC_TOOLS_USE_BLAS is defined)
+**/
+class DynMatrix
+{
+protected:
+    // matrix data (row-major, leading dimension cols_)
+    Helper::AlignedBuffer<double> values_;
+    unsigned int rows_, cols_;
+
+public:
+    /**
+    * Default Constructor
+    * empty matrix
+    **/
+    DynMatrix(): rows_(0), cols_(0) {}
+
+    /**
+    * Constructor
+    * @param rows - number of rows
+    * @param cols - number of columns
+    * @param value - initial value of the elements
+    **/
+    DynMatrix(const unsigned int& rows, const unsigned int& cols, const double& value = 0.0)
+        : values_(size_t(rows)*cols, value), rows_(rows), cols_(cols) {}
+
+    /**
+    * Constructor
+    * @param rows - number of rows
+    * @param cols - number of columns
+    * @param values - list of double values (row-major)
+    **/
+    DynMatrix(const unsigned int& rows, const unsigned int& cols, std::initializer_list<double> values)
+        : values_(size_t(rows)*cols, 0.0), rows_(rows), cols_(cols)
+    {
+        std::copy(values.begin(), values.begin()+std::min(values.size(), values_.size()), values_.data());
+    }
+
+    /**
+    * Constructor from a fixed-size Matrix
+    * @param mat - Matrix to copy from
+    **/
+    template<unsigned int R, unsigned int C>
+    DynMatrix(const Matrix<R,C>& mat): values_(size_t(R)*C), rows_(R), cols_(C)
+    {
+        std::copy(mat.data(), mat.data()+R*C, values_.data());
+    }
+
+    /**
+    * Constructor from a view (copies the viewed elements)
+    * @param view - view to copy from
+    **/
+    explicit DynMatrix(const MatrixView& view): values_(size_t(view.rows)*view.cols), rows_(view.rows), cols_(view.cols)
+    {
+        for(unsigned int i=0;i<rows_;i++)
+            std::copy(view.data+size_t(i)*view.ld, view.data+size_t(i)*view.ld+cols_, values_.data()+size_t(i)*cols_);
+    }
+
+    /**
+    * Identity Matrix
+    * @param n - dimension
+    * @return DynMatrix - n x n identity
+    **/
+    static DynMatrix identity(const unsigned int& n)
+    {
+        DynMatrix res(n, n);
+        for(unsigned int i=0;i<n;i++)
+            res(i,i) = 1.0;
+        return res;
+    }
+
+    /**
+    * Resize (the content is kept only if the number of elements does not change)
+    * @param rows - number of rows
+    * @param cols - number of columns
+    **/
+    void resize(const unsigned int& rows, const unsigned int& cols)
+    {
+        values_.resize(size_t(rows)*cols);
+        rows_ = rows;
+        cols_ = cols;
+    }
+
+    /**
+    * Make Zero
+    **/
+    void zero()
+    {
+        std::fill(values_.data(), values_.data()+values_.size(), 0.0);
+    }
+
+    unsigned int rows() const {return rows_;}
+    unsigned int cols() const {return cols_;}
+
+    double* data() {return values_.data();}
+    const double* data() const {return values_.data();}
+
+    double& operator()(const unsigned int& i, const unsigned int& j) {return values_[size_t(i)*cols_+j];}
+    double operator()(const unsigned int& i, const unsigned int& j) const {return values_[size_t(i)*cols_+j];}
+
+    /**
+    * View of the whole matrix or of a block
+    * @param i, j - first row and column of the block
+    * @param rows, cols - size of the block
+    * @return MatrixView - the view
+    **/
+    MatrixView view() {return MatrixView(data(), rows_, cols_, cols_);}
+    MatrixView view(const unsigned int& i, const unsigned int& j, const unsigned int& rows, const unsigned int& cols)
+    {
+        return MatrixView(data()+size_t(i)*cols_+j, rows, cols, cols_);
+    }
+
+    /**
+    * Copy a block into a fixed-size Matrix
+    * @param i, j - first row and column of the block
+    * @return Matrix<R,C> - the block
+    **/
+    template<unsigned int R, unsigned int C>
+    Matrix<R,C> block(const unsigned int& i = 0, const unsigned int& j = 0) const
+    {
+        Matrix<R,C> res;
+        for(unsigned int r=0;r<R;r++)
+            std::copy(data()+size_t(i+r)*cols_+j, data()+size_t(i+r)*cols_+j+C, res.data()+r*C);
+        return res;
+    }
+
+    /**
+    * Overwrite a block with a fixed-size Matrix
+    * @param i, j - first row and column of the block
+    * @param mat - Matrix to copy from
+    **/
+    template<unsigned int R, unsigned int C>
+    void setBlock(const unsigned int& i, const unsigned int& j, const Matrix<R,C>& mat)
+    {
+        for(unsigned int r=0;r<R;r++)
+            std::copy(mat.data()+r*C, mat.data()+(r+1)*C, data()+size_t(i+r)*cols_+j);
+    }
+
+    DynMatrix& operator+=(const DynMatrix& other)
+    {
+        const size_t n = values_.size();
+        double* a = data();
+        const double* b = other.data();
+        for(size_t i=0;i<n;i++)
+            a[i] += b[i];
+        return *this;
+    }
+
+    DynMatrix& operator-=(const DynMatrix& other)
+    {
+        const size_t n = values_.size();
+        double* a = data();
+        const double* b = other.data();
+        for(size_t i=0;i<n;i++)
+            a[i] -= b[i];
+        return *this;
+    }
+
+    DynMatrix& operator*=(const double& other)
+    {
+        const size_t n = values_.size();
+        double* a = data();
+        for(size_t i=0;i<n;i++)
+            a[i] *= other;
+        return *this;
+    }
+
+    /**
+    * Overloading /= operator
+    * Division with scalar (double) - if zero ignores division (returns self)
+    **/
+    DynMatrix& operator/=(const double& other)
+    {
+        if(std::abs(other) < std::numeric_limits<double>::epsilon())
+            return *this;
+        return (*this) *= 1.0/other;
+    }
+
+    DynMatrix operator+(const DynMatrix& other) const
+    {
+        DynMatrix t = *this;
+        t += other;
+        return t;
+    }
+
+    DynMatrix operator-(const DynMatrix& other) const
+    {
+        DynMatrix t = *this;
+        t -= other;
+        return t;
+    }
+
+    DynMatrix operator*(const double& other) const
+    {
+        DynMatrix t = *this;
+        t *= other;
+        return t;
+    }
+
+    DynMatrix operator/(const double& other) const
+    {
+        DynMatrix t = *this;
+        t /= other;
+        return t;
+    }
+
+    DynMatrix operator-() const
+    {
+        return (*this)*(-1.0);
+    }
+
+    /**
+    * Overloading * operator
+    * Multiplication with Matrix (rows of other must equal cols of this)
+    **/
+    DynMatrix operator*(const DynMatrix& other) const
+    {
+        DynMatrix res(rows_, other.cols_);
+        Kernels::gemm(rows_, other.cols_, cols_, data(), cols_, other.data(), other.cols_, res.data(), other.cols_);
+        return res;
+    }
+
+    /**
+    * Overloading * operator
+    * Multiplication with Vector (size of vec must equal cols of this)
+    **/
+    DynVector operator*(const DynVector& vec) const
+    {
+        DynVector res(rows_);
+        Kernels::gemv(rows_, cols_, data(), cols_, vec.data(), res.data());
+        return res;
+    }
+
+    /**
+    * Get Transpose of Matrix (cache blocked)
+    * @return DynMatrix - the transposed matrix
+    **/
+    DynMatrix transpose() const
+    {
+        DynMatrix r(cols_, rows_);
+        const unsigned int B = 32;
+        for(unsigned int i0=0;i0<rows_;i0+=B)
+            for(unsigned int j0=0;j0<cols_;j0+=B)
+                for(unsigned int i=i0;i<std::min(rows_, i0+B);i++)
+                    for(unsigned int j=j0;j<std::min(cols_, j0+B);j++)
+                        r(j,i) = (*this)(i,j);
+        return r;
+    }
+
+    DynMatrix operator~() const
+    {
+        return transpose();
+    }
+
+    /**
+    * Get Norm of Matrix
+    * @return double - the Frobenius (L2) Norm of the Matrix
+    **/
+    double norm() const
+    {
+        const size_t n = values_.size();
+        const double* a = data();
+        double s = 0.0;
+        for(size_t i=0;i<n;i++)
+            s += a[i]*a[i];
+        return std::sqrt(s);
+    }
+
+    bool operator==(const DynMatrix& other) const
+    {
+        return rows_==other.rows_ && cols_==other.cols_ && ((*this)-other).norm()<std::numeric_limits<double>::epsilon();
+    }
+
+    bool operator!=(const DynMatrix& other) const
+    {
+        return !((*this)==other);
+    }
+};
+
+inline DynMatrix operator*(const double& a, const DynMatrix& b)
+{
+    return b*a;
+}
+
+/**
+* Overloading * operator
+* Multiplication with Vector - (vT*M)T
+**/
+inline DynVector operator*(const DynVector& v, const DynMatrix& m)
+{
+    DynVector res(m.cols());
+    Kernels::gemvT(m.rows(), m.cols(), m.data(), m.cols(), v.data(), res.data());
+    return res;
+}
+
+/**
+* Overloading << operator
+* "print" matrix to stream
+**/
+inline std::ostream& operator<<(std::ostream& os, const DynMatrix& obj)
+{
+    for(unsigned int i=0;i<obj.rows();i++)
+    {
+        for(unsigned int j=0;j<obj.cols();j++)
+            os<<obj(i,j)<<" ";
+        if(i+1<obj.rows())
+            os<<std::endl;
+    }
+    return os;
+}
+
+/**
+* Get Inverse of Matrix (blocked LU decomposition with partial pivoting)
+* @param mat - square Matrix to invert
+* @return DynMatrix - the inverse (zero Matrix if mat is singular)
+**/
+inline DynMatrix inverse(const DynMatrix& mat)
+{
+    const unsigned int n = mat.rows();
+    DynMatrix lu = mat, res(n, n);
+    std::vector<unsigned int> piv(n);
+    if(!Kernels::luFactor(n, lu.data(), n, piv.data()))
+        return res;
+    res = DynMatrix::identity(n);
+    Kernels::luSolve(n, lu.data(), n, piv.data(), res.data(), n, n);
+    return res;
+}
+
+/**
+* Get Determinant of the Matrix (blocked LU decomposition with partial pivoting)
+* @param m - Matrix
+* @return double - the determinant (0 if the Matrix is not square)
+**/
+inline double determinant(const DynMatrix& m)
+{
+    if(m.rows()!=m.cols())
+        return 0.0;
+    const unsigned int n = m.rows();
+    DynMatrix lu = m;
+    std::vector<unsigned int> piv(n);
+    Kernels::luFactor(n, lu.data(), n, piv.data());
+    return Kernels::luDeterminant(n, lu.data(), n, piv.data());
+}
+
+} }
+
+#endif
@@ -0,0 +1,290 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#ifndef GEOMETRIC_TOOLS_MATH_DYN_VECTOR_H
+#define GEOMETRIC_TOOLS_MATH_DYN_VECTOR_H
+
+/**
+* Includes
+**/
+#include <iostream>
+#include <limits>
+#include <cmath>
+#include <initializer_list>
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Misc/AlignedBuffer.h>
+
+namespace GeometricTools { namespace Math {
+
+/**
+* Dynamic Vector Class
+* Heap allocated (64-byte aligned) vector whose size is only known at runtime
+* Mirrors the Vector<N> interface; sizes of the operands must match
+**/
+class DynVector
+{
+protected:
+    // values of vector
+    Helper::AlignedBuffer<double> values_;
+
+public:
+    /**
+    * Default Constructor
+    * empty vector
+    **/
+    DynVector() {}
+
+    /**
+    * Constructor
+    * @param n - size of the vector
+    * @param value - initial value of the elements
+    **/
+    explicit DynVector(const size_t& n, const double& value = 0.0): values_(n, value) {}
+
+    /**
+    * Constructor
+    * @param values - list of double values
+    **/
+    DynVector(std::initializer_list<double> values): values_(values.size())
+    {
+        std::copy(values.begin(), values.end(), values_.data());
+    }
+
+    /**
+    * Constructor from a fixed-size Vector
+    * @param vec - Vector to copy from
+    **/
+    template<unsigned int N>
+    DynVector(const Vector<N>& vec): values_(N)
+    {
+        std::copy(vec.data(), vec.data()+N, values_.data());
+    }
+
+    /**
+    * Copy N elements into a fixed-size Vector
+    * @param offset - index of the first element
+    * @return Vector<N> - the elements offset..offset+N-1
+    **/
+    template<unsigned int N>
+    Vector<N> fixed(const size_t& offset = 0) const
+    {
+        Vector<N> res;
+        std::copy(values_.data()+offset, values_.data()+offset+N, res.data());
+        return res;
+    }
+
+    /**
+    * Overwrite N elements with a fixed-size Vector
+    * @param offset - index of the first element
+    * @param vec - Vector to copy from
+    **/
+    template<unsigned int N>
+    void setFixed(const size_t& offset, const Vector<N>& vec)
+    {
+        std::copy(vec.data(), vec.data()+N, values_.data()+offset);
+    }
+
+    /**
+    * Resize (the content is kept only if the size does not change)
+    * @param n - new size
+    **/
+    void resize(const size_t& n)
+    {
+        values_.resize(n);
+    }
+
+    size_t size() const {return values_.size();}
+
+    double* data() {return values_.data();}
+    const double* data() const {return values_.data();}
+
+    double& operator[](const size_t& i) {return values_[i];}
+    double operator[](const size_t& i) const {return values_[i];}
+    double& operator()(const size_t& i) {return values_[i];}
+    double operator()(const size_t& i) const {return values_[i];}
+
+    /**
+    * Set vector to 0s
+    **/
+    void zero()
+    {
+        std::fill(values_.data(), values_.data()+size(), 0.0);
+    }
+
+    /**
+    * Set vector to 1s
+    **/
+    void ones()
+    {
+        std::fill(values_.data(), values_.data()+size(), 1.0);
+    }
+
+    DynVector& operator+=(const DynVector& other)
+    {
+        const size_t n = size();
+        double* a = data();
+        const double* b = other.data();
+        for(size_t i=0;i<n;i++)
+            a[i] += b[i];
+        return *this;
+    }
+
+    DynVector& operator-=(const DynVector& other)
+    {
+        const size_t n = size();
+        double* a = data();
+        const double* b = other.data();
+        for(size_t i=0;i<n;i++)
+            a[i] -= b[i];
+        return *this;
+    }
+
+    DynVector& operator*=(const double& other)
+    {
+        const size_t n = size();
+        double* a = data();
+        for(size_t i=0;i<n;i++)
+            a[i] *= other;
+        return *this;
+    }
+
+    /**
+    * Overloading /= operator
+    * Division with scalar (double) - if zero ignores division (returns self)
+    **/
+    DynVector& operator/=(const double& other)
+    {
+        if(std::abs(other) < std::numeric_limits<double>::epsilon())
+            return *this;
+        return (*this) *= 1.0/other;
+    }
+
+    DynVector operator+(const DynVector& other) const
+    {
+        DynVector t = *this;
+        t += other;
+        return t;
+    }
+
+    DynVector operator-(const DynVector& other) const
+    {
+        DynVector t = *this;
+        t -= other;
+        return t;
+    }
+
+    DynVector operator*(const double& other) const
+    {
+        DynVector t = *this;
+        t *= other;
+        return t;
+    }
+
+    DynVector operator/(const double& other) const
+    {
+        DynVector t = *this;
+        t /= other;
+        return t;
+    }
+
+    DynVector operator-() const
+    {
+        return (*this)*(-1.0);
+    }
+
+    /**
+    * Overloading * operator
+    * Multiplication of 2 Vectors (Dot product)
+    * @return double - the result of the multiplication
+    **/
+    double operator*(const DynVector& other) const
+    {
+        const size_t n = size();
+        const double* a = data();
+        const double* b = other.data();
+        double s0 = 0.0, s1 = 0.0;
+        size_t i = 0;
+        for(;i+1<n;i+=2)
+        {
+            s0 += a[i]*b[i];
+            s1 += a[i+1]*b[i+1];
+        }
+        if(i<n)
+            s0 += a[i]*b[i];
+        return s0+s1;
+    }
+
+    /**
+    * Get LengthSq of Vector
+    * @return double - length squared
+    **/
+    double lengthSq() const
+    {
+        return (*this)*(*this);
+    }
+
+    /**
+    * Get Length of Vector
+    * @return double - length
+    **/
+    double length() const
+    {
+        return std::sqrt(lengthSq());
+    }
+
+    /**
+    * Normalize Vector
+    **/
+    void normalize()
+    {
+        double l = length();
+        if(l>std::numeric_limits<double>::epsilon())
+            *this /= l;
+    }
+
+    /**
+    * Overloading == operator (same size and squared distance below machine epsilon)
+    **/
+    bool operator==(const DynVector& other) const
+    {
+        return size()==other.size() && ((*this)-other).lengthSq()<std::numeric_limits<double>::epsilon();
+    }
+
+    bool operator!=(const DynVector& other) const
+    {
+        return !((*this)==other);
+    }
+};
+
+inline DynVector operator*(const double& a, const DynVector& b)
+{
+    return b*a;
+}
+
+/**
+* Overloading << operator
+* "print" vector to stream
+**/
+inline std::ostream& operator<<(std::ostream& os, const DynVector& obj)
+{
+    for(size_t i=0;i<obj.size();i++)
+        os<<obj[i]<<" ";
+    return os;
+}
+
+} }
+
+#endif
@@ -0,0 +1,1047 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#ifndef GEOMETRIC_TOOLS_MATH_KERNELS_H
+#define GEOMETRIC_TOOLS_MATH_KERNELS_H
+
+/**
+* Includes
+**/
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+/**
+* Backend selection
+* The kernels below are plain loops (no dependencies) and are what the fixed-size Matrix/Vector use.
+* Define GEOMETRIC_TOOLS_USE_BLAS and/or GEOMETRIC_TOOLS_USE_LAPACK (CMake options USE_BLAS/USE_LAPACK)
+* to hand large problems (dimension >= GEOMETRIC_TOOLS_BACKEND_THRESHOLD) over to BLAS/LAPACK
+**/
+#ifndef GEOMETRIC_TOOLS_BACKEND_THRESHOLD
+#define GEOMETRIC_TOOLS_BACKEND_THRESHOLD 64
+#endif
+
+/**
+* Block sizes of the native kernels
+* GEOMETRIC_TOOLS_BLOCK_SIZE - panel width of the blocked LU/QR/Cholesky factorizations
+* GEOMETRIC_TOOLS_BLOCK_K, GEOMETRIC_TOOLS_BLOCK_N - cache blocking of the matrix product
+**/
+#ifndef GEOMETRIC_TOOLS_BLOCK_SIZE
+#define GEOMETRIC_TOOLS_BLOCK_SIZE 48
+#endif
+#ifndef GEOMETRIC_TOOLS_BLOCK_K
+#define GEOMETRIC_TOOLS_BLOCK_K 128
+#endif
+#ifndef GEOMETRIC_TOOLS_BLOCK_N
+#define GEOMETRIC_TOOLS_BLOCK_N 256
+#endif
+
+#ifdef GEOMETRIC_TOOLS_USE_BLAS
+#include <cblas.h>
+#endif
+
+#ifdef GEOMETRIC_TOOLS_USE_LAPACK
+extern "C" int dgetrf_(int *m, int *n, double *a, int * lda, int *ipiv, int *info);
+#endif
+
+namespace GeometricTools { namespace Math { namespace Kernels {
+
+/**
+* General matrix product C = alpha*A*B+beta*C (row-major)
+* The native loops are blocked so that a GEOMETRIC_TOOLS_BLOCK_K x GEOMETRIC_TOOLS_BLOCK_N panel of B stays in cache
+* @param m - rows of A and C
+* @param n - columns of B and C
+* @param k - columns of A and rows of B
+* @param alpha - scale of the product
+* @param A - m x k matrix
+* @param lda - leading dimension of A
+* @param B - k x n matrix
+* @param ldb - leading dimension of B
+* @param beta - scale of the previous content of C (0 overwrites C)
+* @param C - m x n result (must not alias A or B)
+* @param ldc - leading dimension of C
+**/
+inline void gemm(const unsigned int& m, const unsigned int& n, const unsigned int& k, const double& alpha, const double* A, const unsigned int& lda,
+                 const double* B, const unsigned int& ldb, const double& beta, double* C, const unsigned int& ldc)
+{
+#ifdef GEOMETRIC_TOOLS_USE_BLAS
+    if(std::min(std::min(m, n), k)>=GEOMETRIC_TOOLS_BACKEND_THRESHOLD)
+    {
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+        return;
+    }
+#endif
+    if(beta!=1.0)
+    {
+        for(unsigned int i=0;i<m;i++)
+        {
+            double* c = C+size_t(i)*ldc;
+            for(unsigned int j=0;j<n;j++)
+                c[j] = (beta==0.0) ? 0.0 : beta*c[j];
+        }
+    }
+    for(unsigned int p0=0;p0<k;p0+=GEOMETRIC_TOOLS_BLOCK_K)
+    {
+        const unsigned int p1 = std::min(k, p0+GEOMETRIC_TOOLS_BLOCK_K);
+        for(unsigned int j0=0;j0<n;j0+=GEOMETRIC_TOOLS_BLOCK_N)
+        {
+            const unsigned int j1 = std::min(n, j0+GEOMETRIC_TOOLS_BLOCK_N);
+            for(unsigned int i=0;i<m;i++)
+            {
+                double* c = C+size_t(i)*ldc;
+                const double* a = A+size_t(i)*lda;
+                // i-k-j order: the inner loop streams over contiguous rows of B and C
+                for(unsigned int p=p0;p<p1;p++)
+                {
+                    const double s = alpha*a[p];
+                    const double* b = B+size_t(p)*ldb;
+                    for(unsigned int j=j0;j<j1;j++)
+                        c[j] += s*b[j];
+                }
+            }
+        }
+    }
+}
+
+/**
+* General matrix product C = A*B (row-major)
+* @param m - rows of A and C
+* @param n - columns of B and C
+* @param k - columns of A and rows of B
+* @param A - m x k matrix
+* @param lda - leading dimension of A
+* @param B - k x n matrix
+* @param ldb - leading dimension of B
+* @param C - m x n result (must not alias A or B)
+* @param ldc - leading dimension of C
+**/
+inline void gemm(const unsigned int& m, const unsigned int& n, const unsigned int& k, const double* A, const unsigned int& lda,
+                 const double* B, const unsigned int& ldb, double* C, const unsigned int& ldc)
+{
+    gemm(m, n, k, 1.0, A, lda, B, ldb, 0.0, C, ldc);
+}
+
+/**
+* Lower triangle of C = C+alpha*A*A^T (row-major, symmetric rank-k update)
+* Only the entries C(i,j) with j<=i are referenced
+* @param n - rows of A, dimension of C
+* @param k - columns of A
+* @param alpha - scale of the product
+* @param A - n x k matrix
+* @param lda - leading dimension of A
+* @param C - n x n matrix
+* @param ldc - leading dimension of C
+**/
+inline void syrkLower(const unsigned int& n, const unsigned int& k, const double& alpha, const double* A, const unsigned int& lda,
+                      double* C, const unsigned int& ldc)
+{
+#ifdef GEOMETRIC_TOOLS_USE_BLAS
+    if(std::min(n, k)>=GEOMETRIC_TOOLS_BACKEND_THRESHOLD)
+    {
+        cblas_dsyrk(CblasRowMajor, CblasLower, CblasNoTrans, n, k, alpha, A, lda, 1.0, C, ldc);
+        return;
+    }
+#endif
+    // rows of A are contiguous: every entry is a dot product of two rows
+    for(unsigned int i=0;i<n;i++)
+    {
+        const double* ai = A+size_t(i)*lda;
+        double* c = C+size_t(i)*ldc;
+        for(unsigned int j=0;j<=i;j++)
+        {
+            const double* aj = A+size_t(j)*lda;
+            double s0 = 0.0, s1 = 0.0;
+            unsigned int p = 0;
+            for(;p+1<k;p+=2)
+            {
+                s0 += ai[p]*aj[p];
+                s1 += ai[p+1]*aj[p+1];
+            }
+            if(p<k)
+                s0 += ai[p]*aj[p];
+            c[j] += alpha*(s0+s1);
+        }
+    }
+}
+
+/**
+* Matrix-vector product y = A*x (row-major)
+* @param m - rows of A
+* @param n - columns of A
+* @param A - m x n matrix
+* @param lda - leading dimension of A
+* @param x - n elements
+* @param y - m elements (must not alias x)
+**/
+inline void gemv(const unsigned int& m, const unsigned int& n, const double* A, const unsigned int& lda, const double* x, double* y)
+{
+#ifdef GEOMETRIC_TOOLS_USE_BLAS
+    if(std::min(m, n)>=GEOMETRIC_TOOLS_BACKEND_THRESHOLD)
+    {
+        cblas_dgemv(CblasRowMajor, CblasNoTrans, m, n, 1.0, A, lda, x, 1, 0.0, y, 1);
+        return;
+    }
+#endif
+    for(unsigned int i=0;i<m;i++)
+    {
+        const double* a = A+size_t(i)*lda;
+        double s = 0.0;
+        for(unsigned int j=0;j<n;j++)
+            s += a[j]*x[j];
+        y[i] = s;
+    }
+}
+
+/**
+* Transposed matrix-vector product y = A^T*x (row-major)
+* @param m - rows of A
+* @param n - columns of A
+* @param A - m x n matrix
+* @param lda - leading dimension of A
+* @param x - m elements
+* @param y - n elements (must not alias x)
+**/
+inline void gemvT(const unsigned int& m, const unsigned int& n, const double* A, const unsigned int& lda, const double* x, double* y)
+{
+    for(unsigned int j=0;j<n;j++)
+        y[j] = 0.0;
+    for(unsigned int i=0;i<m;i++)
+    {
+        const double* a = A+size_t(i)*lda;
+        const double s = x[i];
+        for(unsigned int j=0;j<n;j++)
+            y[j] += s*a[j];
+    }
+}
+
+/**
+* LU factorization with partial pivoting, in place (row-major): P*A = L*U
+* L is unit lower triangular (stored below the diagonal), U is stored on and above the diagonal
+* @param n - dimension of A
+* @param A - n x n matrix (overwritten by L and U)
+* @param lda - leading dimension of A
+* @param piv - n elements; row i was swapped with row piv[i] at step i
+* @return bool - false if a zero pivot was met (A is singular; the factorization is still completed)
+**/
+inline bool luFactor(const unsigned int& n, double* A, const unsigned int& lda, unsigned int* piv)
+{
+#ifdef GEOMETRIC_TOOLS_USE_LAPACK
+    if(n>=GEOMETRIC_TOOLS_BACKEND_THRESHOLD)
+    {
+        // LAPACK is column-major: factor a transposed copy and transpose it back
+        int dim = int(n), info = 0;
+        std::vector<double> t(size_t(n)*n);
+        std::vector<int> ipiv(n);
+        for(unsigned int i=0;i<n;i++)
+            for(unsigned int j=0;j<n;j++)
+                t[size_t(j)*n+i] = A[size_t(i)*lda+j];
+        dgetrf_(&dim, &dim, t.data(), &dim, ipiv.data(), &info);
+        for(unsigned int i=0;i<n;i++)
+        {
+            piv[i] = ipiv[i]-1;
+            for(unsigned int j=0;j<n;j++)
+                A[size_t(i)*lda+j] = t[size_t(j)*n+i];
+        }
+        return info==0;
+    }
+#endif
+    bool regular = true;
+    // right-looking blocked LU: factor a panel of columns, then update the trailing matrix with one matrix product
+    // (for n<=GEOMETRIC_TOOLS_BLOCK_SIZE the single panel is the classic unblocked elimination)
+    for(unsigned int k=0;k<n;k+=GEOMETRIC_TOOLS_BLOCK_SIZE)
+    {
+        const unsigned int e = std::min(n, k+GEOMETRIC_TOOLS_BLOCK_SIZE);
+        for(unsigned int c=k;c<e;c++)
+        {
+            unsigned int p = c;
+            double best = std::abs(A[size_t(c)*lda+c]);
+            for(unsigned int i=c+1;i<n;i++)
+            {
+                double v = std::abs(A[size_t(i)*lda+c]);
+                if(v>best)
+                {
+                    best = v;
+                    p = i;
+                }
+            }
+            piv[c] = p;
+            double* rc = A+size_t(c)*lda;
+            // whole rows are exchanged, so the columns left and right of the panel follow the pivoting
+            if(p!=c)
+                std::swap_ranges(rc, rc+n, A+size_t(p)*lda);
+            if(rc[c]==0.0)
+            {
+                regular = false;
+                continue;
+            }
+            const double inv = 1.0/rc[c];
+            for(unsigned int i=c+1;i<n;i++)
+            {
+                double* ri = A+size_t(i)*lda;
+                const double l = (ri[c] *= inv);
+                if(l==0.0)
+                    continue;
+                for(unsigned int j=c+1;j<e;j++)
+                    ri[j] -= l*rc[j];
+            }
+        }
+        if(e==n)
+            break;
+        // U12 = L11^-1*A12
+        for(unsigned int i=k+1;i<e;i++)
+        {
+            double* ri = A+size_t(i)*lda;
+            for(unsigned int c=k;c<i;c++)
+            {
+                const double l = ri[c];
+                const double* rc = A+size_t(c)*lda;
+                for(unsigned int j=e;j<n;j++)
+                    ri[j] -= l*rc[j];
+            }
+        }
+        // A22 = A22-L21*U12
+        gemm(n-e, n-e, e-k, -1.0, A+size_t(e)*lda+k, lda, A+size_t(k)*lda+e, lda, 1.0, A+size_t(e)*lda+e, lda);
+    }
+    return regular;
+}
+
+/**
+* Solve A*X = B given the factorization of luFactor
+* @param n - dimension of A
+* @param LU - factored matrix
+* @param lda - leading dimension of LU
+* @param piv - pivots of luFactor
+* @param B - n x nrhs right hand sides (row-major), overwritten by the solution
+* @param nrhs - number of right hand sides
+* @param ldb - leading dimension of B
+**/
+inline void luSolve(const unsigned int& n, const double* LU, const unsigned int& lda, const unsigned int* piv,
+                    double* B, const unsigned int& nrhs = 1, const unsigned int& ldb = 1)
+{
+    for(unsigned int i=0;i<n;i++)
+        if(piv[i]!=i)
+            std::swap_ranges(B+size_t(i)*ldb, B+size_t(i)*ldb+nrhs, B+size_t(piv[i])*ldb);
+    // forward substitution (unit diagonal)
+    for(unsigned int i=1;i<n;i++)
+    {
+        const double* l = LU+size_t(i)*lda;
+        double* bi = B+size_t(i)*ldb;
+        for(unsigned int k=0;k<i;k++)
+        {
+            const double s = l[k];
+            const double* bk = B+size_t(k)*ldb;
+            for(unsigned int r=0;r<nrhs;r++)
+                bi[r] -= s*bk[r];
+        }
+    }
+    // back substitution
+    for(unsigned int i=n;i>0;i--)
+    {
+        const double* u = LU+size_t(i-1)*lda;
+        double* bi = B+size_t(i-1)*ldb;
+        for(unsigned int k=i;k<n;k++)
+        {
+            const double s = u[k];
+            const double* bk = B+size_t(k)*ldb;
+            for(unsigned int r=0;r<nrhs;r++)
+                bi[r] -= s*bk[r];
+        }
+        const double inv = 1.0/u[i-1];
+        for(unsigned int r=0;r<nrhs;r++)
+            bi[r] *= inv;
+    }
+}
+
+/**
+* Determinant from the factorization of luFactor
+* @param n - dimension of A
+* @param LU - factored matrix
+* @param lda - leading dimension of LU
+* @param piv - pivots of luFactor
+* @return double - the determinant
+**/
+inline double luDeterminant(const unsigned int& n, const double* LU, const unsigned int& lda, const unsigned int* piv)
+{
+    double d = 1.0;
+    for(unsigned int i=0;i<n;i++)
+    {
+        d *= LU[size_t(i)*lda+i];
+        if(piv[i]!=i)
+            d = -d;
+    }
+    return d;
+}
+
+/**
+* Householder QR factorization, in place (row-major): A = Q*R, Q = H(0)*H(1)*...*H(k-1), k = min(m,n)
+* H(i) = I - tau[i]*v*v^T with v[i] = 1 and v[i+1..m-1] stored below the diagonal of column i
+* @param m - rows of A
+* @param n - columns of A
+* @param A - m x n matrix (overwritten by R and the reflectors)
+* @param lda - leading dimension of A
+* @param tau - min(m,n) elements, scalar factors of the reflectors
+**/
+inline void qrFactor(const unsigned int& m, const unsigned int& n, double* A, const unsigned int& lda, double* tau)
+{
+    const unsigned int k = std::min(m, n);
+    std::vector<double> w(n);
+    for(unsigned int c=0;c<k;c++)
+    {
+        double alpha = A[size_t(c)*lda+c], norm = 0.0;
+        for(unsigned int i=c+1;i<m;i++)
+            norm += A[size_t(i)*lda+c]*A[size_t(i)*lda+c];
+        if(norm==0.0)
+        {
+            tau[c] = 0.0;
+            continue;
+        }
+        double beta = std::sqrt(alpha*alpha+norm);
+        if(alpha>0.0)
+            beta = -beta;
+        tau[c] = (beta-alpha)/beta;
+        const double scale = 1.0/(alpha-beta);
+        for(unsigned int i=c+1;i<m;i++)
+            A[size_t(i)*lda+c] *= scale;
+        A[size_t(c)*lda+c] = beta;
+        // apply H(c) to the trailing columns: A -= tau*v*(v^T*A)
+        for(unsigned int j=c+1;j<n;j++)
+            w[j] = A[size_t(c)*lda+j];
+        for(unsigned int i=c+1;i<m;i++)
+        {
+            const double v = A[size_t(i)*lda+c];
+            const double* a = A+size_t(i)*lda;
+            for(unsigned int j=c+1;j<n;j++)
+                w[j] += v*a[j];
+        }
+        for(unsigned int j=c+1;j<n;j++)
+            A[size_t(c)*lda+j] -= tau[c]*w[j];
+        for(unsigned int i=c+1;i<m;i++)
+        {
+            const double v = tau[c]*A[size_t(i)*lda+c];
+            double* a = A+size_t(i)*lda;
+            for(unsigned int j=c+1;j<n;j++)
+                a[j] -= v*w[j];
+        }
+    }
+}
+
+/**
+* Form the m x m orthogonal factor of qrFactor
+* @param m - rows of A
+* @param n - columns of A
+* @param A - factored matrix
+* @param lda - leading dimension of A
+* @param tau - scalar factors of qrFactor
+* @param Q - m x m result
+* @param ldq - leading dimension of Q
+**/
+inline void qrFormQ(const unsigned int& m, const unsigned int& n, const double* A, const unsigned int& lda, const double* tau,
+                    double* Q, const unsigned int& ldq)
+{
+    for(unsigned int i=0;i<m;i++)
+        for(unsigned int j=0;j<m;j++)
+            Q[size_t(i)*ldq+j] = (i==j) ? 1.0 : 0.0;
+    std::vector<double> w(m);
+    // Q = H(0)*(H(1)*(...*H(k-1))), H(c) only touches rows/columns c..m-1
+    for(unsigned int c=std::min(m, n);c>0;c--)
+    {
+        const unsigned int r = c-1;
+        if(tau[r]==0.0)
+            continue;
+        for(unsigned int j=r;j<m;j++)
+            w[j] = Q[size_t(r)*ldq+j];
+        for(unsigned int i=r+1;i<m;i++)
+        {
+            const double v = A[size_t(i)*lda+r];
+            const double* q = Q+size_t(i)*ldq;
+            for(unsigned int j=r;j<m;j++)
+                w[j] += v*q[j];
+        }
+        for(unsigned int j=r;j<m;j++)
+            Q[size_t(r)*ldq+j] -= tau[r]*w[j];
+        for(unsigned int i=r+1;i<m;i++)
+        {
+            const double v = tau[r]*A[size_t(i)*lda+r];
+            double* q = Q+size_t(i)*ldq;
+            for(unsigned int j=r;j<m;j++)
+                q[j] -= v*w[j];
+        }
+    }
+}
+
+/**
+* Blocked Householder QR factorization, in place (row-major), same output as qrFactor
+* Panels of GEOMETRIC_TOOLS_BLOCK_SIZE columns are factored with qrFactor and applied to the trailing columns
+* at once through the compact WY form H(k)*...*H(k+b-1) = I - V*T*V^T (two matrix products instead of b rank-1 updates)
+* @param m - rows of A
+* @param n - columns of A
+* @param A - m x n matrix (overwritten by R and the reflectors)
+* @param lda - leading dimension of A
+* @param tau - min(m,n) elements, scalar factors of the reflectors
+**/
+inline void qrFactorBlocked(const unsigned int& m, const unsigned int& n, double* A, const unsigned int& lda, double* tau)
+{
+    const unsigned int kmax = std::min(m, n), nb = GEOMETRIC_TOOLS_BLOCK_SIZE;
+    if(kmax<=nb)
+    {
+        qrFactor(m, n, A, lda, tau);
+        return;
+    }
+    std::vector<double> V, T(size_t(nb)*nb), W;
+    for(unsigned int k=0;k<kmax;k+=nb)
+    {
+        const unsigned int b = std::min(nb, kmax-k), rows = m-k;
+        qrFactor(rows, b, A+size_t(k)*lda+k, lda, tau+k);
+        const unsigned int nc = n-k-b;
+        if(nc==0)
+            break;
+        // explicit V (unit lower trapezoidal), rows x b
+        V.assign(size_t(rows)*b, 0.0);
+        for(unsigned int i=0;i<rows;i++)
+        {
+            const double* a = A+size_t(k+i)*lda+k;
+            for(unsigned int j=0;j<b && j<=i;j++)
+                V[size_t(i)*b+j] = (i==j) ? 1.0 : a[j];
+        }
+        // T upper triangular: T(0:j,j) = -tau_j*T(0:j,0:j)*V(:,0:j)^T*v_j, T(j,j) = tau_j
+        for(unsigned int j=0;j<b;j++)
+        {
+            for(unsigned int i=0;i<j;i++)
+            {
+                double s = 0.0;
+                for(unsigned int r=j;r<rows;r++)
+                    s += V[size_t(r)*b+i]*V[size_t(r)*b+j];
+                T[size_t(i)*nb+j] = -tau[k+j]*s;
+            }
+            for(unsigned int i=0;i<j;i++)
+            {
+                double s = 0.0;
+                for(unsigned int l=i;l<j;l++)
+                    s += T[size_t(i)*nb+l]*T[size_t(l)*nb+j];
+                T[size_t(i)*nb+j] = s;
+            }
+            T[size_t(j)*nb+j] = tau[k+j];
+            for(unsigned int i=j+1;i<b;i++)
+                T[size_t(i)*nb+j] = 0.0;
+        }
+        // A2 = (I - V*T^T*V^T)*A2: W = V^T*A2, W = T^T*W, A2 -= V*W
+        double* A2 = A+size_t(k)*lda+k+b;
+        W.assign(size_t(b)*nc, 0.0);
+        for(unsigned int r=0;r<rows;r++)
+        {
+            const double* a = A2+size_t(r)*lda;
+            for(unsigned int j=0;j<b && j<=r;j++)
+            {
+                const double v = V[size_t(r)*b+j];
+                double* w = &W[size_t(j)*nc];
+                for(unsigned int c=0;c<nc;c++)
+                    w[c] += v*a[c];
+            }
+        }
+        for(unsigned int i=b;i>0;i--)
+        {
+            // row i-1 of T^T*W uses rows 0..i-1 of W (T^T is lower triangular), go bottom-up to work in place
+            double* w = &W[size_t(i-1)*nc];
+            const double d = T[size_t(i-1)*nb+i-1];
+            for(unsigned int c=0;c<nc;c++)
+                w[c] *= d;
+            for(unsigned int l=0;l+1<i;l++)
+            {
+                const double t = T[size_t(l)*nb+i-1];
+                const double* wl = &W[size_t(l)*nc];
+                for(unsigned int c=0;c<nc;c++)
+                    w[c] += t*wl[c];
+            }
+        }
+        gemm(rows, nc, b, -1.0, V.data(), b, W.data(), nc, 1.0, A2, lda);
+    }
+}
+
+/**
+* Least squares solution of A*x = b (m>=n, full column rank) from the factorization of qrFactor/qrFactorBlocked
+* @param m - rows of A
+* @param n - columns of A
+* @param QR - factored matrix
+* @param lda - leading dimension of QR
+* @param tau - scalar factors of the reflectors
+* @param b - m elements, overwritten by Q^T*b (the solution is in the first n elements)
+* @return bool - false if R is singular
+**/
+inline bool qrSolve(const unsigned int& m, const unsigned int& n, const double* QR, const unsigned int& lda, const double* tau, double* b)
+{
+    for(unsigned int c=0;c<n;c++)
+    {
+        if(tau[c]==0.0)
+            continue;
+        double w = b[c];
+        for(unsigned int i=c+1;i<m;i++)
+            w += QR[size_t(i)*lda+c]*b[i];
+        w *= tau[c];
+        b[c] -= w;
+        for(unsigned int i=c+1;i<m;i++)
+            b[i] -= w*QR[size_t(i)*lda+c];
+    }
+    for(unsigned int i=n;i>0;i--)
+    {
+        const double* r = QR+size_t(i-1)*lda;
+        if(r[i-1]==0.0)
+            return false;
+        double s = b[i-1];
+        for(unsigned int j=i;j<n;j++)
+            s -= r[j]*b[j];
+        b[i-1] = s/r[i-1];
+    }
+    return true;
+}
+
+/**
+* Blocked Cholesky factorization, in place (row-major): A = L*L^T
+* Only the lower triangle of A is referenced and overwritten by L (the strict upper triangle is left untouched)
+* @param n - dimension of A
+* @param A - symmetric positive definite n x n matrix
+* @param lda - leading dimension of A
+* @return bool - false if A is not (numerically) positive definite
+**/
+inline bool choleskyFactor(const unsigned int& n, double* A, const unsigned int& lda)
+{
+    for(unsigned int k=0;k<n;k+=GEOMETRIC_TOOLS_BLOCK_SIZE)
+    {
+        const unsigned int e = std::min(n, k+GEOMETRIC_TOOLS_BLOCK_SIZE);
+        // diagonal block and the panel below it, dot product form on the rows (contiguous)
+        for(unsigned int j=k;j<e;j++)
+        {
+            double* rj = A+size_t(j)*lda;
+            double d = rj[j];
+            for(unsigned int p=k;p<j;p++)
+                d -= rj[p]*rj[p];
+            if(!(d>0.0))
+                return false;
+            d = std::sqrt(d);
+            rj[j] = d;
+            const double inv = 1.0/d;
+            for(unsigned int i=j+1;i<n;i++)
+            {
+                double* ri = A+size_t(i)*lda;
+                double s = ri[j];
+                for(unsigned int p=k;p<j;p++)
+                    s -= ri[p]*rj[p];
+                ri[j] = s*inv;
+            }
+        }
+        // A22 = A22-L21*L21^T (lower triangle)
+        if(e<n)
+            syrkLower(n-e, e-k, -1.0, A+size_t(e)*lda+k, lda, A+size_t(e)*lda+e, lda);
+    }
+    return true;
+}
+
+/**
+* Solve A*X = B given the factorization of choleskyFactor
+* @param n - dimension of A
+* @param L - factored matrix (lower triangle)
+* @param lda - leading dimension of L
+* @param B - n x nrhs right hand sides (row-major), overwritten by the solution
+* @param nrhs - number of right hand sides
+* @param ldb - leading dimension of B
+**/
+inline void choleskySolve(const unsigned int& n, const double* L, const unsigned int& lda, double* B,
+                          const unsigned int& nrhs = 1, const unsigned int& ldb = 1)
+{
+    // L*Y = B
+    for(unsigned int i=0;i<n;i++)
+    {
+        const double* l = L+size_t(i)*lda;
+        double* bi = B+size_t(i)*ldb;
+        for(unsigned int k=0;k<i;k++)
+        {
+            const double s = l[k];
+            const double* bk = B+size_t(k)*ldb;
+            for(unsigned int r=0;r<nrhs;r++)
+                bi[r] -= s*bk[r];
+        }
+        const double inv = 1.0/l[i];
+        for(unsigned int r=0;r<nrhs;r++)
+            bi[r] *= inv;
+    }
+    // L^T*X = Y (column i of L^T is row i of L)
+    for(unsigned int i=n;i>0;i--)
+    {
+        const double* l = L+size_t(i-1)*lda;
+        double* bi = B+size_t(i-1)*ldb;
+        const double inv = 1.0/l[i-1];
+        for(unsigned int r=0;r<nrhs;r++)
+            bi[r] *= inv;
+        for(unsigned int k=0;k+1<i;k++)
+        {
+            const double s = l[k];
+            double* bk = B+size_t(k)*ldb;
+            for(unsigned int r=0;r<nrhs;r++)
+                bk[r] -= s*bi[r];
+        }
+    }
+}
+
+/**
+* LDL^T factorization without pivoting, in place (row-major): A = L*D*L^T
+* L is unit lower triangular (stored below the diagonal), D is diagonal. Works for symmetric indefinite
+* matrices as long as no zero pivot is met. Only the lower triangle of A is referenced
+* @param n - dimension of A
+* @param A - symmetric n x n matrix (lower triangle overwritten by L)
+* @param lda - leading dimension of A
+* @param d - n elements, the diagonal of D
+* @return bool - false if a zero pivot was met
+**/
+inline bool ldltFactor(const unsigned int& n, double* A, const unsigned int& lda, double* d)
+{
+    for(unsigned int i=0;i<n;i++)
+    {
+        double* ri = A+size_t(i)*lda;
+        // t_j = L(i,j)*d_j is kept in place while the row is built, then scaled back
+        for(unsigned int j=0;j<i;j++)
+        {
+            const double* rj = A+size_t(j)*lda;
+            double s = ri[j];
+            for(unsigned int p=0;p<j;p++)
+                s -= ri[p]*rj[p];
+            ri[j] = s;
+        }
+        double di = ri[i];
+        for(unsigned int j=0;j<i;j++)
+        {
+            const double t = ri[j];
+            ri[j] = t/d[j];
+            di -= t*ri[j];
+        }
+        if(di==0.0)
+            return false;
+        d[i] = di;
+    }
+    return true;
+}
+
+/**
+* Solve A*X = B given the factorization of ldltFactor
+* @param n - dimension of A
+* @param L - factored matrix (strict lower triangle)
+* @param lda - leading dimension of L
+* @param d - diagonal of D
+* @param B - n x nrhs right hand sides (row-major), overwritten by the solution
+* @param nrhs - number of right hand sides
+* @param ldb - leading dimension of B
+**/
+inline void ldltSolve(const unsigned int& n, const double* L, const unsigned int& lda, const double* d, double* B,
+                      const unsigned int& nrhs = 1, const unsigned int& ldb = 1)
+{
+    for(unsigned int i=1;i<n;i++)
+    {
+        const double* l = L+size_t(i)*lda;
+        double* bi = B+size_t(i)*ldb;
+        for(unsigned int k=0;k<i;k++)
+        {
+            const double s = l[k];
+            const double* bk = B+size_t(k)*ldb;
+            for(unsigned int r=0;r<nrhs;r++)
+                bi[r] -= s*bk[r];
+        }
+    }
+    for(unsigned int i=0;i<n;i++)
+    {
+        const double inv = 1.0/d[i];
+        double* bi = B+size_t(i)*ldb;
+        for(unsigned int r=0;r<nrhs;r++)
+            bi[r] *= inv;
+    }
+    for(unsigned int i=n;i>0;i--)
+    {
+        const double* l = L+size_t(i-1)*lda;
+        const double* bi = B+size_t(i-1)*ldb;
+        for(unsigned int k=0;k+1<i;k++)
+        {
+            const double s = l[k];
+            double* bk = B+size_t(k)*ldb;
+            for(unsigned int r=0;r<nrhs;r++)
+                bk[r] -= s*bi[r];
+        }
+    }
+}
+
+/**
+* Rank-1 update (sigma=1) or downdate (sigma=-1) of a Cholesky factor: L*L^T+sigma*x*x^T = L'*L'^T, O(n^2)
+* @param n - dimension of L
+* @param L - factor of choleskyFactor (lower triangle, overwritten by L')
+* @param lda - leading dimension of L
+* @param x - n elements (destroyed)
+* @param sigma - 1 for an update, -1 for a downdate
+* @return bool - false if the downdated matrix is not positive definite (L is then left partially modified)
+**/
+inline bool choleskyRank1(const unsigned int& n, double* L, const unsigned int& lda, double* x, const double& sigma)
+{
+    for(unsigned int k=0;k<n;k++)
+    {
+        double* lk = L+size_t(k)*lda;
+        const double r2 = lk[k]*lk[k]+sigma*x[k]*x[k];
+        if(!(r2>0.0))
+            return false;
+        const double r = std::sqrt(r2);
+        const double c = r/lk[k], s = x[k]/lk[k];
+        lk[k] = r;
+        const double ic = 1.0/c;
+        for(unsigned int i=k+1;i<n;i++)
+        {
+            double& lik = L[size_t(i)*lda+k];
+            lik = (lik+sigma*s*x[i])*ic;
+            x[i] = c*x[i]-s*lik;
+        }
+    }
+    return true;
+}
+
+/**
+* Rank-1 modification of an LDL^T factorization: L*D*L^T+alpha*x*x^T = L'*D'*L'^T, O(n^2)
+* (Gill, Golub, Murray and Saunders, method C1) - alpha<0 downdates
+* @param n - dimension of L
+* @param L - factor of ldltFactor (strict lower triangle, overwritten by L')
+* @param lda - leading dimension of L
+* @param d - diagonal of D (overwritten by D')
+* @param x - n elements (destroyed)
+* @param alpha - scale of the modification
+* @return bool - false if a pivot of D' vanished (L and d are then left partially modified)
+**/
+inline bool ldltRank1(const unsigned int& n, double* L, const unsigned int& lda, double* d, double* x, double alpha)
+{
+    for(unsigned int j=0;j<n;j++)
+    {
+        const double p = x[j];
+        const double dj = d[j]+alpha*p*p;
+        if(dj==0.0)
+            return false;
+        const double beta = p*alpha/dj;
+        alpha *= d[j]/dj;
+        d[j] = dj;
+        for(unsigned int i=j+1;i<n;i++)
+        {
+            double& lij = L[size_t(i)*lda+j];
+            x[i] -= p*lij;
+            lij += beta*x[i];
+        }
+    }
+    return true;
+}
+
+/**
+* Thin singular value decomposition by one-sided (Hestenes) Jacobi rotations, in place and allocation free: A = U*diag(s)*V^T
+* Pairs of columns of A are rotated until they are orthogonal; the rotations accumulate in V.
+* Accurate to working precision also for the small singular values, cost O(m*n^2) per sweep (a handful of sweeps)
+* @param m - rows of A (m>=n)
+* @param n - columns of A
+* @param A - m x n matrix (overwritten by the m x n orthonormal U)
+* @param lda - leading dimension of A
+* @param s - n elements, the singular values in decreasing order
+* @param V - n x n result (orthogonal)
+* @param ldv - leading dimension of V
+* @return bool - false if the rotations did not converge
+**/
+inline bool jacobiSVD(const unsigned int& m, const unsigned int& n, double* A, const unsigned int& lda, double* s,
+                      double* V, const unsigned int& ldv)
+{
+    const double eps = std::numeric_limits<double>::epsilon();
+    for(unsigned int i=0;i<n;i++)
+        for(unsigned int j=0;j<n;j++)
+            V[size_t(i)*ldv+j] = (i==j) ? 1.0 : 0.0;
+    bool converged = false;
+    for(unsigned int sweep=0;sweep<64 && !converged;sweep++)
+    {
+        converged = true;
+        for(unsigned int p=0;p+1<n;p++)
+        {
+            for(unsigned int q=p+1;q<n;q++)
+            {
+                double alpha = 0.0, beta = 0.0, gamma = 0.0;
+                for(unsigned int i=0;i<m;i++)
+                {
+                    const double ap = A[size_t(i)*lda+p], aq = A[size_t(i)*lda+q];
+                    alpha += ap*ap;
+                    beta += aq*aq;
+                    gamma += ap*aq;
+                }
+                if(!(std::abs(gamma)>eps*std::sqrt(alpha*beta)))
+                    continue;
+                converged = false;
+                // rotation that zeroes the off-diagonal entry of the 2x2 Gram matrix [alpha gamma; gamma beta]
+                const double zeta = (beta-alpha)/(2.0*gamma);
+                const double t = ((zeta>=0.0) ? 1.0 : -1.0)/(std::abs(zeta)+std::sqrt(1.0+zeta*zeta));
+                const double c = 1.0/std::sqrt(1.0+t*t), sn = c*t;
+                for(unsigned int i=0;i<m;i++)
+                {
+                    double* a = A+size_t(i)*lda;
+                    const double ap = a[p], aq = a[q];
+                    a[p] = c*ap-sn*aq;
+                    a[q] = sn*ap+c*aq;
+                }
+                for(unsigned int i=0;i<n;i++)
+                {
+                    double* v = V+size_t(i)*ldv;
+                    const double vp = v[p], vq = v[q];
+                    v[p] = c*vp-sn*vq;
+                    v[q] = sn*vp+c*vq;
+                }
+            }
+        }
+    }
+    for(unsigned int j=0;j<n;j++)
+    {
+        double nrm = 0.0;
+        for(unsigned int i=0;i<m;i++)
+            nrm += A[size_t(i)*lda+j]*A[size_t(i)*lda+j];
+        s[j] = std::sqrt(nrm);
+    }
+    // decreasing order (selection sort, n is small)
+    for(unsigned int j=0;j+1<n;j++)
+    {
+        unsigned int k = j;
+        for(unsigned int i=j+1;i<n;i++)
+            if(s[i]>s[k])
+                k = i;
+        if(k==j)
+            continue;
+        std::swap(s[j], s[k]);
+        for(unsigned int i=0;i<m;i++)
+            std::swap(A[size_t(i)*lda+j], A[size_t(i)*lda+k]);
+        for(unsigned int i=0;i<n;i++)
+            std::swap(V[size_t(i)*ldv+j], V[size_t(i)*ldv+k]);
+    }
+    // U = A*diag(s)^-1; the columns of (numerically) zero singular values are completed to an orthonormal set
+    const double tol = (n>0) ? s[0]*eps*std::max(m, n) : 0.0;
+    for(unsigned int j=0;j<n;j++)
+    {
+        if(s[j]>tol && s[j]>0.0)
+        {
+            const double inv = 1.0/s[j];
+            for(unsigned int i=0;i<m;i++)
+                A[size_t(i)*lda+j] *= inv;
+            continue;
+        }
+        for(unsigned int e=0;e<m;e++)
+        {
+            for(unsigned int i=0;i<m;i++)
+                A[size_t(i)*lda+j] = (i==e) ? 1.0 : 0.0;
+            // two passes of Gram-Schmidt against the previous columns
+            for(unsigned int pass=0;pass<2;pass++)
+            {
+                for(unsigned int k=0;k<j;k++)
+                {
+                    double d = 0.0;
+                    for(unsigned int i=0;i<m;i++)
+                        d += A[size_t(i)*lda+k]*A[size_t(i)*lda+j];
+                    for(unsigned int i=0;i<m;i++)
+                        A[size_t(i)*lda+j] -= d*A[size_t(i)*lda+k];
+                }
+            }
+            double nrm = 0.0;
+            for(unsigned int i=0;i<m;i++)
+                nrm += A[size_t(i)*lda+j]*A[size_t(i)*lda+j];
+            if(nrm>0.25)
+            {
+                nrm = 1.0/std::sqrt(nrm);
+                for(unsigned int i=0;i<m;i++)
+                    A[size_t(i)*lda+j] *= nrm;
+                break;
+            }
+        }
+    }
+    return converged;
+}
+
+/**
+* Eigen decomposition of a symmetric matrix by cyclic Jacobi rotations, in place and allocation free: A = V*diag(w)*V^T
+* @param n - dimension of A
+* @param A - symmetric n x n matrix (destroyed)
+* @param lda - leading dimension of A
+* @param w - n elements, the eigenvalues in decreasing order
+* @param V - n x n result, the eigenvectors as columns (orthogonal)
+* @param ldv - leading dimension of V
+* @return bool - false if the rotations did not converge
+**/
+inline bool symmetricEigen(const unsigned int& n, double* A, const unsigned int& lda, double* w, double* V, const unsigned int& ldv)
+{
+    const double eps = std::numeric_limits<double>::epsilon();
+    for(unsigned int i=0;i<n;i++)
+        for(unsigned int j=0;j<n;j++)
+            V[size_t(i)*ldv+j] = (i==j) ? 1.0 : 0.0;
+    bool converged = false;
+    for(unsigned int sweep=0;sweep<64 && !converged;sweep++)
+    {
+        converged = true;
+        for(unsigned int p=0;p+1<n;p++)
+        {
+            for(unsigned int q=p+1;q<n;q++)
+            {
+                const double apq = A[size_t(p)*lda+q], app = A[size_t(p)*lda+p], aqq = A[size_t(q)*lda+q];
+                if(!(std::abs(apq)>eps*std::sqrt(std::abs(app*aqq))) )
+                    continue;
+                converged = false;
+                const double theta = (aqq-app)/(2.0*apq);
+                const double t = ((theta>=0.0) ? 1.0 : -1.0)/(std::abs(theta)+std::sqrt(1.0+theta*theta));
+                const double c = 1.0/std::sqrt(1.0+t*t), sn = c*t;
+                // A = J^T*A*J, J the rotation in the (p,q) plane
+                for(unsigned int k=0;k<n;k++)
+                {
+                    double* a = A+size_t(k)*lda;
+                    const double akp = a[p], akq = a[q];
+                    a[p] = c*akp-sn*akq;
+                    a[q] = sn*akp+c*akq;
+                }
+                double* ap = A+size_t(p)*lda;
+                double* aq = A+size_t(q)*lda;
+                for(unsigned int k=0;k<n;k++)
+                {
+                    const double apk = ap[k], aqk = aq[k];
+                    ap[k] = c*apk-sn*aqk;
+                    aq[k] = sn*apk+c*aqk;
+                }
+                ap[q] = aq[p] = 0.0;
+                for(unsigned int k=0;k<n;k++)
+                {
+                    double* v = V+size_t(k)*ldv;
+                    const double vp = v[p], vq = v[q];
+                    v[p] = c*vp-sn*vq;
+                    v[q] = sn*vp+c*vq;
+                }
+            }
+        }
+    }
+    for(unsigned int j=0;j<n;j++)
+        w[j] = A[size_t(j)*lda+j];
+    for(unsigned int j=0;j+1<n;j++)
+    {
+        unsigned int k = j;
+        for(unsigned int i=j+1;i<n;i++)
+            if(w[i]>w[k])
+                k = i;
+        if(k==j)
+            continue;
+        std::swap(w[j], w[k]);
+        for(unsigned int i=0;i<n;i++)
+            std::swap(V[size_t(i)*ldv+j], V[size_t(i)*ldv+k]);
+    }
+    return converged;
+}
+
+} } }
+
+#endif
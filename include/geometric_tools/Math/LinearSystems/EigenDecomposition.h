@@ -0,0 +1,181 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#ifndef GEOMETRIC_TOOLS_MATH_LINEAR_SYSTEMS_EIGEN_DECOMPOSITION_H
+#define GEOMETRIC_TOOLS_MATH_LINEAR_SYSTEMS_EIGEN_DECOMPOSITION_H
+
+/**
+* Includes
+**/
+#include <cmath>
+#include <algorithm>
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Math/Matrix.h>
+#include <geometric_tools/Math/Kernels.h>
+#include <geometric_tools/Math/DynMatrix.h>
+
+namespace GeometricTools {
+
+namespace Math {
+
+namespace LinearSystems {
+
+/**
+* Perform Eigen Decomposition of a symmetric Matrix (cyclic Jacobi, no heap allocation): a = V*diag(values)*V^T
+* @param a - symmetric Matrix to decompose
+* @param values - eigenvalues (decreasing)       --
+* @param vectors - eigenvectors (columns of V)    |
+*					   --> Pass by reference (returns)
+* @return bool - false if the iteration did not converge
+**/
+template<unsigned int D>
+bool EigenDecomposition(const Matrix<D,D>& a, Vector<D>& values, Matrix<D,D>& vectors)
+{
+    Matrix<D,D> tmp = a;
+    return Kernels::symmetricEigen(D, tmp.data(), D, values.data(), vectors.data(), D);
+}
+
+/**
+* Perform Eigen Decomposition of a symmetric Matrix (cyclic Jacobi): a = V*diag(values)*V^T
+* @param a - symmetric Matrix to decompose (n x n)
+* @param values - eigenvalues (decreasing)       --
+* @param vectors - eigenvectors (columns of V)    |
+*					   --> Pass by reference (returns)
+* @return bool - false if the iteration did not converge
+**/
+inline bool EigenDecomposition(const DynMatrix& a, DynVector& values, DynMatrix& vectors)
+{
+    const unsigned int n = a.rows();
+    DynMatrix tmp = a;
+    values.resize(n);
+    vectors.resize(n, n);
+    return Kernels::symmetricEigen(n, tmp.data(), n, values.data(), vectors.data(), n);
+}
+
+/**
+* Unit null vector of the rank 2 matrix A-e*I: the longest cross product of two of its rows
+**/
+inline Vector<3> eigenVector3(const Matrix<3,3>& A, const double& e)
+{
+    Vector<3> r0(A(0,0)-e, A(0,1), A(0,2));
+    Vector<3> r1(A(0,1), A(1,1)-e, A(1,2));
+    Vector<3> r2(A(0,2), A(1,2), A(2,2)-e);
+    Vector<3> c[3] = {cross(r0, r1), cross(r0, r2), cross(r1, r2)};
+    unsigned int best = 0;
+    double d = c[0]*c[0];
+    for(unsigned int i=1;i<3;i++)
+    {
+        double di = c[i]*c[i];
+        if(di>d)
+        {
+            d = di;
+            best = i;
+        }
+    }
+    if(!(d>0.0))
+        return Vector<3>(1.0, 0.0, 0.0);
+    // (Vector division ignores divisors below epsilon)
+    return c[best]*(1.0/std::sqrt(d));
+}
+
+/**
+* Perform Eigen Decomposition of a symmetric 3x3 Matrix in closed form (trigonometric roots of the characteristic
+* polynomial, eigenvectors from cross products and one plane rotation - no iteration): a = V*diag(values)*V^T
+* Only the upper triangle of a is read
+* @param a - symmetric Matrix to decompose
+* @param values - eigenvalues (decreasing)       --
+* @param vectors - eigenvectors (columns of V)    |
+*					   --> Pass by reference (returns)
+* @return bool - always true
+**/
+inline bool EigenDecomposition(const Matrix<3,3>& a, Vector<3>& values, Matrix<3,3>& vectors)
+{
+    vectors.identity();
+    // scale to [-1,1] to avoid overflow/underflow in the cubic terms
+    double scale = 0.0;
+    for(unsigned int i=0;i<3;i++)
+        for(unsigned int j=i;j<3;j++)
+            scale = std::max(scale, std::abs(a(i,j)));
+    if(scale==0.0)
+    {
+        values = Vector<3>(0.0, 0.0, 0.0);
+        return true;
+    }
+    Matrix<3,3> A;
+    for(unsigned int i=0;i<3;i++)
+        for(unsigned int j=i;j<3;j++)
+            A(i,j) = A(j,i) = a(i,j)*(1.0/scale);
+    const double q = (A(0,0)+A(1,1)+A(2,2))/3.0;
+    const double b00 = A(0,0)-q, b11 = A(1,1)-q, b22 = A(2,2)-q;
+    const double off = A(0,1)*A(0,1)+A(0,2)*A(0,2)+A(1,2)*A(1,2);
+    const double p = std::sqrt((b00*b00+b11*b11+b22*b22+2.0*off)/6.0);
+    if(p==0.0)
+    {
+        values = Vector<3>(q, q, q)*scale;
+        return true;
+    }
+    // B = (A-q*I)/p has eigenvalues 2*cos(phi+2*k*pi/3) with cos(3*phi) = det(B)/2
+    const double ip = 1.0/p;
+    const double c00 = b00*ip, c11 = b11*ip, c22 = b22*ip;
+    const double c01 = A(0,1)*ip, c02 = A(0,2)*ip, c12 = A(1,2)*ip;
+    double halfDet = 0.5*(c00*(c11*c22-c12*c12)-c01*(c01*c22-c12*c02)+c02*(c01*c12-c11*c02));
+    halfDet = std::min(std::max(halfDet, -1.0), 1.0);
+    const double phi = std::acos(halfDet)/3.0;
+    const double twoPiOverThree = 2.0943951023931954923;
+    const double beta2 = 2.0*std::cos(phi), beta0 = 2.0*std::cos(phi+twoPiOverThree);
+    // eigenvector of the eigenvalue that is farther from the other two (its root is accurate even when the
+    // other two nearly coincide - the trigonometric roots lose half the digits next to a double root)
+    const Vector<3> v0 = eigenVector3(A, (halfDet>=0.0) ? q+p*beta2 : q+p*beta0);
+    // the other two: exact 2x2 Jacobi rotation of A restricted to the plane orthogonal to v0
+    Vector<3> U;
+    if(std::abs(v0[0])>std::abs(v0[1]))
+        U = Vector<3>(-v0[2], 0.0, v0[0])*(1.0/std::sqrt(v0[0]*v0[0]+v0[2]*v0[2]));
+    else
+        U = Vector<3>(0.0, v0[2], -v0[1])*(1.0/std::sqrt(v0[1]*v0[1]+v0[2]*v0[2]));
+    Vector<3> V = cross(v0, U);
+    const double m00 = U*(A*U), m01 = U*(A*V), m11 = V*(A*V);
+    Vector<3> v1 = U, v2 = V;
+    if(m01!=0.0)
+    {
+        const double theta = (m11-m00)/(2.0*m01);
+        const double t = ((theta>=0.0) ? 1.0 : -1.0)/(std::abs(theta)+std::sqrt(1.0+theta*theta));
+        const double c = 1.0/std::sqrt(1.0+t*t), sn = c*t;
+        v1 = c*U-sn*V;
+        v2 = sn*U+c*V;
+    }
+    // Rayleigh quotients of the (orthonormal) eigenvectors, sorted in decreasing order
+    Vector<3> v[3] = {v0, v1, v2};
+    double e[3] = {v0*(A*v0), v1*(A*v1), v2*(A*v2)};
+    for(unsigned int i=0;i<2;i++)
+        for(unsigned int j=0;j<2-i;j++)
+            if(e[j]<e[j+1])
+            {
+                std::swap(e[j], e[j+1]);
+                std::swap(v[j], v[j+1]);
+            }
+    values = Vector<3>(e[0], e[1], e[2])*scale;
+    for(unsigned int i=0;i<3;i++)
+    {
+        vectors(i,0) = v[0][i];
+        vectors(i,1) = v[1][i];
+        vectors(i,2) = v[2][i];
+    }
+    return true;
+}
+
+} } }
+
+#endif
@@ -22,8 +22,9 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 * Includes
 **/
 #include <geometric_tools/Math/Matrix.h>
-
-extern "C" int dgetrf_(int *m, int *n, double *a, int * lda, int *ipiv, int *info);
+#include <geometric_tools/Math/Kernels.h>
+#include <vector>
+#include <geometric_tools/Math/DynMatrix.h>
 
 namespace GeometricTools {
 
@@ -38,7 +39,7 @@ class Vector;
 namespace LinearSystems {
 
 /**
-* Perform LU Decomposition
+* Perform LU Decomposition with partial pivoting: a = P*L*U
 * @param a - Matrix to decompose
 * @param L - L Matrix --
 * @param U - U Matrix  |
@@ -51,16 +52,46 @@ void LUDecomposition(const Matrix<D,D>& a, Matrix<D,D>& L, Matrix<D,D>& U, Matri
     L.identity();
     P.identity();
     U = a;
-    int* ipiv = new int[D];
-    int dim = int(D), info;
-    dgetrf_(&dim, &dim, U.data(), &dim, ipiv, &info);
+    unsigned int piv[D];
+    Kernels::luFactor(D, U.data(), D, piv);
     for(unsigned int i=0;i<D;i++) {
-        P.swapCols(i, ipiv[i]-1);
+        P.swapCols(i, piv[i]);
+        for(unsigned int j=0;j<i;j++) {
+            L(i,j) = U(i,j);
+            U(i,j) = 0.0;
+        }
+    }
+}
+
+/**
+* Perform (blocked) LU Decomposition with partial pivoting: a = P*L*U
+* @param a - Matrix to decompose (n x n)
+* @param L - L Matrix --
+* @param U - U Matrix  |
+* @param P - P Matrix  |
+*					   --> Pass by reference (returns)
+**/
+inline void LUDecomposition(const DynMatrix& a, DynMatrix& L, DynMatrix& U, DynMatrix& P)
+{
+    const unsigned int n = a.rows();
+    L = DynMatrix::identity(n);
+    U = a;
+    std::vector<unsigned int> piv(n);
+    Kernels::luFactor(n, U.data(), n, piv.data());
+    // P = P(0)*P(1)*...*P(n-1), built on the row permutation
+    std::vector<unsigned int> perm(n);
+    for(unsigned int i=0;i<n;i++)
+        perm[i] = i;
+    for(unsigned int i=0;i<n;i++) {
+        std::swap(perm[i], perm[piv[i]]);
         for(unsigned int j=0;j<i;j++) {
             L(i,j) = U(i,j);
             U(i,j) = 0.0;
         }
     }
+    P = DynMatrix(n, n);
+    for(unsigned int i=0;i<n;i++)
+        P(perm[i],i) = 1.0;
 }
 
 } } }
@@ -0,0 +1,377 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_MATH_LINEAR_SYSTEMS_LEAST_SQUARES_H
+#define GEOMETRIC_TOOLS_MATH_LINEAR_SYSTEMS_LEAST_SQUARES_H
+
+/**
+* Includes
+**/
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+using std::vector;
+
+namespace GeometricTools {
+
+namespace Math {
+
+namespace LinearSystems {
+
+/**
+* LeastSquares Class
+* Streaming least squares min |Ax-b| by Givens QR: rows are folded into the triangular factor R
+* (and Q^T b) as they arrive, so A is never stored. Memory is O(n*bandwidth) and a row costs
+* O(bandwidth^2) independently of the number of rows already added.
+* With bandwidth w every row has its non-zeros in w consecutive columns and R keeps the same bandwidth;
+* a row then costs O(w^2) if rows arrive sorted by their first column (O(n*w) otherwise - see BandedNormalEquations).
+* A bandwidth of n (default) gives the dense case. Several right hand sides share the rotations.
+**/
+class LeastSquares
+{
+protected:
+    unsigned int n_, w_, k_;
+    // row i of R holds columns i..i+w-1
+    vector<double> R_;
+    // Q^T b (n per right hand side)
+    vector<double> qb_;
+    vector<double> rss_;
+    vector<double> row_, rhs_;
+    size_t rows_;
+public:
+    /**
+    * Constructor
+    * @param n - number of unknowns
+    * @param rhs - number of right hand sides
+    * @param bandwidth - non-zeros per row (0 for dense)
+    **/
+    LeastSquares(const unsigned int& n = 0, const unsigned int& rhs = 1, const unsigned int& bandwidth = 0)
+    {
+        resize(n, rhs, bandwidth);
+    }
+
+    /**
+    * Reset to an empty problem
+    * @param n - number of unknowns
+    * @param rhs - number of right hand sides
+    * @param bandwidth - non-zeros per row (0 for dense)
+    **/
+    void resize(const unsigned int& n, const unsigned int& rhs = 1, const unsigned int& bandwidth = 0)
+    {
+        n_ = n;
+        k_ = std::max(rhs, 1u);
+        w_ = (bandwidth==0 || bandwidth>n)? n : bandwidth;
+        R_.assign(size_t(n_)*w_, 0.0);
+        qb_.assign(size_t(n_)*k_, 0.0);
+        rss_.assign(k_, 0.0);
+        row_.assign(w_+1, 0.0);
+        rhs_.assign(k_, 0.0);
+        rows_ = 0;
+    }
+
+    /**
+    * Remove all rows (keeps the sizes)
+    **/
+    void clear()
+    {
+        std::fill(R_.begin(), R_.end(), 0.0);
+        std::fill(qb_.begin(), qb_.end(), 0.0);
+        std::fill(rss_.begin(), rss_.end(), 0.0);
+        rows_ = 0;
+    }
+
+    unsigned int unknowns() const {return n_;}
+
+    unsigned int bandwidth() const {return w_;}
+
+    size_t rows() const {return rows_;}
+
+    /**
+    * Add a row
+    * @param first - column of a[0]
+    * @param a - row values (bandwidth values, columns past n are ignored)
+    * @param b - right hand side values (rhs values)
+    * @param weight - weight of the row in the squared residual
+    **/
+    void addRow(const unsigned int& first, const double* a, const double* b, const double& weight = 1.0)
+    {
+        if(first>=n_ || weight<=0.0)
+            return;
+        double sw = std::sqrt(weight);
+        unsigned int m = std::min(w_, n_-first);
+        // row_[j] holds column c+j while rotating against row c of R
+        for(unsigned int j=0;j<m;j++)
+            row_[j] = sw*a[j];
+        for(unsigned int j=m;j<=w_;j++)
+            row_[j] = 0.0;
+        for(unsigned int r=0;r<k_;r++)
+            rhs_[r] = sw*b[r];
+        rows_++;
+
+        for(unsigned int c=first;c<n_;c++)
+        {
+            double v = row_[0];
+            if(v!=0.0)
+            {
+                double* Rc = &R_[size_t(c)*w_];
+                unsigned int mc = std::min(w_, n_-c);
+                double rho = std::sqrt(Rc[0]*Rc[0]+v*v);
+                double cs = Rc[0]/rho, sn = v/rho;
+                for(unsigned int j=0;j<mc;j++)
+                {
+                    double rj = Rc[j], vj = row_[j];
+                    Rc[j] = cs*rj+sn*vj;
+                    row_[j] = -sn*rj+cs*vj;
+                }
+                for(unsigned int r=0;r<k_;r++)
+                {
+                    double q = qb_[size_t(r)*n_+c];
+                    qb_[size_t(r)*n_+c] = cs*q+sn*rhs_[r];
+                    rhs_[r] = -sn*q+cs*rhs_[r];
+                }
+                // eliminated exactly (do not carry round-off along the band)
+                row_[0] = 0.0;
+            }
+            // shift to the next column
+            bool any = false;
+            for(unsigned int j=0;j<w_;j++)
+            {
+                row_[j] = row_[j+1];
+                any = any || row_[j]!=0.0;
+            }
+            row_[w_] = 0.0;
+            if(!any)
+                break;
+        }
+        for(unsigned int r=0;r<k_;r++)
+            rss_[r] += rhs_[r]*rhs_[r];
+    }
+
+    /**
+    * Add a dense row (only valid for the dense case)
+    * @param a - row values (n values)
+    * @param b - right hand side values (rhs values)
+    * @param weight - weight of the row
+    **/
+    void addRow(const double* a, const double* b, const double& weight = 1.0)
+    {
+        unsigned int first = 0;
+        while(first<n_ && a[first]==0.0)
+            first++;
+        if(first==n_)
+        {
+            for(unsigned int r=0;r<k_;r++)
+                rss_[r] += weight*b[r]*b[r];
+            rows_++;
+            return;
+        }
+        addRow(first, a+first, b, weight);
+    }
+
+    /**
+    * Solve R x = Q^T b
+    * @param x - solution (n values per right hand side, one right hand side after the other)
+    * @return bool - false if the problem is rank deficient (too few or degenerate rows)
+    **/
+    bool solve(double* x) const
+    {
+        double scale = 0.0;
+        for(unsigned int i=0;i<n_;i++)
+            scale = std::max(scale, std::abs(R_[size_t(i)*w_]));
+        for(unsigned int i=0;i<n_;i++)
+            if(!(std::abs(R_[size_t(i)*w_])>1e-13*scale))
+                return false;
+        for(unsigned int r=0;r<k_;r++)
+        {
+            double* xr = x+size_t(r)*n_;
+            for(unsigned int i=n_;i>0;i--)
+            {
+                const double* Ri = &R_[size_t(i-1)*w_];
+                double s = qb_[size_t(r)*n_+i-1];
+                unsigned int mi = std::min(w_, n_-i+1);
+                for(unsigned int j=1;j<mi;j++)
+                    s -= Ri[j]*xr[i-1+j];
+                xr[i-1] = s/Ri[0];
+            }
+        }
+        return true;
+    }
+
+    /**
+    * Sum of the (weighted) squared residuals of the least squares solution
+    * @param r - right hand side
+    * @return double - residual
+    **/
+    double residual(const unsigned int& r = 0) const {return rss_[r];}
+};
+
+/**
+* BandedNormalEquations Class
+* Streaming least squares through the normal equations A^T A x = A^T b for rows with w consecutive
+* non-zeros (B-spline bases): only the w diagonals of A^T A are stored, a row costs O(w^2) in any order
+* and the solve is a banded Cholesky factorization in O(n*w^2).
+* The condition number is squared compared to QR - fine for well conditioned bases like B-splines.
+**/
+class BandedNormalEquations
+{
+protected:
+    unsigned int n_, w_, k_;
+    // row i holds columns i..i+w-1 of the upper triangle of A^T A
+    vector<double> M_;
+    vector<double> atb_;
+    vector<double> btb_;
+    size_t rows_;
+public:
+    /**
+    * Constructor
+    * @param n - number of unknowns
+    * @param rhs - number of right hand sides
+    * @param bandwidth - non-zeros per row (0 for dense)
+    **/
+    BandedNormalEquations(const unsigned int& n = 0, const unsigned int& rhs = 1, const unsigned int& bandwidth = 0)
+    {
+        resize(n, rhs, bandwidth);
+    }
+
+    void resize(const unsigned int& n, const unsigned int& rhs = 1, const unsigned int& bandwidth = 0)
+    {
+        n_ = n;
+        k_ = std::max(rhs, 1u);
+        w_ = (bandwidth==0 || bandwidth>n)? n : bandwidth;
+        M_.assign(size_t(n_)*w_, 0.0);
+        atb_.assign(size_t(n_)*k_, 0.0);
+        btb_.assign(k_, 0.0);
+        rows_ = 0;
+    }
+
+    void clear()
+    {
+        std::fill(M_.begin(), M_.end(), 0.0);
+        std::fill(atb_.begin(), atb_.end(), 0.0);
+        std::fill(btb_.begin(), btb_.end(), 0.0);
+        rows_ = 0;
+    }
+
+    unsigned int unknowns() const {return n_;}
+
+    unsigned int bandwidth() const {return w_;}
+
+    size_t rows() const {return rows_;}
+
+    /**
+    * Add a row
+    * @param first - column of a[0]
+    * @param a - row values (bandwidth values, columns past n are ignored)
+    * @param b - right hand side values (rhs values)
+    * @param weight - weight of the row in the squared residual
+    **/
+    void addRow(const unsigned int& first, const double* a, const double* b, const double& weight = 1.0)
+    {
+        if(first>=n_ || weight<=0.0)
+            return;
+        unsigned int m = std::min(w_, n_-first);
+        for(unsigned int p=0;p<m;p++)
+        {
+            double wa = weight*a[p];
+            double* Mp = &M_[size_t(first+p)*w_];
+            for(unsigned int q=p;q<m;q++)
+                Mp[q-p] += wa*a[q];
+            for(unsigned int r=0;r<k_;r++)
+                atb_[size_t(r)*n_+first+p] += wa*b[r];
+        }
+        for(unsigned int r=0;r<k_;r++)
+            btb_[r] += weight*b[r]*b[r];
+        rows_++;
+    }
+
+    /**
+    * Solve the normal equations (banded Cholesky)
+    * @param x - solution (n values per right hand side, one right hand side after the other)
+    * @return bool - false if the problem is rank deficient
+    **/
+    bool solve(double* x) const
+    {
+        const unsigned int w = w_;
+        vector<double> U(M_);
+        double scale = 0.0;
+        for(unsigned int i=0;i<n_;i++)
+            scale = std::max(scale, M_[size_t(i)*w]);
+        for(unsigned int i=0;i<n_;i++)
+        {
+            double* Ui = &U[size_t(i)*w];
+            unsigned int k0 = (i+1>w)? i+1-w : 0;
+            for(unsigned int j=i;j<std::min(i+w, n_);j++)
+            {
+                double s = Ui[j-i];
+                // rows k<i with both (k,i) and (k,j) inside the band
+                unsigned int kk = (j+1>w)? std::max(k0, j+1-w) : k0;
+                for(unsigned int k=kk;k<i;k++)
+                    s -= U[size_t(k)*w+(i-k)]*U[size_t(k)*w+(j-k)];
+                if(j==i)
+                {
+                    if(!(s>1e-14*scale))
+                        return false;
+                    Ui[0] = std::sqrt(s);
+                }
+                else
+                    Ui[j-i] = s/Ui[0];
+            }
+        }
+        for(unsigned int r=0;r<k_;r++)
+        {
+            double* xr = x+size_t(r)*n_;
+            const double* br = &atb_[size_t(r)*n_];
+            for(unsigned int i=0;i<n_;i++)
+            {
+                double s = br[i];
+                unsigned int k0 = (i+1>w)? i+1-w : 0;
+                for(unsigned int k=k0;k<i;k++)
+                    s -= U[size_t(k)*w+(i-k)]*xr[k];
+                xr[i] = s/U[size_t(i)*w];
+            }
+            for(unsigned int i=n_;i>0;i--)
+            {
+                const double* Ui = &U[size_t(i-1)*w];
+                double s = xr[i-1];
+                for(unsigned int j=1;j<std::min(w, n_-i+1);j++)
+                    s -= Ui[j]*xr[i-1+j];
+                xr[i-1] = s/Ui[0];
+            }
+        }
+        return true;
+    }
+
+    /**
+    * Sum of the (weighted) squared residuals for a solution
+    * @param x - solution of that right hand side
+    * @param r - right hand side
+    * @return double - b^T b - x^T A^T b (exact at the least squares solution)
+    **/
+    double residual(const double* x, const unsigned int& r = 0) const
+    {
+        double s = btb_[r];
+        for(unsigned int i=0;i<n_;i++)
+            s -= x[i]*atb_[size_t(r)*n_+i];
+        return std::max(s, 0.0);
+    }
+};
+
+} } }
+
+#endif
@@ -22,13 +22,9 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 * Includes
 **/
 #include <geometric_tools/Math/Matrix.h>
-
-extern "C" int dgeqrf_(int *m, int *n, double *a, int *
-                       lda, double *tau, double *work, int *lwork, int *info);
-
-extern "C" int dorgqr_(int *m, int *n, int *k, double *
-                       a, int *lda, double *tau, double *work, int *lwork,
-                       int *info);
+#include <geometric_tools/Math/Kernels.h>
+#include <vector>
+#include <geometric_tools/Math/DynMatrix.h>
 
 namespace GeometricTools {
 
@@ -37,7 +33,7 @@ namespace Math {
 namespace LinearSystems {
 
 /**
-* Perform QR Decomposition
+* Perform QR Decomposition (Householder reflections): a = Q*R
 * @param a - Matrix to decompose
 * @param Q - Q Matrix --
 * @param R - R Matrix  |
@@ -46,13 +42,10 @@ namespace LinearSystems {
 template<unsigned int D>
 void QRDecomposition(const Matrix<D,D>& a, Matrix<D,D>& Q, Matrix<D,D>& R)
 {
-    Q.identity();
     R = a;
-    double* tau = new double[D];
-    int dim = int(D);
-    double* work = new double[D];
-    dgeqrf_(&dim, &dim, R.data(), &dim, tau, work, &dim, info);
-    Q = R;
+    double tau[D];
+    Kernels::qrFactor(D, D, R.data(), D, tau);
+    Kernels::qrFormQ(D, D, R.data(), D, tau, Q.data(), D);
     for(unsigned int i=0;i<D;i++)
     {
         for(unsigned int j=0;j<i;j++)
@@ -60,7 +53,52 @@ void QRDecomposition(const Matrix<D,D>& a, Matrix<D,D>& Q, Matrix<D,D>& R)
             R(i,j) = 0.0;
         }
     }
-    dorgqr_(&dim, &dim, &dim, Q.data(), &dim, tau, work, &dim, &info);
+}
+
+/**
+* Perform (blocked) QR Decomposition (Householder reflections): a = Q*R
+* @param a - Matrix to decompose (m x n)
+* @param Q - Q Matrix (m x m) --
+* @param R - R Matrix (m x n)  |
+*					   --> Pass by reference (returns)
+**/
+inline void QRDecomposition(const DynMatrix& a, DynMatrix& Q, DynMatrix& R)
+{
+    const unsigned int m = a.rows(), n = a.cols();
+    R = a;
+    std::vector<double> tau(std::min(m, n));
+    Kernels::qrFactorBlocked(m, n, R.data(), n, tau.data());
+    Q.resize(m, m);
+    Kernels::qrFormQ(m, n, R.data(), n, tau.data(), Q.data(), m);
+    for(unsigned int i=0;i<m;i++)
+    {
+        for(unsigned int j=0;j<i && j<n;j++)
+        {
+            R(i,j) = 0.0;
+        }
+    }
+}
+
+/**
+* Least squares solution of A*x = B (blocked QR Decomposition)
+* @param A - parameter Matrix (m x n, m>=n, full column rank)
+* @param B - constant Vector (m)
+* @return DynVector - solution (n), empty if A is rank deficient
+**/
+inline DynVector solveQR(const DynMatrix& A, const DynVector& B)
+{
+    const unsigned int m = A.rows(), n = A.cols();
+    if(m<n)
+        return DynVector();
+    DynMatrix qr = A;
+    std::vector<double> tau(n);
+    Kernels::qrFactorBlocked(m, n, qr.data(), n, tau.data());
+    DynVector b = B;
+    if(!Kernels::qrSolve(m, n, qr.data(), n, tau.data(), b.data()))
+        return DynVector();
+    DynVector res(n);
+    std::copy(b.data(), b.data()+n, res.data());
+    return res;
 }
 
 } } }
@@ -14,7 +14,6 @@ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVI
 INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
 OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **/
-
 #ifndef GEOMETRIC_TOOLS_MATH_LINEAR_SYSTEMS_SVD_DECOMPOSITION
 #define GEOMETRIC_TOOLS_MATH_LINEAR_SYSTEMS_SVD_DECOMPOSITION
 
@@ -22,11 +21,8 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 * Includes
 **/
 #include <geometric_tools/Math/Matrix.h>
-
-extern "C" int dgesvd_(char *jobu, char *jobvt, int *m, int *n,
-                       double *a, int *lda, double *s, double *u, int *
-                       ldu, double *vt, int *ldvt, double *work, int *lwork,
-                       int *info);
+#include <geometric_tools/Math/Kernels.h>
+#include <geometric_tools/Math/DynMatrix.h>
 
 namespace GeometricTools {
 
@@ -35,31 +31,60 @@ namespace Math {
 namespace LinearSystems {
 
 /**
-* Perform SVD Decomposition
+* Perform thin SVD Decomposition (one-sided Jacobi, no heap allocation): a = U*diag(s)*V^T
+* @param a - Matrix to decompose (R>=C)
+* @param U - U Matrix (orthonormal columns) --
+* @param s - singular values (decreasing)    |
+* @param V - V Matrix (orthogonal)           |
+*					   --> Pass by reference (returns)
+* @return bool - false if the iteration did not converge
+**/
+template<unsigned int R, unsigned int C>
+bool SVDDecomposition(const Matrix<R,C>& a, Matrix<R,C>& U, Vector<C>& s, Matrix<C,C>& V)
+{
+    static_assert(R>=C, "SVDDecomposition needs at least as many rows as columns (decompose the transpose)");
+    U = a;
+    return Kernels::jacobiSVD(R, C, U.data(), C, s.data(), V.data(), C);
+}
+
+/**
+* Perform SVD Decomposition (one-sided Jacobi, no heap allocation): a = U*S*V^T
 * @param a - Matrix to decompose
-* @param U - U Matrix --
-* @param S - S Matrix
-* @param V - V Matrix  |
+* @param U - U Matrix (orthogonal)                    --
+* @param S - S Matrix (diagonal, decreasing entries)   |
+* @param V - V Matrix (orthogonal)                     |
 *					   --> Pass by reference (returns)
 **/
 template<unsigned int D>
 void SVDDecomposition(const Matrix<D,D>& a, Matrix<D,D>& U, Matrix<D,D>& S, Matrix<D,D>& V)
 {
-    Matrix<D,D> tmp = a;
-    U.identity();
-    S.identity();
-    V.identity();
-    double* work = new double[D];
-    int dim = int(D), info, lwork = std::max(4*D, 5*D);
-    char job = 'S';
-    //TODO: DOES NOT WORK
-    dgesvd_(&job, &job, &dim, &dim, tmp.data(), &dim, S.data(), U.data(), &dim, V.data(), &dim, work, &lwork, &info);
-    U = U.transpose();
-    S = S.transpose();
-    for(unsigned int i=1;i<D;i++) {
-        S(i,i) = S(0,i);
-        S(0,i) = 0.0;
-    }
+    Vector<D> s;
+    SVDDecomposition(a, U, s, V);
+    S.zero();
+    for(unsigned int i=0;i<D;i++)
+        S(i,i) = s[i];
+}
+
+/**
+* Perform thin SVD Decomposition (one-sided Jacobi): a = U*diag(s)*V^T
+* @param a - Matrix to decompose (m x n)
+* @param U - U Matrix (m x k, orthonormal columns) --
+* @param s - singular values (k, decreasing)        |
+* @param V - V Matrix (n x k, orthonormal columns)  |
+*					   --> Pass by reference (returns) with k = min(m,n)
+* @return bool - false if the iteration did not converge
+**/
+inline bool SVDDecomposition(const DynMatrix& a, DynMatrix& U, DynVector& s, DynMatrix& V)
+{
+    // a wide matrix is decomposed through its transpose: a^T = V*diag(s)*U^T
+    const bool wide = a.rows()<a.cols();
+    DynMatrix& X = wide ? V : U;
+    DynMatrix& Y = wide ? U : V;
+    X = wide ? a.transpose() : a;
+    const unsigned int m = X.rows(), n = X.cols();
+    s.resize(n);
+    Y.resize(n, n);
+    return Kernels::jacobiSVD(m, n, X.data(), n, s.data(), Y.data(), n);
 }
 
 } } }
@@ -0,0 +1,601 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#ifndef GEOMETRIC_TOOLS_MATH_LINEAR_SYSTEMS_SOLVE_CHOLESKY_H
+#define GEOMETRIC_TOOLS_MATH_LINEAR_SYSTEMS_SOLVE_CHOLESKY_H
+
+/**
+* Includes
+**/
+#include <vector>
+#include <cmath>
+#include <geometric_tools/Math/Matrix.h>
+#include <geometric_tools/Math/Kernels.h>
+#include <geometric_tools/Math/DynMatrix.h>
+#include <geometric_tools/Misc/Parallel.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/**
+* Largest dimension handled by the straight-line fixed size Cholesky factorization; larger systems use the blocked kernel
+**/
+#ifndef GEOMETRIC_TOOLS_CHOLESKY_UNROLL
+#define GEOMETRIC_TOOLS_CHOLESKY_UNROLL 8
+#endif
+
+using std::vector;
+
+namespace GeometricTools {
+
+namespace Math {
+
+namespace LinearSystems {
+
+/**
+* Fixed size Cholesky factorization, in place (row-major D x D): A = L*L^T
+* One instantiation per column J, so every loop has a compile time trip count and the whole
+* factorization is straight-line code
+**/
+template<unsigned int D, unsigned int J = 0>
+struct CholeskyColumns
+{
+    /**
+    * Factor columns J..D-1
+    * @param A - symmetric positive definite matrix (lower triangle overwritten by L)
+    * @return bool - false if A is not positive definite
+    **/
+    static bool factor(double* A)
+    {
+        double d = A[J*D+J];
+        for(unsigned int p=0;p<J;p++)
+            d -= A[J*D+p]*A[J*D+p];
+        if(!(d>0.0))
+            return false;
+        d = std::sqrt(d);
+        A[J*D+J] = d;
+        const double inv = 1.0/d;
+        for(unsigned int i=J+1;i<D;i++)
+        {
+            double s = A[i*D+J];
+            for(unsigned int p=0;p<J;p++)
+                s -= A[i*D+p]*A[J*D+p];
+            A[i*D+J] = s*inv;
+        }
+        return CholeskyColumns<D,J+1>::factor(A);
+    }
+};
+
+template<unsigned int D>
+struct CholeskyColumns<D,D>
+{
+    static bool factor(double*)
+    {
+        return true;
+    }
+};
+
+/**
+* Cholesky factorization of a compile time dimension, in place (row-major D x D)
+* Straight-line kernel up to GEOMETRIC_TOOLS_CHOLESKY_UNROLL, blocked kernel above
+* @param A - symmetric positive definite matrix (lower triangle overwritten by L)
+* @return bool - false if A is not positive definite
+**/
+template<unsigned int D>
+inline bool choleskyFactorFixed(double* A)
+{
+    if(D<=GEOMETRIC_TOOLS_CHOLESKY_UNROLL)
+        return CholeskyColumns<(D<=GEOMETRIC_TOOLS_CHOLESKY_UNROLL)?D:0>::factor(A);
+    return Kernels::choleskyFactor(D, A, D);
+}
+
+/**
+* Perform Cholesky Decomposition: a = L*L^T
+* Straight-line fixed size kernel up to GEOMETRIC_TOOLS_CHOLESKY_UNROLL, blocked kernel above
+* @param a - symmetric positive definite Matrix to decompose (only the lower triangle is read)
+* @param L - lower triangular L Matrix (pass by reference - returns)
+* @return bool - false if a is not positive definite
+**/
+template<unsigned int D>
+bool CholeskyDecomposition(const Matrix<D,D>& a, Matrix<D,D>& L)
+{
+    L = a;
+    bool res = choleskyFactorFixed<D>(L.data());
+    for(unsigned int i=0;i<D;i++)
+        for(unsigned int j=i+1;j<D;j++)
+            L(i,j) = 0.0;
+    return res;
+}
+
+/**
+* Solve L*L^T*x = B for a factor of CholeskyDecomposition
+* @param L - lower triangular factor
+* @param B - constant Vector
+* @return Vector<D> - solution
+**/
+template<unsigned int D>
+Vector<D> choleskySolve(const Matrix<D,D>& L, const Vector<D>& B)
+{
+    Vector<D> res = B;
+    Kernels::choleskySolve(D, L.data(), D, res.data());
+    return res;
+}
+
+/**
+* Solve symmetric positive definite Linear System using Cholesky Decomposition
+* Straight-line fixed size kernel up to GEOMETRIC_TOOLS_CHOLESKY_UNROLL, blocked kernel above
+* @param A - parameter Matrix (only the lower triangle is read)
+* @param B - constant Vector
+* @return Vector<D> - solution (B if A is not positive definite)
+**/
+template<unsigned int D>
+Vector<D> solveCholesky(const Matrix<D,D>& A, const Vector<D>& B)
+{
+    Matrix<D,D> L = A;
+    Vector<D> res = B;
+    if(!choleskyFactorFixed<D>(L.data()))
+        return res;
+    Kernels::choleskySolve(D, L.data(), D, res.data());
+    return res;
+}
+
+/**
+* Rank-1 update of a Cholesky factor: L*L^T+x*x^T = L'*L'^T in O(D^2) (adding a row x to a least squares problem)
+* @param L - lower triangular factor (pass by reference - returns L')
+* @param x - update Vector
+**/
+template<unsigned int D>
+void choleskyUpdate(Matrix<D,D>& L, Vector<D> x)
+{
+    Kernels::choleskyRank1(D, L.data(), D, x.data(), 1.0);
+}
+
+/**
+* Rank-1 downdate of a Cholesky factor: L*L^T-x*x^T = L'*L'^T in O(D^2) (removing a row x from a least squares problem)
+* @param L - lower triangular factor (pass by reference - returns L', unchanged on failure)
+* @param x - downdate Vector
+* @return bool - false if L*L^T-x*x^T is not positive definite
+**/
+template<unsigned int D>
+bool choleskyDowndate(Matrix<D,D>& L, Vector<D> x)
+{
+    Matrix<D,D> tmp = L;
+    if(!Kernels::choleskyRank1(D, tmp.data(), D, x.data(), -1.0))
+        return false;
+    L = tmp;
+    return true;
+}
+
+/**
+* Perform LDL^T Decomposition (no square roots, also valid for symmetric indefinite matrices without zero pivots): a = L*D*L^T
+* @param a - symmetric Matrix to decompose (only the lower triangle is read)
+* @param L - unit lower triangular L Matrix --
+* @param d - diagonal of D                  |
+*					   --> Pass by reference (returns)
+* @return bool - false if a zero pivot was met
+**/
+template<unsigned int D>
+bool LDLTDecomposition(const Matrix<D,D>& a, Matrix<D,D>& L, Vector<D>& d)
+{
+    L = a;
+    bool res = Kernels::ldltFactor(D, L.data(), D, d.data());
+    for(unsigned int i=0;i<D;i++)
+    {
+        L(i,i) = 1.0;
+        for(unsigned int j=i+1;j<D;j++)
+            L(i,j) = 0.0;
+    }
+    return res;
+}
+
+/**
+* Solve L*D*L^T*x = B for the factors of LDLTDecomposition
+* @param L - unit lower triangular factor
+* @param d - diagonal of D
+* @param B - constant Vector
+* @return Vector<D> - solution
+**/
+template<unsigned int D>
+Vector<D> ldltSolve(const Matrix<D,D>& L, const Vector<D>& d, const Vector<D>& B)
+{
+    Vector<D> res = B;
+    Kernels::ldltSolve(D, L.data(), D, d.data(), res.data());
+    return res;
+}
+
+/**
+* Solve symmetric Linear System using LDL^T Decomposition
+* @param A - parameter Matrix (only the lower triangle is read)
+* @param B - constant Vector
+* @return Vector<D> - solution (B if a zero pivot was met)
+**/
+template<unsigned int D>
+Vector<D> solveLDLT(const Matrix<D,D>& A, const Vector<D>& B)
+{
+    Matrix<D,D> L = A;
+    Vector<D> d, res = B;
+    if(!Kernels::ldltFactor(D, L.data(), D, d.data()))
+        return res;
+    Kernels::ldltSolve(D, L.data(), D, d.data(), res.data());
+    return res;
+}
+
+/**
+* Rank-1 modification of an LDL^T factorization: L*D*L^T+alpha*x*x^T = L'*D'*L'^T in O(D^2) (alpha<0 downdates)
+* @param L - unit lower triangular factor --
+* @param d - diagonal of D                  |
+*					   --> Pass by reference (returns L' and D', unchanged on failure)
+* @param x - modification Vector
+* @param alpha - scale of the modification
+* @return bool - false if a pivot of D' vanished
+**/
+template<unsigned int D>
+bool ldltUpdate(Matrix<D,D>& L, Vector<D>& d, Vector<D> x, const double& alpha = 1.0)
+{
+    Matrix<D,D> tmpL = L;
+    Vector<D> tmpd = d;
+    if(!Kernels::ldltRank1(D, tmpL.data(), D, tmpd.data(), x.data(), alpha))
+        return false;
+    L = tmpL;
+    d = tmpd;
+    return true;
+}
+
+/**
+* CholeskyBatch Class
+* Many small symmetric positive definite systems of the same dimension solved together
+* Storage is interleaved by tiles of W=4 systems (Structure of Arrays inside a tile): element (i,j) of the W systems
+* of a tile is contiguous, so the factorization and the substitutions run with the system index in the innermost,
+* fixed length loop (one AVX2 register when compiled with -mavx2) and a tile stays in L1
+* Re-use it between batches - set() overwrites a system, solve() factors and solves all of them
+**/
+template<unsigned int D>
+class CholeskyBatch
+{
+protected:
+    static const unsigned int W = 4;
+    // elements of a tile: lower triangle of the matrices, then right hand sides (solutions after solve)
+    static const unsigned int T = D*(D+1)/2;
+    static const unsigned int E = T+D;
+    // element e of system s at ((s/W)*E+e)*W+s%W
+    vector<double> data_;
+    vector<unsigned char> ok_;
+    unsigned int count_;
+
+    static unsigned int tri(const unsigned int& i, const unsigned int& j) {return i*(i+1)/2+j;}
+
+    double& at(const unsigned int& s, const unsigned int& e) {return data_[(size_t(s/W)*E+e)*W+s%W];}
+    double at(const unsigned int& s, const unsigned int& e) const {return data_[(size_t(s/W)*E+e)*W+s%W];}
+
+    /**
+    * Factor and solve the W systems of a tile
+    * The diagonal of the factors is stored inverted (multiplications instead of divisions in the substitutions)
+    **/
+#ifdef __AVX2__
+    static __m256d mulSub(const __m256d& acc, const __m256d& a, const __m256d& b)
+    {
+#ifdef __FMA__
+        return _mm256_fnmadd_pd(a, b, acc);
+#else
+        return _mm256_sub_pd(acc, _mm256_mul_pd(a, b));
+#endif
+    }
+
+    void solveTile(double* a, unsigned char* ok)
+    {
+        double* x = a+T*W;
+        const __m256d zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+        __m256d good = _mm256_cmp_pd(zero, zero, _CMP_EQ_OQ);
+        for(unsigned int j=0;j<D;j++)
+        {
+            __m256d d = _mm256_loadu_pd(a+tri(j,j)*W);
+            for(unsigned int p=0;p<j;p++)
+            {
+                const __m256d l = _mm256_loadu_pd(a+tri(j,p)*W);
+                d = mulSub(d, l, l);
+            }
+            // a non positive definite system gets a unit pivot (no NaN) and is flagged
+            const __m256d pos = _mm256_cmp_pd(d, zero, _CMP_GT_OQ);
+            good = _mm256_and_pd(good, pos);
+            d = _mm256_div_pd(one, _mm256_sqrt_pd(_mm256_blendv_pd(one, d, pos)));
+            _mm256_storeu_pd(a+tri(j,j)*W, d);
+            for(unsigned int i=j+1;i<D;i++)
+            {
+                __m256d acc = _mm256_loadu_pd(a+tri(i,j)*W);
+                for(unsigned int p=0;p<j;p++)
+                    acc = mulSub(acc, _mm256_loadu_pd(a+tri(i,p)*W), _mm256_loadu_pd(a+tri(j,p)*W));
+                _mm256_storeu_pd(a+tri(i,j)*W, _mm256_mul_pd(acc, d));
+            }
+        }
+        // L*y = b
+        for(unsigned int i=0;i<D;i++)
+        {
+            __m256d acc = _mm256_loadu_pd(x+i*W);
+            for(unsigned int k=0;k<i;k++)
+                acc = mulSub(acc, _mm256_loadu_pd(a+tri(i,k)*W), _mm256_loadu_pd(x+k*W));
+            _mm256_storeu_pd(x+i*W, _mm256_mul_pd(acc, _mm256_loadu_pd(a+tri(i,i)*W)));
+        }
+        // L^T*x = y
+        for(unsigned int i=D;i>0;i--)
+        {
+            __m256d acc = _mm256_loadu_pd(x+(i-1)*W);
+            for(unsigned int k=i;k<D;k++)
+                acc = mulSub(acc, _mm256_loadu_pd(a+tri(k,i-1)*W), _mm256_loadu_pd(x+k*W));
+            _mm256_storeu_pd(x+(i-1)*W, _mm256_mul_pd(acc, _mm256_loadu_pd(a+tri(i-1,i-1)*W)));
+        }
+        const int mask = _mm256_movemask_pd(good);
+        for(unsigned int s=0;s<W;s++)
+            ok[s] = (mask>>s)&1;
+    }
+#else
+    void solveTile(double* a, unsigned char* ok)
+    {
+        double* x = a+T*W;
+        for(unsigned int j=0;j<D;j++)
+        {
+            double* ajj = a+tri(j,j)*W;
+            for(unsigned int p=0;p<j;p++)
+            {
+                const double* ajp = a+tri(j,p)*W;
+                for(unsigned int s=0;s<W;s++)
+                    ajj[s] -= ajp[s]*ajp[s];
+            }
+            // a non positive definite system gets a unit pivot (no NaN) and is flagged
+            for(unsigned int s=0;s<W;s++)
+            {
+                const bool good = ajj[s]>0.0;
+                ok[s] = ok[s] && good;
+                ajj[s] = good ? 1.0/std::sqrt(ajj[s]) : 1.0;
+            }
+            for(unsigned int i=j+1;i<D;i++)
+            {
+                double* aij = a+tri(i,j)*W;
+                for(unsigned int p=0;p<j;p++)
+                {
+                    const double* aip = a+tri(i,p)*W;
+                    const double* ajp = a+tri(j,p)*W;
+                    for(unsigned int s=0;s<W;s++)
+                        aij[s] -= aip[s]*ajp[s];
+                }
+                for(unsigned int s=0;s<W;s++)
+                    aij[s] *= ajj[s];
+            }
+        }
+        // L*y = b
+        for(unsigned int i=0;i<D;i++)
+        {
+            double* xi = x+i*W;
+            for(unsigned int k=0;k<i;k++)
+            {
+                const double* aik = a+tri(i,k)*W;
+                const double* xk = x+k*W;
+                for(unsigned int s=0;s<W;s++)
+                    xi[s] -= aik[s]*xk[s];
+            }
+            const double* aii = a+tri(i,i)*W;
+            for(unsigned int s=0;s<W;s++)
+                xi[s] *= aii[s];
+        }
+        // L^T*x = y
+        for(unsigned int i=D;i>0;i--)
+        {
+            double* xi = x+(i-1)*W;
+            for(unsigned int k=i;k<D;k++)
+            {
+                const double* aki = a+tri(k,i-1)*W;
+                const double* xk = x+k*W;
+                for(unsigned int s=0;s<W;s++)
+                    xi[s] -= aki[s]*xk[s];
+            }
+            const double* aii = a+tri(i-1,i-1)*W;
+            for(unsigned int s=0;s<W;s++)
+                xi[s] *= aii[s];
+        }
+    }
+#endif
+
+public:
+    /**
+    * Constructor
+    * @param count - number of systems
+    **/
+    CholeskyBatch(const unsigned int& count = 0)
+    {
+        resize(count);
+    }
+
+    void resize(const unsigned int& count)
+    {
+        count_ = count;
+        const unsigned int tiles = (count_+W-1)/W;
+        data_.assign(size_t(tiles)*E*W, 0.0);
+        // the padding systems of the last tile are identities
+        for(unsigned int s=count_;s<tiles*W;s++)
+            for(unsigned int i=0;i<D;i++)
+                at(s, tri(i,i)) = 1.0;
+        ok_.assign(size_t(tiles)*W, 0);
+    }
+
+    unsigned int size() const {return count_;}
+
+    /**
+    * Set a system
+    * @param s - index of the system
+    * @param A - symmetric positive definite Matrix (only the lower triangle is read)
+    * @param B - constant Vector
+    **/
+    void set(const unsigned int& s, const Matrix<D,D>& A, const Vector<D>& B)
+    {
+        for(unsigned int i=0;i<D;i++)
+        {
+            for(unsigned int j=0;j<=i;j++)
+                at(s, tri(i,j)) = A(i,j);
+            at(s, T+i) = B[i];
+        }
+    }
+
+    /**
+    * Factor and solve all the systems (the factors overwrite the matrices)
+    * @param threads - number of threads (0 means all the hardware threads)
+    * @return unsigned int - number of positive definite systems
+    **/
+    unsigned int solve(const unsigned int& threads = 0)
+    {
+        std::fill(ok_.begin(), ok_.end(), 1);
+        const unsigned int tiles = (count_+W-1)/W;
+        Helper::parallelChunks(0, tiles, [&](unsigned int, unsigned int b, unsigned int e) {
+            for(unsigned int t=b;t<e;t++)
+                solveTile(&data_[size_t(t)*E*W], &ok_[size_t(t)*W]);
+        }, threads);
+        unsigned int res = 0;
+        for(unsigned int s=0;s<count_;s++)
+            res += ok_[s];
+        return res;
+    }
+
+    /**
+    * Solution of a system (after solve)
+    * @param s - index of the system
+    * @return Vector<D> - the solution (meaningless if ok(s) is false)
+    **/
+    Vector<D> solution(const unsigned int& s) const
+    {
+        Vector<D> res;
+        for(unsigned int i=0;i<D;i++)
+            res[i] = at(s, T+i);
+        return res;
+    }
+
+    /**
+    * @param s - index of the system
+    * @return bool - true if the system was positive definite (after solve)
+    **/
+    bool ok(const unsigned int& s) const {return ok_[s]!=0;}
+};
+
+/**
+* Solve many symmetric positive definite Linear Systems of the same dimension (see CholeskyBatch)
+* @param A - parameter Matrices (only the lower triangles are read)
+* @param B - constant Vectors
+* @param threads - number of threads (0 means all the hardware threads)
+* @return vector<Vector<D> > - solutions (B[i] for the systems that are not positive definite)
+**/
+template<unsigned int D>
+vector<Vector<D> > solveCholesky(const vector<Matrix<D,D> >& A, const vector<Vector<D> >& B, const unsigned int& threads = 0)
+{
+    CholeskyBatch<D> batch(A.size());
+    for(unsigned int s=0;s<A.size();s++)
+        batch.set(s, A[s], B[s]);
+    batch.solve(threads);
+    vector<Vector<D> > res(A.size());
+    for(unsigned int s=0;s<A.size();s++)
+        res[s] = batch.ok(s) ? batch.solution(s) : B[s];
+    return res;
+}
+
+/**
+* Perform (blocked) Cholesky Decomposition: a = L*L^T
+* @param a - symmetric positive definite Matrix to decompose (n x n)
+* @param L - lower triangular L Matrix (pass by reference - returns)
+* @return bool - false if a is not positive definite
+**/
+inline bool CholeskyDecomposition(const DynMatrix& a, DynMatrix& L)
+{
+    const unsigned int n = a.rows();
+    L = a;
+    bool res = Kernels::choleskyFactor(n, L.data(), n);
+    for(unsigned int i=0;i<n;i++)
+        for(unsigned int j=i+1;j<n;j++)
+            L(i,j) = 0.0;
+    return res;
+}
+
+/**
+* Solve symmetric positive definite Linear System using (blocked) Cholesky Decomposition
+* @param A - parameter Matrix (n x n)
+* @param B - constant Vector (n)
+* @return DynVector - solution (B if A is not positive definite)
+**/
+inline DynVector solveCholesky(const DynMatrix& A, const DynVector& B)
+{
+    const unsigned int n = A.rows();
+    DynMatrix L = A;
+    DynVector res = B;
+    if(!Kernels::choleskyFactor(n, L.data(), n))
+        return res;
+    Kernels::choleskySolve(n, L.data(), n, res.data());
+    return res;
+}
+
+/**
+* Rank-1 update (sigma=1) or downdate (sigma=-1) of a Cholesky factor: L*L^T+sigma*x*x^T = L'*L'^T in O(n^2)
+* @param L - lower triangular factor (pass by reference - returns L', unchanged on failure)
+* @param x - modification Vector
+* @param sigma - 1 for an update, -1 for a downdate
+* @return bool - false if the downdated matrix is not positive definite
+**/
+inline bool choleskyUpdate(DynMatrix& L, DynVector x, const double& sigma = 1.0)
+{
+    DynMatrix tmp = L;
+    if(!Kernels::choleskyRank1(L.rows(), tmp.data(), L.cols(), x.data(), sigma))
+        return false;
+    L = std::move(tmp);
+    return true;
+}
+
+/**
+* Perform LDL^T Decomposition: a = L*D*L^T
+* @param a - symmetric Matrix to decompose (n x n, only the lower triangle is read)
+* @param L - unit lower triangular L Matrix --
+* @param d - diagonal of D                  |
+*					   --> Pass by reference (returns)
+* @return bool - false if a zero pivot was met
+**/
+inline bool LDLTDecomposition(const DynMatrix& a, DynMatrix& L, DynVector& d)
+{
+    const unsigned int n = a.rows();
+    L = a;
+    d.resize(n);
+    bool res = Kernels::ldltFactor(n, L.data(), n, d.data());
+    for(unsigned int i=0;i<n;i++)
+    {
+        L(i,i) = 1.0;
+        for(unsigned int j=i+1;j<n;j++)
+            L(i,j) = 0.0;
+    }
+    return res;
+}
+
+/**
+* Solve symmetric Linear System using LDL^T Decomposition
+* @param A - parameter Matrix (n x n, only the lower triangle is read)
+* @param B - constant Vector (n)
+* @return DynVector - solution (B if a zero pivot was met)
+**/
+inline DynVector solveLDLT(const DynMatrix& A, const DynVector& B)
+{
+    const unsigned int n = A.rows();
+    DynMatrix L = A;
+    DynVector d(n), res = B;
+    if(!Kernels::ldltFactor(n, L.data(), n, d.data()))
+        return res;
+    Kernels::ldltSolve(n, L.data(), n, d.data(), res.data());
+    return res;
+}
+
+} } }
+
+#endif
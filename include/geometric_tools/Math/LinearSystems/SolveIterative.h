@@ -0,0 +1,457 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#ifndef GEOMETRIC_TOOLS_MATH_LINEAR_SYSTEMS_SOLVE_ITERATIVE_H
+#define GEOMETRIC_TOOLS_MATH_LINEAR_SYSTEMS_SOLVE_ITERATIVE_H
+
+/**
+* Includes
+**/
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <geometric_tools/Math/DynVector.h>
+#include <geometric_tools/Math/SparseMatrix.h>
+
+using std::vector;
+
+namespace GeometricTools {
+
+namespace Math {
+
+namespace LinearSystems {
+
+/**
+* IterativeInfo Struct
+* Outcome of an iterative solver
+**/
+struct IterativeInfo
+{
+    // number of iterations performed
+    unsigned int iterations;
+    // final relative residual |b-A*x|/|b| (as tracked by the recurrence)
+    double residual;
+    // true if residual <= tolerance
+    bool converged;
+};
+
+/**
+* Identity Preconditioner Class
+* z = r (no preconditioning)
+**/
+class IdentityPreconditioner
+{
+public:
+    void apply(const DynVector& r, DynVector& z) const
+    {
+        std::copy(r.data(), r.data()+r.size(), z.data());
+    }
+};
+
+/**
+* Jacobi Preconditioner Class
+* z = diag(A)^-1 * r - cheap, and enough when the matrix is strongly diagonally dominant
+**/
+class JacobiPreconditioner
+{
+protected:
+    // inverse of the diagonal (1 where the diagonal is 0)
+    DynVector inv_;
+
+public:
+    /**
+    * Constructor
+    * @param A - square sparse Matrix
+    **/
+    explicit JacobiPreconditioner(const SparseMatrix& A): inv_(A.diagonal())
+    {
+        for(size_t i=0;i<inv_.size();i++)
+            inv_[i] = (inv_[i]!=0.0)? 1.0/inv_[i] : 1.0;
+    }
+
+    void apply(const DynVector& r, DynVector& z) const
+    {
+        const size_t n = r.size();
+        for(size_t i=0;i<n;i++)
+            z[i] = inv_[i]*r[i];
+    }
+};
+
+/**
+* Incomplete Cholesky IC(0) Preconditioner Class
+* A ~ L*L^T where L keeps the sparsity pattern of the lower triangle of A (no fill-in)
+* For symmetric positive definite A; if the factorization breaks down (a pivot <= 0) it is retried on
+* A + shift*diag(A) with a growing shift, and falls back to Jacobi scaling as a last resort
+**/
+class IC0Preconditioner
+{
+protected:
+    // lower triangular factor (the diagonal is the last element of every row)
+    SparseMatrix L_;
+    // L^T, for a gather based backward substitution (the diagonal is the first element of every row)
+    SparseMatrix U_;
+    // inverse of the diagonal of L (the substitutions are latency bound: no divisions in them)
+    DynVector invDiag_;
+    // diagonal shift that made the factorization succeed
+    double shift_;
+    // false if the factorization failed for every shift
+    bool ok_;
+
+    /**
+    * Factorize L_ in place (L_ holds the lower triangle of A + shift*diag(A) on entry)
+    * @return bool - false if a pivot <= 0 (up to rounding) was met
+    **/
+    bool factorize()
+    {
+        const unsigned int n = L_.rows();
+        const vector<unsigned int>& ptr = L_.rowPtr();
+        const vector<unsigned int>& col = L_.colIndex();
+        vector<double>& val = L_.values();
+        for(unsigned int i=0;i<n;i++)
+        {
+            const unsigned int di = ptr[i+1]-1;
+            for(unsigned int p=ptr[i];p<di;p++)
+            {
+                // L(i,k) = (A(i,k) - sum_{j<k} L(i,j)*L(k,j)) / L(k,k) over the common pattern of rows i and k
+                const unsigned int k = col[p], dk = ptr[k+1]-1;
+                double s = val[p];
+                unsigned int qi = ptr[i], qk = ptr[k];
+                while(qi<p && qk<dk)
+                {
+                    if(col[qi]==col[qk])
+                        s -= val[qi++]*val[qk++];
+                    else if(col[qi]<col[qk])
+                        qi++;
+                    else
+                        qk++;
+                }
+                val[p] = s/val[dk];
+            }
+            double d = val[di];
+            for(unsigned int p=ptr[i];p<di;p++)
+                d -= val[p]*val[p];
+            // a pivot that lost all its significant digits is a breakdown too
+            if(!(d>16.0*std::numeric_limits<double>::epsilon()*std::abs(val[di])))
+                return false;
+            val[di] = std::sqrt(d);
+        }
+        return true;
+    }
+
+public:
+    /**
+    * Constructor
+    * @param A - symmetric positive definite sparse Matrix (only the lower triangle is read)
+    **/
+    explicit IC0Preconditioner(const SparseMatrix& A): shift_(0.0), ok_(false)
+    {
+        const unsigned int n = A.rows();
+        const vector<unsigned int>& ptr = A.rowPtr();
+        const vector<unsigned int>& col = A.colIndex();
+        const vector<double>& val = A.values();
+
+        // lower triangle pattern, with an explicit diagonal on every row
+        vector<unsigned int> lptr(n+1, 0), lcol;
+        vector<double> a, diag(n, 0.0);
+        lcol.reserve(A.nonZeros()/2+n);
+        a.reserve(A.nonZeros()/2+n);
+        for(unsigned int i=0;i<n;i++)
+        {
+            for(unsigned int k=ptr[i];k<ptr[i+1] && col[k]<i;k++)
+            {
+                lcol.push_back(col[k]);
+                a.push_back(val[k]);
+            }
+            diag[i] = A(i, i);
+            lcol.push_back(i);
+            a.push_back(diag[i]);
+            lptr[i+1] = lcol.size();
+        }
+        L_ = SparseMatrix(n, n, std::move(lptr), std::move(lcol), a);
+
+        for(double shift = 0.0; shift<=1.0; shift = (shift>0.0)? shift*10.0 : 1e-3)
+        {
+            vector<double>& lval = L_.values();
+            std::copy(a.begin(), a.end(), lval.begin());
+            for(unsigned int i=0;i<n;i++)
+                lval[L_.rowPtr()[i+1]-1] *= 1.0+shift;
+            if(factorize())
+            {
+                shift_ = shift;
+                ok_ = true;
+                break;
+            }
+        }
+
+        vector<double>& lval = L_.values();
+        if(!ok_)
+        {
+            // Jacobi fallback: L = sqrt(|diag(A)|)
+            std::fill(lval.begin(), lval.end(), 0.0);
+            for(unsigned int i=0;i<n;i++)
+                lval[L_.rowPtr()[i+1]-1] = (diag[i]!=0.0)? std::sqrt(std::abs(diag[i])) : 1.0;
+        }
+        U_ = L_.transpose();
+        invDiag_.resize(n);
+        for(unsigned int i=0;i<n;i++)
+            invDiag_[i] = 1.0/lval[L_.rowPtr()[i+1]-1];
+    }
+
+    /**
+    * z = (L*L^T)^-1 * r (one forward and one backward substitution)
+    **/
+    void apply(const DynVector& r, DynVector& z) const
+    {
+        const unsigned int n = L_.rows();
+        const unsigned int* ptr = L_.rowPtr().data();
+        const unsigned int* col = L_.colIndex().data();
+        const double* val = L_.values().data();
+        const double* inv = invDiag_.data();
+        double* y = z.data();
+        for(unsigned int i=0;i<n;i++)
+        {
+            double s = r[i];
+            for(unsigned int p=ptr[i];p+1<ptr[i+1];p++)
+                s -= val[p]*y[col[p]];
+            y[i] = s*inv[i];
+        }
+        ptr = U_.rowPtr().data();
+        col = U_.colIndex().data();
+        val = U_.values().data();
+        for(unsigned int i=n;i-->0;)
+        {
+            double s = y[i];
+            for(unsigned int p=ptr[i]+1;p<ptr[i+1];p++)
+                s -= val[p]*y[col[p]];
+            y[i] = s*inv[i];
+        }
+    }
+
+    /**
+    * The incomplete factor L
+    **/
+    const SparseMatrix& factor() const {return L_;}
+
+    /**
+    * Diagonal shift that was needed (0 if A itself could be factorized)
+    **/
+    double shift() const {return shift_;}
+
+    /**
+    * False if the factorization failed for every shift (Jacobi scaling is used instead)
+    **/
+    bool ok() const {return ok_;}
+};
+
+/**
+* Solve a symmetric positive definite sparse Linear System with the preconditioned Conjugate Gradient method
+* @param A - symmetric positive definite sparse Matrix
+* @param B - constant Vector
+* @param x - initial guess (pass by reference - returns solution); a Vector of another size is reset to 0s
+* @param M - preconditioner (M.apply(r, z) computes z ~ A^-1 * r, symmetric positive definite)
+* @param tolerance - stop when |B-A*x| <= tolerance*|B|
+* @param maxIterations - maximum number of iterations (0 means 2*rows)
+* @param threads - number of threads of the Matrix-Vector products (0 means all the hardware threads)
+* @return IterativeInfo - iterations, final relative residual and convergence flag
+**/
+template<class Preconditioner>
+IterativeInfo solveCG(const SparseMatrix& A, const DynVector& B, DynVector& x, const Preconditioner& M,
+                      const double& tolerance = 1e-10, unsigned int maxIterations = 0, const unsigned int& threads = 0)
+{
+    const size_t n = A.rows();
+    if(maxIterations==0)
+        maxIterations = 2*n;
+    if(x.size()!=n)
+        x = DynVector(n);
+    IterativeInfo info = {0, 0.0, true};
+    const double bnorm = B.length();
+    if(bnorm==0.0)
+    {
+        x.zero();
+        return info;
+    }
+
+    DynVector r(n), z(n), p(n), q(n);
+    A.multiply(x.data(), r.data(), threads);
+    for(size_t i=0;i<n;i++)
+        r[i] = B[i]-r[i];
+    info.residual = r.length()/bnorm;
+    if(info.residual<=tolerance)
+        return info;
+    M.apply(r, z);
+    p = z;
+    double rz = r*z;
+
+    info.converged = false;
+    while(info.iterations<maxIterations)
+    {
+        info.iterations++;
+        A.multiply(p.data(), q.data(), threads);
+        double pq = p*q;
+        if(pq==0.0)
+            break;
+        const double alpha = rz/pq;
+        double rr = 0.0;
+        for(size_t i=0;i<n;i++)
+        {
+            x[i] += alpha*p[i];
+            r[i] -= alpha*q[i];
+            rr += r[i]*r[i];
+        }
+        info.residual = std::sqrt(rr)/bnorm;
+        if(info.residual<=tolerance)
+        {
+            info.converged = true;
+            break;
+        }
+        M.apply(r, z);
+        const double rzNew = r*z;
+        const double beta = rzNew/rz;
+        rz = rzNew;
+        for(size_t i=0;i<n;i++)
+            p[i] = z[i]+beta*p[i];
+    }
+    return info;
+}
+
+/**
+* Solve a symmetric positive definite sparse Linear System with the (unpreconditioned) Conjugate Gradient method
+* @param A - symmetric positive definite sparse Matrix
+* @param B - constant Vector
+* @param x - initial guess (pass by reference - returns solution); a Vector of another size is reset to 0s
+* @param tolerance - stop when |B-A*x| <= tolerance*|B|
+* @param maxIterations - maximum number of iterations (0 means 2*rows)
+* @param threads - number of threads of the Matrix-Vector products (0 means all the hardware threads)
+* @return IterativeInfo - iterations, final relative residual and convergence flag
+**/
+inline IterativeInfo solveCG(const SparseMatrix& A, const DynVector& B, DynVector& x,
+                             const double& tolerance = 1e-10, const unsigned int& maxIterations = 0, const unsigned int& threads = 0)
+{
+    return solveCG(A, B, x, IdentityPreconditioner(), tolerance, maxIterations, threads);
+}
+
+/**
+* Solve a general (nonsymmetric) sparse Linear System with the right-preconditioned BiCGSTAB method
+* @param A - square sparse Matrix
+* @param B - constant Vector
+* @param x - initial guess (pass by reference - returns solution); a Vector of another size is reset to 0s
+* @param M - preconditioner (M.apply(r, z) computes z ~ A^-1 * r)
+* @param tolerance - stop when |B-A*x| <= tolerance*|B|
+* @param maxIterations - maximum number of iterations (0 means 2*rows)
+* @param threads - number of threads of the Matrix-Vector products (0 means all the hardware threads)
+* @return IterativeInfo - iterations, final relative residual and convergence flag (false on breakdown)
+**/
+template<class Preconditioner>
+IterativeInfo solveBiCGSTAB(const SparseMatrix& A, const DynVector& B, DynVector& x, const Preconditioner& M,
+                            const double& tolerance = 1e-10, unsigned int maxIterations = 0, const unsigned int& threads = 0)
+{
+    const size_t n = A.rows();
+    if(maxIterations==0)
+        maxIterations = 2*n;
+    if(x.size()!=n)
+        x = DynVector(n);
+    IterativeInfo info = {0, 0.0, true};
+    const double bnorm = B.length();
+    if(bnorm==0.0)
+    {
+        x.zero();
+        return info;
+    }
+
+    DynVector r(n), r0(n), p(n), v(n), s(n), t(n), ph(n), sh(n);
+    A.multiply(x.data(), r.data(), threads);
+    for(size_t i=0;i<n;i++)
+        r[i] = B[i]-r[i];
+    info.residual = r.length()/bnorm;
+    if(info.residual<=tolerance)
+        return info;
+    r0 = r;
+    double rho = 1.0, alpha = 1.0, omega = 1.0;
+
+    info.converged = false;
+    while(info.iterations<maxIterations)
+    {
+        info.iterations++;
+        const double rhoNew = r0*r;
+        if(rhoNew==0.0)
+            break;
+        const double beta = (rhoNew/rho)*(alpha/omega);
+        rho = rhoNew;
+        for(size_t i=0;i<n;i++)
+            p[i] = r[i]+beta*(p[i]-omega*v[i]);
+        M.apply(p, ph);
+        A.multiply(ph.data(), v.data(), threads);
+        const double r0v = r0*v;
+        if(r0v==0.0)
+            break;
+        alpha = rho/r0v;
+        double ss = 0.0;
+        for(size_t i=0;i<n;i++)
+        {
+            s[i] = r[i]-alpha*v[i];
+            ss += s[i]*s[i];
+        }
+        if(std::sqrt(ss)/bnorm<=tolerance)
+        {
+            for(size_t i=0;i<n;i++)
+                x[i] += alpha*ph[i];
+            info.residual = std::sqrt(ss)/bnorm;
+            info.converged = true;
+            break;
+        }
+        M.apply(s, sh);
+        A.multiply(sh.data(), t.data(), threads);
+        const double tt = t*t;
+        omega = (tt>0.0)? (t*s)/tt : 0.0;
+        double rr = 0.0;
+        for(size_t i=0;i<n;i++)
+        {
+            x[i] += alpha*ph[i]+omega*sh[i];
+            r[i] = s[i]-omega*t[i];
+            rr += r[i]*r[i];
+        }
+        info.residual = std::sqrt(rr)/bnorm;
+        if(info.residual<=tolerance)
+        {
+            info.converged = true;
+            break;
+        }
+        if(omega==0.0)
+            break;
+    }
+    return info;
+}
+
+/**
+* Solve a general (nonsymmetric) sparse Linear System with the (unpreconditioned) BiCGSTAB method
+* @param A - square sparse Matrix
+* @param B - constant Vector
+* @param x - initial guess (pass by reference - returns solution); a Vector of another size is reset to 0s
+* @param tolerance - stop when |B-A*x| <= tolerance*|B|
+* @param maxIterations - maximum number of iterations (0 means 2*rows)
+* @param threads - number of threads of the Matrix-Vector products (0 means all the hardware threads)
+* @return IterativeInfo - iterations, final relative residual and convergence flag (false on breakdown)
+**/
+inline IterativeInfo solveBiCGSTAB(const SparseMatrix& A, const DynVector& B, DynVector& x,
+                                   const double& tolerance = 1e-10, const unsigned int& maxIterations = 0, const unsigned int& threads = 0)
+{
+    return solveBiCGSTAB(A, B, x, IdentityPreconditioner(), tolerance, maxIterations, threads);
+}
+
+} } }
+
+#endif
@@ -22,10 +22,9 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 * Includes
 **/
 #include <geometric_tools/Math/Matrix.h>
-
-extern "C" int dgetrf_(int *m, int *n, double *a, int * lda, int *ipiv, int *info);
-extern "C" int dgetrs_(char *trans, int *n, int *nrhs,
-                       double *a, int *lda, int *ipiv, double *b, int * ldb, int *info);
+#include <geometric_tools/Math/Kernels.h>
+#include <vector>
+#include <geometric_tools/Math/DynMatrix.h>
 
 namespace GeometricTools {
 
@@ -42,16 +41,31 @@ namespace LinearSystems {
 template<unsigned int D>
 Vector<D> solveLU(const Matrix<D,D>& A, const Vector<D>& B)
 {
-    int dim = int(D), info, nhrs = 1;
-    char trans = 'T';
     Matrix<D,D> U = A;
-    int* ipiv = new int[dim];
-
-    dgetrf_(&dim, &dim, U.data(), &dim, ipiv, &info);
+    unsigned int piv[D];
+    Kernels::luFactor(D, U.data(), D, piv);
 
     Vector<D> res = B;
+    Kernels::luSolve(D, U.data(), D, piv, res.data());
+
+    return res;
+}
+
+/**
+* Solve Linear System using (blocked) LU Decomposition
+* @param A - parameter Matrix (n x n)
+* @param B - constant Vector (n)
+* @return DynVector - solution
+**/
+inline DynVector solveLU(const DynMatrix& A, const DynVector& B)
+{
+    const unsigned int n = A.rows();
+    DynMatrix U = A;
+    std::vector<unsigned int> piv(n);
+    Kernels::luFactor(n, U.data(), n, piv.data());
 
-    dgetrs_(&trans, &dim, &nhrs, U.data(), &dim, ipiv, res.data(), &dim, &info);
+    DynVector res = B;
+    Kernels::luSolve(n, U.data(), n, piv.data(), res.data());
 
     return res;
 }
@@ -22,9 +22,9 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 * Includes
 **/
 #include <geometric_tools/Math/Matrix.h>
-
-extern "C" void dgesv_( int* n, int* nrhs, double* a, int* lda, int* ipiv,
-                double* b, int* ldb, int* info );
+#include <geometric_tools/Math/Kernels.h>
+#include <vector>
+#include <geometric_tools/Math/DynMatrix.h>
 
 namespace GeometricTools {
 
@@ -33,7 +33,7 @@ namespace Math {
 namespace LinearSystems {
 
 /**
-* Solve Linear System
+* Solve Linear System (LU decomposition with partial pivoting)
 * @param A - parameter Matrix
 * @param B - constant Vector
 * @return Vector<D> - solution
@@ -41,13 +41,50 @@ namespace LinearSystems {
 template<unsigned int D>
 Vector<D> solveLinear(const Matrix<D,D>& A, const Vector<D>& B)
 {
-    int dim = int(D), nrhs = 1, info;
     Matrix<D,D> U = A;
-    int* ipiv = new int[D];
-
+    unsigned int piv[D];
     Vector<D> res = B;
-    dgesv_( &dim, &nrhs, U.transpose().data(), &dim, ipiv, res.data(), &dim, &info );
+    if(!Kernels::luFactor(D, U.data(), D, piv))
+        return res;
+    Kernels::luSolve(D, U.data(), D, piv, res.data());
+
+    return res;
+}
 
+/**
+* Solve Linear System (blocked LU decomposition with partial pivoting)
+* @param A - parameter Matrix (n x n)
+* @param B - constant Vector (n)
+* @return DynVector - solution (B if A is singular)
+**/
+inline DynVector solveLinear(const DynMatrix& A, const DynVector& B)
+{
+    const unsigned int n = A.rows();
+    DynMatrix U = A;
+    std::vector<unsigned int> piv(n);
+    DynVector res = B;
+    if(!Kernels::luFactor(n, U.data(), n, piv.data()))
+        return res;
+    Kernels::luSolve(n, U.data(), n, piv.data(), res.data());
+
+    return res;
+}
+
+/**
+* Solve Linear System with several right hand sides (blocked LU decomposition with partial pivoting)
+* @param A - parameter Matrix (n x n)
+* @param B - constant Matrix (n x k, one right hand side per column)
+* @return DynMatrix - solution (B if A is singular)
+**/
+inline DynMatrix solveLinear(const DynMatrix& A, const DynMatrix& B)
+{
+    const unsigned int n = A.rows();
+    DynMatrix U = A;
+    std::vector<unsigned int> piv(n);
+    DynMatrix res = B;
+    if(!Kernels::luFactor(n, U.data(), n, piv.data()))
+        return res;
+    Kernels::luSolve(n, U.data(), n, piv.data(), res.data(), res.cols(), res.cols());
 
     return res;
 }
@@ -0,0 +1,119 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_MATH_LINEAR_SYSTEMS_SOLVE_TRIDIAGONAL_H
+#define GEOMETRIC_TOOLS_MATH_LINEAR_SYSTEMS_SOLVE_TRIDIAGONAL_H
+
+/**
+* Includes
+**/
+#include <vector>
+#include <cstddef>
+
+using std::vector;
+
+namespace GeometricTools {
+
+namespace Math {
+
+namespace LinearSystems {
+
+/**
+* Solve Tridiagonal Linear System in place (Thomas algorithm, O(n))
+* Row i: a[i]*x[i-1]+b[i]*x[i]+c[i]*x[i+1] = d[i] (a[0] and c[n-1] are not used)
+* No pivoting - the matrix should be diagonally dominant or symmetric positive definite
+* @param a - sub-diagonal
+* @param b - diagonal
+* @param c - super-diagonal
+* @param d - right hand side (overwritten with the solution)
+* @param scratch - workspace of n elements
+* @param n - size of the system
+* @return bool - false if a zero pivot was met
+**/
+inline bool solveTridiagonal(const double* a, const double* b, const double* c, double* d, double* scratch, const size_t& n)
+{
+    if(n==0)
+        return true;
+    if(b[0]==0.0)
+        return false;
+    double beta = b[0];
+    d[0] /= beta;
+    for(size_t i=1;i<n;i++)
+    {
+        scratch[i] = c[i-1]/beta;
+        beta = b[i]-a[i]*scratch[i];
+        if(beta==0.0)
+            return false;
+        d[i] = (d[i]-a[i]*d[i-1])/beta;
+    }
+    for(size_t i=n-1;i>0;i--)
+        d[i-1] -= scratch[i]*d[i];
+    return true;
+}
+
+/**
+* Solve Tridiagonal Linear System (Thomas algorithm, O(n))
+* Row i: a[i]*x[i-1]+b[i]*x[i]+c[i]*x[i+1] = d[i] (a[0] and c[n-1] are not used)
+* @param a - sub-diagonal
+* @param b - diagonal
+* @param c - super-diagonal
+* @param d - right hand side
+* @return vector<double> - solution (empty if a zero pivot was met)
+**/
+inline vector<double> solveTridiagonal(const vector<double>& a, const vector<double>& b, const vector<double>& c, const vector<double>& d)
+{
+    vector<double> x = d, scratch(d.size());
+    if(!solveTridiagonal(a.data(), b.data(), c.data(), x.data(), scratch.data(), x.size()))
+        return vector<double>();
+    return x;
+}
+
+/**
+* Solve Cyclic Tridiagonal Linear System (Thomas algorithm and Sherman-Morrison correction, O(n))
+* Row i: a[i]*x[i-1]+b[i]*x[i]+c[i]*x[i+1] = d[i] with indices taken modulo n
+* (a[0] multiplies x[n-1] and c[n-1] multiplies x[0]); needs n>=3
+* @param a - sub-diagonal (and lower-left corner a[0])
+* @param b - diagonal
+* @param c - super-diagonal (and upper-right corner c[n-1])
+* @param d - right hand side
+* @return vector<double> - solution (empty if the system could not be solved)
+**/
+inline vector<double> solveCyclicTridiagonal(const vector<double>& a, const vector<double>& b, const vector<double>& c, const vector<double>& d)
+{
+    size_t n = d.size();
+    if(n<3)
+        return vector<double>();
+    double alpha = c[n-1], beta = a[0];
+    double gamma = -b[0];
+    vector<double> bb = b, x = d, z(n, 0.0), scratch(n);
+    bb[0] = b[0]-gamma;
+    bb[n-1] = b[n-1]-alpha*beta/gamma;
+    if(!solveTridiagonal(a.data(), bb.data(), c.data(), x.data(), scratch.data(), n))
+        return vector<double>();
+    z[0] = gamma;
+    z[n-1] = alpha;
+    if(!solveTridiagonal(a.data(), bb.data(), c.data(), z.data(), scratch.data(), n))
+        return vector<double>();
+    double f = (x[0]+beta*x[n-1]/gamma)/(1.0+z[0]+beta*z[n-1]/gamma);
+    for(size_t i=0;i<n;i++)
+        x[i] -= f*z[i];
+    return x;
+}
+
+} } }
+
+#endif
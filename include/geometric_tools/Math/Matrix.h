@@ -24,9 +24,7 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 #include <iostream>
 #include <cassert>
 #include <geometric_tools/Math/Vector.h>
-
-extern "C" int dgetrf_(int *m, int *n, double *a, int * lda, int *ipiv, int *info);
-extern "C" int dgetri_(int *n, double *a, int *lda, int *ipiv, double *work, int *lwork, int *info);
+#include <geometric_tools/Math/Kernels.h>
 
 namespace GeometricTools { namespace Math {
 
@@ -168,8 +166,8 @@ public:
     **/
     Matrix operator+=(const Matrix& other)
     {
-        unsigned int N = COLS*ROWS;
-        cblas_daxpy(N, 1.0, &other.values_[0], 1, &values_[0], 1);
+        for(unsigned int i=0;i<COLS*ROWS;i++)
+            values_[i] += other.values_[i];
         return *this;
     }
 
@@ -181,8 +179,8 @@ public:
     **/
     Matrix operator-=(const Matrix& other)
     {
-        unsigned int N = COLS*ROWS;
-        cblas_daxpy(N, -1.0, &other.values_[0], 1, &values_[0], 1);
+        for(unsigned int i=0;i<COLS*ROWS;i++)
+            values_[i] -= other.values_[i];
         return *this;
     }
 
@@ -194,8 +192,8 @@ public:
     **/
     Matrix operator*=(const double& other)
     {
-        unsigned int N = COLS*ROWS;
-        cblas_dscal(N, other, &values_[0], 1);
+        for(unsigned int i=0;i<COLS*ROWS;i++)
+            values_[i] *= other;
         return *this;
     }
 
@@ -209,8 +207,9 @@ public:
     {
         if(std::abs(other) < std::numeric_limits<double>::epsilon())
             return (*this);
-        unsigned int N = COLS*ROWS;
-        cblas_dscal(N, 1.0/other, &values_[0], 1);
+        const double inv = 1.0/other;
+        for(unsigned int i=0;i<COLS*ROWS;i++)
+            values_[i] *= inv;
         return *this;
     }
 
@@ -297,10 +296,10 @@ public:
     * Overloading * operator
     * Multiplication with Vector
     **/
-    Vector<COLS> operator*(const Vector<COLS>& r2) const
+    Vector<ROWS> operator*(const Vector<COLS>& r2) const
     {
-        Vector<COLS> res;
-        cblas_dgemv(CblasRowMajor, CblasNoTrans, ROWS, COLS, 1.0, values_, ROWS, r2.values_, 1, 1.0, res.values_, 1);
+        Vector<ROWS> res;
+        Kernels::gemv(ROWS, COLS, values_, COLS, r2.values_, res.values_);
         return res;
     }
 
@@ -309,10 +308,10 @@ public:
     * Multiplication with Matrix
     **/
     template<unsigned int R2>
-    Matrix<ROWS,R2> operator*(const Matrix<COLS,R2>& r2)
+    Matrix<ROWS,R2> operator*(const Matrix<COLS,R2>& r2) const
     {
         Matrix<ROWS,R2> res;
-        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, ROWS, R2, COLS, 1.0, values_, ROWS, r2.values_, COLS, 0.0, res.values_, ROWS);
+        Kernels::gemm(ROWS, R2, COLS, values_, COLS, r2.data(), R2, res.data(), R2);
         return res;
     }
 
@@ -348,14 +347,21 @@ public:
         return values_;
     }
 
+    const double* data() const
+    {
+        return values_;
+    }
+
     /**
     * Get Norm of Matrix
     * @return double - the L2 Norm of the Matrix
     **/
-    double norm()
+    double norm() const
     {
-        unsigned int N = COLS*ROWS;
-        return cblas_dnrm2(N, &values_[0], 1);
+        double s = 0.0;
+        for(unsigned int i=0;i<COLS*ROWS;i++)
+            s += values_[i]*values_[i];
+        return std::sqrt(s);
     }
 
     /**
@@ -384,7 +390,7 @@ public:
     **/
     Vector<ROWS> getCol(const unsigned int& i)
     {
-        Vector<COLS> tmp;
+        Vector<ROWS> tmp;
         for(unsigned int j=0;j<ROWS;j++)
             tmp[j] = values_[j*COLS+i];
         return tmp;
@@ -427,7 +433,7 @@ public:
         Vector<ROWS> t;
         for(unsigned k=0;k<ROWS;k++)
             t(k) = (*this)(k,i);
-        for(unsigned k=0;k<COLS;k++)
+        for(unsigned k=0;k<ROWS;k++)
         {
             (*this)(k,i) = (*this)(k,j);
             (*this)(k,j) = t(k);
@@ -516,7 +522,7 @@ Matrix<N,M> operator/(const double& a, const Matrix<N,M>& b)
 * Perform scalar * Matrix (as opposed to Matrix * scalar inside Class)
 **/
 template<unsigned int N, unsigned int M>
-Matrix<N,M> operator*(const double& a, Matrix<N,M>& b)
+Matrix<N,M> operator*(const double& a, const Matrix<N,M>& b)
 {
     return b*a;
 }
@@ -529,7 +535,7 @@ template<unsigned int C1, unsigned int K>
 Vector<C1> operator*(const Vector<K>& v1, const Matrix<K, C1>& v2)
 {
     Vector<C1> res;
-    cblas_dgemv(CblasRowMajor, CblasTrans, C1, K, 1.0, v1.data(), C1, v2.data(), 1, 1.0, res.data(), 1);
+    Kernels::gemvT(K, C1, v2.data(), C1, v1.data(), res.data());
     return res;
 }
 
@@ -559,55 +565,39 @@ Matrix<ROWS-1,COLS-1> Minor(Matrix<ROWS,COLS> m, unsigned int i, unsigned int j)
 }
 
 /**
-* Get Inverse of Matrix
+* Get Inverse of Matrix (LU decomposition with partial pivoting)
 * Applies only to square matrices
+* @param mat - Matrix to invert
+* @return Matrix - the inverse (zero Matrix if mat is singular)
 **/
 template<unsigned int D>
 Matrix<D,D> inverse(const Matrix<D,D>& mat)
 {
-    Matrix<D,D> res = mat;
-    int d = D;
-    int* ipiv = new int[D], info;
-    double* work = new double[D];
-    dgetrf_(&d, &d, res.data(), &d, ipiv, &info);
-    dgetri_(&d, res.data(), &d, ipiv, work, &d, &info);
-    delete ipiv;
+    Matrix<D,D> lu = mat, res;
+    unsigned int piv[D];
+    if(!Kernels::luFactor(D, lu.data(), D, piv))
+        return res;
+    res.identity();
+    Kernels::luSolve(D, lu.data(), D, piv, res.data(), D, D);
     return res;
 }
 
 /**
-* Get Determinant of the Matrix
+* Get Determinant of the Matrix (LU decomposition with partial pivoting, O(N^3))
+* @param m - Matrix
+* @return double - the determinant (0 if the Matrix is not square)
 **/
 template<unsigned int ROWS, unsigned int COLS>
-double determinant(Matrix<ROWS,COLS> m)
+double determinant(const Matrix<ROWS,COLS>& m)
 {
-    if(COLS!=ROWS || COLS<2)
+    if(COLS!=ROWS)
         return 0.0;
-    if(COLS==2)
-    {
-        double x = (m(0,0)*m(1,1)-m(1,0)*m(0,1));
-        return x;
-    }
-    double s = 0.0;
-    const int R = ROWS-1;
-    const int C = COLS-1;
-    Matrix<R,C> temp;
-    for(unsigned int i=0;i<COLS;i++)
-    {
-        temp = Minor(m,0,i);
-        s += pow(-1,i)*m(0,i)*determinant(temp);
-    }
-    return s;
-}
-
-/**
-* Get Determinant of the Matrix
-* Base Case - 1x1 Matrix - Scalar value
-**/
-template<>
-double determinant(Matrix<1,1> m)
-{
-    return 0.0;
+    if(ROWS==2)
+        return m(0,0)*m(1,1)-m(1,0)*m(0,1);
+    Matrix<ROWS,COLS> lu = m;
+    unsigned int piv[ROWS];
+    Kernels::luFactor(ROWS, lu.data(), COLS, piv);
+    return Kernels::luDeterminant(ROWS, lu.data(), COLS, piv);
 }
 
 /**
@@ -631,7 +621,9 @@ template<unsigned int N>
 Matrix<N,N> operator*(const Vector<N>& v1, const Matrix<N,1>& v2)
 {
     Matrix<N,N> res;
-    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, N, N, 1, 1.0, v1.data(), 1, v2.data(), N, 0.0, res.data(), N);
+    for(unsigned int i=0;i<N;i++)
+        for(unsigned int j=0;j<N;j++)
+            res(i,j) = v1[i]*v2(j,0);
     return res;
 }
 
@@ -23,52 +23,188 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 **/
 #include <tuple>
 #include <cmath>
+#include <algorithm>
 
 namespace GeometricTools { namespace Math { namespace NumericalOptimization {
 
-inline std::tuple<double,double,double> getBracket(double(*f)(double), const double& x1, const double& x2)
+/**
+* Find a bracket (a,b,c) of a minimum: a<b<c with f(b) <= f(a) and f(b) < f(c)
+* Steps downhill from [x1,x2] with steps growing as the square root of the bracket width
+* Every point is evaluated once
+* @param f - function to minimize (any callable double(double): function pointer, functor, lambda)
+* @param x1 - first starting point
+* @param x2 - second starting point
+* @param maxIterations - maximum number of downhill steps (f may be unbounded below)
+* @return tuple<double,double,double> - the bracket (the last points tried if maxIterations was reached)
+**/
+template<class Function>
+std::tuple<double,double,double> getBracket(Function f, const double& x1, const double& x2, const unsigned int& maxIterations = 1000)
 {
-    double X1 = (x1<x2)? x1 : x2;
-    double X2 = (x2>x1)? x2 : x1;
-    double d = sqrt(X2-X1);
-    bool cond = f(X1)<f(X2);
-    double X3 = (cond)? X1-d : X2+d;
-    if(f(X3)>std::min(f(X1), f(X2)))
+    double X1 = std::min(x1, x2), X2 = std::max(x1, x2);
+    double f1 = f(X1), f2 = f(X2);
+    for(unsigned int k=0;k<maxIterations;k++)
     {
+        double d = std::sqrt(X2-X1);
+        bool cond = f1<f2;
+        double X3 = (cond)? X1-d : X2+d;
+        double f3 = f(X3);
+        if(f3>std::min(f1, f2))
+        {
+            if(cond)
+                return std::make_tuple(X3, X1, X2);
+            return std::make_tuple(X1, X2, X3);
+        }
+        // keep the lower point and the new one
         if(cond)
-            return std::make_tuple(X3, X1, X2);
-        return std::make_tuple(X1, X2, X3);
+        {
+            X2 = X1; f2 = f1;
+            X1 = X3; f1 = f3;
+        }
+        else
+        {
+            X1 = X2; f1 = f2;
+            X2 = X3; f2 = f3;
+        }
     }
-    X2 = (f(X1)<f(X2))? X1 : X2;
-    X1 = X3;
-    return getBracket(f, X1, X2);
+    return std::make_tuple(X1, (X1+X2)/2.0, X2);
 }
 
-inline std::tuple<double,double> goldenSearchMinimize(double(*f)(double), const double& a, const double& b, const double& c, const double& tau_ = 1e-10)
+/**
+* Golden Section Search for the minimum of f inside a bracket (a,b,c)
+* Shrinks the bracket by the golden ratio with one evaluation of f per iteration
+* @param f - function to minimize (any callable double(double): function pointer, functor, lambda)
+* @param a - left end of the bracket
+* @param b - middle point of the bracket (f(b) < f(a), f(b) < f(c))
+* @param c - right end of the bracket
+* @param tau_ - squared relative tolerance (f is flat near a minimum, so only sqrt(tau_) is attainable on x);
+* tau_ times the initial bracket width is also the absolute tolerance, so a minimum at x = 0 terminates too
+* @param maxIterations - maximum number of iterations (one evaluation of f each)
+* @return tuple<double,double> - position of the minimum and value of f there
+**/
+template<class Function>
+std::tuple<double,double> goldenSearchMinimize(Function f, double a, double b, double c, const double& tau_ = 1e-10,
+                                               const unsigned int& maxIterations = 200)
 {
-    double tau = sqrt(tau_);
-    static double w_ = 2-(1+sqrt(5))/2;
-    double x;
-    if((c-b)>(b-a))
-        x = b+w_*(c-b);
-    else
-        x = b-w_*(b-a);
-    if (std::abs(c-a) < tau*(std::abs(b)+std::abs(x)))
-        return std::make_tuple((c+a)/2.0, f((c+a)/2.0));
-    if(f(x)<f(b))
+    const double tau = std::sqrt(tau_);
+    const double w = 2.0-(1.0+std::sqrt(5.0))/2.0;
+    const double zeps = tau_*std::abs(c-a);
+    double fb = f(b);
+    for(unsigned int k=0;k<maxIterations;k++)
     {
-        if((c-b) > (b-a))
-            return goldenSearchMinimize(f, b, x, c, tau);
+        const bool right = (c-b)>(b-a);
+        double x = (right)? b+w*(c-b) : b-w*(b-a);
+        if(!(std::abs(c-a)>=tau*(std::abs(b)+std::abs(x))+zeps))
+            break;
+        double fx = f(x);
+        if(fx<fb)
+        {
+            if(right)
+                a = b;
+            else
+                c = b;
+            b = x;
+            fb = fx;
+        }
         else
-            return goldenSearchMinimize(f, a, x, b, tau);
+        {
+            if(right)
+                c = x;
+            else
+                a = x;
+        }
     }
-    else
+    return std::make_tuple((c+a)/2.0, f((c+a)/2.0));
+}
+
+/**
+* Brent's Method for the minimum of f inside a bracket (a,b,c)
+* Parabolic interpolation through the three best points, with golden section steps whenever the parabola
+* misbehaves: superlinear convergence on smooth functions, never slower than golden section search
+* @param f - function to minimize (any callable double(double): function pointer, functor, lambda)
+* @param a - left end of the bracket
+* @param b - middle point of the bracket (f(b) < f(a), f(b) < f(c))
+* @param c - right end of the bracket
+* @param tau_ - squared relative tolerance; tau_ times the initial bracket width is the absolute one (as in goldenSearchMinimize)
+* @param maxIterations - maximum number of iterations (one evaluation of f each)
+* @return tuple<double,double> - position of the minimum and value of f there
+**/
+template<class Function>
+std::tuple<double,double> brentMinimize(Function f, const double& a, const double& b, const double& c, const double& tau_ = 1e-10,
+                                        const unsigned int& maxIterations = 100)
+{
+    const double tau = std::sqrt(tau_);
+    const double w = 2.0-(1.0+std::sqrt(5.0))/2.0;
+    const double zeps = tau_*std::abs(c-a);
+    double lo = std::min(a, c), hi = std::max(a, c);
+    // x: best point so far, v: second best, u: previous value of v
+    double x = b, v = b, u = b;
+    double fx = f(x), fv = fx, fu = fx;
+    // last step and the one before it
+    double d = 0.0, e = 0.0;
+    for(unsigned int k=0;k<maxIterations;k++)
     {
-        if((c-b) > (b-a))
-            return goldenSearchMinimize(f, a, b, x, tau);
+        const double m = (lo+hi)/2.0;
+        const double tol1 = tau*std::abs(x)+zeps, tol2 = 2.0*tol1;
+        if(std::abs(x-m)<=tol2-(hi-lo)/2.0)
+            break;
+        bool golden = true;
+        if(std::abs(e)>tol1)
+        {
+            // parabola through x, v, u
+            double r = (x-v)*(fx-fu);
+            double q = (x-u)*(fx-fv);
+            double p = (x-u)*q-(x-v)*r;
+            q = 2.0*(q-r);
+            if(q>0.0)
+                p = -p;
+            q = std::abs(q);
+            // accept the step if it falls inside the bracket and is less than half the step before last
+            if(std::abs(p)<std::abs(0.5*q*e) && p>q*(lo-x) && p<q*(hi-x))
+            {
+                e = d;
+                d = p/q;
+                double t = x+d;
+                if(t-lo<tol2 || hi-t<tol2)
+                    d = (x<m)? tol1 : -tol1;
+                golden = false;
+            }
+        }
+        if(golden)
+        {
+            e = (x>=m)? lo-x : hi-x;
+            d = w*e;
+        }
+        // never evaluate closer than tol1 to x
+        double t = (std::abs(d)>=tol1)? x+d : x+((d>0.0)? tol1 : -tol1);
+        double ft = f(t);
+        if(ft<=fx)
+        {
+            if(t>=x)
+                lo = x;
+            else
+                hi = x;
+            u = v; fu = fv;
+            v = x; fv = fx;
+            x = t; fx = ft;
+        }
         else
-            return goldenSearchMinimize(f, x, b, c, tau);
+        {
+            if(t<x)
+                lo = t;
+            else
+                hi = t;
+            if(ft<=fv || v==x)
+            {
+                u = v; fu = fv;
+                v = t; fv = ft;
+            }
+            else if(ft<=fu || u==x || u==v)
+            {
+                u = t; fu = ft;
+            }
+        }
     }
+    return std::make_tuple(x, fx);
 }
 
 } } }
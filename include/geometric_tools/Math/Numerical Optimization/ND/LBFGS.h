@@ -0,0 +1,147 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#ifndef GEOMETRIC_TOOLS_MATH_NUMERICAL_OPT_ND_LBFGS_H
+#define GEOMETRIC_TOOLS_MATH_NUMERICAL_OPT_ND_LBFGS_H
+
+/**
+* Includes
+**/
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <geometric_tools/Math/Numerical Optimization/ND/MinimizeInfo.h>
+#include <geometric_tools/Math/Numerical Optimization/ND/LineSearch.h>
+
+namespace GeometricTools { namespace Math { namespace NumericalOptimization {
+
+/**
+* L-BFGS minimization (limited memory quasi-Newton) with the More-Thuente line search
+* All the work vectors (the memory pairs included) are allocated once, before the first iteration
+* @param f - objective returning its value and filling its gradient (any callable double(const VectorType& x, VectorType& gradient))
+* @param x - starting point (pass by reference - returns the minimizer); Vector<N> or DynVector
+* @param tolerance - stop when |gradient| <= tolerance*max(1,|x|), or when a step decreases f by less than rounding
+* @param maxIterations - maximum number of iterations (0 means 100*size)
+* @param memory - number of correction pairs kept (3 to 20 is usual)
+* @return MinimizeInfo - iterations, evaluations, value at x and convergence flag
+**/
+template<class Function, class VectorType>
+MinimizeInfo lbfgsMinimize(Function f, VectorType& x, const double& tolerance = 1e-8, unsigned int maxIterations = 0, const unsigned int& memory = 6)
+{
+    const unsigned int n = x.size(), m = std::max(memory, 1u);
+    if(maxIterations==0)
+        maxIterations = 100*std::max(n, 1u);
+    MinimizeInfo info = {0, 0, 0.0, false};
+
+    VectorType g = x, x0 = x, g0 = x, d = x;
+    std::vector<VectorType> S(m, x), Y(m, x);
+    std::vector<double> rho(m), alpha(m);
+    // stored pairs and position of the newest one
+    unsigned int count = 0, newest = 0;
+
+    double fx = f(x, g);
+    info.evaluations = 1;
+    double stp = 1.0/std::max(g.length(), 1e-300);
+    for(unsigned int i=0;i<n;i++)
+        d[i] = -g[i];
+
+    while(true)
+    {
+        if(!(g.length()>tolerance*std::max(1.0, x.length())))
+        {
+            info.converged = true;
+            break;
+        }
+        if(info.iterations>=maxIterations)
+            break;
+        info.iterations++;
+
+        x0 = x;
+        g0 = g;
+        const double f0 = fx;
+        if(!moreThuenteLineSearch(f, x0, f0, g0, d, stp, x, fx, g, info.evaluations))
+        {
+            x = x0;
+            fx = f0;
+            g = g0;
+            // the quasi-Newton model is off: retry once along the steepest descent before giving up
+            if(count==0)
+                break;
+            count = 0;
+            stp = 1.0/std::max(g.length(), 1e-300);
+            for(unsigned int i=0;i<n;i++)
+                d[i] = -g[i];
+            continue;
+        }
+        if(f0-fx<=std::numeric_limits<double>::epsilon()*std::max(1.0, std::abs(fx)))
+        {
+            info.converged = true;
+            break;
+        }
+
+        // new correction pair s = x-x0, y = g-g0 (skipped if the curvature condition fails)
+        double ys = 0.0, yy = 0.0;
+        for(unsigned int i=0;i<n;i++)
+        {
+            const double yi = g[i]-g0[i];
+            ys += yi*(x[i]-x0[i]);
+            yy += yi*yi;
+        }
+        if(ys>std::numeric_limits<double>::epsilon()*yy && yy>0.0)
+        {
+            newest = (count==0)? 0 : (newest+1)%m;
+            for(unsigned int i=0;i<n;i++)
+            {
+                S[newest][i] = x[i]-x0[i];
+                Y[newest][i] = g[i]-g0[i];
+            }
+            rho[newest] = 1.0/ys;
+            count = std::min(count+1, m);
+        }
+
+        // two-loop recursion: d = -H*g
+        for(unsigned int i=0;i<n;i++)
+            d[i] = -g[i];
+        if(count>0)
+        {
+            for(unsigned int k=0;k<count;k++)
+            {
+                unsigned int j = (newest+m-k)%m;
+                alpha[j] = rho[j]*(S[j]*d);
+                for(unsigned int i=0;i<n;i++)
+                    d[i] -= alpha[j]*Y[j][i];
+            }
+            const double gamma = 1.0/(rho[newest]*(Y[newest]*Y[newest]));
+            for(unsigned int i=0;i<n;i++)
+                d[i] *= gamma;
+            for(unsigned int k=count;k-->0;)
+            {
+                unsigned int j = (newest+m-k)%m;
+                const double beta = rho[j]*(Y[j]*d);
+                for(unsigned int i=0;i<n;i++)
+                    d[i] += (alpha[j]-beta)*S[j][i];
+            }
+        }
+        stp = 1.0;
+    }
+    info.value = fx;
+    return info;
+}
+
+} } }
+
+#endif
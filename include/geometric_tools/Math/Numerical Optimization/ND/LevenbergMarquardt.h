@@ -0,0 +1,256 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#ifndef GEOMETRIC_TOOLS_MATH_NUMERICAL_OPT_ND_LEVENBERG_MARQUARDT_H
+#define GEOMETRIC_TOOLS_MATH_NUMERICAL_OPT_ND_LEVENBERG_MARQUARDT_H
+
+/**
+* Includes
+**/
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <geometric_tools/Math/Kernels.h>
+#include <geometric_tools/Math/Numerical Optimization/ND/MinimizeInfo.h>
+#include <geometric_tools/Misc/Parallel.h>
+
+namespace GeometricTools { namespace Math { namespace NumericalOptimization {
+
+/**
+* Robust Loss Class
+* rho(s) applied to the squared norm s = |r|^2 of every residual block: the cost is 1/2*sum(rho(s))
+* Beyond scale the outliers weigh less than with plain least squares (Squared)
+**/
+class RobustLoss
+{
+public:
+    enum Type {Squared, Huber, SoftL1, Cauchy};
+
+protected:
+    // kind of loss
+    Type type_;
+    // squared scale (residual norm where the loss departs from least squares)
+    double c2_;
+
+public:
+    /**
+    * Constructor
+    * @param type - kind of loss
+    * @param scale - residual norm where the loss departs from least squares
+    **/
+    RobustLoss(const Type& type = Squared, const double& scale = 1.0): type_(type), c2_(scale*scale) {}
+
+    /**
+    * Evaluate the loss
+    * @param s - squared norm of the residual block
+    * @param rho - rho(s) (returns)
+    * @param drho - rho'(s), the weight of the block in the normal equations (returns)
+    **/
+    void evaluate(const double& s, double& rho, double& drho) const
+    {
+        switch(type_)
+        {
+            case Huber:
+                if(s<=c2_)
+                {
+                    rho = s;
+                    drho = 1.0;
+                }
+                else
+                {
+                    double r = std::sqrt(s), c = std::sqrt(c2_);
+                    rho = 2.0*c*r-c2_;
+                    drho = c/r;
+                }
+                break;
+            case SoftL1:
+            {
+                double t = std::sqrt(1.0+s/c2_);
+                rho = 2.0*c2_*(t-1.0);
+                drho = 1.0/t;
+                break;
+            }
+            case Cauchy:
+                rho = c2_*std::log1p(s/c2_);
+                drho = 1.0/(1.0+s/c2_);
+                break;
+            default:
+                rho = s;
+                drho = 1.0;
+        }
+    }
+
+    Type type() const {return type_;}
+};
+
+/**
+* Levenberg-Marquardt nonlinear least squares: minimize 1/2*sum_i rho(|r_i(x)|^2) over x
+* The residual blocks are evaluated in parallel; every thread accumulates its own J^T*W*J and J^T*W*r,
+* which are summed and solved with the Cholesky kernel of LinearSystems (damped with Marquardt's diagonal scaling)
+* Robust losses use iteratively reweighted least squares: block i is weighted by rho'(|r_i|^2)
+* With RobustLoss::Squared and a small damping this is Gauss-Newton
+* @param residual - residual blocks (any callable void(unsigned int block, const VectorType& x, double* r, double* J)
+*                   filling the blockSize residuals r and their blockSize x size row-major Jacobian J; called concurrently)
+* @param blocks - number of residual blocks
+* @param blockSize - number of residuals per block
+* @param x - starting point (pass by reference - returns the solution); Vector<N> or DynVector
+* @param loss - robust loss applied to every block
+* @param tolerance - stop when |J^T*r|_inf, the relative decrease of the cost or the relative step falls below tolerance
+* @param maxIterations - maximum number of iterations
+* @param threads - number of threads (0 means all the hardware threads)
+* @return MinimizeInfo - iterations, evaluations (of all the blocks), final cost and convergence flag
+**/
+template<class Residual, class VectorType>
+MinimizeInfo levenbergMarquardt(Residual residual, const unsigned int& blocks, const unsigned int& blockSize, VectorType& x,
+                                const RobustLoss& loss = RobustLoss(), const double& tolerance = 1e-10,
+                                const unsigned int& maxIterations = 100, const unsigned int& threads = 0)
+{
+    const unsigned int n = x.size();
+    const unsigned int t = std::max(1u, std::min(Helper::threadCount(threads), blocks));
+    MinimizeInfo info = {0, 0, 0.0, false};
+
+    // per thread: J^T*W*J (lower triangle), J^T*W*r, cost, and room for one block
+    const unsigned int stride = n*n+n+1+blockSize*(n+1);
+    std::vector<double> work(size_t(t)*stride);
+    std::vector<double> A(n*n), g(n), A2(n*n), g2(n), L(n*n), h(n);
+    VectorType trial = x;
+
+    auto evaluate = [&](const VectorType& p, std::vector<double>& Ap, std::vector<double>& gp) {
+        Helper::parallelChunks(0, blocks, [&](unsigned int c, unsigned int b, unsigned int e) {
+            double* acc = work.data()+size_t(c)*stride;
+            double* JtJ = acc;
+            double* Jtr = acc+n*n;
+            double* r = acc+n*n+n+1;
+            double* J = r+blockSize;
+            std::fill(acc, acc+n*n+n+1, 0.0);
+            for(unsigned int k=b;k<e;k++)
+            {
+                residual(k, p, r, J);
+                double s = 0.0;
+                for(unsigned int i=0;i<blockSize;i++)
+                    s += r[i]*r[i];
+                double rho, w;
+                loss.evaluate(s, rho, w);
+                acc[n*n+n] += rho;
+                for(unsigned int i=0;i<blockSize;i++)
+                {
+                    const double* Ji = J+size_t(i)*n;
+                    const double wr = w*r[i];
+                    for(unsigned int a=0;a<n;a++)
+                    {
+                        const double wJ = w*Ji[a];
+                        Jtr[a] += Ji[a]*wr;
+                        for(unsigned int q=0;q<=a;q++)
+                            JtJ[a*n+q] += wJ*Ji[q];
+                    }
+                }
+            }
+        }, t);
+        std::fill(Ap.begin(), Ap.end(), 0.0);
+        std::fill(gp.begin(), gp.end(), 0.0);
+        double cost = 0.0;
+        for(unsigned int c=0;c<t;c++)
+        {
+            const double* acc = work.data()+size_t(c)*stride;
+            for(unsigned int a=0;a<n*n;a++)
+                Ap[a] += acc[a];
+            for(unsigned int a=0;a<n;a++)
+                gp[a] += acc[n*n+a];
+            cost += acc[n*n+n];
+        }
+        info.evaluations++;
+        return 0.5*cost;
+    };
+
+    double cost = evaluate(x, A, g);
+    double mu = 1e-3, nu = 2.0;
+    while(true)
+    {
+        double gmax = 0.0;
+        for(unsigned int a=0;a<n;a++)
+            gmax = std::max(gmax, std::abs(g[a]));
+        if(!(gmax>tolerance) || cost==0.0)
+        {
+            info.converged = true;
+            break;
+        }
+        if(info.iterations>=maxIterations || mu>1e32)
+            break;
+        info.iterations++;
+
+        // (A+mu*D)*h = -g, D = diag(A) clamped away from 0
+        double dmax = 0.0;
+        for(unsigned int a=0;a<n;a++)
+            dmax = std::max(dmax, A[a*n+a]);
+        L = A;
+        for(unsigned int a=0;a<n;a++)
+        {
+            L[a*n+a] += mu*std::max(A[a*n+a], 1e-12*dmax+1e-300);
+            h[a] = -g[a];
+        }
+        if(!Kernels::choleskyFactor(n, L.data(), n))
+        {
+            mu *= nu;
+            nu *= 2.0;
+            continue;
+        }
+        Kernels::choleskySolve(n, L.data(), n, h.data());
+
+        double hnorm = 0.0, xnorm = 0.0, predicted = 0.0;
+        for(unsigned int a=0;a<n;a++)
+        {
+            trial[a] = x[a]+h[a];
+            hnorm += h[a]*h[a];
+            xnorm += x[a]*x[a];
+            // L(0)-L(h) = 1/2*h^T*(mu*D*h-g)
+            predicted += 0.5*h[a]*(mu*std::max(A[a*n+a], 1e-12*dmax+1e-300)*h[a]-g[a]);
+        }
+        if(std::sqrt(hnorm)<=tolerance*(std::sqrt(xnorm)+tolerance))
+        {
+            info.converged = true;
+            break;
+        }
+
+        const double trialCost = evaluate(trial, A2, g2);
+        const double gain = (cost-trialCost)/predicted;
+        if(gain>0.0 && trialCost==trialCost)
+        {
+            const double decrease = cost-trialCost;
+            std::swap(x, trial);
+            std::swap(A, A2);
+            std::swap(g, g2);
+            cost = trialCost;
+            mu *= std::max(1.0/3.0, 1.0-std::pow(2.0*gain-1.0, 3));
+            nu = 2.0;
+            if(decrease<=tolerance*(cost+decrease))
+            {
+                info.converged = true;
+                break;
+            }
+        }
+        else
+        {
+            mu *= nu;
+            nu *= 2.0;
+        }
+    }
+    info.value = cost;
+    return info;
+}
+
+} } }
+
+#endif
@@ -0,0 +1,241 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#ifndef GEOMETRIC_TOOLS_MATH_NUMERICAL_OPT_ND_LINE_SEARCH_H
+#define GEOMETRIC_TOOLS_MATH_NUMERICAL_OPT_ND_LINE_SEARCH_H
+
+/**
+* Includes
+**/
+#include <cmath>
+#include <algorithm>
+
+namespace GeometricTools { namespace Math { namespace NumericalOptimization {
+
+/**
+* Safeguarded step of the More-Thuente line search (dcstep of MINPACK-2)
+* Updates the interval of uncertainty [stx,sty] with the trial step stp and computes the next trial step
+* from cubic/quadratic interpolation of the function values and derivatives at the end points
+* @param stx, fx, dx - best step so far, function value and derivative there (pass by reference - returns)
+* @param sty, fy, dy - other end point of the interval (pass by reference - returns)
+* @param stp, fp, dp - current step, function value and derivative there (stp returns the new trial step)
+* @param brackt - true once a minimizer is bracketed (pass by reference - returns)
+* @param stpmin - lower bound of the step
+* @param stpmax - upper bound of the step
+**/
+inline void moreThuenteStep(double& stx, double& fx, double& dx, double& sty, double& fy, double& dy,
+                            double& stp, const double& fp, const double& dp, bool& brackt, const double& stpmin, const double& stpmax)
+{
+    const double sgnd = dp*((dx<0.0)? -1.0 : 1.0);
+    double stpf;
+    if(fp>fx)
+    {
+        // higher function value: the minimum is bracketed, take the cubic step if closer to stx, else the average
+        double theta = 3.0*(fx-fp)/(stp-stx)+dx+dp;
+        double s = std::max(std::abs(theta), std::max(std::abs(dx), std::abs(dp)));
+        double gamma = s*std::sqrt((theta/s)*(theta/s)-(dx/s)*(dp/s));
+        if(stp<stx)
+            gamma = -gamma;
+        double p = (gamma-dx)+theta, q = ((gamma-dx)+gamma)+dp;
+        double stpc = stx+(p/q)*(stp-stx);
+        double stpq = stx+((dx/((fx-fp)/(stp-stx)+dx))/2.0)*(stp-stx);
+        stpf = (std::abs(stpc-stx)<std::abs(stpq-stx))? stpc : stpc+(stpq-stpc)/2.0;
+        brackt = true;
+    }
+    else if(sgnd<0.0)
+    {
+        // derivatives of opposite sign: bracketed, take the step farther from stp
+        double theta = 3.0*(fx-fp)/(stp-stx)+dx+dp;
+        double s = std::max(std::abs(theta), std::max(std::abs(dx), std::abs(dp)));
+        double gamma = s*std::sqrt((theta/s)*(theta/s)-(dx/s)*(dp/s));
+        if(stp>stx)
+            gamma = -gamma;
+        double p = (gamma-dp)+theta, q = ((gamma-dp)+gamma)+dx;
+        double stpc = stp+(p/q)*(stx-stp);
+        double stpq = stp+(dp/(dp-dx))*(stx-stp);
+        stpf = (std::abs(stpc-stp)>std::abs(stpq-stp))? stpc : stpq;
+        brackt = true;
+    }
+    else if(std::abs(dp)<std::abs(dx))
+    {
+        // same sign, decreasing derivative magnitude: the cubic step is only used if it goes in the right direction
+        double theta = 3.0*(fx-fp)/(stp-stx)+dx+dp;
+        double s = std::max(std::abs(theta), std::max(std::abs(dx), std::abs(dp)));
+        double gamma = s*std::sqrt(std::max(0.0, (theta/s)*(theta/s)-(dx/s)*(dp/s)));
+        if(stp>stx)
+            gamma = -gamma;
+        double p = (gamma-dp)+theta, q = (gamma+(dx-dp))+gamma;
+        double r = p/q;
+        double stpc;
+        if(r<0.0 && gamma!=0.0)
+            stpc = stp+r*(stx-stp);
+        else
+            stpc = (stp>stx)? stpmax : stpmin;
+        double stpq = stp+(dp/(dp-dx))*(stx-stp);
+        if(brackt)
+        {
+            stpf = (std::abs(stpc-stp)<std::abs(stpq-stp))? stpc : stpq;
+            if(stp>stx)
+                stpf = std::min(stp+0.66*(sty-stp), stpf);
+            else
+                stpf = std::max(stp+0.66*(sty-stp), stpf);
+        }
+        else
+        {
+            stpf = (std::abs(stpc-stp)>std::abs(stpq-stp))? stpc : stpq;
+            stpf = std::max(stpmin, std::min(stpmax, stpf));
+        }
+    }
+    else
+    {
+        // same sign, no decrease of the derivative magnitude
+        if(brackt)
+        {
+            double theta = 3.0*(fp-fy)/(sty-stp)+dy+dp;
+            double s = std::max(std::abs(theta), std::max(std::abs(dy), std::abs(dp)));
+            double gamma = s*std::sqrt((theta/s)*(theta/s)-(dy/s)*(dp/s));
+            if(stp>sty)
+                gamma = -gamma;
+            double p = (gamma-dp)+theta, q = ((gamma-dp)+gamma)+dy;
+            stpf = stp+(p/q)*(sty-stp);
+        }
+        else
+            stpf = (stp>stx)? stpmax : stpmin;
+    }
+
+    if(fp>fx)
+    {
+        sty = stp; fy = fp; dy = dp;
+    }
+    else
+    {
+        if(sgnd<0.0)
+        {
+            sty = stx; fy = fx; dy = dx;
+        }
+        stx = stp; fx = fp; dx = dp;
+    }
+    stp = stpf;
+}
+
+/**
+* More-Thuente line search (dcsrch of MINPACK-2)
+* Finds a step satisfying the strong Wolfe conditions along a descent direction d:
+*   f(x0+stp*d) <= f0 + ftol*stp*g0.d   and   |g(x0+stp*d).d| <= gtol*|g0.d|
+* No allocation: x and g are the caller's buffers
+* @param f - objective (any callable double(const VectorType& x, VectorType& gradient))
+* @param x0 - starting point
+* @param f0 - f(x0)
+* @param g0 - gradient at x0
+* @param d - descent direction (g0.d < 0)
+* @param stp - initial step (pass by reference - returns the accepted step)
+* @param x - x0+stp*d (returns)
+* @param fx - f(x) (returns)
+* @param g - gradient at x (returns)
+* @param evaluations - incremented by the number of evaluations of f (pass by reference - returns)
+* @param ftol - sufficient decrease parameter
+* @param gtol - curvature parameter (0.9 suits quasi-Newton directions)
+* @param maxEvaluations - maximum number of evaluations of f
+* @return bool - true if the sufficient decrease condition holds at the returned step
+**/
+template<class Function, class VectorType>
+bool moreThuenteLineSearch(Function f, const VectorType& x0, const double& f0, const VectorType& g0, const VectorType& d, double& stp,
+                           VectorType& x, double& fx, VectorType& g, unsigned int& evaluations,
+                           const double& ftol = 1e-4, const double& gtol = 0.9, const unsigned int& maxEvaluations = 20)
+{
+    const unsigned int n = x0.size();
+    const double xtol = 1e-14, stpmin = 0.0, stpmax = 1e20;
+    const double ginit = g0*d;
+    if(!(ginit<0.0) || !(stp>0.0))
+    {
+        x = x0; fx = f0; g = g0;
+        return false;
+    }
+    const double gtest = ftol*ginit;
+    bool brackt = false;
+    int stage = 1;
+    double width = stpmax-stpmin, width1 = 2.0*width;
+    double stx = 0.0, fxb = f0, gx = ginit;
+    double sty = 0.0, fy = f0, gy = ginit;
+    double stmin = 0.0, stmax = stp+4.0*stp;
+
+    for(unsigned int k=0;k<maxEvaluations;k++)
+    {
+        for(unsigned int i=0;i<n;i++)
+            x[i] = x0[i]+stp*d[i];
+        fx = f(x, g);
+        evaluations++;
+        const double dg = g*d;
+        const double ftest = f0+stp*gtest;
+        const double evaluated = stp;
+        if(stage==1 && fx<=ftest && dg>=0.0)
+            stage = 2;
+
+        // rounding errors, interval too small, step at a bound, or strong Wolfe conditions met
+        if(brackt && (stp<=stmin || stp>=stmax))
+            return fx<=ftest;
+        if(brackt && stmax-stmin<=xtol*stmax)
+            return fx<=ftest;
+        if(stp==stpmax && fx<=ftest && dg<=gtest)
+            return true;
+        if(stp==stpmin && (fx>ftest || dg>=gtest))
+            return fx<=ftest;
+        if(fx<=ftest && std::abs(dg)<=gtol*(-ginit))
+            return true;
+
+        if(stage==1 && fx<=fxb && fx>ftest)
+        {
+            // modified function psi(stp) = f(stp)-f0-stp*gtest until a step with psi<=0 and f'>=0 is found
+            double fm = fx-stp*gtest, fxm = fxb-stx*gtest, fym = fy-sty*gtest;
+            double gm = dg-gtest, gxm = gx-gtest, gym = gy-gtest;
+            moreThuenteStep(stx, fxm, gxm, sty, fym, gym, stp, fm, gm, brackt, stmin, stmax);
+            fxb = fxm+stx*gtest; fy = fym+sty*gtest;
+            gx = gxm+gtest; gy = gym+gtest;
+        }
+        else
+            moreThuenteStep(stx, fxb, gx, sty, fy, gy, stp, fx, dg, brackt, stmin, stmax);
+
+        // force a sufficient decrease of the interval
+        if(brackt)
+        {
+            if(std::abs(sty-stx)>=0.66*width1)
+                stp = stx+0.5*(sty-stx);
+            width1 = width;
+            width = std::abs(sty-stx);
+            stmin = std::min(stx, sty);
+            stmax = std::max(stx, sty);
+        }
+        else
+        {
+            stmin = stp+1.1*(stp-stx);
+            stmax = stp+4.0*(stp-stx);
+        }
+        stp = std::max(stpmin, std::min(stpmax, stp));
+        if((brackt && (stp<=stmin || stp>=stmax)) || (brackt && stmax-stmin<=xtol*stmax))
+            stp = stx;
+        if(k+1==maxEvaluations)
+        {
+            // out of evaluations: report the last step tried
+            stp = evaluated;
+            return fx<=ftest;
+        }
+    }
+    return false;
+}
+
+} } }
+
+#endif
@@ -0,0 +1,68 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#ifndef GEOMETRIC_TOOLS_MATH_NUMERICAL_OPT_ND_MULTI_START_H
+#define GEOMETRIC_TOOLS_MATH_NUMERICAL_OPT_ND_MULTI_START_H
+
+/**
+* Includes
+**/
+#include <vector>
+#include <geometric_tools/Math/Numerical Optimization/ND/MinimizeInfo.h>
+#include <geometric_tools/Misc/Parallel.h>
+
+namespace GeometricTools { namespace Math { namespace NumericalOptimization {
+
+/**
+* Multi-start minimization: runs a local minimizer from every starting point and keeps the best result
+* The starts are independent and are spread across threads (the objective must be safe to call concurrently)
+* @param minimize - local minimizer (any callable MinimizeInfo(VectorType& x) refining x in place),
+*                   e.g. [&](Vector<3>& x) {return lbfgsMinimize(f, x);}
+* @param starts - starting points (pass by reference - every one returns its local minimizer)
+* @param x - best local minimizer (returns)
+* @param threads - number of threads (0 means all the hardware threads)
+* @return MinimizeInfo - the result of the best start, with iterations and evaluations summed over all the starts
+**/
+template<class Minimizer, class VectorType>
+MinimizeInfo multiStartMinimize(Minimizer minimize, std::vector<VectorType>& starts, VectorType& x, const unsigned int& threads = 0)
+{
+    MinimizeInfo res = {0, 0, 0.0, false};
+    if(starts.empty())
+        return res;
+    std::vector<MinimizeInfo> infos(starts.size());
+    Helper::parallelFor(0, starts.size(), [&](unsigned int i) {
+        infos[i] = minimize(starts[i]);
+    }, threads);
+
+    unsigned int best = 0, iterations = 0, evaluations = 0;
+    for(unsigned int i=0;i<infos.size();i++)
+    {
+        iterations += infos[i].iterations;
+        evaluations += infos[i].evaluations;
+        // lowest value wins (NaN values never do)
+        if(infos[i].value<infos[best].value || !(infos[best].value==infos[best].value))
+            best = i;
+    }
+    x = starts[best];
+    res = infos[best];
+    res.iterations = iterations;
+    res.evaluations = evaluations;
+    return res;
+}
+
+} } }
+
+#endif
@@ -0,0 +1,173 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#ifndef GEOMETRIC_TOOLS_MATH_NUMERICAL_OPT_ND_NELDER_MEAD_H
+#define GEOMETRIC_TOOLS_MATH_NUMERICAL_OPT_ND_NELDER_MEAD_H
+
+/**
+* Includes
+**/
+#include <cmath>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <geometric_tools/Math/Numerical Optimization/ND/MinimizeInfo.h>
+
+namespace GeometricTools { namespace Math { namespace NumericalOptimization {
+
+/**
+* Nelder-Mead (downhill simplex) minimization - derivative free
+* Uses the dimension dependent coefficients of Gao and Han, which keep the simplex from collapsing beyond ~10 unknowns
+* The simplex and the trial points are allocated once: an iteration only evaluates f and moves doubles around
+* @param f - objective (any callable double(const VectorType&))
+* @param x - starting point (pass by reference - returns the best vertex); Vector<N> or DynVector
+* @param step - size of the initial simplex (offset of the other vertices along every axis)
+* @param tolerance - stop when the spread of f over the simplex is below tolerance (relative to max(|f|,tolerance))
+*                    and the simplex is smaller than sqrt(tolerance) (relative to max(1,|x|))
+* @param maxIterations - maximum number of iterations (0 means 1000*size)
+* @return MinimizeInfo - iterations, evaluations, value at x and convergence flag
+**/
+template<class Function, class VectorType>
+MinimizeInfo nelderMeadMinimize(Function f, VectorType& x, const double& step = 0.1, const double& tolerance = 1e-10, unsigned int maxIterations = 0)
+{
+    const unsigned int n = x.size();
+    if(maxIterations==0)
+        maxIterations = 1000*n;
+    MinimizeInfo info = {0, 0, 0.0, false};
+    if(n==0)
+    {
+        info.value = f(x);
+        info.evaluations = 1;
+        info.converged = true;
+        return info;
+    }
+    const double reflection = 1.0, expansion = 1.0+2.0/n, contraction = 0.75-0.5/n, shrink = 1.0-1.0/n;
+    const double xtol = std::sqrt(tolerance);
+
+    std::vector<VectorType> P(n+1, x);
+    std::vector<double> F(n+1);
+    VectorType sum = x, trial = x, trial2 = x;
+    for(unsigned int i=1;i<=n;i++)
+        P[i][i-1] += step;
+    for(unsigned int i=0;i<=n;i++)
+        F[i] = f(P[i]);
+    info.evaluations = n+1;
+
+    auto updateSum = [&]() {
+        for(unsigned int j=0;j<n;j++)
+        {
+            double s = 0.0;
+            for(unsigned int i=0;i<=n;i++)
+                s += P[i][j];
+            sum[j] = s;
+        }
+    };
+    // trial = centroid + t*(P[h]-centroid), centroid of all the vertices but h
+    auto move = [&](VectorType& v, unsigned int h, double t) {
+        for(unsigned int j=0;j<n;j++)
+        {
+            double c = (sum[j]-P[h][j])/n;
+            v[j] = c+t*(P[h][j]-c);
+        }
+        return f(v);
+    };
+    // replace vertex h by v (swap: no copy for dynamic vectors)
+    auto replace = [&](VectorType& v, double fv, unsigned int h) {
+        for(unsigned int j=0;j<n;j++)
+            sum[j] += v[j]-P[h][j];
+        std::swap(P[h], v);
+        F[h] = fv;
+    };
+    updateSum();
+
+    unsigned int l = 0;
+    while(true)
+    {
+        // best l, worst h, second worst s
+        unsigned int h = 0, s = 0;
+        l = 0;
+        for(unsigned int i=1;i<=n;i++)
+        {
+            if(F[i]<F[l])
+                l = i;
+            if(F[i]>F[h])
+                h = i;
+        }
+        s = (h==0)? 1 : 0;
+        for(unsigned int i=0;i<=n;i++)
+            if(i!=h && F[i]>F[s])
+                s = i;
+
+        double size = 0.0, scale = 1.0;
+        for(unsigned int j=0;j<n;j++)
+        {
+            scale = std::max(scale, std::abs(P[l][j]));
+            for(unsigned int i=0;i<=n;i++)
+                size = std::max(size, std::abs(P[i][j]-P[l][j]));
+        }
+        if(F[h]-F[l]<=tolerance*std::max(std::abs(F[l]), tolerance) && size<=xtol*scale)
+        {
+            info.converged = true;
+            break;
+        }
+        if(info.iterations>=maxIterations)
+            break;
+        info.iterations++;
+
+        const double fr = move(trial, h, -reflection);
+        info.evaluations++;
+        if(fr<F[l])
+        {
+            const double fe = move(trial2, h, -reflection*expansion);
+            info.evaluations++;
+            if(fe<fr)
+                replace(trial2, fe, h);
+            else
+                replace(trial, fr, h);
+        }
+        else if(fr<F[s])
+            replace(trial, fr, h);
+        else
+        {
+            // outside contraction if the reflected point improved on the worst one, inside contraction otherwise
+            const bool outside = fr<F[h];
+            const double fc = move(trial2, h, (outside)? -reflection*contraction : contraction);
+            info.evaluations++;
+            if(fc<std::min(fr, F[h]))
+                replace(trial2, fc, h);
+            else
+            {
+                for(unsigned int i=0;i<=n;i++)
+                {
+                    if(i==l)
+                        continue;
+                    for(unsigned int j=0;j<n;j++)
+                        P[i][j] = P[l][j]+shrink*(P[i][j]-P[l][j]);
+                    F[i] = f(P[i]);
+                }
+                info.evaluations += n;
+                updateSum();
+            }
+        }
+    }
+    x = P[l];
+    info.value = F[l];
+    return info;
+}
+
+} } }
+
+#endif
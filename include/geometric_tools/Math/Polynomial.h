@@ -0,0 +1,354 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_MATH_POLYNOMIAL_H
+#define GEOMETRIC_TOOLS_MATH_POLYNOMIAL_H
+
+/**
+* Includes
+**/
+#include <cstddef>
+#include <algorithm>
+
+namespace GeometricTools { namespace Math {
+
+/**
+* Polynomial evaluation (Horner scheme)
+* Coefficients are stored highest power first: p(u) = c[0]*u^D+c[1]*u^(D-1)+...+c[D]
+**/
+
+/**
+* Evaluate a polynomial
+* @param c - coefficients (degree+1 values, highest power first)
+* @param degree - degree of the polynomial
+* @param u - parameter
+* @return double - p(u)
+**/
+inline double horner(const double* c, const unsigned int& degree, const double& u)
+{
+    double s = c[0];
+    for(unsigned int i=1;i<=degree;i++)
+        s = s*u+c[i];
+    return s;
+}
+
+/**
+* Evaluate a derivative of a polynomial
+* @param c - coefficients (degree+1 values, highest power first)
+* @param degree - degree of the polynomial
+* @param u - parameter
+* @param order - order of the derivative
+* @return double - p^(order)(u)
+**/
+inline double hornerDerivative(const double* c, const unsigned int& degree, const double& u, const unsigned int& order = 1)
+{
+    if(order>degree)
+        return 0.0;
+    double s = 0.0;
+    for(unsigned int i=0;i<=degree-order;i++)
+    {
+        // falling factorial (degree-i)!/(degree-i-order)!
+        double f = 1.0;
+        for(unsigned int k=0;k<order;k++)
+            f *= double(degree-i-k);
+        s = s*u+f*c[i];
+    }
+    return s;
+}
+
+/**
+* Evaluate a polynomial of compile-time degree (fully unrolled)
+* @param c - coefficients (D+1 values, highest power first)
+* @param u - parameter
+* @return double - p(u)
+**/
+template<unsigned int D>
+inline double horner(const double* c, const double& u)
+{
+    double s = c[0];
+    for(unsigned int i=1;i<=D;i++)
+        s = s*u+c[i];
+    return s;
+}
+
+/**
+* Evaluate a polynomial of compile-time degree at many parameters
+* The coefficient loop is unrolled so that the loop over the parameters vectorizes
+* @param c - coefficients (D+1 values, highest power first)
+* @param u - parameters
+* @param out - values (may alias u)
+* @param n - number of parameters
+**/
+template<unsigned int D>
+inline void hornerBatch(const double* c, const double* u, double* out, const size_t& n)
+{
+    for(size_t i=0;i<n;i++)
+    {
+        double x = u[i], s = c[0];
+        for(unsigned int k=1;k<=D;k++)
+            s = s*x+c[k];
+        out[i] = s;
+    }
+}
+
+/**
+* Evaluate a polynomial of run-time degree at many parameters
+* Works on blocks of parameters, one coefficient at a time, so that the inner loop vectorizes
+* @param c - coefficients (degree+1 values, highest power first)
+* @param degree - degree of the polynomial
+* @param u - parameters
+* @param out - values (may alias u)
+* @param n - number of parameters
+**/
+inline void hornerBatch(const double* c, const unsigned int& degree, const double* u, double* out, const size_t& n)
+{
+    const size_t B = 128;
+    double x[B], s[B];
+    for(size_t b=0;b<n;b+=B)
+    {
+        size_t m = std::min(B, n-b);
+        for(size_t i=0;i<m;i++)
+        {
+            x[i] = u[b+i];
+            s[i] = c[0];
+        }
+        for(unsigned int k=1;k<=degree;k++)
+            for(size_t i=0;i<m;i++)
+                s[i] = s[i]*x[i]+c[k];
+        for(size_t i=0;i<m;i++)
+            out[b+i] = s[i];
+    }
+}
+
+/**
+* Evaluate a derivative of a polynomial of compile-time degree at many parameters
+* @param c - coefficients (D+1 values, highest power first)
+* @param u - parameters
+* @param out - values (may alias u)
+* @param n - number of parameters
+* @param order - order of the derivative
+**/
+template<unsigned int D>
+inline void hornerDerivativeBatch(const double* c, const double* u, double* out, const size_t& n, const unsigned int& order = 1)
+{
+    if(order>D)
+    {
+        std::fill(out, out+n, 0.0);
+        return;
+    }
+    // coefficients of the derivative polynomial
+    double dc[D+1];
+    for(unsigned int i=0;i<=D-order;i++)
+    {
+        double f = 1.0;
+        for(unsigned int k=0;k<order;k++)
+            f *= double(D-i-k);
+        dc[i] = f*c[i];
+    }
+    hornerBatch(dc, D-order, u, out, n);
+}
+
+/**
+* Bernstein (Bezier) basis evaluation (de Casteljau scheme)
+* Control values b[0..D] define p(u) = sum_i C(D,i)*(1-u)^(D-i)*u^i*b[i]
+**/
+
+/**
+* Evaluate a Bernstein polynomial of compile-time degree
+* @param b - control values (D+1 values)
+* @param u - parameter
+* @return double - p(u)
+**/
+template<unsigned int D>
+inline double deCasteljau(const double* b, const double& u)
+{
+    double w[D+1];
+    for(unsigned int j=0;j<=D;j++)
+        w[j] = b[j];
+    const double v = 1.0-u;
+    for(unsigned int r=1;r<=D;r++)
+        for(unsigned int j=0;j<=D-r;j++)
+            w[j] = v*w[j]+u*w[j+1];
+    return w[0];
+}
+
+/**
+* Evaluate a Bernstein polynomial at many parameters
+* Works on blocks of parameters so that the inner loop vectorizes
+* @param b - control values (degree+1 values)
+* @param u - parameters
+* @param out - values (may alias u)
+* @param n - number of parameters
+* @param degree - degree of the polynomial (at most D, D bounds the scratch storage)
+**/
+template<unsigned int D>
+inline void deCasteljauBatch(const double* b, const double* u, double* out, const size_t& n, const unsigned int& degree = D)
+{
+    const size_t B = 64;
+    double w[D+1][B], x[B], v[B];
+    for(size_t k=0;k<n;k+=B)
+    {
+        size_t m = std::min(B, n-k);
+        for(size_t i=0;i<m;i++)
+        {
+            x[i] = u[k+i];
+            v[i] = 1.0-x[i];
+        }
+        for(unsigned int j=0;j<=degree;j++)
+            for(size_t i=0;i<m;i++)
+                w[j][i] = b[j];
+        for(unsigned int r=1;r<=degree;r++)
+            for(unsigned int j=0;j<=degree-r;j++)
+                for(size_t i=0;i<m;i++)
+                    w[j][i] = v[i]*w[j][i]+x[i]*w[j+1][i];
+        for(size_t i=0;i<m;i++)
+            out[k+i] = w[0][i];
+    }
+}
+
+/**
+* Control values of a derivative of a Bernstein polynomial (hodograph)
+* @param b - control values (degree+1 values)
+* @param degree - degree of the polynomial
+* @param order - order of the derivative
+* @param db - control values of the derivative (degree-order+1 values, may alias b)
+**/
+inline void bernsteinDerivative(const double* b, const unsigned int& degree, const unsigned int& order, double* db)
+{
+    if(db!=b)
+        std::copy(b, b+degree+1, db);
+    for(unsigned int k=0;k<order;k++)
+    {
+        unsigned int p = degree-k;
+        for(unsigned int j=0;j<p;j++)
+            db[j] = double(p)*(db[j+1]-db[j]);
+    }
+}
+
+/**
+* Convert Bernstein control values to monomial coefficients
+* @param b - control values (degree+1 values)
+* @param degree - degree of the polynomial
+* @param c - coefficients (degree+1 values, highest power first)
+**/
+inline void bernsteinToMonomial(const double* b, const unsigned int& degree, double* c)
+{
+    // a_k = C(degree,k) * sum_i (-1)^(k-i) C(k,i) b_i
+    double cn = 1.0;
+    for(unsigned int k=0;k<=degree;k++)
+    {
+        double s = 0.0, ck = 1.0;
+        for(unsigned int i=0;i<=k;i++)
+        {
+            s += (((k-i)&1)? -ck : ck)*b[i];
+            ck = ck*double(k-i)/double(i+1);
+        }
+        c[degree-k] = cn*s;
+        cn = cn*double(degree-k)/double(k+1);
+    }
+}
+
+/**
+* Convert monomial coefficients to Bernstein control values
+* @param c - coefficients (degree+1 values, highest power first)
+* @param degree - degree of the polynomial
+* @param b - control values (degree+1 values)
+**/
+inline void monomialToBernstein(const double* c, const unsigned int& degree, double* b)
+{
+    // b_i = sum_{k<=i} C(i,k)/C(degree,k) a_k
+    for(unsigned int i=0;i<=degree;i++)
+    {
+        double s = 0.0, cik = 1.0, cnk = 1.0;
+        for(unsigned int k=0;k<=i;k++)
+        {
+            s += cik/cnk*c[degree-k];
+            cik = cik*double(i-k)/double(k+1);
+            cnk = cnk*double(degree-k)/double(k+1);
+        }
+        b[i] = s;
+    }
+}
+
+/**
+* Evaluate a Bernstein polynomial of run-time degree in O(degree) without scratch storage
+* Horner scheme on u/(1-u) (or (1-u)/u for u>0.5)
+* @param b - control values (degree+1 values)
+* @param degree - degree of the polynomial
+* @param u - parameter
+* @return double - p(u)
+**/
+inline double bernstein(const double* b, const unsigned int& degree, const double& u)
+{
+    if(degree==0)
+        return b[0];
+    const bool low = (u<=0.5);
+    const double v = 1.0-u;
+    const double t = low? u/v : v/u;
+    double s = low? b[degree] : b[0], c = 1.0, f = 1.0;
+    for(unsigned int k=1;k<=degree;k++)
+    {
+        // C(degree,k) for the control value degree-k positions away from the start of the sum
+        c = c*double(degree-k+1)/double(k);
+        s = s*t+c*(low? b[degree-k] : b[k]);
+        f *= low? v : u;
+    }
+    return s*f;
+}
+
+/**
+* Split a Bernstein polynomial at a parameter (de Casteljau)
+* @param b - control values (degree+1 values)
+* @param degree - degree of the polynomial
+* @param u - split parameter
+* @param left - control values on [0,u] reparameterized to [0,1] (degree+1 values)
+* @param right - control values on [u,1] reparameterized to [0,1] (degree+1 values, may alias b)
+**/
+inline void bernsteinSubdivide(const double* b, const unsigned int& degree, const double& u, double* left, double* right)
+{
+    if(right!=b)
+        std::copy(b, b+degree+1, right);
+    const double v = 1.0-u;
+    left[0] = right[0];
+    for(unsigned int r=1;r<=degree;r++)
+    {
+        for(unsigned int j=0;j<=degree-r;j++)
+            right[j] = v*right[j]+u*right[j+1];
+        left[r] = right[0];
+    }
+}
+
+/**
+* Degree elevation of a Bernstein polynomial
+* @param b - control values (degree+1 values)
+* @param degree - degree of the polynomial
+* @param e - control values of the same polynomial with degree+1 (degree+2 values)
+**/
+inline void bernsteinElevate(const double* b, const unsigned int& degree, double* e)
+{
+    e[degree+1] = b[degree];
+    for(unsigned int i=degree;i>=1;i--)
+    {
+        double a = double(i)/double(degree+1);
+        e[i] = a*b[i-1]+(1.0-a)*b[i];
+    }
+    e[0] = b[0];
+}
+
+} }
+
+#endif
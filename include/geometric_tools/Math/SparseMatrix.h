@@ -0,0 +1,334 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#ifndef GEOMETRIC_TOOLS_MATH_SPARSE_MATRIX_H
+#define GEOMETRIC_TOOLS_MATH_SPARSE_MATRIX_H
+
+/**
+* Includes
+**/
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <geometric_tools/Math/DynVector.h>
+#include <geometric_tools/Math/DynMatrix.h>
+#include <geometric_tools/Misc/Parallel.h>
+
+/**
+* Products with fewer stored elements than GEOMETRIC_TOOLS_SPARSE_PARALLEL_NNZ run on the calling thread only
+* (starting the threads costs more than the product itself)
+**/
+#ifndef GEOMETRIC_TOOLS_SPARSE_PARALLEL_NNZ
+#define GEOMETRIC_TOOLS_SPARSE_PARALLEL_NNZ 65536
+#endif
+
+using std::vector;
+
+namespace GeometricTools { namespace Math {
+
+/**
+* Sparse Matrix Class
+* Compressed Sparse Row (CSR) storage: the elements of row i are values[rowPtr[i]..rowPtr[i+1]-1],
+* in increasing column order (colIndex)
+* Use TripletBuilder to assemble one
+**/
+class SparseMatrix
+{
+protected:
+    // dimensions of matrix
+    unsigned int rows_, cols_;
+    // start of every row in colIndex_/values_ (rows_+1 entries)
+    vector<unsigned int> rowPtr_;
+    // column of every stored element
+    vector<unsigned int> colIndex_;
+    // value of every stored element
+    vector<double> values_;
+
+public:
+    /**
+    * Default Constructor
+    * empty 0x0 matrix
+    **/
+    SparseMatrix(): rows_(0), cols_(0), rowPtr_(1, 0) {}
+
+    /**
+    * Constructor
+    * rows x cols matrix without stored elements (all zeros)
+    * @param rows - number of rows
+    * @param cols - number of columns
+    **/
+    SparseMatrix(const unsigned int& rows, const unsigned int& cols): rows_(rows), cols_(cols), rowPtr_(rows+1, 0) {}
+
+    /**
+    * Constructor from CSR arrays (the columns of every row must be sorted and unique)
+    * @param rows - number of rows
+    * @param cols - number of columns
+    * @param rowPtr - start of every row (rows+1 entries)
+    * @param colIndex - column of every stored element
+    * @param values - value of every stored element
+    **/
+    SparseMatrix(const unsigned int& rows, const unsigned int& cols, vector<unsigned int> rowPtr, vector<unsigned int> colIndex, vector<double> values):
+        rows_(rows), cols_(cols), rowPtr_(std::move(rowPtr)), colIndex_(std::move(colIndex)), values_(std::move(values)) {}
+
+    unsigned int rows() const {return rows_;}
+    unsigned int cols() const {return cols_;}
+
+    /**
+    * Number of stored elements
+    **/
+    size_t nonZeros() const {return values_.size();}
+
+    const vector<unsigned int>& rowPtr() const {return rowPtr_;}
+    const vector<unsigned int>& colIndex() const {return colIndex_;}
+
+    /**
+    * Stored values (writable: the values can be changed in place as long as the pattern stays the same)
+    **/
+    vector<double>& values() {return values_;}
+    const vector<double>& values() const {return values_;}
+
+    /**
+    * Index of element (i,j) in values()
+    * @param i - row
+    * @param j - column
+    * @return size_t - index, nonZeros() if the element is not stored
+    **/
+    size_t find(const unsigned int& i, const unsigned int& j) const
+    {
+        const unsigned int* b = colIndex_.data()+rowPtr_[i];
+        const unsigned int* e = colIndex_.data()+rowPtr_[i+1];
+        const unsigned int* p = std::lower_bound(b, e, j);
+        if(p==e || *p!=j)
+            return values_.size();
+        return size_t(p-colIndex_.data());
+    }
+
+    /**
+    * Element (i,j) (0 if not stored)
+    **/
+    double operator()(const unsigned int& i, const unsigned int& j) const
+    {
+        size_t k = find(i, j);
+        return (k<values_.size())? values_[k] : 0.0;
+    }
+
+    /**
+    * Sparse Matrix - Vector product: y = A*x
+    * The rows are split among the threads in chunks holding the same number of stored elements
+    * @param x - Vector of cols() elements
+    * @param y - Vector of rows() elements (returns)
+    * @param threads - number of threads (0 means all the hardware threads)
+    **/
+    void multiply(const double* x, double* y, const unsigned int& threads = 0) const
+    {
+        const unsigned int* ptr = rowPtr_.data();
+        const unsigned int* col = colIndex_.data();
+        const double* val = values_.data();
+        auto rowRange = [=](unsigned int b, unsigned int e) {
+            for(unsigned int i=b;i<e;i++)
+            {
+                double s0 = 0.0, s1 = 0.0;
+                unsigned int k = ptr[i];
+                for(;k+1<ptr[i+1];k+=2)
+                {
+                    s0 += val[k]*x[col[k]];
+                    s1 += val[k+1]*x[col[k+1]];
+                }
+                if(k<ptr[i+1])
+                    s0 += val[k]*x[col[k]];
+                y[i] = s0+s1;
+            }
+        };
+        const unsigned int nnz = values_.size();
+        unsigned int t = (nnz<GEOMETRIC_TOOLS_SPARSE_PARALLEL_NNZ)? 1 : std::min(Helper::threadCount(threads), rows_);
+        if(t<=1)
+        {
+            rowRange(0, rows_);
+            return;
+        }
+        Helper::parallelFor(0, t, [&](unsigned int c) {
+            // rows whose first element falls in [c*nnz/t, (c+1)*nnz/t)
+            unsigned int b = std::lower_bound(ptr, ptr+rows_, (unsigned int)((unsigned long long)nnz*c/t))-ptr;
+            unsigned int e = std::lower_bound(ptr, ptr+rows_, (unsigned int)((unsigned long long)nnz*(c+1)/t))-ptr;
+            rowRange(b, (c+1==t)? rows_ : e);
+        }, t);
+    }
+
+    /**
+    * Overloading * operator
+    * Sparse Matrix - Vector product
+    * @return DynVector - the result of the multiplication
+    **/
+    DynVector operator*(const DynVector& x) const
+    {
+        DynVector y(rows_);
+        multiply(x.data(), y.data());
+        return y;
+    }
+
+    /**
+    * Get the diagonal (0 for the elements that are not stored)
+    * @return DynVector - min(rows,cols) elements
+    **/
+    DynVector diagonal() const
+    {
+        DynVector d(std::min(rows_, cols_));
+        for(unsigned int i=0;i<d.size();i++)
+            d[i] = (*this)(i, i);
+        return d;
+    }
+
+    /**
+    * Get the transpose
+    * @return SparseMatrix - cols x rows matrix
+    **/
+    SparseMatrix transpose() const
+    {
+        vector<unsigned int> ptr(cols_+1, 0), col(values_.size());
+        vector<double> val(values_.size());
+        for(size_t k=0;k<colIndex_.size();k++)
+            ptr[colIndex_[k]+1]++;
+        for(unsigned int j=0;j<cols_;j++)
+            ptr[j+1] += ptr[j];
+        vector<unsigned int> next(ptr.begin(), ptr.end()-1);
+        for(unsigned int i=0;i<rows_;i++)
+            for(unsigned int k=rowPtr_[i];k<rowPtr_[i+1];k++)
+            {
+                unsigned int p = next[colIndex_[k]]++;
+                col[p] = i;
+                val[p] = values_[k];
+            }
+        return SparseMatrix(cols_, rows_, std::move(ptr), std::move(col), std::move(val));
+    }
+
+    /**
+    * Convert to a dense matrix (for debugging and small problems)
+    * @return DynMatrix - rows x cols matrix
+    **/
+    DynMatrix toDense() const
+    {
+        DynMatrix res(rows_, cols_);
+        for(unsigned int i=0;i<rows_;i++)
+            for(unsigned int k=rowPtr_[i];k<rowPtr_[i+1];k++)
+                res(i, colIndex_[k]) = values_[k];
+        return res;
+    }
+};
+
+/**
+* Triplet Builder Class
+* Collects (row, column, value) triplets in any order and compresses them into a SparseMatrix
+* Duplicated elements are summed, which is what finite element / Laplacian assembly needs
+**/
+class TripletBuilder
+{
+protected:
+    // dimensions of matrix
+    unsigned int rows_, cols_;
+    // triplets
+    vector<unsigned int> i_, j_;
+    vector<double> v_;
+
+public:
+    /**
+    * Constructor
+    * @param rows - number of rows
+    * @param cols - number of columns
+    **/
+    TripletBuilder(const unsigned int& rows, const unsigned int& cols): rows_(rows), cols_(cols) {}
+
+    /**
+    * Reserve room for n triplets
+    **/
+    void reserve(const size_t& n)
+    {
+        i_.reserve(n);
+        j_.reserve(n);
+        v_.reserve(n);
+    }
+
+    /**
+    * Add a triplet (summed with the previous ones at the same position)
+    * @param i - row
+    * @param j - column
+    * @param value - value to add at (i,j)
+    **/
+    void add(const unsigned int& i, const unsigned int& j, const double& value)
+    {
+        i_.push_back(i);
+        j_.push_back(j);
+        v_.push_back(value);
+    }
+
+    /**
+    * Number of triplets
+    **/
+    size_t size() const {return v_.size();}
+
+    /**
+    * Remove all the triplets
+    **/
+    void clear()
+    {
+        i_.clear();
+        j_.clear();
+        v_.clear();
+    }
+
+    /**
+    * Build the CSR matrix
+    * Bucket sort of the triplets by row, then every row is sorted by column and its duplicates are summed: O(nnz*log(nnz/rows))
+    * @return SparseMatrix - the assembled matrix
+    **/
+    SparseMatrix build() const
+    {
+        vector<unsigned int> ptr(rows_+1, 0);
+        for(size_t k=0;k<i_.size();k++)
+            ptr[i_[k]+1]++;
+        for(unsigned int i=0;i<rows_;i++)
+            ptr[i+1] += ptr[i];
+        vector<std::pair<unsigned int, double> > entries(v_.size());
+        vector<unsigned int> next(ptr.begin(), ptr.end()-1);
+        for(size_t k=0;k<v_.size();k++)
+            entries[next[i_[k]]++] = std::make_pair(j_[k], v_[k]);
+
+        vector<unsigned int> rowPtr(rows_+1, 0), col;
+        vector<double> val;
+        col.reserve(entries.size());
+        val.reserve(entries.size());
+        for(unsigned int i=0;i<rows_;i++)
+        {
+            std::sort(entries.begin()+ptr[i], entries.begin()+ptr[i+1],
+                [](const std::pair<unsigned int, double>& a, const std::pair<unsigned int, double>& b) {return a.first<b.first;});
+            for(unsigned int k=ptr[i];k<ptr[i+1];k++)
+            {
+                if(col.size()>rowPtr[i] && col.back()==entries[k].first)
+                    val.back() += entries[k].second;
+                else
+                {
+                    col.push_back(entries[k].first);
+                    val.push_back(entries[k].second);
+                }
+            }
+            rowPtr[i+1] = col.size();
+        }
+        return SparseMatrix(rows_, cols_, std::move(rowPtr), std::move(col), std::move(val));
+    }
+};
+
+} }
+
+#endif
@@ -26,7 +26,6 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 #include <cmath>
 #include <cstring>
 #include <geometric_tools/Misc/Helper.h>
-#include <cblas.h>
 
 namespace GeometricTools { namespace Math {
 
@@ -115,7 +114,8 @@ public:
     **/
     Vector operator+=(const Vector& other)
     {
-        cblas_daxpy(N, 1.0, &other.values_[0], 1, &values_[0], 1);
+        for(unsigned int i=0;i<N;i++)
+            values_[i] += other.values_[i];
         return *this;
     }
 
@@ -127,7 +127,8 @@ public:
     **/
     Vector operator-=(const Vector& other)
     {
-        cblas_daxpy(N, -1.0, &other.values_[0], 1, &values_[0], 1);
+        for(unsigned int i=0;i<N;i++)
+            values_[i] -= other.values_[i];
         return *this;
     }
 
@@ -139,9 +140,8 @@ public:
     **/
     Vector operator+=(const double& other)
     {
-        Vector tmp;
-        tmp.ones();
-        cblas_daxpy(N, other, &tmp.values_[0], 1, &values_[0], 1);
+        for(unsigned int i=0;i<N;i++)
+            values_[i] += other;
         return *this;
     }
 
@@ -153,9 +153,8 @@ public:
     **/
     Vector operator-=(const double& other)
     {
-        Vector tmp;
-        tmp.ones();
-        cblas_daxpy(N, -other, &tmp.values_[0], 1, &values_[0], 1);
+        for(unsigned int i=0;i<N;i++)
+            values_[i] -= other;
         return *this;
     }
 
@@ -167,7 +166,8 @@ public:
     **/
     Vector operator*=(const double& other)
     {
-        cblas_dscal(N, other, &values_[0], 1);
+        for(unsigned int i=0;i<N;i++)
+            values_[i] *= other;
         return *this;
     }
 
@@ -181,7 +181,9 @@ public:
     {
         if(std::abs(other) < std::numeric_limits<double>::epsilon())
             return (*this);
-        cblas_dscal(N, 1.0/other, &values_[0], 1);
+        const double inv = 1.0/other;
+        for(unsigned int i=0;i<N;i++)
+            values_[i] *= inv;
         return *this;
     }
 
@@ -314,13 +316,18 @@ public:
         return values_;
     }
 
+    const double* data() const
+    {
+        return values_;
+    }
+
     /**
     * Get Length of Vector
     * @return double - length
     **/
     double length() const
     {
-        return cblas_dnrm2(N, &values_[0], 1);
+        return std::sqrt(lengthSq());
     }
 
     /**
@@ -328,7 +335,8 @@ public:
     **/
     void ones()
     {
-        memset(&values_[0], 1, N*sizeof(double));
+        for(unsigned int i=0;i<N;i++)
+            values_[i] = 1.0;
     }
 
 
@@ -338,8 +346,10 @@ public:
     **/
     double lengthSq() const
     {
-        double s = cblas_dnrm2(N, &values_[0], 1);
-        return s*s;
+        double s = 0.0;
+        for(unsigned int i=0;i<N;i++)
+            s += values_[i]*values_[i];
+        return s;
     }
 
 
@@ -407,6 +417,15 @@ public:
         return values_[i];
     }
 
+    /**
+    * Number of elements (same interface as DynVector, for code templated on the vector type)
+    * @return unsigned int - N
+    **/
+    unsigned int size() const
+    {
+        return N;
+    }
+
     /**
     * Get ith unit vector with size N
     * @param i
@@ -0,0 +1,142 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#ifndef GEOMETRIC_TOOLS_MISC_ALIGNED_BUFFER_H
+#define GEOMETRIC_TOOLS_MISC_ALIGNED_BUFFER_H
+
+/**
+* Includes
+**/
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <algorithm>
+
+namespace GeometricTools { namespace Helper {
+
+/**
+* AlignedBuffer Class
+* Heap array of trivially copyable elements whose first element is aligned to ALIGN bytes
+* (cache line / widest SIMD register), with value semantics (deep copy, cheap move)
+**/
+template<class T, size_t ALIGN = 64>
+class AlignedBuffer
+{
+protected:
+    T* data_;
+    size_t size_;
+
+    static T* allocate(const size_t& n)
+    {
+        if(n==0)
+            return nullptr;
+        // over-allocate and keep the original pointer right before the aligned block
+        void* raw = std::malloc(n*sizeof(T)+ALIGN+sizeof(void*));
+        if(raw==nullptr)
+            throw std::bad_alloc();
+        uintptr_t p = (reinterpret_cast<uintptr_t>(raw)+sizeof(void*)+ALIGN-1) & ~uintptr_t(ALIGN-1);
+        reinterpret_cast<void**>(p)[-1] = raw;
+        return reinterpret_cast<T*>(p);
+    }
+
+    static void release(T* p)
+    {
+        if(p!=nullptr)
+            std::free(reinterpret_cast<void**>(p)[-1]);
+    }
+
+public:
+    AlignedBuffer(): data_(nullptr), size_(0) {}
+
+    /**
+    * Constructor
+    * @param n - number of elements
+    * @param value - initial value of the elements
+    **/
+    explicit AlignedBuffer(const size_t& n, const T& value = T()): data_(allocate(n)), size_(n)
+    {
+        std::fill(data_, data_+n, value);
+    }
+
+    AlignedBuffer(const AlignedBuffer& other): data_(allocate(other.size_)), size_(other.size_)
+    {
+        if(size_)
+            std::memcpy(data_, other.data_, size_*sizeof(T));
+    }
+
+    AlignedBuffer(AlignedBuffer&& other): data_(other.data_), size_(other.size_)
+    {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    AlignedBuffer& operator=(const AlignedBuffer& other)
+    {
+        if(this!=&other)
+        {
+            if(size_!=other.size_)
+            {
+                release(data_);
+                data_ = allocate(other.size_);
+                size_ = other.size_;
+            }
+            if(size_)
+                std::memcpy(data_, other.data_, size_*sizeof(T));
+        }
+        return *this;
+    }
+
+    AlignedBuffer& operator=(AlignedBuffer&& other)
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+
+    ~AlignedBuffer()
+    {
+        release(data_);
+    }
+
+    /**
+    * Resize the buffer (the content is kept only if the size does not change)
+    * @param n - new number of elements
+    * @param value - value of the elements when the buffer is reallocated
+    **/
+    void resize(const size_t& n, const T& value = T())
+    {
+        if(n==size_)
+            return;
+        release(data_);
+        data_ = allocate(n);
+        size_ = n;
+        std::fill(data_, data_+n, value);
+    }
+
+    size_t size() const {return size_;}
+
+    T* data() {return data_;}
+    const T* data() const {return data_;}
+
+    T& operator[](const size_t& i) {return data_[i];}
+    const T& operator[](const size_t& i) const {return data_[i];}
+};
+
+} }
+
+#endif
@@ -0,0 +1,178 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_MISC_GAP_BUFFER_H
+#define GEOMETRIC_TOOLS_MISC_GAP_BUFFER_H
+
+/**
+* Includes
+**/
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+
+namespace GeometricTools { namespace Helper {
+
+/**
+* GapBuffer Class
+* Sequence container with a movable gap: insertions and deletions cost O(1) amortized near the previous edit
+* and O(distance) elsewhere (instead of O(n) for vector), indexing is O(1)
+* Elements live in [0,gap_start_) and [gap_end_,capacity)
+**/
+template<class T>
+class GapBuffer
+{
+protected:
+    std::vector<T> data_;
+    size_t gap_start_, gap_end_;
+
+    void moveGap(const size_t& pos)
+    {
+        if(pos<gap_start_)
+        {
+            std::move_backward(data_.begin()+pos, data_.begin()+gap_start_, data_.begin()+gap_end_);
+            gap_end_ -= gap_start_-pos;
+            gap_start_ = pos;
+        }
+        else if(pos>gap_start_)
+        {
+            size_t k = pos-gap_start_;
+            std::move(data_.begin()+gap_end_, data_.begin()+gap_end_+k, data_.begin()+gap_start_);
+            gap_start_ += k;
+            gap_end_ += k;
+        }
+    }
+
+    void grow(const size_t& min_capacity)
+    {
+        size_t cap = std::max(min_capacity, std::max<size_t>(8, 2*data_.size()));
+        size_t tail = data_.size()-gap_end_;
+        // build the new storage in order (head, gap, tail) instead of moving into preallocated slots
+        std::vector<T> data;
+        data.reserve(cap);
+        data.insert(data.end(), std::make_move_iterator(data_.begin()), std::make_move_iterator(data_.begin()+gap_start_));
+        data.resize(cap-tail);
+        data.insert(data.end(), std::make_move_iterator(data_.begin()+gap_end_), std::make_move_iterator(data_.end()));
+        data_.swap(data);
+        gap_end_ = cap-tail;
+    }
+
+public:
+    GapBuffer(): gap_start_(0), gap_end_(0) {}
+
+    size_t size() const {return data_.size()-(gap_end_-gap_start_);}
+
+    bool empty() const {return size()==0;}
+
+    void reserve(const size_t& n)
+    {
+        if(n>data_.size())
+            grow(n);
+    }
+
+    T& operator[](const size_t& i)
+    {
+        return (i<gap_start_)? data_[i] : data_[i+(gap_end_-gap_start_)];
+    }
+
+    const T& operator[](const size_t& i) const
+    {
+        return (i<gap_start_)? data_[i] : data_[i+(gap_end_-gap_start_)];
+    }
+
+    T& front() {return (*this)[0];}
+    const T& front() const {return (*this)[0];}
+    T& back() {return (*this)[size()-1];}
+    const T& back() const {return (*this)[size()-1];}
+
+    /**
+    * Insert an element
+    * @param pos - index of the new element (0..size())
+    * @param value - the element
+    **/
+    void insert(const size_t& pos, const T& value)
+    {
+        if(gap_start_==gap_end_)
+            grow(data_.size()+1);
+        moveGap(pos);
+        data_[gap_start_++] = value;
+    }
+
+    /**
+    * Remove an element
+    * @param pos - index of the element
+    **/
+    void erase(const size_t& pos)
+    {
+        moveGap(pos);
+        data_[gap_end_++] = T();
+    }
+
+    void push_back(const T& value) {insert(size(), value);}
+
+    void pop_back() {erase(size()-1);}
+
+    void clear()
+    {
+        std::fill(data_.begin(), data_.end(), T());
+        gap_start_ = 0;
+        gap_end_ = data_.size();
+    }
+
+    /**
+    * Copy the elements to a vector
+    * @return std::vector<T> - the elements in order
+    **/
+    std::vector<T> toVector() const
+    {
+        std::vector<T> v(data_.begin(), data_.begin()+gap_start_);
+        v.insert(v.end(), data_.begin()+gap_end_, data_.end());
+        return v;
+    }
+
+    /**
+    * Iterator Class
+    * Forward iterator over the elements (skips the gap)
+    **/
+    template<class Buffer, class Value>
+    class Iterator
+    {
+    protected:
+        Buffer* buffer_;
+        size_t i_;
+    public:
+        Iterator(Buffer* buffer, const size_t& i): buffer_(buffer), i_(i) {}
+        Value& operator*() const {return (*buffer_)[i_];}
+        Value* operator->() const {return &(*buffer_)[i_];}
+        Iterator& operator++() {i_++; return *this;}
+        bool operator==(const Iterator& other) const {return i_==other.i_;}
+        bool operator!=(const Iterator& other) const {return i_!=other.i_;}
+    };
+
+    typedef Iterator<GapBuffer, T> iterator;
+    typedef Iterator<const GapBuffer, const T> const_iterator;
+
+    iterator begin() {return iterator(this, 0);}
+    iterator end() {return iterator(this, size());}
+    const_iterator begin() const {return const_iterator(this, 0);}
+    const_iterator end() const {return const_iterator(this, size());}
+};
+
+} }
+
+#endif
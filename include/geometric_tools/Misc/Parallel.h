@@ -0,0 +1,107 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_MISC_PARALLEL_H
+#define GEOMETRIC_TOOLS_MISC_PARALLEL_H
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace GeometricTools { namespace Helper {
+
+/**
+* Number of threads to use
+* @param threads - requested number of threads (0 means all the hardware threads)
+**/
+inline unsigned int threadCount(const unsigned int& threads = 0)
+{
+    if(threads>0)
+        return threads;
+    unsigned int n = std::thread::hardware_concurrency();
+    return (n>0)? n : 1;
+}
+
+/**
+* Parallel for loop
+* Splits [begin,end) in contiguous chunks, one per thread, and calls f(i) for every index
+* The calling thread processes the first chunk; runs serially if there is only one thread or one index
+* @param begin - first index
+* @param end - one past the last index
+* @param f - callable f(unsigned int i)
+* @param threads - number of threads (0 means all the hardware threads)
+**/
+template<class Function>
+void parallelFor(const unsigned int& begin, const unsigned int& end, Function f, const unsigned int& threads = 0)
+{
+    if(end<=begin)
+        return;
+    unsigned int n = end-begin;
+    unsigned int t = std::min(threadCount(threads), n);
+    if(t<=1)
+    {
+        for(unsigned int i=begin;i<end;i++)
+            f(i);
+        return;
+    }
+    unsigned int chunk = (n+t-1)/t;
+    std::vector<std::thread> workers;
+    workers.reserve(t-1);
+    for(unsigned int k=1;k<t;k++)
+    {
+        unsigned int b = begin+k*chunk, e = std::min(end, b+chunk);
+        if(b>=e)
+            break;
+        workers.push_back(std::thread([&f, b, e]() {
+            for(unsigned int i=b;i<e;i++)
+                f(i);
+        }));
+    }
+    for(unsigned int i=begin;i<std::min(end, begin+chunk);i++)
+        f(i);
+    for(unsigned int k=0;k<workers.size();k++)
+        workers[k].join();
+}
+
+/**
+* Parallel loop over chunks
+* Calls f(chunk, begin, end) once per thread with its contiguous range - useful for per-thread accumulators
+* @param begin - first index
+* @param end - one past the last index
+* @param f - callable f(unsigned int chunk, unsigned int begin, unsigned int end)
+* @param threads - number of threads (0 means all the hardware threads)
+* @return unsigned int - number of chunks used
+**/
+template<class Function>
+unsigned int parallelChunks(const unsigned int& begin, const unsigned int& end, Function f, const unsigned int& threads = 0)
+{
+    if(end<=begin)
+        return 0;
+    unsigned int n = end-begin;
+    unsigned int t = std::min(threadCount(threads), n);
+    unsigned int chunk = (n+t-1)/t;
+    unsigned int chunks = (n+chunk-1)/chunk;
+    parallelFor(0, chunks, [&](unsigned int k) {
+        unsigned int b = begin+k*chunk;
+        f(k, b, std::min(end, b+chunk));
+    }, chunks);
+    return chunks;
+}
+
+} }
+
+#endif
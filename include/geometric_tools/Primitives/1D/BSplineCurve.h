@@ -0,0 +1,499 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_PRIMITIVES_1D_BSPLINE_CURVE_H
+#define GEOMETRIC_TOOLS_PRIMITIVES_1D_BSPLINE_CURVE_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Math/Polynomial.h>
+#include <geometric_tools/Primitives/1D/Curve.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+using std::vector;
+
+namespace GeometricTools {
+
+using Math::Vector;
+
+namespace Primitives {
+
+/**
+* Non-zero B-spline basis functions of degree D on a knot span (Cox-de Boor)
+* @param knots - knot vector
+* @param k - span index (knots[k] <= t < knots[k+1])
+* @param t - knot value
+* @param N - the D+1 values N_{k-D..k}(t)
+**/
+template<unsigned int D>
+inline void bsplineBasis(const double* knots, const unsigned int& k, const double& t, double* N)
+{
+    double left[D+1], right[D+1];
+    N[0] = 1.0;
+    for(unsigned int j=1;j<=D;j++)
+    {
+        left[j] = t-knots[k+1-j];
+        right[j] = knots[k+j]-t;
+        double saved = 0.0;
+        for(unsigned int r=0;r<j;r++)
+        {
+            double tmp = N[r]/(right[r+1]+left[j-r]);
+            N[r] = saved+right[r+1]*tmp;
+            saved = left[j-r]*tmp;
+        }
+        N[j] = saved;
+    }
+}
+
+/**
+* BSplineCurve Class
+* 1D (function) B-spline curve of degree D
+* With n control points the knot vector has n+D+1 knots and the curve lives on [knot(D), knot(n)].
+* As for every other curve the parameter u in [0,1] is mapped linearly onto that domain.
+* Knots are either generated (uniform or clamped uniform, growing with the control points)
+* or given explicitly (non-uniform).
+**/
+template<unsigned int D>
+class BSplineCurve : public Curve
+{
+public:
+    enum KnotType {Uniform, ClampedUniform, NonUniform};
+protected:
+    vector<double> control_;
+    vector<double> knots_;
+    KnotType type_;
+public:
+    /**
+    * Constructor
+    * Knots are generated while control points are added
+    * @param type - Uniform or ClampedUniform
+    **/
+    BSplineCurve(const KnotType& type = ClampedUniform): type_(type==NonUniform? ClampedUniform : type) {}
+
+    /**
+    * Constructor
+    * Control points are added afterwards (knots.size()-D-1 of them)
+    * @param knots - non-decreasing knot vector
+    **/
+    BSplineCurve(const vector<double>& knots): knots_(knots), type_(NonUniform) {}
+
+    /**
+    * Constructor
+    * @param control - control points
+    * @param knots - non-decreasing knot vector (control.size()+D+1 values)
+    **/
+    BSplineCurve(const vector<double>& control, const vector<double>& knots): knots_(knots), type_(NonUniform)
+    {
+        setControl(control);
+    }
+
+    /**
+    * Constructor
+    * @param control - control points
+    * @param type - Uniform or ClampedUniform
+    **/
+    BSplineCurve(const vector<double>& control, const KnotType& type): type_(type==NonUniform? ClampedUniform : type)
+    {
+        setControl(control);
+    }
+
+    KnotType knotType() const {return type_;}
+
+    const vector<double>& knots() const {return knots_;}
+
+    const vector<double>& control() const {return control_;}
+
+    /**
+    * Domain of the curve in knot space
+    * @return Vector<2> - [knot(D), knot(n)]
+    **/
+    Vector<2> domain() const
+    {
+        if(!defined())
+            return Vector<2>(0.0, 0.0);
+        return Vector<2>(knots_[D], knots_[control_.size()]);
+    }
+
+    /**
+    * Map a curve parameter to knot space
+    * @param u - parameter in [0,1]
+    * @return double - knot value
+    **/
+    double knotValue(const double& u) const
+    {
+        Vector<2> d = domain();
+        return d[0]+std::min(std::max(u, 0.0), 1.0)*(d[1]-d[0]);
+    }
+
+    /**
+    * Index of the knot span containing a knot value
+    * @param t - knot value (clamped to the domain)
+    * @return unsigned int - k with knot(k) <= t < knot(k+1), D <= k < n
+    **/
+    unsigned int findSpan(const double& t) const
+    {
+        unsigned int n = control_.size();
+        if(type_!=NonUniform)
+        {
+            // unit spaced knots
+            double s = std::floor(t-knots_[D]);
+            if(s<0.0)
+                s = 0.0;
+            return D+std::min((unsigned int)s, n-D-1);
+        }
+        if(t>=knots_[n])
+            return std::lower_bound(knots_.begin()+D+1, knots_.begin()+n+1, knots_[n])-knots_.begin()-1;
+        return std::upper_bound(knots_.begin()+D+1, knots_.begin()+n, t)-knots_.begin()-1;
+    }
+
+    void addPoint(const double& point)
+    {
+        if(!canAddPoint(point))
+            return;
+        points_.push_back(point);
+        control_.push_back(point);
+        if(type_!=NonUniform)
+            generateKnots();
+    }
+
+    /**
+    * Replace a control point
+    * Only the D+1 spans influenced by the point change
+    * @param point - the point
+    * @param i - index of the control point
+    **/
+    void replacePoint(const double& point, const unsigned int& i)
+    {
+        if(i>=control_.size())
+            return;
+        control_[i] = point;
+        points_[i] = point;
+    }
+
+    virtual unsigned int degree() const {return D;}
+
+    /**
+    * Monomial coefficients of every non-empty span
+    * D+1 values per span (highest power first) in the local span parameter s in [0,1];
+    * together with breakpoints() they define the same curve as a PiecewisePolynomialCurve<D>
+    * @return vector<double> - the coefficients
+    **/
+    virtual vector<double> coeff() const
+    {
+        vector<double> c;
+        if(!defined())
+            return c;
+        vector<double> b = bezierControl();
+        c.resize(b.size());
+        for(size_t i=0;i<b.size();i+=D+1)
+            Math::bernsteinToMonomial(&b[i], D, &c[i]);
+        return c;
+    }
+
+    /**
+    * Distinct knots inside the domain mapped to the parameter range [0,1]
+    * @return vector<double> - breakpoints (spans+1 values)
+    **/
+    virtual vector<double> breakpoints() const
+    {
+        vector<double> res;
+        if(!defined())
+            return res;
+        Vector<2> d = domain();
+        for(unsigned int i=D;i<=control_.size();i++)
+            if(res.empty() || knots_[i]>knots_[i-1])
+                res.push_back((knots_[i]-d[0])/(d[1]-d[0]));
+        res.back() = 1.0;
+        return res;
+    }
+
+    /**
+    * Bezier control points of every non-empty span (extraction by knot insertion)
+    * @return vector<double> - D+1 control points per span
+    **/
+    vector<double> bezierControl() const
+    {
+        BSplineCurve c(*this);
+        unsigned int n = control_.size();
+        // domain ends as well, so that unclamped curves extract correctly
+        for(unsigned int i=D;i<=n;i++)
+        {
+            if(i>D && knots_[i]==knots_[i-1])
+                continue;
+            unsigned int m = multiplicity(knots_[i]);
+            if(m<D)
+                c.insertKnot(knots_[i], D-m);
+        }
+        vector<double> b;
+        // after extraction every interior knot has multiplicity D, spans start every D control points
+        for(unsigned int k=D;k<c.control_.size();k++)
+        {
+            if(c.knots_[k+1]==c.knots_[k])
+                continue;
+            b.insert(b.end(), c.control_.begin()+(k-D), c.control_.begin()+(k+1));
+        }
+        return b;
+    }
+
+    /**
+    * Multiplicity of a knot value
+    * @param t - knot value
+    * @return unsigned int - number of knots equal to t
+    **/
+    unsigned int multiplicity(const double& t) const
+    {
+        return std::upper_bound(knots_.begin(), knots_.end(), t)-std::lower_bound(knots_.begin(), knots_.end(), t);
+    }
+
+    /**
+    * Knot insertion (Boehm's algorithm) - the curve does not change
+    * Afterwards the knots are non-uniform
+    * @param t - knot value (inside the domain)
+    * @param times - how many times to insert it
+    **/
+    void insertKnot(const double& t, const unsigned int& times = 1)
+    {
+        if(!defined())
+            return;
+        Vector<2> d = domain();
+        if(t<d[0] || t>d[1])
+            return;
+        type_ = NonUniform;
+        for(unsigned int r=0;r<times;r++)
+        {
+            unsigned int k = findSpan(t);
+            vector<double> q(control_.size()+1);
+            for(unsigned int j=0;j<=k-D;j++)
+                q[j] = control_[j];
+            for(unsigned int j=k-D+1;j<=k;j++)
+            {
+                double a = (t-knots_[j])/(knots_[j+D]-knots_[j]);
+                q[j] = (1.0-a)*control_[j-1]+a*control_[j];
+            }
+            for(unsigned int j=k+1;j<q.size();j++)
+                q[j] = control_[j-1];
+            knots_.insert(knots_.begin()+k+1, t);
+            control_.swap(q);
+        }
+        syncPoints();
+    }
+
+    /**
+    * Refine the curve by inserting the midpoint of every non-empty span
+    * The control polygon converges to the curve under repeated subdivision
+    **/
+    void subdivide()
+    {
+        if(!defined())
+            return;
+        vector<double> mids;
+        for(unsigned int i=D;i<control_.size();i++)
+            if(knots_[i+1]>knots_[i])
+                mids.push_back(0.5*(knots_[i]+knots_[i+1]));
+        for(size_t i=0;i<mids.size();i++)
+            insertKnot(mids[i]);
+    }
+
+    /**
+    * Split the curve at a parameter
+    * Both parts are exact B-splines of the same degree (clamped at the split), each reparameterized to [0,1]
+    * @param u - split parameter in (0,1)
+    * @param left - curve on [0,u]
+    * @param right - curve on [u,1]
+    **/
+    void split(const double& u, BSplineCurve& left, BSplineCurve& right) const
+    {
+        if(!defined() || u<=0.0 || u>=1.0)
+            return;
+        BSplineCurve c(*this);
+        double t = knotValue(u);
+        unsigned int m = c.multiplicity(t);
+        if(m<D+1)
+            c.insertKnot(t, D+1-m);
+        unsigned int a = std::lower_bound(c.knots_.begin(), c.knots_.end(), t)-c.knots_.begin();
+        left = BSplineCurve(vector<double>(c.control_.begin(), c.control_.begin()+a),
+                            vector<double>(c.knots_.begin(), c.knots_.begin()+a+D+1));
+        right = BSplineCurve(vector<double>(c.control_.begin()+a, c.control_.end()),
+                             vector<double>(c.knots_.begin()+a, c.knots_.end()));
+    }
+
+    using Curve::getPoints;
+
+    virtual const double getPoint(const double& u) const
+    {
+        return getDerivative(u, 0);
+    }
+
+    /**
+    * Evaluate the curve at many parameters
+    * Spans and local control points are gathered per block so that the de Boor recurrences vectorize
+    **/
+    virtual void getPoints(const double* u, double* out, const size_t& n) const
+    {
+        getDerivatives(u, out, n, 0);
+    }
+
+    virtual const double getDerivative(const double& u, const unsigned int& order = 1) const
+    {
+        if(!defined())
+            return 0.0;
+        if(order>D)
+            return 0.0;
+        const Vector<2> dom = domain();
+        double t = dom[0]+std::min(std::max(u, 0.0), 1.0)*(dom[1]-dom[0]);
+        unsigned int k = findSpan(t);
+        double d[D+1];
+        for(unsigned int j=0;j<=D;j++)
+            d[j] = control_[k-D+j];
+        const double* kn = &knots_[k-D];
+        // derivative control points
+        for(unsigned int s=1;s<=order;s++)
+        {
+            unsigned int p = D-s+1;
+            for(unsigned int j=D;j>=s;j--)
+                d[j] = double(p)*(d[j]-d[j-1])/(kn[j+p]-kn[j]);
+        }
+        // de Boor on the remaining degree
+        unsigned int q = D-order;
+        for(unsigned int r=1;r<=q;r++)
+            for(unsigned int j=D;j>=order+r;j--)
+            {
+                double a = (t-kn[j])/(kn[j+q+1-r]-kn[j]);
+                d[j] = (1.0-a)*d[j-1]+a*d[j];
+            }
+        // chain rule for the mapping of [0,1] onto the domain
+        double scale = 1.0;
+        for(unsigned int s=0;s<order;s++)
+            scale *= dom[1]-dom[0];
+        return d[D]*scale;
+    }
+
+    virtual void getDerivatives(const double* u, double* out, const size_t& n, const unsigned int& order = 1) const
+    {
+        if(!defined() || order>D)
+        {
+            std::fill(out, out+n, 0.0);
+            return;
+        }
+        const size_t B = 64;
+        double d[D+1][B], kl[2*D+1][B], t[B];
+        const Vector<2> dom = domain();
+        double scale = 1.0;
+        for(unsigned int s=0;s<order;s++)
+            scale *= dom[1]-dom[0];
+        const unsigned int q = D-order;
+        for(size_t b=0;b<n;b+=B)
+        {
+            size_t m = std::min(B, n-b);
+            // gather
+            for(size_t i=0;i<m;i++)
+            {
+                t[i] = dom[0]+std::min(std::max(u[b+i], 0.0), 1.0)*(dom[1]-dom[0]);
+                unsigned int k = findSpan(t[i]);
+                for(unsigned int j=0;j<=D;j++)
+                    d[j][i] = control_[k-D+j];
+                for(unsigned int j=0;j<=2*D;j++)
+                    kl[j][i] = knots_[k-D+j];
+            }
+            for(unsigned int s=1;s<=order;s++)
+            {
+                unsigned int p = D-s+1;
+                for(unsigned int j=D;j>=s;j--)
+                    for(size_t i=0;i<m;i++)
+                        d[j][i] = double(p)*(d[j][i]-d[j-1][i])/(kl[j+p][i]-kl[j][i]);
+            }
+            for(unsigned int r=1;r<=q;r++)
+                for(unsigned int j=D;j>=order+r;j--)
+                    for(size_t i=0;i<m;i++)
+                    {
+                        double a = (t[i]-kl[j][i])/(kl[j+q+1-r][i]-kl[j][i]);
+                        d[j][i] = (1.0-a)*d[j-1][i]+a*d[j][i];
+                    }
+            for(size_t i=0;i<m;i++)
+                out[b+i] = d[D][i]*scale;
+        }
+    }
+
+protected:
+    void setControl(const vector<double>& control)
+    {
+        control_ = control;
+        if(type_!=NonUniform)
+            generateKnots();
+        syncPoints();
+    }
+
+    void syncPoints()
+    {
+        points_.clear();
+        for(size_t i=0;i<control_.size();i++)
+            points_.push_back(control_[i]);
+    }
+
+    void generateKnots()
+    {
+        unsigned int n = control_.size();
+        knots_.resize(n+D+1);
+        for(unsigned int i=0;i<n+D+1;i++)
+        {
+            if(type_==Uniform)
+                knots_[i] = double(i);
+            else
+                knots_[i] = std::min(std::max(double(i)-double(D), 0.0), double(n)-double(D));
+        }
+    }
+
+    void calculateCoefficients() {}
+
+    bool defined() const
+    {
+        unsigned int n = control_.size();
+        return n>=D+1 && knots_.size()==n+D+1 && knots_[n]>knots_[D];
+    }
+
+    bool canAddPoint(const double& point)
+    {
+        return type_!=NonUniform || control_.size()+D+1<knots_.size();
+    }
+
+    bool canAddDotPoint(const Vector<2>& point)
+    {
+        return false;
+    }
+
+    bool canAddDDotPoint(const Vector<2>& point)
+    {
+        return false;
+    }
+};
+
+/**
+* Typedefs for frequently used types
+**/
+typedef BSplineCurve<1> LinearBSplineCurve;
+
+typedef BSplineCurve<2> QuadraticBSplineCurve;
+
+typedef BSplineCurve<3> CubicBSplineCurve;
+
+} }
+
+#endif
@@ -0,0 +1,207 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_PRIMITIVES_1D_BEZIER_CURVE_H
+#define GEOMETRIC_TOOLS_PRIMITIVES_1D_BEZIER_CURVE_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Math/Polynomial.h>
+#include <geometric_tools/Primitives/1D/Curve.h>
+#include <vector>
+
+using std::vector;
+
+namespace GeometricTools {
+
+using Math::Vector;
+
+namespace Primitives {
+
+/**
+* BezierCurve Class
+* 1D (function) Bezier curve of degree N defined by N+1 control points
+* Evaluation uses the de Casteljau scheme directly on the control points (no linear system is solved)
+**/
+template<unsigned int N>
+class BezierCurve : public Curve
+{
+protected:
+    Vector<N+1> control_;
+    Vector<N+1> coefficients_;
+    bool coeff_defined_;
+public:
+    BezierCurve(): coeff_defined_(false) {}
+
+    /**
+    * Constructor
+    * @param control - control points
+    **/
+    BezierCurve(const Vector<N+1>& control): control_(control), coeff_defined_(true)
+    {
+        Math::bernsteinToMonomial(control_.data(), N, coefficients_.data());
+    }
+
+    /**
+    * Get control points
+    * @return Vector<N+1> - the control points
+    **/
+    const Vector<N+1>& control() const {return control_;}
+
+    /**
+    * Replace a control point
+    * @param point - the point
+    * @param i - index of the control point
+    **/
+    void replacePoint(const double& point, const unsigned int& i)
+    {
+        if(i>N || !defined())
+            return;
+        control_[i] = point;
+        if(i<points_.size())
+            points_[i] = point;
+        Math::bernsteinToMonomial(control_.data(), N, coefficients_.data());
+    }
+
+    virtual vector<double> coeff() const
+    {
+        return vector<double>(coefficients_.data(), coefficients_.data()+N+1);
+    }
+
+    using Curve::getPoints;
+
+    virtual const double getPoint(const double& u) const
+    {
+        return Math::deCasteljau<N>(control_.data(), u);
+    }
+
+    virtual void getPoints(const double* u, double* out, const size_t& n) const
+    {
+        Math::deCasteljauBatch<N>(control_.data(), u, out, n);
+    }
+
+    virtual const double getDerivative(const double& u, const unsigned int& order = 1) const
+    {
+        if(order>N)
+            return 0.0;
+        double b[N+1];
+        Math::bernsteinDerivative(control_.data(), N, order, b);
+        double v = 1.0-u;
+        for(unsigned int r=1;r<=N-order;r++)
+            for(unsigned int j=0;j<=N-order-r;j++)
+                b[j] = v*b[j]+u*b[j+1];
+        return b[0];
+    }
+
+    virtual void getDerivatives(const double* u, double* out, const size_t& n, const unsigned int& order = 1) const
+    {
+        if(order>N)
+        {
+            std::fill(out, out+n, 0.0);
+            return;
+        }
+        double b[N+1];
+        Math::bernsteinDerivative(control_.data(), N, order, b);
+        Math::deCasteljauBatch<N>(b, u, out, n, N-order);
+    }
+
+    /**
+    * Split the curve at a parameter
+    * Both halves are exact Bezier curves of the same degree, each reparameterized to [0,1]
+    * @param u - split parameter
+    * @param left - curve on [0,u]
+    * @param right - curve on [u,1]
+    **/
+    void subdivide(const double& u, BezierCurve& left, BezierCurve& right) const
+    {
+        Vector<N+1> l, r, w = control_;
+        double v = 1.0-u;
+        l[0] = w[0];
+        r[N] = w[N];
+        for(unsigned int k=1;k<=N;k++)
+        {
+            for(unsigned int j=0;j<=N-k;j++)
+                w[j] = v*w[j]+u*w[j+1];
+            l[k] = w[0];
+            r[N-k] = w[N-k];
+        }
+        left = BezierCurve(l);
+        right = BezierCurve(r);
+    }
+
+    /**
+    * Degree elevation
+    * @return BezierCurve<N+1> - the same curve with one more control point
+    **/
+    BezierCurve<N+1> elevate() const
+    {
+        Vector<N+2> e;
+        e[0] = control_[0];
+        e[N+1] = control_[N];
+        for(unsigned int i=1;i<=N;i++)
+        {
+            double a = double(i)/double(N+1);
+            e[i] = a*control_[i-1]+(1.0-a)*control_[i];
+        }
+        return BezierCurve<N+1>(e);
+    }
+
+protected:
+    void calculateCoefficients()
+    {
+        if(!defined())
+            return;
+        for(unsigned int i=0;i<=N;i++)
+            control_[i] = points_[i];
+        Math::bernsteinToMonomial(control_.data(), N, coefficients_.data());
+    }
+
+    bool defined() const
+    {
+        return coeff_defined_ || points_.size()==N+1;
+    }
+
+    bool canAddPoint(const double& point)
+    {
+        return points_.size()<=N;
+    }
+
+    bool canAddDotPoint(const Vector<2>& point)
+    {
+        return false;
+    }
+
+    bool canAddDDotPoint(const Vector<2>& point)
+    {
+        return false;
+    }
+};
+
+/**
+* Typedefs for frequently used types
+**/
+typedef BezierCurve<1> LinearBezierCurve;
+
+typedef BezierCurve<2> QuadraticBezierCurve;
+
+typedef BezierCurve<3> CubicBezierCurve;
+
+} }
+
+#endif
@@ -23,7 +23,8 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 **/
 #include <geometric_tools/Math/Vector.h>
 #include <geometric_tools/Math/Matrix.h>
-#include <geometric_tools/Math/LinearSystems/SolveLU.h>
+#include <geometric_tools/Primitives/1D/HermiteCurve.h>
+#include <geometric_tools/Math/Polynomial.h>
 #include <geometric_tools/Primitives/1D/Curve.h>
 #include <vector>
 
@@ -34,7 +35,6 @@ namespace GeometricTools {
 
 using Math::Matrix;
 using Math::Vector;
-using Math::LinearSystems::solveLU;
 
 namespace Primitives {
 
@@ -63,17 +63,41 @@ public:
         t_ = t;
     }
 
+    using Curve::getPoints;
+
     virtual const double getPoint(const double &u) const
     {
-        double s = 0.0;
-        for(int i=0;i<=3;i++)
-        {
-            s += coefficients_[i]*std::pow(u, double(3-i));
-        }
-        return s;
+        return Math::horner(coefficients_.data(), 3, u);
+    }
+
+    virtual void getPoints(const double* u, double* out, const size_t& n) const
+    {
+        Math::hornerBatch<3>(coefficients_.data(), u, out, n);
+    }
+
+    virtual const double getDerivative(const double& u, const unsigned int& order = 1) const
+    {
+        return Math::hornerDerivative(coefficients_.data(), 3, u, order);
+    }
+
+    virtual void getDerivatives(const double* u, double* out, const size_t& n, const unsigned int& order = 1) const
+    {
+        Math::hornerDerivativeBatch<3>(coefficients_.data(), u, out, n, order);
+    }
+
+    /**
+    * Set the four control points at once (replaces the current ones)
+    * @param points - p[-1], p[0], p[1], p[2] (the curve goes from p[0] to p[1])
+    **/
+    void setPoints(const double* points)
+    {
+        points_.clear();
+        for(int i=0;i<4;i++)
+            points_.push_back(points[i]);
+        calculateCoefficients();
     }
 
-    virtual vector<double> coeff()
+    virtual vector<double> coeff() const
     {
         vector<double> tmp;
         tmp.insert(tmp.begin(), coefficients_.data(), coefficients_.data()+4);
@@ -87,17 +111,12 @@ protected:
             return;
         double p0 = points_[1], pd0 = 0.5*(1.0-t_)*(points_[2]-points_[0]);
         double p1 = points_[2], pd1 = 0.5*(1.0-t_)*(points_[3]-points_[1]);
-        Matrix<4,4> A{0.0, 0.0, 0.0, 1.0,
-                      1.0, 1.0, 1.0, 1.0,
-                      0.0, 0.0, 1.0, 0.0,
-                      3.0, 2.0, 1.0, 0.0};
         if(p0!=p1)
         {
             pd0 /= (p1-p0);
             pd1 /= (p1-p0);
         }
-        Vector<4> y{p0, p1, pd0, pd1};
-        coefficients_ = solveLU(A, y);
+        hermiteCoefficients(p0, p1, pd0, pd1, coefficients_);
     }
 
     bool defined() const
@@ -60,26 +60,79 @@ public:
 
     void addPoint(const double& point)
     {
-        points_.push_back(point);
+        control_points_.push_back(point);
+        points_stale_ = true;
         if(defined())
             calculateCoefficients();
     }
 
+    /**
+    * Insert a control point
+    * Only the (at most four) pieces whose neighbourhood contains the point are recomputed
+    * @param point - the point
+    * @param i - index of the new control point
+    **/
+    void addPointInPlace(const double& point, const unsigned int& i)
+    {
+        if(i>=control_points_.size())
+            return addPoint(point);
+        control_points_.insert(i, point);
+        points_stale_ = true;
+        if(!defined())
+            return;
+        // piece j uses points j..j+3
+        unsigned int count = control_points_.size()-3;
+        unsigned int first = (i>3)? i-3 : 0;
+        unsigned int last = std::min(i+1, count);
+        curves_.insert(last-1, new CardinalCurve(t_));
+        for(unsigned int c=first;c<last;c++)
+            updatePiece(c);
+        notifyChange(first, last, 1);
+    }
+
+    /**
+    * Replace a control point
+    * Only the (at most four) pieces whose neighbourhood contains the point are recomputed
+    * @param point - the point
+    * @param i - index of the control point
+    **/
+    void replacePoint(const double& point, const unsigned int& i)
+    {
+        if(i>=control_points_.size())
+            return;
+        control_points_[i] = point;
+        points_stale_ = true;
+        if(!defined())
+            return;
+        unsigned int first = (i>3)? i-3 : 0;
+        unsigned int last = std::min(i+1, (unsigned int)curves_.size());
+        for(unsigned int c=first;c<last;c++)
+            updatePiece(c);
+        notifyChange(first, last, 0);
+    }
+
 protected:
+    void updatePiece(const unsigned int& c)
+    {
+        double p[4] = {control_points_[c], control_points_[c+1], control_points_[c+2], control_points_[c+3]};
+        ((CardinalCurve*)curves_[c])->setPoints(p);
+    }
+
     void calculateCoefficients()
     {
         if(!defined())
             return;
-        curves_.push_back(new CardinalCurve(t_));
-        for(int i=points_.size()-4;i<points_.size();i++)
+        while(curves_.size()+3<control_points_.size())
         {
-            ((CardinalCurve*)curves_[curves_.size()-1])->addPoint(points_[i]);
+            curves_.push_back(new CardinalCurve(t_));
+            updatePiece(curves_.size()-1);
+            notifyChange(curves_.size()-1, curves_.size(), 1);
         }
     }
 
     bool defined() const
     {
-        return (points_.size()>=4);
+        return (control_points_.size()>=4);
     }
 
     bool canAddPoint(const double& point)
@@ -0,0 +1,177 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_PRIMITIVES_1D_CUBIC_SPLINE_CURVE_H
+#define GEOMETRIC_TOOLS_PRIMITIVES_1D_CUBIC_SPLINE_CURVE_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Math/LinearSystems/SolveTridiagonal.h>
+#include <geometric_tools/Primitives/1D/PiecewisePolynomialCurve.h>
+#include <vector>
+
+using std::vector;
+
+namespace GeometricTools {
+
+using Math::Vector;
+using Math::LinearSystems::solveTridiagonal;
+using Math::LinearSystems::solveCyclicTridiagonal;
+
+namespace Primitives {
+
+/**
+* CubicSplineCurve Class
+* 1D (function) C2-continuous interpolating cubic spline over arbitrary (increasing) knots
+* The second derivatives at the knots come from one tridiagonal system (O(n)); the pieces are then stored in the
+* flat PiecewisePolynomialCurve<3> representation
+**/
+class CubicSplineCurve : public PiecewisePolynomialCurve<3>
+{
+public:
+    /**
+    * Boundary conditions
+    * Natural - zero second derivative at both ends
+    * Clamped - given first derivative at both ends
+    * Periodic - value, slope and curvature wrap around (the last value is taken equal to the first)
+    **/
+    enum Boundary {Natural, Clamped, Periodic};
+
+    CubicSplineCurve() {}
+
+    /**
+    * Constructor
+    * @param knots - increasing knots (at least 2)
+    * @param values - values at the knots
+    * @param boundary - boundary conditions
+    * @param slope_start - first derivative at the first knot (Clamped only)
+    * @param slope_end - first derivative at the last knot (Clamped only)
+    **/
+    CubicSplineCurve(const vector<double>& knots, const vector<double>& values, const Boundary& boundary = Natural, const double& slope_start = 0.0, const double& slope_end = 0.0)
+    {
+        interpolate(knots, values, boundary, slope_start, slope_end);
+    }
+
+    /**
+    * Compute the spline that interpolates values at knots
+    * @param knots - increasing knots (at least 2, at least 3 for Periodic)
+    * @param values - values at the knots
+    * @param boundary - boundary conditions
+    * @param slope_start - first derivative at the first knot (Clamped only)
+    * @param slope_end - first derivative at the last knot (Clamped only)
+    * @return bool - false if the input is invalid (the curve is left empty)
+    **/
+    bool interpolate(const vector<double>& knots, const vector<double>& values, const Boundary& boundary = Natural, const double& slope_start = 0.0, const double& slope_end = 0.0)
+    {
+        coefficients_.clear();
+        setUniformKnots();
+        unsigned int n = knots.size();
+        if(n<2 || values.size()!=n || (boundary==Periodic && n<3))
+            return false;
+        vector<double> h(n-1), y = values;
+        for(unsigned int i=0;i<n-1;i++)
+        {
+            h[i] = knots[i+1]-knots[i];
+            if(!(h[i]>0.0))
+                return false;
+        }
+        if(boundary==Periodic)
+            y[n-1] = y[0];
+
+        // second derivatives M at the knots
+        vector<double> M(n, 0.0);
+        if(boundary==Periodic)
+        {
+            // unknowns M[0..n-2], M[n-1] = M[0]
+            unsigned int m = n-1;
+            vector<double> a(m), b(m), c(m), d(m);
+            for(unsigned int i=0;i<m;i++)
+            {
+                unsigned int p = (i+m-1)%m;
+                double hp = h[p], hi = h[i];
+                a[i] = hp;
+                b[i] = 2.0*(hp+hi);
+                c[i] = hi;
+                double yp = (i==0)? y[m-1] : y[i-1];
+                d[i] = 6.0*((y[i+1]-y[i])/hi-(y[i]-yp)/hp);
+            }
+            vector<double> x;
+            if(m>=3)
+                x = solveCyclicTridiagonal(a, b, c, d);
+            else
+            {
+                // two unknowns: both neighbours are the same knot, so the cyclic system is a dense 2x2 one
+                double a00 = b[0], a01 = a[0]+c[0], a10 = a[1]+c[1], a11 = b[1];
+                double det = a00*a11-a01*a10;
+                if(det!=0.0)
+                    x = {(d[0]*a11-a01*d[1])/det, (a00*d[1]-a10*d[0])/det};
+            }
+            if(x.size()!=m)
+                return false;
+            for(unsigned int i=0;i<m;i++)
+                M[i] = x[i];
+            M[n-1] = M[0];
+        }
+        else
+        {
+            vector<double> a(n, 0.0), b(n, 0.0), c(n, 0.0), d(n, 0.0);
+            for(unsigned int i=1;i<n-1;i++)
+            {
+                a[i] = h[i-1];
+                b[i] = 2.0*(h[i-1]+h[i]);
+                c[i] = h[i];
+                d[i] = 6.0*((y[i+1]-y[i])/h[i]-(y[i]-y[i-1])/h[i-1]);
+            }
+            if(boundary==Clamped)
+            {
+                b[0] = 2.0*h[0];
+                c[0] = h[0];
+                d[0] = 6.0*((y[1]-y[0])/h[0]-slope_start);
+                a[n-1] = h[n-2];
+                b[n-1] = 2.0*h[n-2];
+                d[n-1] = 6.0*(slope_end-(y[n-1]-y[n-2])/h[n-2]);
+            }
+            else
+            {
+                b[0] = b[n-1] = 1.0;
+            }
+            M = solveTridiagonal(a, b, c, d);
+            if(M.size()!=n)
+                return false;
+        }
+
+        // pieces in the local parameter s = (u-knot[i])/h[i]
+        coefficients_.resize(4*(n-1));
+        for(unsigned int i=0;i<n-1;i++)
+        {
+            double hi = h[i], h2 = hi*hi;
+            double slope = (y[i+1]-y[i])/hi-hi*(2.0*M[i]+M[i+1])/6.0;
+            coefficients_[4*i] = (M[i+1]-M[i])*h2/6.0;
+            coefficients_[4*i+1] = M[i]*h2/2.0;
+            coefficients_[4*i+2] = slope*hi;
+            coefficients_[4*i+3] = y[i];
+        }
+        setKnots(knots);
+        return true;
+    }
+};
+
+} }
+
+#endif
@@ -24,6 +24,7 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 #include <geometric_tools/Math/Vector.h>
 #include <geometric_tools/Misc/Helper.h>
 #include <vector>
+#include <cstddef>
 
 using std::vector;
 
@@ -121,7 +122,69 @@ public:
 
     virtual const double getPoint(const double& u) const = 0;
 
-    virtual vector<double> coeff() = 0;
+    /**
+    * Evaluate the curve at many parameters
+    * Default implementation calls getPoint - subclasses override it with vectorized kernels
+    * @param u - parameters
+    * @param out - values (n elements, may alias u)
+    * @param n - number of parameters
+    **/
+    virtual void getPoints(const double* u, double* out, const size_t& n) const
+    {
+        for(size_t i=0;i<n;i++)
+            out[i] = getPoint(u[i]);
+    }
+
+    /**
+    * Derivative of the curve with respect to the parameter
+    * Default implementation uses central differences - subclasses override it with the exact derivative
+    * @param u - parameter
+    * @param order - order of the derivative
+    * @return double - the derivative
+    **/
+    virtual const double getDerivative(const double& u, const unsigned int& order = 1) const
+    {
+        if(order==0)
+            return getPoint(u);
+        const double h = 1e-4;
+        return (getDerivative(u+h, order-1)-getDerivative(u-h, order-1))/(2.0*h);
+    }
+
+    /**
+    * Derivatives of the curve at many parameters
+    * @param u - parameters
+    * @param out - derivatives (n elements, may alias u)
+    * @param n - number of parameters
+    * @param order - order of the derivative
+    **/
+    virtual void getDerivatives(const double* u, double* out, const size_t& n, const unsigned int& order = 1) const
+    {
+        for(size_t i=0;i<n;i++)
+            out[i] = getDerivative(u[i], order);
+    }
+
+    virtual vector<double> coeff() const = 0;
+
+    /**
+    * Degree of the polynomial piece(s) of the curve
+    * Default for single piece curves: coeff() holds degree+1 coefficients
+    * @return unsigned int - the degree
+    **/
+    virtual unsigned int degree() const
+    {
+        vector<double> c = coeff();
+        return c.empty()? 0 : c.size()-1;
+    }
+
+    /**
+    * Parameters where the polynomial pieces meet (including 0 and 1)
+    * coeff() holds degree+1 coefficients per piece in the local piece parameter [0,1]
+    * @return vector<double> - breakpoints (pieces+1 values)
+    **/
+    virtual vector<double> breakpoints() const
+    {
+        return vector<double>{0.0, 1.0};
+    }
 
     vector<double>& getPoints() { return points_; }
     vector<Vector<2> >& getDotPoints() { return dot_points_; }
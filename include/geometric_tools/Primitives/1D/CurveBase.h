@@ -0,0 +1,84 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_PRIMITIVES_1D_CURVE_BASE_H
+#define GEOMETRIC_TOOLS_PRIMITIVES_1D_CURVE_BASE_H
+
+/**
+* Includes
+**/
+#include <cstddef>
+
+namespace GeometricTools { namespace Primitives {
+
+/**
+* CurveBase Class
+* Static (CRTP) interface for 1D curves - the non-virtual counterpart of Curve
+* Derived classes implement:
+*   double evaluate(const double& u) const
+*   double derivative(const double& u, const unsigned int& order) const
+* and get the Curve-like evaluation API, which the compiler can inline at every call site
+**/
+template<class Derived>
+class CurveBase
+{
+public:
+    const Derived& derived() const {return static_cast<const Derived&>(*this);}
+
+    Derived& derived() {return static_cast<Derived&>(*this);}
+
+    const double getPoint(const double& u) const
+    {
+        return derived().evaluate(u);
+    }
+
+    /**
+    * Evaluate the curve at many parameters
+    * @param u - parameters
+    * @param out - values (n elements, may alias u)
+    * @param n - number of parameters
+    **/
+    void getPoints(const double* u, double* out, const size_t& n) const
+    {
+        const Derived& d = derived();
+        for(size_t i=0;i<n;i++)
+            out[i] = d.evaluate(u[i]);
+    }
+
+    const double getDerivative(const double& u, const unsigned int& order = 1) const
+    {
+        return derived().derivative(u, order);
+    }
+
+    /**
+    * Derivatives of the curve at many parameters
+    * @param u - parameters
+    * @param out - derivatives (n elements, may alias u)
+    * @param n - number of parameters
+    * @param order - order of the derivative
+    **/
+    void getDerivatives(const double* u, double* out, const size_t& n, const unsigned int& order = 1) const
+    {
+        const Derived& d = derived();
+        for(size_t i=0;i<n;i++)
+            out[i] = d.derivative(u[i], order);
+    }
+};
+
+} }
+
+#endif
@@ -23,7 +23,7 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 **/
 #include <geometric_tools/Math/Vector.h>
 #include <geometric_tools/Math/Matrix.h>
-#include <geometric_tools/Math/LinearSystems/SolveLU.h>
+#include <geometric_tools/Math/Polynomial.h>
 #include <geometric_tools/Primitives/1D/Curve.h>
 #include <vector>
 
@@ -34,10 +34,20 @@ namespace GeometricTools {
 
 using Math::Matrix;
 using Math::Vector;
-using Math::LinearSystems::solveLU;
 
 namespace Primitives {
 
+/**
+* Coefficients (highest power first) of the cubic with p(0)=p0, p(1)=p1, p'(0)=m0, p'(1)=m1
+**/
+inline void hermiteCoefficients(const double& p0, const double& p1, const double& m0, const double& m1, Vector<4>& coefficients)
+{
+    coefficients[0] = 2.0*p0-2.0*p1+m0+m1;
+    coefficients[1] = -3.0*p0+3.0*p1-2.0*m0-m1;
+    coefficients[2] = m0;
+    coefficients[3] = p0;
+}
+
 /**
 * HermiteCurve Class
 * 1D (function) Hermite Cubic curve
@@ -52,21 +62,49 @@ public:
 
     HermiteCurve(const Vector<4>& coef): coefficients_(coef), coeff_defined_(true) {}
 
-    virtual vector<double> coeff()
+    /**
+    * Set both control points at once (replaces the current ones)
+    * @param point0 - first point and slope
+    * @param point1 - second point and slope
+    **/
+    void setDotPoints(const Vector<2>& point0, const Vector<2>& point1)
+    {
+        points_.clear();
+        dot_points_.clear();
+        points_.push_back(point0[0]);
+        points_.push_back(point1[0]);
+        dot_points_.push_back(point0);
+        dot_points_.push_back(point1);
+        calculateCoefficients();
+    }
+
+    virtual vector<double> coeff() const
     {
         vector<double> tmp;
         tmp.insert(tmp.begin(), coefficients_.data(), coefficients_.data()+4);
         return tmp;
     }
 
+    using Curve::getPoints;
+
     virtual const double getPoint(const double &u) const
     {
-        double s = 0.0;
-        for(int i=0;i<=3;i++)
-        {
-            s += coefficients_[i]*std::pow(u, double(3-i));
-        }
-        return s;
+        return Math::horner(coefficients_.data(), 3, u);
+    }
+
+    virtual void getPoints(const double* u, double* out, const size_t& n) const
+    {
+        Math::hornerBatch<3>(coefficients_.data(), u, out, n);
+    }
+
+    virtual const double getDerivative(const double& u, const unsigned int& order = 1) const
+    {
+        return Math::hornerDerivative(coefficients_.data(), 3, u, order);
+    }
+
+    virtual void getDerivatives(const double* u, double* out, const size_t& n, const unsigned int& order = 1) const
+    {
+        Math::hornerDerivativeBatch<3>(coefficients_.data(), u, out, n, order);
     }
 
 protected:
@@ -76,17 +114,12 @@ protected:
             return;
         double p0 = points_[0], pd0 = dot_points_[0][1];
         double p1 = points_[1], pd1 = dot_points_[1][1];
-        Matrix<4,4> A{0.0, 0.0, 0.0, 1.0,
-                      1.0, 1.0, 1.0, 1.0,
-                      0.0, 0.0, 1.0, 0.0,
-                      3.0, 2.0, 1.0, 0.0};
         if(p0!=p1)
         {
             pd0 /= (p1-p0);
             pd1 /= (p1-p0);
         }
-        Vector<4> y{p0, p1, pd0, pd1};
-        coefficients_ = solveLU(A, y);
+        hermiteCoefficients(p0, p1, pd0, pd1, coefficients_);
     }
 
     bool defined() const
@@ -48,92 +48,84 @@ public:
 
     void addDotPoint(const Vector<2> &point)
     {
-        points_.push_back(point[0]);
-        dot_points_.push_back(point);
+        control_points_.push_back(point[0]);
+        control_dot_points_.push_back(point);
+        points_stale_ = true;
         if(defined())
             calculateCoefficients();
     }
 
+    /**
+    * Insert a control point
+    * Only the piece that is split is recomputed and one piece is created
+    * @param point - point and slope
+    * @param i - index of the new control point
+    **/
     void addDotPointInPlace(const Vector<2>& point, const unsigned int& i)
     {
-        if(i>=points_.size())
+        if(i>=control_points_.size())
             return addDotPoint(point);
-        int c = int(i)-1;
-        if(c<0)
+        control_points_.insert(i, point[0]);
+        control_dot_points_.insert(i, point);
+        points_stale_ = true;
+        if(!defined())
+            return;
+        if(i==0)
         {
-            points_.insert(points_.begin(), point[0]);
-            dot_points_.insert(dot_points_.begin(), point);
-            curves_.insert(curves_.begin(), new HermiteCurve());
-            ((HermiteCurve*)curves_[0])->addDotPoint(dot_points_[0]);
-            ((HermiteCurve*)curves_[0])->addDotPoint(dot_points_[1]);
+            curves_.insert(0, new HermiteCurve());
+            updatePiece(0);
+            notifyChange(0, 1, 1);
             return;
         }
-        curves_[c]->getPoints().clear();
-        curves_[c]->getDotPoints().clear();
-        points_.insert(points_.begin()+i, point[0]);
-        dot_points_.insert(dot_points_.begin()+i, point);
-        ((HermiteCurve*)curves_[c])->addDotPoint(dot_points_[i-1]);
-        ((HermiteCurve*)curves_[c])->addDotPoint(dot_points_[i]);
-        curves_.insert(curves_.begin()+i, new HermiteCurve());
-        ((HermiteCurve*)curves_[i])->addDotPoint(dot_points_[i]);
-        ((HermiteCurve*)curves_[i])->addDotPoint(dot_points_[i+1]);
+        curves_.insert(i, new HermiteCurve());
+        updatePiece(i-1);
+        updatePiece(i);
+        notifyChange(i-1, i+1, 1);
     }
 
+    /**
+    * Replace a control point
+    * Only the (at most two) pieces that use it are recomputed
+    * @param point - point and slope
+    * @param i - index of the control point
+    **/
     void replaceDotPoint(const Vector<2>& point, const unsigned int &i)
     {
-        if(i>=points_.size())
-            return;
-        int c = int(i)-1;
-        if(c<0)
-        {
-            points_[0] = point[0];
-            dot_points_[0] = point;
-            curves_[0]->getPoints().clear();
-            curves_[0]->getDotPoints().clear();
-            ((HermiteCurve*)curves_[0])->addDotPoint(dot_points_[0]);
-            ((HermiteCurve*)curves_[0])->addDotPoint(dot_points_[1]);
+        if(i>=control_points_.size())
             return;
-        }
-        if(i==(points_.size()-1))
-        {
-            points_[i] = point[0];
-            dot_points_[i] = point;
-            curves_[c]->getPoints().clear();
-            curves_[c]->getDotPoints().clear();
-            ((HermiteCurve*)curves_[c])->addDotPoint(dot_points_[i-1]);
-            ((HermiteCurve*)curves_[c])->addDotPoint(dot_points_[i]);
+        control_points_[i] = point[0];
+        control_dot_points_[i] = point;
+        points_stale_ = true;
+        if(!defined())
             return;
-        }
-        points_[i] = point[0];
-        dot_points_[i] = point;
-        // change previous piece
-        curves_[c]->getPoints().clear();
-        curves_[c]->getDotPoints().clear();
-        ((HermiteCurve*)curves_[c])->addDotPoint(dot_points_[i-1]);
-        ((HermiteCurve*)curves_[c])->addDotPoint(dot_points_[i]);
-        // change next piece
-        curves_[i]->getPoints().clear();
-        curves_[i]->getDotPoints().clear();
-        ((HermiteCurve*)curves_[i])->addDotPoint(dot_points_[i]);
-        ((HermiteCurve*)curves_[i])->addDotPoint(dot_points_[i+1]);
+        unsigned int first = (i>0)? i-1 : 0;
+        unsigned int last = std::min(i+1, (unsigned int)curves_.size());
+        for(unsigned int c=first;c<last;c++)
+            updatePiece(c);
+        notifyChange(first, last, 0);
     }
 
 protected:
+    void updatePiece(const unsigned int& c)
+    {
+        ((HermiteCurve*)curves_[c])->setDotPoints(control_dot_points_[c], control_dot_points_[c+1]);
+    }
+
     void calculateCoefficients()
     {
         if(!defined())
             return;
-        for(int i=dot_points_.size()-2;i<dot_points_.size()-1;i++)
+        while(curves_.size()+1<control_dot_points_.size())
         {
             curves_.push_back(new HermiteCurve());
-            ((HermiteCurve*)curves_[i])->addDotPoint(dot_points_[i]);
-            ((HermiteCurve*)curves_[i])->addDotPoint(dot_points_[i+1]);
+            updatePiece(curves_.size()-1);
+            notifyChange(curves_.size()-1, curves_.size(), 1);
         }
     }
 
     bool defined() const
     {
-        return (points_.size()>=2 && dot_points_.size()>=2);
+        return (control_points_.size()>=2 && control_dot_points_.size()>=2);
     }
 
     bool canAddPoint(const double& point)
@@ -25,7 +25,11 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 
 #include <geometric_tools/Math/Vector.h>
 #include <geometric_tools/Math/Matrix.h>
+#include <geometric_tools/Misc/GapBuffer.h>
 #include <vector>
+#include <cmath>
+#include <algorithm>
+#include <functional>
 
 using std::vector;
 
@@ -37,6 +41,21 @@ using Math::Vector;
 
 namespace Primitives {
 
+/**
+* CurveChange struct
+* Describes an edit of a piecewise curve, so that caches (sampled polylines, bounding boxes...) can update incrementally
+* Pieces [first,last) of the edited curve have new coefficients; `inserted` pieces were added inside that range
+* (negative if removed), so old pieces from index last-inserted onwards are unchanged but now have index +inserted
+* u_min/u_max is the parameter range of the changed pieces in the edited curve
+* (PiecewiseCurve uses a uniform parameterization, so when inserted!=0 the other pieces also move in parameter space)
+**/
+struct CurveChange
+{
+    unsigned int first, last;
+    int inserted;
+    double u_min, u_max;
+};
+
 /**
 * PiecewiseCurve Class
 * Abstract 1D piecewise curve - base class for all 1D piecewise curves
@@ -44,9 +63,26 @@ namespace Primitives {
 class PiecewiseCurve : public Curve
 {
 protected:
-    vector<Curve*> curves_;
+    GapBuffer<Curve*> curves_;
+    // control points of the pieces, gap buffered so that an insertion in the middle does not shift the whole array
+    GapBuffer<double> control_points_;
+    GapBuffer<Vector<2> > control_dot_points_;
+    bool points_stale_;
+    vector<std::function<void(const CurveChange&)> > listeners_;
+
+    /**
+    * Copy the control points to the vectors returned by getPoints/getDotPoints (only after an edit)
+    **/
+    void syncPoints()
+    {
+        if(!points_stale_)
+            return;
+        points_ = control_points_.toVector();
+        dot_points_ = control_dot_points_.toVector();
+        points_stale_ = false;
+    }
 public:
-    PiecewiseCurve() {}
+    PiecewiseCurve(): points_stale_(false) {}
 
     ~PiecewiseCurve()
     {
@@ -57,7 +93,7 @@ public:
         }
     }
 
-    virtual vector<double> coeff()
+    virtual vector<double> coeff() const
     {
         if(curves_.size()==0)
             return vector<double>();
@@ -70,6 +106,64 @@ public:
         return coef;
     }
 
+    /**
+    * Get the number of pieces
+    * @return unsigned int - number of pieces
+    **/
+    unsigned int pieces() const {return curves_.size();}
+
+    virtual unsigned int degree() const
+    {
+        return curves_.empty()? 0 : curves_[0]->degree();
+    }
+
+    virtual vector<double> breakpoints() const
+    {
+        vector<double> b(curves_.size()+1);
+        for(unsigned int i=0;i<b.size();i++)
+            b[i] = double(i)/double(curves_.size());
+        return b;
+    }
+
+    /**
+    * Register a function to be called after every edit
+    * @param listener - callable listener(const CurveChange&)
+    * @return unsigned int - id of the listener (for removeChangeListener)
+    **/
+    unsigned int addChangeListener(const std::function<void(const CurveChange&)>& listener)
+    {
+        listeners_.push_back(listener);
+        return listeners_.size()-1;
+    }
+
+    void removeChangeListener(const unsigned int& id)
+    {
+        if(id<listeners_.size())
+            listeners_[id] = nullptr;
+    }
+
+    using Curve::getPoints;
+
+    /**
+    * Control points (copied out of the gap buffer on the first call after an edit - edit them through the add/replace methods)
+    * @return vector<double>& - the points
+    **/
+    vector<double>& getPoints()
+    {
+        syncPoints();
+        return points_;
+    }
+
+    /**
+    * Control points with slopes (copied out of the gap buffer on the first call after an edit)
+    * @return vector<Vector<2> >& - the points and slopes
+    **/
+    vector<Vector<2> >& getDotPoints()
+    {
+        syncPoints();
+        return dot_points_;
+    }
+
     const double getPoint(const double &u) const
     {
         // Assumes that all the piecewise curve is in u[0,1]
@@ -78,12 +172,91 @@ public:
             return 0.0;
         return curves_[c]->getPoint(u*curves_.size()-c);
     }
+
+    /**
+    * Evaluate the curve at many parameters
+    * Consecutive parameters that fall in the same piece are evaluated with one batched call of that piece
+    * @param u - parameters
+    * @param out - values (n elements, may alias u)
+    * @param n - number of parameters
+    **/
+    void getPoints(const double* u, double* out, const size_t& n) const
+    {
+        evaluateRuns(u, out, n, 0);
+    }
+
+    const double getDerivative(const double& u, const unsigned int& order = 1) const
+    {
+        int c = getCurveFromU(u*curves_.size());
+        if(c==-1)
+            return 0.0;
+        return curves_[c]->getDerivative(u*curves_.size()-c, order)*std::pow(double(curves_.size()), double(order));
+    }
+
+    void getDerivatives(const double* u, double* out, const size_t& n, const unsigned int& order = 1) const
+    {
+        evaluateRuns(u, out, n, order);
+    }
 protected:
+    /**
+    * Inform the listeners that pieces [first,last) changed and `inserted` pieces were added in that range
+    **/
+    void notifyChange(const unsigned int& first, const unsigned int& last, const int& inserted)
+    {
+        if(listeners_.empty())
+            return;
+        CurveChange change;
+        change.first = first;
+        change.last = last;
+        change.inserted = inserted;
+        double m = std::max(1.0, double(curves_.size()));
+        change.u_min = first/m;
+        change.u_max = last/m;
+        for(unsigned int i=0;i<listeners_.size();i++)
+        {
+            if(listeners_[i])
+                listeners_[i](change);
+        }
+    }
+
+    void evaluateRuns(const double* u, double* out, const size_t& n, const unsigned int& order) const
+    {
+        if(curves_.size()==0)
+        {
+            std::fill(out, out+n, 0.0);
+            return;
+        }
+        double m = double(curves_.size()), scale = std::pow(m, double(order));
+        size_t i = 0;
+        while(i<n)
+        {
+            int c = getCurveFromU(u[i]*m);
+            size_t j = i;
+            // local parameters are written to out and evaluated in place
+            while(j<n && getCurveFromU(u[j]*m)==c)
+            {
+                out[j] = u[j]*m-c;
+                j++;
+            }
+            if(order==0)
+                curves_[c]->getPoints(out+i, out+i, j-i);
+            else
+            {
+                curves_[c]->getDerivatives(out+i, out+i, j-i, order);
+                for(size_t k=i;k<j;k++)
+                    out[k] *= scale;
+            }
+            i = j;
+        }
+    }
+
     const int getCurveFromU(const double& u) const
     {
         if(curves_.size()==0)
             return -1;
         int c = int(u);
+        if(c<0)
+            c = 0;
         if(c>=curves_.size())
             c = curves_.size()-1;
         return c;
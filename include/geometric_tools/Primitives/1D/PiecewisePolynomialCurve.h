@@ -0,0 +1,389 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_PRIMITIVES_1D_PIECEWISE_POLYNOMIAL_CURVE_H
+#define GEOMETRIC_TOOLS_PRIMITIVES_1D_PIECEWISE_POLYNOMIAL_CURVE_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Math/Polynomial.h>
+#include <geometric_tools/Primitives/1D/CurveBase.h>
+#include <geometric_tools/Primitives/1D/PiecewiseCurve.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+using std::vector;
+
+namespace GeometricTools {
+
+using Math::Vector;
+
+namespace Primitives {
+
+/**
+* PiecewisePolynomialCurve Class
+* 1D (function) piecewise polynomial curve of degree D with flat storage and static dispatch
+* The coefficients of all the pieces live in one array (D+1 per piece, highest power first) and evaluation is
+* resolved at compile time. Piece i spans [knot(i),knot(i+1)] and is evaluated with a local parameter in [0,1].
+* Knots are uniform over [0,1] by default (same parameterization as PiecewiseCurve, O(1) lookup); non-uniform
+* knots are located by binary search, or by a Cursor when sampling sequentially
+**/
+template<unsigned int D>
+class PiecewisePolynomialCurve : public CurveBase<PiecewisePolynomialCurve<D> >
+{
+protected:
+    vector<double> coefficients_;
+    // non-uniform knots (pieces+1 values, empty when the knots are uniform)
+    vector<double> knots_;
+    // uniform knots: first knot and piece length
+    double u0_, h_;
+    bool uniform_;
+public:
+    PiecewisePolynomialCurve(): u0_(0.0), h_(1.0), uniform_(true) {}
+
+    /**
+    * Constructor
+    * @param coefficients - coefficients of all the pieces (D+1 per piece, highest power first)
+    **/
+    PiecewisePolynomialCurve(const vector<double>& coefficients): coefficients_(coefficients), u0_(0.0), h_(1.0), uniform_(true)
+    {
+        coefficients_.resize(coefficients_.size()-coefficients_.size()%(D+1));
+        setUniformKnots();
+    }
+
+    /**
+    * Constructor
+    * @param coefficients - coefficients of all the pieces (D+1 per piece, highest power first)
+    * @param knots - sorted knots (pieces+1 values)
+    **/
+    PiecewisePolynomialCurve(const vector<double>& coefficients, const vector<double>& knots): PiecewisePolynomialCurve(coefficients)
+    {
+        setKnots(knots);
+    }
+
+    /**
+    * Constructor
+    * Copies the pieces of a (virtual) piecewise curve whose pieces have degree D
+    * @param curve - the piecewise curve
+    **/
+    explicit PiecewisePolynomialCurve(const PiecewiseCurve& curve): PiecewisePolynomialCurve(curve.coeff()) {}
+
+    /**
+    * Append a piece
+    * With uniform knots the pieces are spread again over the same range (like PiecewiseCurve)
+    * @param coef - coefficients of the piece (highest power first)
+    **/
+    void addPiece(const Vector<D+1>& coef)
+    {
+        if(uniform_)
+        {
+            double u1 = u0_+h_*pieces();
+            coefficients_.insert(coefficients_.end(), coef.data(), coef.data()+(D+1));
+            setUniformKnots(u0_, (pieces()>1)? u1 : u0_+1.0);
+            return;
+        }
+        coefficients_.insert(coefficients_.end(), coef.data(), coef.data()+(D+1));
+        knots_.push_back(knots_.back()+(knots_.back()-knots_[knots_.size()-2]));
+    }
+
+    /**
+    * Append a piece that ends at a given knot
+    * @param coef - coefficients of the piece (highest power first)
+    * @param knot - end knot of the piece (greater than the current last knot)
+    **/
+    void addPiece(const Vector<D+1>& coef, const double& knot)
+    {
+        if(pieces()==0)
+        {
+            coefficients_.insert(coefficients_.end(), coef.data(), coef.data()+(D+1));
+            setUniformKnots(u0_, knot);
+            return;
+        }
+        if(uniform_)
+        {
+            double u1 = u0_+h_*pieces();
+            if(std::abs((knot-u1)-h_)<=1e-12*std::abs(knot-u0_))
+            {
+                coefficients_.insert(coefficients_.end(), coef.data(), coef.data()+(D+1));
+                return;
+            }
+            knots_ = knots();
+            uniform_ = false;
+        }
+        coefficients_.insert(coefficients_.end(), coef.data(), coef.data()+(D+1));
+        knots_.push_back(knot);
+    }
+
+    /**
+    * Replace the coefficients of a piece
+    * @param i - index of the piece
+    * @param coef - coefficients of the piece (highest power first)
+    **/
+    void setPiece(const unsigned int& i, const Vector<D+1>& coef)
+    {
+        std::copy(coef.data(), coef.data()+(D+1), coefficients_.begin()+i*(D+1));
+    }
+
+    /**
+    * Use uniform knots
+    * @param u_min - first knot
+    * @param u_max - last knot
+    **/
+    void setUniformKnots(const double& u_min = 0.0, const double& u_max = 1.0)
+    {
+        knots_.clear();
+        uniform_ = true;
+        u0_ = u_min;
+        h_ = (u_max-u_min)/std::max(1u, pieces());
+    }
+
+    /**
+    * Use non-uniform knots (uniform knots are detected and get the O(1) lookup)
+    * @param knots - sorted knots (pieces+1 values)
+    **/
+    void setKnots(const vector<double>& knots)
+    {
+        unsigned int m = pieces();
+        if(knots.size()!=m+1)
+            return;
+        double h = (knots[m]-knots[0])/m;
+        bool uniform = true;
+        for(unsigned int i=1;i<m && uniform;i++)
+            uniform = std::abs(knots[i]-(knots[0]+i*h))<=1e-12*std::abs(knots[m]-knots[0]);
+        if(uniform)
+            return setUniformKnots(knots[0], knots[m]);
+        knots_ = knots;
+        uniform_ = false;
+    }
+
+    bool uniformKnots() const {return uniform_;}
+
+    /**
+    * Get a knot
+    * @param i - index of the knot (0..pieces)
+    * @return double - the knot
+    **/
+    double knot(const unsigned int& i) const {return uniform_? u0_+h_*i : knots_[i];}
+
+    /**
+    * Get all the knots
+    * @return vector<double> - pieces+1 knots
+    **/
+    vector<double> knots() const
+    {
+        if(!uniform_)
+            return knots_;
+        vector<double> k(pieces()+1);
+        for(unsigned int i=0;i<k.size();i++)
+            k[i] = knot(i);
+        return k;
+    }
+
+    unsigned int pieces() const {return coefficients_.size()/(D+1);}
+
+    unsigned int degree() const {return D;}
+
+    /**
+    * Same as knots() - named like Curve::breakpoints() so that both curve families can be decomposed alike
+    **/
+    vector<double> breakpoints() const {return knots();}
+
+    /**
+    * Get the coefficients of a piece
+    * @param i - index of the piece
+    * @return const double* - D+1 coefficients (highest power first)
+    **/
+    const double* piece(const unsigned int& i) const {return coefficients_.data()+i*(D+1);}
+
+    /**
+    * Get the coefficients of all the pieces (no copy is made)
+    * @return vector<double> - D+1 coefficients per piece
+    **/
+    const vector<double>& coeff() const {return coefficients_;}
+
+    /**
+    * Find the piece that contains a parameter
+    * O(1) for uniform knots, binary search otherwise; parameters outside the knots map to the first/last piece
+    * @param u - parameter
+    * @return unsigned int - index of the piece
+    **/
+    unsigned int findPiece(const double& u) const
+    {
+        unsigned int m = pieces();
+        if(uniform_)
+        {
+            double t = (u-u0_)/h_;
+            if(!(t>0.0))
+                return 0;
+            if(t>=double(m))
+                return m-1;
+            return (unsigned int)t;
+        }
+        unsigned int c = std::upper_bound(knots_.begin()+1, knots_.end()-1, u)-(knots_.begin()+1);
+        return c;
+    }
+
+    double evaluate(const double& u) const
+    {
+        if(pieces()==0)
+            return 0.0;
+        return evaluatePiece(findPiece(u), u);
+    }
+
+    double derivative(const double& u, const unsigned int& order = 1) const
+    {
+        if(pieces()==0)
+            return 0.0;
+        return derivativePiece(findPiece(u), u, order);
+    }
+
+    /**
+    * Evaluate a given piece (no lookup)
+    * @param c - index of the piece
+    * @param u - (global) parameter
+    * @return double - value of the piece
+    **/
+    double evaluatePiece(const unsigned int& c, const double& u) const
+    {
+        double k = knot(c), h = uniform_? h_ : knots_[c+1]-k;
+        return Math::horner<D>(piece(c), (u-k)/h);
+    }
+
+    /**
+    * Derivative of a given piece (no lookup)
+    * @param c - index of the piece
+    * @param u - (global) parameter
+    * @param order - order of the derivative
+    * @return double - derivative of the piece
+    **/
+    double derivativePiece(const unsigned int& c, const double& u, const unsigned int& order = 1) const
+    {
+        double k = knot(c), h = uniform_? h_ : knots_[c+1]-k;
+        return Math::hornerDerivative(piece(c), D, (u-k)/h, order)/std::pow(h, double(order));
+    }
+
+    /**
+    * Cursor Class
+    * Remembers the last piece used, so sampling a (mostly) monotone sequence of parameters costs O(1) per sample
+    **/
+    class Cursor
+    {
+    protected:
+        const PiecewisePolynomialCurve* curve_;
+        unsigned int piece_;
+    public:
+        Cursor(const PiecewisePolynomialCurve& curve): curve_(&curve), piece_(0) {}
+
+        /**
+        * Move the cursor to the piece that contains a parameter
+        * Walks a few pieces from the current one before falling back to findPiece
+        * @param u - parameter
+        * @return unsigned int - index of the piece
+        **/
+        unsigned int seek(const double& u)
+        {
+            const PiecewisePolynomialCurve& c = *curve_;
+            unsigned int m = c.pieces();
+            if(m==0)
+                return 0;
+            if(c.uniform_)
+                return (piece_ = c.findPiece(u));
+            for(unsigned int steps=0;steps<4;steps++)
+            {
+                if(piece_+1<m && u>=c.knots_[piece_+1])
+                    piece_++;
+                else if(piece_>0 && u<c.knots_[piece_])
+                    piece_--;
+                else
+                    return piece_;
+            }
+            return (piece_ = c.findPiece(u));
+        }
+
+        unsigned int piece() const {return piece_;}
+
+        double getPoint(const double& u)
+        {
+            if(curve_->pieces()==0)
+                return 0.0;
+            return curve_->evaluatePiece(seek(u), u);
+        }
+
+        double getDerivative(const double& u, const unsigned int& order = 1)
+        {
+            if(curve_->pieces()==0)
+                return 0.0;
+            return curve_->derivativePiece(seek(u), u, order);
+        }
+    };
+
+    Cursor cursor() const {return Cursor(*this);}
+
+    /**
+    * Evaluate the curve at many parameters
+    * Uniform knots map every parameter to its piece and local parameter with one multiplication;
+    * otherwise a Cursor is used, so sorted parameters are cheapest
+    * @param u - parameters
+    * @param out - values (n elements, may alias u)
+    * @param n - number of parameters
+    **/
+    void getPoints(const double* u, double* out, const size_t& n) const
+    {
+        if(uniform_ && pieces()>0)
+        {
+            const double inv = 1.0/h_, m = pieces();
+            for(size_t i=0;i<n;i++)
+            {
+                double t = (u[i]-u0_)*inv;
+                unsigned int c = (t>0.0)? ((t<m)? (unsigned int)t : (unsigned int)m-1) : 0;
+                out[i] = Math::horner<D>(piece(c), t-c);
+            }
+            return;
+        }
+        Cursor cur(*this);
+        for(size_t i=0;i<n;i++)
+            out[i] = cur.getPoint(u[i]);
+    }
+
+    /**
+    * Derivatives of the curve at many parameters (uses a Cursor, so sorted parameters are cheapest)
+    * @param u - parameters
+    * @param out - derivatives (n elements, may alias u)
+    * @param n - number of parameters
+    * @param order - order of the derivative
+    **/
+    void getDerivatives(const double* u, double* out, const size_t& n, const unsigned int& order = 1) const
+    {
+        Cursor cur(*this);
+        for(size_t i=0;i<n;i++)
+            out[i] = cur.getDerivative(u[i], order);
+    }
+};
+
+/**
+* Typedefs for frequently used types
+**/
+typedef PiecewisePolynomialCurve<1> PiecewiseLinearCurve;
+
+typedef PiecewisePolynomialCurve<3> PiecewiseCubicCurve;
+
+} }
+
+#endif
@@ -24,12 +24,12 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 #include <geometric_tools/Math/Vector.h>
 #include <geometric_tools/Math/Matrix.h>
 #include <geometric_tools/Math/LinearSystems/SolveLinear.h>
+#include <geometric_tools/Math/Polynomial.h>
 #include <geometric_tools/Primitives/1D/Curve.h>
 #include <vector>
-#include <map>
+#include <algorithm>
 
 using std::vector;
-using std::map;
 
 
 namespace GeometricTools {
@@ -51,26 +51,110 @@ protected:
     Vector<N+1> coefficients_;
     bool coeff_defined_;
     int n;
+    // index in points_ of every slope/curvature constraint (constraints are parameterized by index, not value)
+    vector<unsigned int> dot_index_, ddot_index_;
 public:
     PolynomialCurve(): coeff_defined_(false), n(N) {}
 
     PolynomialCurve(const Vector<N+1>& coef): coefficients_(coef), coeff_defined_(true), n(N) {}
 
-    virtual vector<double> coeff()
+    virtual vector<double> coeff() const
     {
         vector<double> tmp;
         tmp.insert(tmp.begin(), coefficients_.data(), coefficients_.data()+(n+1));
         return tmp;
     }
 
+    /**
+    * Add a point with a slope constraint
+    * The slope applies at the parameter of the new point (its index), so repeated values stay distinct
+    * @param point - point and slope
+    **/
+    void addDotPoint(const Vector<2>& point)
+    {
+        if(defined() || !canAddDotPoint(point))
+            return;
+        dot_index_.push_back(points_.size());
+        points_.push_back(point[0]);
+        dot_points_.push_back(point);
+        if(defined())
+            calculateCoefficients();
+    }
+
+    /**
+    * Insert a point with a slope constraint
+    * The points from index i on (and their constraints) move one parameter step further
+    * @param point - point and slope
+    * @param i - index of the new point (appended if past the end)
+    **/
+    void addDotPointInPlace(const Vector<2>& point, const unsigned int& i)
+    {
+        if(defined() || !canAddDotPoint(point))
+            return;
+        unsigned int k = std::min(i, (unsigned int)points_.size());
+        shiftConstraints(k);
+        dot_index_.push_back(k);
+        points_.insert(points_.begin()+k, point[0]);
+        dot_points_.push_back(point);
+        if(defined())
+            calculateCoefficients();
+    }
+
+    /**
+    * Add a point with a curvature (second derivative) constraint
+    * The constraint applies at the parameter of the new point (its index), so repeated values stay distinct
+    * @param point - point and second derivative
+    **/
+    void addDDotPoint(const Vector<2>& point)
+    {
+        if(defined() || !canAddDDotPoint(point))
+            return;
+        ddot_index_.push_back(points_.size());
+        points_.push_back(point[0]);
+        ddot_points_.push_back(point);
+        if(defined())
+            calculateCoefficients();
+    }
+
+    /**
+    * Insert a point with a curvature (second derivative) constraint
+    * The points from index i on (and their constraints) move one parameter step further
+    * @param point - point and second derivative
+    * @param i - index of the new point (appended if past the end)
+    **/
+    void addDDotPointInPlace(const Vector<2>& point, const unsigned int& i)
+    {
+        if(defined() || !canAddDDotPoint(point))
+            return;
+        unsigned int k = std::min(i, (unsigned int)points_.size());
+        shiftConstraints(k);
+        ddot_index_.push_back(k);
+        points_.insert(points_.begin()+k, point[0]);
+        ddot_points_.push_back(point);
+        if(defined())
+            calculateCoefficients();
+    }
+
+    using Curve::getPoints;
+
     virtual const double getPoint(const double &u) const
     {
-        double s = 0.0;
-        for(int i=0;i<=n;i++)
-        {
-            s += coefficients_[i]*std::pow(u, double(n-i));
-        }
-        return s;
+        return Math::horner(coefficients_.data(), N, u);
+    }
+
+    virtual void getPoints(const double* u, double* out, const size_t& n) const
+    {
+        Math::hornerBatch<N>(coefficients_.data(), u, out, n);
+    }
+
+    virtual const double getDerivative(const double& u, const unsigned int& order = 1) const
+    {
+        return Math::hornerDerivative(coefficients_.data(), N, u, order);
+    }
+
+    virtual void getDerivatives(const double* u, double* out, const size_t& n, const unsigned int& order = 1) const
+    {
+        Math::hornerDerivativeBatch<N>(coefficients_.data(), u, out, n, order);
     }
 
 protected:
@@ -81,43 +165,75 @@ protected:
 
         Matrix<N+1,N+1> A;
         Vector<N+1> y;
-        map<double,double> us;
-        for(int i=0;i<points_.size();i++)
-        {
-            double d = double(points_.size()-1);
-            if(points_.size()<=1)
-                d = 1.0;
-            us[points_[i]] = double(i)/d;
-        }
+        // every constraint is parameterized by the index of its point (a lookup by value breaks for repeated values)
+        double d = (points_.size()>1)? double(points_.size()-1) : 1.0;
         int ddot = ddot_points_.size();
         int dot = dot_points_.size();
         for(int i=0;i<ddot;i++)
         {
             y[i] = ddot_points_[i][1];
+            double u = constraintParameter(ddot_index_, ddot_points_, i, d);
             for(int j=0;j<=n-2;j++)
             {
-                A(i,j) = (n-j)*(n-j-1)*std::pow(us[ddot_points_[i][0]], n-j-2);
+                A(i,j) = (n-j)*(n-j-1)*std::pow(u, n-j-2);
             }
         }
         for(int i=ddot;i<ddot+dot;i++)
         {
             y[i] = dot_points_[i-ddot][1];
+            double u = constraintParameter(dot_index_, dot_points_, i-ddot, d);
             for(int j=0;j<=n-1;j++)
             {
-                A(i,j) = (n-j)*std::pow(us[dot_points_[i-ddot][0]], n-j-1);
+                A(i,j) = (n-j)*std::pow(u, n-j-1);
             }
         }
         for(unsigned int i=dot+ddot;i<=n;i++)
         {
-            y[i] = points_[i-(dot+ddot)];
+            unsigned int k = i-(dot+ddot);
+            y[i] = points_[k];
             for(unsigned int j=0;j<=n;j++)
             {
-                A(i,j) = std::pow(us[points_[i-(dot+ddot)]], n-j);
+                A(i,j) = std::pow(double(k)/d, n-j);
             }
         }
         coefficients_ = solveLinear(A, y);
     }
 
+    /**
+    * Move the constraints of the points from index i on one index further (a point is inserted at i)
+    * @param i - index of the inserted point
+    **/
+    void shiftConstraints(const unsigned int& i)
+    {
+        for(unsigned int k=0;k<dot_index_.size();k++)
+            if(dot_index_[k]>=i)
+                dot_index_[k]++;
+        for(unsigned int k=0;k<ddot_index_.size();k++)
+            if(ddot_index_[k]>=i)
+                ddot_index_[k]++;
+    }
+
+    /**
+    * Parameter of a slope/curvature constraint
+    * Constraints pushed directly into the control data (without an index) fall back to the first point with the same value
+    * @param index - indices of the constraints in points_
+    * @param constraints - the constraints (value, derivative)
+    * @param i - constraint
+    * @param d - number of points minus one
+    * @return double - the parameter in [0,1]
+    **/
+    double constraintParameter(const vector<unsigned int>& index, const vector<Vector<2> >& constraints, const unsigned int& i, const double& d) const
+    {
+        if(index.size()==constraints.size())
+            return double(index[i])/d;
+        for(unsigned int k=0;k<points_.size();k++)
+        {
+            if(points_[k]==constraints[i][0])
+                return double(k)/d;
+        }
+        return 0.0;
+    }
+
     bool defined() const
     {
         if(coeff_defined_)
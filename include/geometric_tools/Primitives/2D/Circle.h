@@ -46,13 +46,13 @@ public:
 
     Circle(const Vector<2>& center, const double& radius): center_(center), radius_(radius) {}
 
-    Vector<2> center() { return center_; }
+    Vector<2> center() const { return center_; }
 
-    double radius() { return radius_; }
+    double radius() const { return radius_; }
 
-    double area() { return Helper::Pi*radius_*radius_; }
+    double area() const { return Helper::Pi*radius_*radius_; }
 
-    QuadraticCurve asQuadratic() { return QuadraticCurve({}, -2.0*center_, center_*center_-radius_*radius_); }
+    QuadraticCurve asQuadratic() const { return QuadraticCurve({}, -2.0*center_, center_*center_-radius_*radius_); }
 };
 
 } }
@@ -118,7 +118,51 @@ public:
         return {curve_x_->getPoint(u), curve_y_->getPoint(u)};
     }
 
-    vector<double> coeff(unsigned int i)
+    /**
+    * Evaluate the curve at many parameters
+    * @param u - parameters
+    * @param x - x coordinates (n elements)
+    * @param y - y coordinates (n elements)
+    * @param n - number of parameters
+    **/
+    void getPoints(const double* u, double* x, double* y, const size_t& n) const
+    {
+        curve_x_->getPoints(u, x, n);
+        curve_y_->getPoints(u, y, n);
+    }
+
+    /**
+    * Derivative of the curve with respect to the parameter
+    * @param u - parameter
+    * @param order - order of the derivative
+    * @return Vector<2> - the derivative
+    **/
+    const Vector<2> getDerivative(const double& u, const unsigned int& order = 1) const
+    {
+        return {curve_x_->getDerivative(u, order), curve_y_->getDerivative(u, order)};
+    }
+
+    /**
+    * Derivatives of the curve at many parameters
+    * @param u - parameters
+    * @param x - x components (n elements)
+    * @param y - y components (n elements)
+    * @param n - number of parameters
+    * @param order - order of the derivative
+    **/
+    void getDerivatives(const double* u, double* x, double* y, const size_t& n, const unsigned int& order = 1) const
+    {
+        curve_x_->getDerivatives(u, x, n, order);
+        curve_y_->getDerivatives(u, y, n, order);
+    }
+
+    /**
+    * Access the component curves
+    **/
+    const CurveTypeA& curveX() const {return *curve_x_;}
+    const CurveTypeB& curveY() const {return *curve_y_;}
+
+    vector<double> coeff(unsigned int i) const
     {
         if(i==0)
             return curve_x_->coeff();
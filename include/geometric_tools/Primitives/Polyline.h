@@ -76,9 +76,21 @@ public:
 
     /**
     * Get Vertices/Points
-    * @return vector<Vector<N> > - the collection of points/vertices
+    * @return vector<Vector<N> > - the collection of points/vertices (no copy is made)
     **/
-    vector<Vector<N> > vertices() const {return vertices_;}
+    const vector<Vector<N> >& vertices() const {return vertices_;}
+
+    /**
+    * Removes all points, keeping the allocated storage
+    * so that the polyline can be reused as an output buffer
+    **/
+    void clear() {vertices_.clear();}
+
+    /**
+    * Reserve storage for points
+    * @param n - number of points
+    **/
+    void reserve(const size_t& n) {vertices_.reserve(n);}
 
     /**
     * Overloading == operator
@@ -0,0 +1,192 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_PRIMITIVES_TOOLS_ARC_LENGTH_H
+#define GEOMETRIC_TOOLS_PRIMITIVES_TOOLS_ARC_LENGTH_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Primitives/2D/PlaneCurve.h>
+#include <geometric_tools/Primitives/Polyline.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+using std::vector;
+
+namespace GeometricTools {
+
+using Math::Vector;
+
+namespace Primitives {
+
+/**
+* Integrate the speed |C'(u)| over [a,b] with 5-point Gauss-Legendre quadrature
+* @param curve - PlaneCurve-like curve (getDerivative returns Vector<2>)
+* @param a - start parameter
+* @param b - end parameter
+* @return double - arc length of the curve between a and b
+**/
+template<class CurveType>
+double gaussLegendreLength(const CurveType& curve, const double& a, const double& b)
+{
+    static const double x[5] = {0.0, -0.5384693101056831, 0.5384693101056831, -0.9061798459386640, 0.9061798459386640};
+    static const double w[5] = {0.5688888888888889, 0.4786286704993665, 0.4786286704993665, 0.2369268850561891, 0.2369268850561891};
+    double m = 0.5*(a+b), r = 0.5*(b-a), s = 0.0;
+    for(int i=0;i<5;i++)
+        s += w[i]*curve.getDerivative(m+r*x[i]).length();
+    return s*r;
+}
+
+/**
+* ArcLengthTable Class
+* Arc length reparameterization of a plane curve
+* Stores the cumulative length at the breakpoints of an adaptive partition of [u_min,u_max]
+* (each interval is accurate to the tolerance with 5-point Gauss-Legendre quadrature);
+* u(s) is answered with a binary search over the table and Newton refinement inside the interval
+**/
+template<class CurveType>
+class ArcLengthTable
+{
+protected:
+    const CurveType* curve_;
+    vector<double> u_, s_;
+public:
+    /**
+    * Constructor
+    * @param curve - the curve (must outlive the table)
+    * @param tolerance - relative accuracy of the length of every interval
+    * @param intervals - initial number of (uniform) intervals
+    * @param u_min - start parameter
+    * @param u_max - end parameter
+    **/
+    ArcLengthTable(const CurveType& curve, const double& tolerance = 1e-10, const unsigned int& intervals = 16, const double& u_min = 0.0, const double& u_max = 1.0): curve_(&curve)
+    {
+        u_.push_back(u_min);
+        s_.push_back(0.0);
+        unsigned int n = std::max(1u, intervals);
+        // explicit stack of intervals [a,b] with their length estimate, processed left to right
+        vector<Vector<3> > stack;
+        for(unsigned int i=n;i>0;i--)
+        {
+            double a = u_min+(u_max-u_min)*(i-1)/n, b = u_min+(u_max-u_min)*i/n;
+            stack.push_back(Vector<3>(a, b, gaussLegendreLength(curve, a, b)));
+        }
+        while(!stack.empty())
+        {
+            Vector<3> top = stack.back();
+            stack.pop_back();
+            double a = top[0], b = top[1], whole = top[2], m = 0.5*(a+b);
+            double left = gaussLegendreLength(curve, a, m), right = gaussLegendreLength(curve, m, b);
+            if(std::abs(left+right-whole)<=tolerance*std::max(left+right, 1e-300) || (b-a)<=1e-12*(u_max-u_min))
+            {
+                u_.push_back(b);
+                s_.push_back(s_.back()+left+right);
+                continue;
+            }
+            stack.push_back(Vector<3>(m, b, right));
+            stack.push_back(Vector<3>(a, m, left));
+        }
+    }
+
+    /**
+    * Get the total length
+    * @return double - the length of the curve over [u_min,u_max]
+    **/
+    double length() const {return s_.back();}
+
+    /**
+    * Get the number of intervals of the table
+    * @return unsigned int - number of intervals
+    **/
+    unsigned int intervals() const {return u_.size()-1;}
+
+    /**
+    * Arc length from u_min to a parameter
+    * @param u - parameter
+    * @return double - arc length
+    **/
+    double arcLength(const double& u) const
+    {
+        if(u<=u_.front())
+            return 0.0;
+        if(u>=u_.back())
+            return s_.back();
+        unsigned int i = std::upper_bound(u_.begin(), u_.end(), u)-u_.begin()-1;
+        return s_[i]+gaussLegendreLength(*curve_, u_[i], u);
+    }
+
+    /**
+    * Parameter at a given arc length (inverse of arcLength)
+    * @param s - arc length (clamped to [0,length()])
+    * @param tolerance - accuracy in arc length
+    * @return double - parameter u such that arcLength(u) = s
+    **/
+    double parameter(const double& s, const double& tolerance = 1e-12) const
+    {
+        if(s<=0.0)
+            return u_.front();
+        if(s>=s_.back())
+            return u_.back();
+        unsigned int i = std::upper_bound(s_.begin(), s_.end(), s)-s_.begin()-1;
+        double lo = u_[i], hi = u_[i+1], ds = s_[i+1]-s_[i];
+        if(ds<=0.0)
+            return lo;
+        // initial guess: linear in the interval, then Newton on F(u) = s_i+L(u_i,u)-s, F' = |C'(u)|
+        double u = lo+(hi-lo)*(s-s_[i])/ds;
+        for(int it=0;it<20;it++)
+        {
+            double F = s_[i]+gaussLegendreLength(*curve_, u_[i], u)-s;
+            if(std::abs(F)<=tolerance*std::max(1.0, s_.back()))
+                break;
+            if(F>0.0)
+                hi = u;
+            else
+                lo = u;
+            double speed = curve_->getDerivative(u).length();
+            double next = (speed>0.0)? u-F/speed : 0.5*(lo+hi);
+            // keep the iterate bracketed, bisect if Newton jumps out
+            u = (next>lo && next<hi)? next : 0.5*(lo+hi);
+        }
+        return u;
+    }
+};
+
+/**
+* Subdivide a curve into segments of equal arc length
+* @param curve - the curve
+* @param N - number of segments (N+1 points)
+* @param u_min - start parameter
+* @param u_max - end parameter
+* @return Polyline<2> - the points
+**/
+template<class CurveA, class CurveB>
+Polyline<2> arcLengthSubdivision(const PlaneCurve<CurveA,CurveB>& curve, const int& N, const double& u_min = 0.0, const double& u_max = 1.0)
+{
+    ArcLengthTable<PlaneCurve<CurveA,CurveB> > table(curve, 1e-10, 16, u_min, u_max);
+    Polyline<2> res;
+    double L = table.length();
+    for(int i=0;i<=N;i++)
+        res.addPoint(curve.getPoint(table.parameter(L*double(i)/double(N))));
+    return res;
+}
+
+} }
+
+#endif
@@ -0,0 +1,197 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_PRIMITIVES_TOOLS_BEZIER_PIECES_H
+#define GEOMETRIC_TOOLS_PRIMITIVES_TOOLS_BEZIER_PIECES_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Math/Polynomial.h>
+#include <geometric_tools/Primitives/2D/PlaneCurve.h>
+#include <geometric_tools/Primitives/2D/Rectangle.h>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+using std::vector;
+
+namespace GeometricTools {
+
+using Math::Vector;
+
+namespace Primitives {
+
+/**
+* BezierPieces Class
+* Exact decomposition of a polynomial PlaneCurve into 2D Bezier pieces of a common degree.
+* The breakpoints of both components are merged, every piece is restricted to its parameter
+* interval and elevated to the highest degree. Control points are stored flat (degree+1 per piece),
+* so the convex hull property gives conservative bounds for pruning in distance/intersection queries.
+**/
+class BezierPieces
+{
+protected:
+    unsigned int degree_;
+    vector<double> u_;
+    vector<double> x_, y_;
+    vector<double> dx_, dy_;
+public:
+    BezierPieces(): degree_(0) {}
+
+    template<class CurveA, class CurveB>
+    BezierPieces(const PlaneCurve<CurveA,CurveB>& curve): degree_(0)
+    {
+        build(curve);
+    }
+
+    /**
+    * Decompose a curve
+    * Component curves have to provide degree(), breakpoints() and coeff() (all curves under Primitives/1D do)
+    * @param curve - the curve
+    **/
+    template<class CurveA, class CurveB>
+    void build(const PlaneCurve<CurveA,CurveB>& curve)
+    {
+        u_.clear();
+        x_.clear();
+        y_.clear();
+        unsigned int da = curve.curveX().degree(), db = curve.curveY().degree();
+        vector<double> ua = curve.curveX().breakpoints(), ub = curve.curveY().breakpoints();
+        vector<double> ca = curve.curveX().coeff(), cb = curve.curveY().coeff();
+        if(ua.size()<2 || ub.size()<2 || ca.size()<(da+1)*(ua.size()-1) || cb.size()<(db+1)*(ub.size()-1))
+            return;
+        degree_ = std::max(da, db);
+        std::merge(ua.begin(), ua.end(), ub.begin(), ub.end(), std::back_inserter(u_));
+        u_.erase(std::unique(u_.begin(), u_.end()), u_.end());
+
+        unsigned int P = u_.size()-1, M = degree_+1;
+        x_.resize(P*M);
+        y_.resize(P*M);
+        for(unsigned int i=0;i<P;i++)
+        {
+            restrict(ca, ua, da, u_[i], u_[i+1], &x_[i*M]);
+            restrict(cb, ub, db, u_[i], u_[i+1], &y_[i*M]);
+        }
+        // hodographs
+        dx_.resize(P*degree_);
+        dy_.resize(P*degree_);
+        for(unsigned int i=0;i<P;i++)
+            for(unsigned int j=0;j<degree_;j++)
+            {
+                dx_[i*degree_+j] = degree_*(x_[i*M+j+1]-x_[i*M+j]);
+                dy_[i*degree_+j] = degree_*(y_[i*M+j+1]-y_[i*M+j]);
+            }
+    }
+
+    unsigned int degree() const {return degree_;}
+
+    unsigned int pieces() const {return u_.empty()? 0 : u_.size()-1;}
+
+    /**
+    * Parameter of a breakpoint
+    * @param i - index (0..pieces)
+    * @return double - curve parameter
+    **/
+    double knot(const unsigned int& i) const {return u_[i];}
+
+    const double* x(const unsigned int& i) const {return &x_[i*(degree_+1)];}
+    const double* y(const unsigned int& i) const {return &y_[i*(degree_+1)];}
+
+    /**
+    * Point on a piece
+    * @param i - piece
+    * @param s - local parameter in [0,1]
+    * @return Vector<2> - the point
+    **/
+    Vector<2> point(const unsigned int& i, const double& s) const
+    {
+        return Vector<2>(Math::bernstein(x(i), degree_, s), Math::bernstein(y(i), degree_, s));
+    }
+
+    /**
+    * Derivative on a piece with respect to the local parameter
+    * @param i - piece
+    * @param s - local parameter in [0,1]
+    * @return Vector<2> - the derivative
+    **/
+    Vector<2> derivative(const unsigned int& i, const double& s) const
+    {
+        if(degree_==0)
+            return Vector<2>(0.0, 0.0);
+        return Vector<2>(Math::bernstein(&dx_[i*degree_], degree_-1, s), Math::bernstein(&dy_[i*degree_], degree_-1, s));
+    }
+
+    /**
+    * Curve parameter of a local piece parameter
+    * @param i - piece
+    * @param s - local parameter in [0,1]
+    * @return double - curve parameter
+    **/
+    double parameter(const unsigned int& i, const double& s) const
+    {
+        return u_[i]+s*(u_[i+1]-u_[i]);
+    }
+
+    /**
+    * Bounding box of the control points of a piece (contains the piece)
+    * @param i - piece
+    * @return Rectangle - the box
+    **/
+    Rectangle bounds(const unsigned int& i) const
+    {
+        const double* px = x(i);
+        const double* py = y(i);
+        double x0 = *std::min_element(px, px+degree_+1), x1 = *std::max_element(px, px+degree_+1);
+        double y0 = *std::min_element(py, py+degree_+1), y1 = *std::max_element(py, py+degree_+1);
+        return Rectangle(Vector<2>(0.5*(x0+x1), 0.5*(y0+y1)), x1-x0, y1-y0);
+    }
+
+protected:
+    /**
+    * Bernstein control values of a component on [a,b], elevated to degree_
+    **/
+    void restrict(const vector<double>& c, const vector<double>& u, const unsigned int& d, const double& a, const double& b, double* out) const
+    {
+        unsigned int j = std::upper_bound(u.begin(), u.end()-1, 0.5*(a+b))-u.begin();
+        j = (j>0)? j-1 : 0;
+        j = std::min(j, (unsigned int)u.size()-2);
+        double h = u[j+1]-u[j];
+        double sa = (a-u[j])/h, sb = (b-u[j])/h;
+
+        vector<double> w(degree_+2), l(degree_+2);
+        Math::monomialToBernstein(&c[j*(d+1)], d, w.data());
+        if(sa!=0.0 || sb!=1.0)
+        {
+            // [0,sb] then the [sa/sb,1] part of it
+            Math::bernsteinSubdivide(w.data(), d, sb, l.data(), w.data());
+            Math::bernsteinSubdivide(l.data(), d, (sb!=0.0)? sa/sb : 0.0, w.data(), l.data());
+            std::copy(l.begin(), l.begin()+d+1, w.begin());
+        }
+        for(unsigned int e=d;e<degree_;e++)
+        {
+            Math::bernsteinElevate(w.data(), e, l.data());
+            std::copy(l.begin(), l.begin()+e+2, w.begin());
+        }
+        std::copy(w.begin(), w.begin()+degree_+1, out);
+    }
+};
+
+} }
+
+#endif
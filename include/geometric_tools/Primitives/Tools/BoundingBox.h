@@ -60,7 +60,7 @@ inline Rectangle boundingBox(const vector<Vector<2> >& points)
 
 inline Rectangle boundingBox(const Polyline<2>& poly)
 {
-    vector<Vector<2> > points = poly.vertices();
+    const vector<Vector<2> >& points = poly.vertices();
     return boundingBox(points);
 }
 
@@ -0,0 +1,292 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_PRIMITIVES_TOOLS_CURVE_FITTING_H
+#define GEOMETRIC_TOOLS_PRIMITIVES_TOOLS_CURVE_FITTING_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Math/Polynomial.h>
+#include <geometric_tools/Math/LinearSystems/LeastSquares.h>
+#include <geometric_tools/Primitives/1D/BSplineCurve.h>
+#include <geometric_tools/Primitives/2D/PlaneCurve.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+using std::vector;
+
+namespace GeometricTools {
+
+using Math::Vector;
+using Math::LinearSystems::LeastSquares;
+using Math::LinearSystems::BandedNormalEquations;
+
+namespace Primitives {
+
+/**
+* Chord length parameterization
+* @param points - samples in curve order
+* @return vector<double> - parameters in [0,1] proportional to the accumulated distance
+**/
+template<unsigned int N>
+vector<double> chordLengthParameters(const vector<Vector<N> >& points)
+{
+    vector<double> u(points.size(), 0.0);
+    for(size_t i=1;i<points.size();i++)
+    {
+        double d = 0.0;
+        for(unsigned int j=0;j<N;j++)
+            d += (points[i][j]-points[i-1][j])*(points[i][j]-points[i-1][j]);
+        u[i] = u[i-1]+std::sqrt(d);
+    }
+    double L = u.empty()? 0.0 : u.back();
+    for(size_t i=1;i<u.size();i++)
+        u[i] = (L>0.0)? u[i]/L : double(i)/double(u.size()-1);
+    if(u.size()>1)
+        u.back() = 1.0;
+    return u;
+}
+
+/**
+* PolynomialFit Class
+* Streaming least squares fit of a polynomial of degree N to samples (u,y), u in [0,1]
+* The fit is done in the Bernstein basis (well conditioned on [0,1]) and converted to monomial coefficients
+* for PolynomialCurve<N>. Several value dimensions share the factorization.
+**/
+template<unsigned int N>
+class PolynomialFit
+{
+protected:
+    LeastSquares ls_;
+    unsigned int dim_;
+    double binom_[N+1];
+public:
+    /**
+    * Constructor
+    * @param dimensions - number of values per sample
+    **/
+    PolynomialFit(const unsigned int& dimensions = 1): ls_(N+1, dimensions), dim_(std::max(dimensions, 1u))
+    {
+        binom_[0] = 1.0;
+        for(unsigned int i=1;i<=N;i++)
+            binom_[i] = binom_[i-1]*double(N-i+1)/double(i);
+    }
+
+    /**
+    * Add a sample
+    * @param u - parameter
+    * @param y - values (dimensions values)
+    * @param weight - weight of the sample
+    **/
+    void addSample(const double& u, const double* y, const double& weight = 1.0)
+    {
+        double a[N+1];
+        double v = 1.0-u, p = 1.0;
+        for(unsigned int i=0;i<=N;i++)
+        {
+            a[i] = binom_[i]*p;
+            p *= u;
+        }
+        p = 1.0;
+        for(unsigned int i=N+1;i>0;i--)
+        {
+            a[i-1] *= p;
+            p *= v;
+        }
+        ls_.addRow(0, a, y, weight);
+    }
+
+    void addSample(const double& u, const double& y, const double& weight = 1.0)
+    {
+        addSample(u, &y, weight);
+    }
+
+    size_t samples() const {return ls_.rows();}
+
+    /**
+    * Fitted coefficients
+    * @param c - coefficients of every dimension (N+1 values each, highest power first)
+    * @return bool - false if there are not enough (distinct) samples
+    **/
+    bool solve(double* c) const
+    {
+        vector<double> b((N+1)*dim_);
+        if(!ls_.solve(b.data()))
+            return false;
+        for(unsigned int d=0;d<dim_;d++)
+            Math::bernsteinToMonomial(&b[d*(N+1)], N, c+d*(N+1));
+        return true;
+    }
+
+    /**
+    * Fitted coefficients of one dimension
+    * @param d - dimension
+    * @return Vector<N+1> - coefficients (highest power first, zero if the fit failed)
+    **/
+    Vector<N+1> coefficients(const unsigned int& d = 0) const
+    {
+        vector<double> c((N+1)*dim_, 0.0);
+        Vector<N+1> res;
+        if(!solve(c.data()))
+            return res;
+        for(unsigned int i=0;i<=N;i++)
+            res[i] = c[d*(N+1)+i];
+        return res;
+    }
+
+    /**
+    * Sum of squared residuals of the fit
+    **/
+    double residual(const unsigned int& d = 0) const {return ls_.residual(d);}
+};
+
+/**
+* BSplineFit Class
+* Streaming least squares fit of a clamped uniform B-spline of degree D with a given number of spans,
+* u in [0,1]. Every sample touches D+1 control points, so the banded normal equations cost
+* O(D^2) per sample (in any order) and O(spans*D) memory whatever the number of samples.
+* An optional smoothing term penalizes second differences of the control points, which also keeps spans
+* without samples well defined.
+**/
+template<unsigned int D>
+class BSplineFit
+{
+protected:
+    enum { W = (D+1>3)? D+1 : 3 };
+    BandedNormalEquations ls_;
+    unsigned int spans_, dim_;
+    vector<double> knots_;
+public:
+    /**
+    * Constructor
+    * @param spans - number of knot spans (spans+D control points)
+    * @param dimensions - number of values per sample
+    * @param smoothing - weight of the second difference penalty
+    **/
+    BSplineFit(const unsigned int& spans, const unsigned int& dimensions = 1, const double& smoothing = 0.0):
+        spans_(std::max(spans, 1u)), dim_(std::max(dimensions, 1u))
+    {
+        unsigned int n = spans_+D;
+        // the second differences need a bandwidth of 3
+        ls_.resize(n, dim_, (smoothing>0.0)? W : D+1);
+        // same knots as BSplineCurve<D>::ClampedUniform with n control points
+        knots_.resize(n+D+1);
+        for(unsigned int i=0;i<n+D+1;i++)
+            knots_[i] = std::min(std::max(double(i)-double(D), 0.0), double(spans_));
+        if(smoothing>0.0 && n>=3)
+        {
+            double a[W] = {0.0};
+            a[0] = 1.0;
+            a[1] = -2.0;
+            a[2] = 1.0;
+            vector<double> zero(dim_, 0.0);
+            for(unsigned int i=0;i+2<n;i++)
+                ls_.addRow(i, a, zero.data(), smoothing);
+        }
+    }
+
+    const vector<double>& knots() const {return knots_;}
+
+    unsigned int controlPoints() const {return spans_+D;}
+
+    /**
+    * Add a sample
+    * @param u - parameter in [0,1]
+    * @param y - values (dimensions values)
+    * @param weight - weight of the sample
+    **/
+    void addSample(const double& u, const double* y, const double& weight = 1.0)
+    {
+        double t = std::min(std::max(u, 0.0), 1.0)*spans_;
+        unsigned int k = D+std::min((unsigned int)t, spans_-1);
+        double N[W] = {0.0};
+        bsplineBasis<D>(knots_.data(), k, t, N);
+        ls_.addRow(k-D, N, y, weight);
+    }
+
+    void addSample(const double& u, const double& y, const double& weight = 1.0)
+    {
+        addSample(u, &y, weight);
+    }
+
+    size_t samples() const {return ls_.rows();}
+
+    /**
+    * Fitted control points
+    * @param control - control points of every dimension (controlPoints() values each)
+    * @return bool - false if the problem is under-determined (add samples or smoothing)
+    **/
+    bool solve(double* control) const
+    {
+        return ls_.solve(control);
+    }
+
+    /**
+    * Fitted curve of one dimension
+    * @param d - dimension
+    * @return BSplineCurve<D> - the curve (undefined if the fit failed)
+    **/
+    BSplineCurve<D> curve(const unsigned int& d = 0) const
+    {
+        vector<double> c(controlPoints()*dim_);
+        if(!solve(c.data()))
+            return BSplineCurve<D>();
+        return BSplineCurve<D>(vector<double>(c.begin()+d*controlPoints(), c.begin()+(d+1)*controlPoints()), knots_);
+    }
+
+    /**
+    * Sum of squared residuals of the fit (including the smoothing term)
+    **/
+    double residual(const unsigned int& d = 0) const
+    {
+        vector<double> c(controlPoints()*dim_);
+        if(!solve(c.data()))
+            return 0.0;
+        return ls_.residual(&c[d*controlPoints()], d);
+    }
+};
+
+/**
+* Least squares B-spline fit of a sequence of 2D points (chord length parameterization)
+* @param points - samples in curve order
+* @param spans - number of knot spans
+* @param curve - empty (default constructed) curve that receives the control points
+* @param smoothing - weight of the second difference penalty
+* @return bool - false if the fit failed
+**/
+template<unsigned int D>
+bool fitPlaneCurve(const vector<Vector<2> >& points, const unsigned int& spans, PlaneCurve<BSplineCurve<D>,BSplineCurve<D> >& curve, const double& smoothing = 0.0)
+{
+    vector<double> u = chordLengthParameters(points);
+    BSplineFit<D> fit(spans, 2, smoothing);
+    for(size_t i=0;i<points.size();i++)
+        fit.addSample(u[i], points[i].data());
+    unsigned int n = fit.controlPoints();
+    vector<double> c(2*n);
+    if(!fit.solve(c.data()))
+        return false;
+    for(unsigned int i=0;i<n;i++)
+        curve.addPoint(Vector<2>(c[i], c[n+i]));
+    return true;
+}
+
+} }
+
+#endif
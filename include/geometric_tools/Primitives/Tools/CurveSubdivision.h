@@ -23,21 +23,135 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 **/
 #include <geometric_tools/Primitives/2D/PlaneCurve.h>
 #include <geometric_tools/Primitives/Polyline.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+using std::vector;
 
 namespace GeometricTools { namespace Primitives {
 
+/**
+* Uniform Subdivision of a PlaneCurve
+* @param curve - curve to subdivide
+* @param N - number of segments
+* @param u_min - start parameter (clamped to [0,1], the parameter range of the curves)
+* @param u_max - end parameter (clamped to [0,1])
+* @return Polyline - N+1 points at equally spaced parameters
+**/
 template<class CurveA, class CurveB>
 Polyline<2> uniformSubdivision(const PlaneCurve<CurveA,CurveB>& curve, const int& N, const double& u_min = 0.0, const double& u_max = 1.0)
 {
     Polyline<2> res;
     double umin = std::min(std::max(0.0, u_min), 1.0);
     double umax = std::min(std::max(0.0, u_max), 1.0);
-    for (int i=0;i<=N;i++)
+    vector<double> u(N+1), x(N+1), y(N+1);
+    for(int i=0;i<=N;i++)
+        u[i] = umin+(umax-umin)*double(i)/double(N); // assumes curves goes in [0,1]
+    curve.getPoints(u.data(), x.data(), y.data(), N+1);
+    for(int i=0;i<=N;i++)
+        res.addPoint(Vector<2>(x[i], y[i]));
+    return res;
+}
+
+/**
+* Distance of a point from the chord [a,b]
+* @param p - point
+* @param a - chord start
+* @param b - chord end
+* @return double - distance
+**/
+inline double chordDeviation(const Vector<2>& p, const Vector<2>& a, const Vector<2>& b)
+{
+    double dx = b[0]-a[0], dy = b[1]-a[1];
+    double px = p[0]-a[0], py = p[1]-a[1];
+    double len_sq = dx*dx+dy*dy;
+    double t = (len_sq>0.0) ? (px*dx+py*dy)/len_sq : 0.0;
+    t = std::min(std::max(t, 0.0), 1.0);
+    px -= t*dx;
+    py -= t*dy;
+    return std::sqrt(px*px+py*py);
+}
+
+/**
+* Adaptive (flatness driven) Subdivision of a PlaneCurve
+* Each span is tested at its quarter, half and three-quarter parameters against its chord and
+* split in two until the deviation drops below the tolerance. Spans are kept in an explicit stack
+* (no recursion) and every split reuses the already evaluated samples, so only two new points are
+* evaluated per span.
+* The deviation is only measured at those three samples, so the curve may stray slightly further from
+* a chord between them; raise min_segments (or lower the tolerance) for curves with sharp features.
+* @param curve - curve to subdivide
+* @param tolerance - maximum allowed chord deviation
+* @param result - output polyline (cleared first, storage is reused)
+* @param u_min - start parameter (clamped to [0,1], the parameter range of the curves)
+* @param u_max - end parameter (clamped to [0,1])
+* @param min_segments - number of initial spans (guards against features hidden between samples)
+* @param max_depth - maximum number of splits of an initial span
+* @return double - maximum chord deviation measured at the samples of the emitted spans
+**/
+template<class CurveA, class CurveB>
+double adaptiveSubdivision(const PlaneCurve<CurveA,CurveB>& curve, const double& tolerance, Polyline<2>& result,
+                           const double& u_min = 0.0, const double& u_max = 1.0,
+                           const unsigned int& min_segments = 8, const unsigned int& max_depth = 20)
+{
+    struct Span
+    {
+        double a, b;
+        Vector<2> pa, pm, pb;
+        unsigned int depth;
+    };
+
+    result.clear();
+    double umin = std::min(std::max(0.0, u_min), 1.0);
+    double umax = std::min(std::max(0.0, u_max), 1.0);
+    unsigned int M = std::max(min_segments, 1u);
+
+    // Initial uniform samples (span ends and midpoints) in one batch
+    vector<double> u(2*M+1), x(2*M+1), y(2*M+1);
+    for(unsigned int i=0;i<=2*M;i++)
+        u[i] = umin+(umax-umin)*double(i)/double(2*M);
+    curve.getPoints(u.data(), x.data(), y.data(), 2*M+1);
+
+    vector<Span> stack;
+    stack.reserve(M+2*max_depth+2);
+    // Push in reverse so that spans are popped (and emitted) left to right
+    for(unsigned int i=M;i>0;i--)
     {
-        double u = umin+(umax-umin)*double(i)/double(N); // assumes curves goes in [0,1]
-        res.addPoint(curve.getPoint(u));
+        unsigned int j = 2*(i-1);
+        Span s = {u[j], u[j+2], Vector<2>(x[j], y[j]), Vector<2>(x[j+1], y[j+1]), Vector<2>(x[j+2], y[j+2]), 0};
+        stack.push_back(s);
     }
-    return res;
+
+    result.addPoint(Vector<2>(x[0], y[0]));
+    double max_error = 0.0;
+    double uq[2], xq[2], yq[2];
+    while(!stack.empty())
+    {
+        Span s = stack.back();
+        stack.pop_back();
+
+        double m = 0.5*(s.a+s.b);
+        uq[0] = 0.5*(s.a+m);
+        uq[1] = 0.5*(m+s.b);
+        curve.getPoints(uq, xq, yq, 2);
+        Vector<2> pl(xq[0], yq[0]), pr(xq[1], yq[1]);
+
+        double err = std::max(chordDeviation(s.pm, s.pa, s.pb),
+                     std::max(chordDeviation(pl, s.pa, s.pb), chordDeviation(pr, s.pa, s.pb)));
+        if(err<=tolerance || s.depth>=max_depth)
+        {
+            max_error = std::max(max_error, err);
+            result.addPoint(s.pb);
+            continue;
+        }
+
+        Span right = {m, s.b, s.pm, pr, s.pb, s.depth+1};
+        Span left = {s.a, m, s.pa, pl, s.pm, s.depth+1};
+        stack.push_back(right);
+        stack.push_back(left);
+    }
+    return max_error;
 }
 
 } }
@@ -0,0 +1,165 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+
+#ifndef GEOMETRIC_TOOLS_PRIMITIVES_TOOLS_SUPPORT_FUNCTION_H
+#define GEOMETRIC_TOOLS_PRIMITIVES_TOOLS_SUPPORT_FUNCTION_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Math/Vector.h>
+#include <geometric_tools/Primitives/LinearShapes.h>
+#include <geometric_tools/Primitives/Polyline.h>
+#include <geometric_tools/Primitives/2D/Polygon.h>
+#include <geometric_tools/Primitives/2D/Rectangle.h>
+#include <geometric_tools/Primitives/2D/Triangle.h>
+#include <geometric_tools/Primitives/2D/Circle.h>
+#include <vector>
+#include <limits>
+
+using std::vector;
+
+namespace GeometricTools {
+
+using Math::Vector;
+
+namespace Primitives {
+
+/**
+* Support Functions
+* The support function of a convex shape returns its farthest point along a direction d
+* They are the only thing the convex queries (GJK/EPA) need to know about a shape
+* Non convex shapes (polygons, polylines) are treated as their convex hull
+**/
+
+/**
+* Shape Dimension Traits
+* Gives the dimension of the space a shape lives in
+**/
+template<class Shape>
+struct ShapeDimension;
+
+template<unsigned int N>
+struct ShapeDimension<Vector<N> > { static const unsigned int value = N; };
+
+template<unsigned int N>
+struct ShapeDimension<Segment<N> > { static const unsigned int value = N; };
+
+template<unsigned int N>
+struct ShapeDimension<Polyline<N> > { static const unsigned int value = N; };
+
+template<unsigned int N>
+struct ShapeDimension<vector<Vector<N> > > { static const unsigned int value = N; };
+
+template<>
+struct ShapeDimension<Polygon> { static const unsigned int value = 2; };
+
+template<>
+struct ShapeDimension<Rectangle> { static const unsigned int value = 2; };
+
+template<>
+struct ShapeDimension<Triangle> { static const unsigned int value = 2; };
+
+template<>
+struct ShapeDimension<Circle> { static const unsigned int value = 2; };
+
+/**
+* Support point of a point set (its convex hull)
+* @param points - the points
+* @param d - search direction
+* @return Vector - the point with the maximum projection on d (the zero vector for an empty set)
+**/
+template<unsigned int N>
+Vector<N> support(const vector<Vector<N> >& points, const Vector<N>& d)
+{
+    if(points.empty())
+        return Vector<N>();
+    unsigned int best = 0;
+    double m = -std::numeric_limits<double>::infinity();
+    for(unsigned int i=0;i<points.size();i++)
+    {
+        double p = points[i]*d;
+        if(p>m)
+        {
+            m = p;
+            best = i;
+        }
+    }
+    return points[best];
+}
+
+/**
+* Support point of a single point
+**/
+template<unsigned int N>
+Vector<N> support(const Vector<N>& point, const Vector<N>& d)
+{
+    return point;
+}
+
+/**
+* Support point of a segment
+**/
+template<unsigned int N>
+Vector<N> support(const Segment<N>& seg, const Vector<N>& d)
+{
+    if((seg.d()*d)>0.0)
+        return seg.P1();
+    return seg.P0();
+}
+
+/**
+* Support point of a polyline (its convex hull)
+**/
+template<unsigned int N>
+Vector<N> support(const Polyline<N>& poly, const Vector<N>& d)
+{
+    return support(poly.vertices(), d);
+}
+
+/**
+* Support point of a polygon (its convex hull)
+**/
+inline Vector<2> support(const Polygon& poly, const Vector<2>& d)
+{
+    return support(poly.vertices(), d);
+}
+
+inline Vector<2> support(const Rectangle& rect, const Vector<2>& d)
+{
+    return support(rect.vertices(), d);
+}
+
+inline Vector<2> support(const Triangle& tri, const Vector<2>& d)
+{
+    return support(tri.vertices(), d);
+}
+
+/**
+* Support point of a circle
+**/
+inline Vector<2> support(const Circle& circle, const Vector<2>& d)
+{
+    double l = d.length();
+    if(l<std::numeric_limits<double>::epsilon())
+        return circle.center()+Vector<2>(circle.radius(), 0.0);
+    return circle.center()+d*(circle.radius()/l);
+}
+
+} }
+
+#endif
@@ -0,0 +1,552 @@
+/**
+Copyright (c) 2014, Konstantinos Chatzilygeroudis
+All rights reserved.
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer
+    in the documentation and/or other materials provided with the distribution.
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**/
+#ifndef GEOMETRIC_TOOLS_PRIMITIVES_TOOLS_TRIANGULATION_H
+#define GEOMETRIC_TOOLS_PRIMITIVES_TOOLS_TRIANGULATION_H
+
+/**
+* Includes
+**/
+#include <geometric_tools/Primitives/2D/Polygon.h>
+#include <geometric_tools/Primitives/2D/Triangle.h>
+#include <geometric_tools/Math/Vector.h>
+#include <vector>
+#include <array>
+#include <set>
+#include <cmath>
+#include <algorithm>
+
+using std::vector;
+
+namespace GeometricTools {
+
+using Math::Vector;
+
+namespace Primitives {
+
+/**
+* Indices of the 3 corners of a triangle in the vertex array of a polygon (counter-clockwise)
+**/
+typedef std::array<unsigned int, 3> TriangleIndices;
+
+/**
+* Vertices of a polygon as a counter-clockwise loop without repeated points
+* Consecutive duplicates and the closing point (a copy of the first one) are skipped
+* @param v - vertices of the polygon (either orientation)
+* @return vector<unsigned int> - indices into v
+**/
+inline vector<unsigned int> counterClockwiseLoop(const vector<Vector<2> >& v)
+{
+    vector<unsigned int> order;
+    order.reserve(v.size());
+    for(unsigned int i=0;i<v.size();i++)
+        if(order.empty() || v[i][0]!=v[order.back()][0] || v[i][1]!=v[order.back()][1])
+            order.push_back(i);
+    while(order.size()>1 && v[order.back()][0]==v[order[0]][0] && v[order.back()][1]==v[order[0]][1])
+        order.pop_back();
+    double sum = 0.0;
+    for(unsigned int k=0;k<order.size();k++)
+    {
+        const Vector<2>& a = v[order[k]];
+        const Vector<2>& b = v[order[(k+1)%order.size()]];
+        sum += a[0]*b[1]-a[1]*b[0];
+    }
+    if(sum<0.0)
+        std::reverse(order.begin(), order.end());
+    return order;
+}
+
+/**
+* Ear clipping triangulation of a simple polygon
+* The remaining polygon is a doubly linked list; above 80 vertices the vertices are also linked in z-order
+* (Morton code of the position) so that an ear test only visits the vertices near the candidate triangle
+* Worst case O(n^2), usually close to linear; for non-simple input it still terminates (clipping the first
+* vertex when no ear is left) but the triangles may overlap
+* @param v - vertices of the polygon (either orientation)
+* @param triangles - counter-clockwise index triples (appended)
+* @param maxTests - budget of ear and point in triangle tests (0 means unlimited)
+* @return bool - false if the budget ran out (nothing is appended then)
+**/
+inline bool triangulateEarClipping(const vector<Vector<2> >& v, vector<TriangleIndices>& triangles, const size_t& maxTests = 0)
+{
+    struct Node
+    {
+        double x, y;
+        unsigned int i, z;
+        int prev, next, prevZ, nextZ;
+    };
+    const vector<unsigned int> order = counterClockwiseLoop(v);
+    const int n = order.size();
+    if(n<3)
+        return true;
+    const size_t start = triangles.size();
+    triangles.reserve(start+n-2);
+
+    vector<Node> nodes(n);
+    double minX = v[order[0]][0], minY = v[order[0]][1], maxX = minX, maxY = minY;
+    for(int k=0;k<n;k++)
+    {
+        Node& p = nodes[k];
+        p.x = v[order[k]][0];
+        p.y = v[order[k]][1];
+        p.i = order[k];
+        p.prev = (k+n-1)%n;
+        p.next = (k+1)%n;
+        p.z = 0;
+        p.prevZ = p.nextZ = -1;
+        minX = std::min(minX, p.x);
+        minY = std::min(minY, p.y);
+        maxX = std::max(maxX, p.x);
+        maxY = std::max(maxY, p.y);
+    }
+
+    // z-order of the vertices: 16 bits per coordinate, interleaved
+    const bool hashed = n>80;
+    const double size = std::max(maxX-minX, maxY-minY);
+    const double invSize = (size>0.0)? 32767.0/size : 0.0;
+    auto zOrder = [&](double x, double y) {
+        unsigned int a = (unsigned int)((x-minX)*invSize), b = (unsigned int)((y-minY)*invSize);
+        a = (a|(a<<8))&0x00FF00FF; a = (a|(a<<4))&0x0F0F0F0F; a = (a|(a<<2))&0x33333333; a = (a|(a<<1))&0x55555555;
+        b = (b|(b<<8))&0x00FF00FF; b = (b|(b<<4))&0x0F0F0F0F; b = (b|(b<<2))&0x33333333; b = (b|(b<<1))&0x55555555;
+        return a|(b<<1);
+    };
+    if(hashed)
+    {
+        vector<int> sorted(n);
+        for(int k=0;k<n;k++)
+        {
+            nodes[k].z = zOrder(nodes[k].x, nodes[k].y);
+            sorted[k] = k;
+        }
+        std::sort(sorted.begin(), sorted.end(), [&](int a, int b) {return nodes[a].z<nodes[b].z;});
+        for(int k=0;k<n;k++)
+        {
+            nodes[sorted[k]].prevZ = (k>0)? sorted[k-1] : -1;
+            nodes[sorted[k]].nextZ = (k+1<n)? sorted[k+1] : -1;
+        }
+    }
+
+    // twice the signed area of (a,b,c): > 0 for a left (convex) turn
+    auto area = [&](int a, int b, int c) {
+        return (nodes[b].x-nodes[a].x)*(nodes[c].y-nodes[a].y)-(nodes[b].y-nodes[a].y)*(nodes[c].x-nodes[a].x);
+    };
+    size_t tests = 0;
+    // p blocks the ear (a,b,c) if it is a reflex (or flat) vertex inside the triangle
+    auto blocks = [&](int a, int b, int c, int p) {
+        tests++;
+        const Node& P = nodes[p];
+        const Node& A = nodes[a];
+        const Node& B = nodes[b];
+        const Node& C = nodes[c];
+        return (B.x-A.x)*(P.y-A.y)-(B.y-A.y)*(P.x-A.x)>=0.0 &&
+               (C.x-B.x)*(P.y-B.y)-(C.y-B.y)*(P.x-B.x)>=0.0 &&
+               (A.x-C.x)*(P.y-C.y)-(A.y-C.y)*(P.x-C.x)>=0.0 &&
+               area(P.prev, p, P.next)<=0.0;
+    };
+    auto isEar = [&](int b) {
+        tests++;
+        const int a = nodes[b].prev, c = nodes[b].next;
+        if(area(a, b, c)<=0.0)
+            return false;
+        if(!hashed)
+        {
+            for(int p=nodes[c].next;p!=a;p=nodes[p].next)
+                if(blocks(a, b, c, p))
+                    return false;
+            return true;
+        }
+        // only the vertices whose z-order falls in the bounding box of the triangle can be inside
+        const unsigned int minZ = zOrder(std::min(nodes[a].x, std::min(nodes[b].x, nodes[c].x)), std::min(nodes[a].y, std::min(nodes[b].y, nodes[c].y)));
+        const unsigned int maxZ = zOrder(std::max(nodes[a].x, std::max(nodes[b].x, nodes[c].x)), std::max(nodes[a].y, std::max(nodes[b].y, nodes[c].y)));
+        for(int p=nodes[b].nextZ;p>=0 && nodes[p].z<=maxZ;p=nodes[p].nextZ)
+            if(p!=a && p!=c && blocks(a, b, c, p))
+                return false;
+        for(int p=nodes[b].prevZ;p>=0 && nodes[p].z>=minZ;p=nodes[p].prevZ)
+            if(p!=a && p!=c && blocks(a, b, c, p))
+                return false;
+        return true;
+    };
+    auto remove = [&](int p) {
+        Node& P = nodes[p];
+        nodes[P.prev].next = P.next;
+        nodes[P.next].prev = P.prev;
+        if(P.prevZ>=0)
+            nodes[P.prevZ].nextZ = P.nextZ;
+        if(P.nextZ>=0)
+            nodes[P.nextZ].prevZ = P.prevZ;
+    };
+
+    int ear = 0, stop = 0;
+    bool filtered = false;
+    while(nodes[ear].prev!=nodes[ear].next)
+    {
+        if(maxTests>0 && tests>maxTests)
+        {
+            triangles.resize(start);
+            return false;
+        }
+        const int prev = nodes[ear].prev, next = nodes[ear].next;
+        if(isEar(ear))
+        {
+            TriangleIndices t = {{nodes[prev].i, nodes[ear].i, nodes[next].i}};
+            triangles.push_back(t);
+            remove(ear);
+            // skipping the next vertex leads to less sliver triangles
+            ear = stop = nodes[next].next;
+            filtered = false;
+            continue;
+        }
+        ear = next;
+        if(ear!=stop)
+            continue;
+        if(!filtered)
+        {
+            // no ear in a full pass: drop flat vertices (collinear with their neighbours) and retry
+            int p = ear;
+            int last = nodes[p].prev;
+            do
+            {
+                int q = nodes[p].next;
+                if(nodes[p].prev!=nodes[p].next && area(nodes[p].prev, p, q)==0.0)
+                {
+                    if(p==last)
+                        last = nodes[p].prev;
+                    remove(p);
+                    ear = q;
+                }
+                if(p==last)
+                    break;
+                p = q;
+            } while(nodes[p].prev!=nodes[p].next);
+            stop = ear;
+            filtered = true;
+        }
+        else
+        {
+            // no ear at all (not a simple polygon or rounding): clip the current vertex anyway
+            TriangleIndices t = {{nodes[nodes[ear].prev].i, nodes[ear].i, nodes[nodes[ear].next].i}};
+            triangles.push_back(t);
+            int q = nodes[ear].next;
+            remove(ear);
+            ear = stop = q;
+            filtered = false;
+        }
+    }
+    return true;
+}
+
+/**
+* Monotone partition triangulation of a simple polygon in O(n log n)
+* A top to bottom sweep adds diagonals at the split and merge vertices, which cuts the polygon into y-monotone pieces;
+* every piece is then triangulated in linear time with a stack
+* @param v - vertices of the polygon (either orientation)
+* @param triangles - counter-clockwise index triples (appended)
+**/
+inline void triangulateMonotone(const vector<Vector<2> >& v, vector<TriangleIndices>& triangles)
+{
+    const vector<unsigned int> order = counterClockwiseLoop(v);
+    const unsigned int n = order.size();
+    if(n<3)
+        return;
+    triangles.reserve(triangles.size()+n-2);
+    // local copy of the points; slot n is the query point of the sweep
+    vector<Vector<2> > P(n+1);
+    for(unsigned int k=0;k<n;k++)
+        P[k] = v[order[k]];
+    auto above = [&](unsigned int a, unsigned int b) {
+        return P[a][1]>P[b][1] || (P[a][1]==P[b][1] && P[a][0]<P[b][0]);
+    };
+    auto turn = [&](unsigned int a, unsigned int b, unsigned int c) {
+        return (P[b][0]-P[a][0])*(P[c][1]-P[a][1])-(P[b][1]-P[a][1])*(P[c][0]-P[a][0]);
+    };
+
+    // classify the vertices
+    enum {Start, End, Split, Merge, Regular};
+    vector<int> type(n);
+    for(unsigned int k=0;k<n;k++)
+    {
+        unsigned int a = (k+n-1)%n, c = (k+1)%n;
+        bool convex = turn(a, k, c)>0.0;
+        if(above(k, a) && above(k, c))
+            type[k] = (convex)? Start : Split;
+        else if(above(a, k) && above(c, k))
+            type[k] = (convex)? End : Merge;
+        else
+            type[k] = Regular;
+    }
+
+    // sweep: status of the edges e_k = (k, k+1) with the interior on their right, ordered by x at the sweep line
+    double sweepY = 0.0;
+    auto xAt = [&](unsigned int e) {
+        if(e==n)
+            return P[n][0];
+        const Vector<2>& a = P[e];
+        const Vector<2>& b = P[(e+1)%n];
+        if(a[1]==b[1])
+            return std::min(a[0], b[0]);
+        return a[0]+(sweepY-a[1])*(b[0]-a[0])/(b[1]-a[1]);
+    };
+    auto less = [&](unsigned int e1, unsigned int e2) {
+        if(e1==e2)
+            return false;
+        double x1 = xAt(e1), x2 = xAt(e2);
+        if(x1!=x2)
+            return x1<x2;
+        // an edge through the query point counts as left of it
+        if(e1==n || e2==n)
+            return e2==n;
+        return e1<e2;
+    };
+    typedef std::set<unsigned int, decltype(less)> Status;
+    Status status(less);
+    vector<Status::iterator> where(n, status.end());
+    vector<unsigned int> helper(n, 0);
+    vector<std::pair<unsigned int, unsigned int> > diagonals;
+
+    vector<unsigned int> events(n);
+    for(unsigned int k=0;k<n;k++)
+        events[k] = k;
+    std::sort(events.begin(), events.end(), [&](unsigned int a, unsigned int b) {return above(a, b);});
+
+    auto insert = [&](unsigned int e, unsigned int h) {
+        where[e] = status.insert(e).first;
+        helper[e] = h;
+    };
+    auto erase = [&](unsigned int e) {
+        if(where[e]!=status.end())
+        {
+            status.erase(where[e]);
+            where[e] = status.end();
+        }
+    };
+    auto leftOf = [&](unsigned int k) {
+        P[n] = P[k];
+        Status::iterator it = status.lower_bound(n);
+        if(it==status.begin())
+            return n;
+        return *(--it);
+    };
+    auto fixUp = [&](unsigned int k, unsigned int e) {
+        if(type[helper[e]]==Merge)
+            diagonals.push_back(std::make_pair(k, helper[e]));
+    };
+    for(unsigned int k : events)
+    {
+        sweepY = P[k][1];
+        const unsigned int prevEdge = (k+n-1)%n;
+        switch(type[k])
+        {
+            case Start:
+                insert(k, k);
+                break;
+            case End:
+                fixUp(k, prevEdge);
+                erase(prevEdge);
+                break;
+            case Split:
+            {
+                unsigned int e = leftOf(k);
+                if(e<n)
+                {
+                    diagonals.push_back(std::make_pair(k, helper[e]));
+                    helper[e] = k;
+                }
+                insert(k, k);
+                break;
+            }
+            case Merge:
+            {
+                fixUp(k, prevEdge);
+                erase(prevEdge);
+                unsigned int e = leftOf(k);
+                if(e<n)
+                {
+                    fixUp(k, e);
+                    helper[e] = k;
+                }
+                break;
+            }
+            default:
+                if(above(prevEdge, k))
+                {
+                    // interior to the right: k is on a left chain
+                    fixUp(k, prevEdge);
+                    erase(prevEdge);
+                    insert(k, k);
+                }
+                else
+                {
+                    unsigned int e = leftOf(k);
+                    if(e<n)
+                    {
+                        fixUp(k, e);
+                        helper[e] = k;
+                    }
+                }
+        }
+    }
+
+    // faces of the polygon edges plus the diagonals: at every vertex the outgoing edges sorted by angle
+    vector<vector<std::pair<double, unsigned int> > > out(n);
+    auto addEdge = [&](unsigned int a, unsigned int b) {
+        out[a].push_back(std::make_pair(std::atan2(P[b][1]-P[a][1], P[b][0]-P[a][0]), b));
+    };
+    for(unsigned int k=0;k<n;k++)
+        addEdge(k, (k+1)%n);
+    for(unsigned int d=0;d<diagonals.size();d++)
+    {
+        addEdge(diagonals[d].first, diagonals[d].second);
+        addEdge(diagonals[d].second, diagonals[d].first);
+    }
+    vector<vector<bool> > used(n);
+    for(unsigned int k=0;k<n;k++)
+    {
+        std::sort(out[k].begin(), out[k].end());
+        used[k].assign(out[k].size(), false);
+    }
+
+    vector<unsigned int> piece, sorted, stack;
+    vector<bool> leftChain(n);
+    for(unsigned int s=0;s<n;s++)
+        for(unsigned int j=0;j<out[s].size();j++)
+        {
+            if(used[s][j])
+                continue;
+            // walk the face on the left of s->out[s][j]: at every vertex turn to the next edge clockwise from the way back
+            piece.clear();
+            unsigned int a = s, jj = j;
+            while(!used[a][jj])
+            {
+                used[a][jj] = true;
+                piece.push_back(a);
+                unsigned int b = out[a][jj].second;
+                double back = std::atan2(P[a][1]-P[b][1], P[a][0]-P[b][0]);
+                const vector<std::pair<double, unsigned int> >& o = out[b];
+                unsigned int next = std::lower_bound(o.begin(), o.end(), std::make_pair(back, 0u))-o.begin();
+                jj = (next==0)? o.size()-1 : next-1;
+                if(o[jj].second==a && o.size()>1)
+                    jj = (jj==0)? o.size()-1 : jj-1;
+                a = b;
+            }
+            const unsigned int m = piece.size();
+            if(m<3)
+                continue;
+
+            // triangulate the y-monotone piece: from the top, the forward (counter-clockwise) walk is the left chain
+            unsigned int top = 0, bottom = 0;
+            for(unsigned int k=1;k<m;k++)
+            {
+                if(above(piece[k], piece[top]))
+                    top = k;
+                if(above(piece[bottom], piece[k]))
+                    bottom = k;
+            }
+            for(unsigned int k=top;k!=bottom;k=(k+1)%m)
+                leftChain[piece[k]] = true;
+            for(unsigned int k=bottom;k!=top;k=(k+1)%m)
+                leftChain[piece[k]] = false;
+            sorted = piece;
+            std::sort(sorted.begin(), sorted.end(), [&](unsigned int x, unsigned int y) {return above(x, y);});
+            auto emit = [&](unsigned int x, unsigned int y, unsigned int z) {
+                if(turn(x, y, z)<0.0)
+                    std::swap(y, z);
+                TriangleIndices t = {{order[x], order[y], order[z]}};
+                triangles.push_back(t);
+            };
+            stack.clear();
+            stack.push_back(sorted[0]);
+            stack.push_back(sorted[1]);
+            for(unsigned int k=2;k+1<m;k++)
+            {
+                const unsigned int u = sorted[k];
+                if(leftChain[u]!=leftChain[stack.back()])
+                {
+                    for(unsigned int q=stack.size()-1;q>0;q--)
+                        emit(u, stack[q], stack[q-1]);
+                    stack.clear();
+                    stack.push_back(sorted[k-1]);
+                    stack.push_back(u);
+                }
+                else
+                {
+                    unsigned int last = stack.back();
+                    stack.pop_back();
+                    while(!stack.empty())
+                    {
+                        const unsigned int t = stack.back();
+                        const double convex = (leftChain[u])? turn(t, last, u) : turn(u, last, t);
+                        if(convex<=0.0)
+                            break;
+                        emit(u, last, t);
+                        last = t;
+                        stack.pop_back();
+                    }
+                    stack.push_back(last);
+                    stack.push_back(u);
+                }
+            }
+            for(unsigned int q=stack.size()-1;q>0;q--)
+                emit(sorted[m-1], stack[q], stack[q-1]);
+        }
+}
+
+/**
+* Triangulate a simple polygon
+* Ear clipping (fast on the usual inputs, large ones included thanks to the z-order hashing); above 256 vertices it
+* runs on a budget of 4*n*log2(n) tests (spiky polygons make it quadratic) and the monotone partition takes over when
+* that runs out, so a failed attempt costs at most about as much as the partition itself
+* @param v - vertices of the polygon (either orientation)
+* @return vector<TriangleIndices> - counter-clockwise index triples into v (n-2 triangles for n distinct, non-collinear vertices)
+**/
+inline vector<TriangleIndices> triangulate(const vector<Vector<2> >& v)
+{
+    vector<TriangleIndices> triangles;
+    const double n = v.size();
+    const size_t budget = (n>256.0)? size_t(4.0*n*std::log2(n)) : 0;
+    if(!triangulateEarClipping(v, triangles, budget))
+        triangulateMonotone(v, triangles);
+    return triangles;
+}
+
+/**
+* Triangulate a simple polygon
+* @param poly - polygon
+* @return vector<TriangleIndices> - counter-clockwise index triples into poly.vertices()
+**/
+inline vector<TriangleIndices> triangulate(const Polygon& poly)
+{
+    return triangulate(poly.vertices());
+}
+
+/**
+* Triangles of a triangulation
+* @param poly - triangulated polygon
+* @param triangles - index triples into poly.vertices()
+* @return vector<Triangle> - the triangles
+**/
+inline vector<Triangle> triangleList(const Polygon& poly, const vector<TriangleIndices>& triangles)
+{
+    const vector<Vector<2> >& v = poly.vertices();
+    vector<Triangle> res;
+    res.reserve(triangles.size());
+    for(unsigned int k=0;k<triangles.size();k++)
+        res.push_back(Triangle(v[triangles[k][0]], v[triangles[k][1]], v[triangles[k][2]]));
+    return res;
+}
+
+} }
+
+#endif
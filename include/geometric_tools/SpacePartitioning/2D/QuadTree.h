@@ -27,9 +27,11 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 #include <geometric_tools/Primitives/Polyline.h>
 #include <geometric_tools/Intersections/IntersectionInfo.h>
 #include <geometric_tools/Intersections/2D/RectangleToRectangle.h>
+#include <geometric_tools/Intersections/2D/PointInPolygon.h>
 #include <geometric_tools/Primitives/Tools/BoundingBox.h>
 #include <vector>
 #include <limits>
+#include <cmath>
 #include <algorithm>
 
 using std::vector;
@@ -52,6 +54,8 @@ protected:
     QuadTree** children_;
     int level_;
     vector<Polygon> objects_;
+    //bounding boxes of the objects (min x, min y, max x, max y)
+    vector<double> boxes_;
     unsigned int max_objects_;
     unsigned int max_level_;
 public:
@@ -65,52 +69,32 @@ public:
             children_[i] = nullptr;
     }
 
+    /**
+    * Add an object
+    * An object goes down to the quadrant that contains its bounding box; objects that straddle quadrants
+    * (or that a full node at the maximum level cannot take) stay at this node
+    * @param obj - the object
+    * @return bool - false if the object lies outside the tree or a leaf at the maximum level is full
+    **/
     bool addObject(const Polygon& obj)
     {
-        if(!canContainObject(obj))
-            return false;
-        if(level_<max_level_ && children_[0]!=nullptr)
-        {
-            for(int i=0;i<4;i++)
-            {
-                if(children_[i]->addObject(obj))
-                    return true;
-            }
-            return false;
-        }
-
-        objects_.push_back(obj);
-        if(objects_.size()>max_objects_)
-        {
-            if(!subdivide())
-            {
-                objects_.erase(objects_.end());
-                return false;
-            }
-            for(int j=0;j<objects_.size();j++)
-            {
-                int i;
-                for(i=0;i<4;i++)
-                {
-                    if(children_[i]->addObject(objects_[j]))
-                        break;
-                }
-                if(i==4)
-                {
-                    objects_.erase(objects_.end());
-                    clearChildren();
-                    return false;
-                }
-            }
-            objects_.clear();
-        }
-        return true;
+        double b[4];
+        bounds(obj, b);
+        return insert(obj, b);
     }
 
     bool removeObject(const Polygon& obj)
     {
         if(!canContainObject(obj))
             return false;
+        vector<Polygon>::iterator it = find(objects_.begin(), objects_.end(), obj);
+        if(it!=objects_.end())
+        {
+            unsigned int i = it-objects_.begin();
+            boxes_.erase(boxes_.begin()+4*i, boxes_.begin()+4*i+4);
+            objects_.erase(it);
+            return true;
+        }
         if(children_[0]!=nullptr)
         {
             for(int i=0;i<4;i++)
@@ -118,18 +102,21 @@ public:
                 if(children_[i]->removeObject(obj))
                     return true;
             }
-            return false;
         }
-        if(objects_.size()==0)
-            return false;
-        objects_.erase(find(objects_.begin(), objects_.end(), obj));
-        return true;
+        return false;
     }
 
     bool queryObject(const Polygon& obj)
     {
         if(!canContainObject(obj))
             return false;
+        double b[4];
+        bounds(obj, b);
+        for(int i=0;i<objects_.size();i++)
+        {
+            if(overlapBox(i, b))
+                return true;
+        }
         if(children_[0]!=nullptr)
         {
             for(int i=0;i<4;i++)
@@ -137,15 +124,6 @@ public:
                 if(children_[i]->queryObject(obj))
                     return true;
             }
-            return false;
-        }
-        if(objects_.size()==0)
-            return false;
-        for(int i=0;i<objects_.size();i++)
-        {
-            Intersection2DInfo* info = intersect(Primitives::boundingBox(objects_[i]), Primitives::boundingBox(obj));
-            if(info!=nullptr)
-                return true;
         }
         return false;
     }
@@ -154,6 +132,14 @@ public:
     {
         Rectangle poly_bound = Primitives::boundingBox(poly);
         if(!canContainObject(poly_bound))
+            return false;
+        double b[4];
+        bounds(poly_bound, b);
+        for(int i=0;i<objects_.size();i++)
+        {
+            if(overlapBox(i, b))
+                return true;
+        }
         if(children_[0]!=nullptr)
         {
             for(int i=0;i<4;i++)
@@ -161,16 +147,6 @@ public:
                 if(children_[i]->queryPolyline(poly))
                     return true;
             }
-            return false;
-        }
-        if(objects_.size()==0)
-            return false;
-        Intersection2DInfo* info;
-        for(int i=0;i<objects_.size()-1;i++)
-        {
-            info = intersect(poly_bound, Primitives::boundingBox(objects_[i]));
-            if(info != nullptr)
-                return true;
         }
         return false;
     }
@@ -180,6 +156,13 @@ public:
         Rectangle poly_bound = Primitives::boundingBox(poly);
         if(!canContainObject(poly_bound))
             return nullptr;
+        Intersection2DInfo* info;
+        for(int i=0;i<objects_.size();i++)
+        {
+            info = intersect(poly_bound, Primitives::boundingBox(objects_[i]));
+            if(info != nullptr)
+                return info;
+        }
         if(children_[0]!=nullptr)
         {
             for(int i=0;i<4;i++)
@@ -188,18 +171,66 @@ public:
                 if(s != nullptr)
                     return s;
             }
-            return nullptr;
         }
-        if(objects_.size()==0)
-            return nullptr;
-        Intersection2DInfo* info;
-        for(int i=0;i<objects_.size()-1;i++)
+        return nullptr;
+    }
+
+    /**
+    * Collect the objects whose bounding box overlaps a range
+    * @param range - axis aligned query rectangle
+    * @param result - the objects found are appended here
+    * @return unsigned int - number of objects appended
+    **/
+    unsigned int queryRange(const Rectangle& range, vector<Polygon>& result) const
+    {
+        if(!overlap(boundary_, range))
+            return 0;
+        unsigned int found = 0;
+        double b[4];
+        bounds(range, b);
+        for(int i=0;i<objects_.size();i++)
         {
-            info = intersect(poly_bound, Primitives::boundingBox(objects_[i]));
-            if(info != nullptr)
-                return info;
+            if(overlapBox(i, b))
+            {
+                result.push_back(objects_[i]);
+                found++;
+            }
         }
-        return nullptr;
+        if(children_[0]!=nullptr)
+        {
+            for(int i=0;i<4;i++)
+                found += children_[i]->queryRange(range, result);
+        }
+        return found;
+    }
+
+    /**
+    * Collect the objects that contain a point (non-zero winding rule, boundary included)
+    * @param p - query point
+    * @param result - the objects found are appended here
+    * @return unsigned int - number of objects appended
+    **/
+    unsigned int queryPoint(const Vector<2>& p, vector<Polygon>& result) const
+    {
+        Vector<2> c = boundary_.center(), h = boundary_.half();
+        if(p[0]<c[0]-h[0] || p[0]>c[0]+h[0] || p[1]<c[1]-h[1] || p[1]>c[1]+h[1])
+            return 0;
+        unsigned int found = 0;
+        const double b[4] = {p[0], p[1], p[0], p[1]};
+        for(int i=0;i<objects_.size();i++)
+        {
+            if(overlapBox(i, b) && contains(objects_[i], p))
+            {
+                result.push_back(objects_[i]);
+                found++;
+            }
+        }
+        if(children_[0]!=nullptr)
+        {
+            for(int i=0;i<4;i++)
+                found += children_[i]->queryPoint(p, result);
+        }
+        return found;
     }
 
     bool full()
@@ -216,8 +247,10 @@ public:
 
     bool empty()
     {
+        if(objects_.size()>0)
+            return false;
         if(level_ == max_level_ || children_[0]==nullptr)
-            return (objects_.size()==0);
+            return true;
         for(int i=0;i<4;i++)
         {
             if(!children_[i]->empty())
@@ -227,6 +260,90 @@ public:
     }
 
 protected:
+    /**
+    * Add an object with a known bounding box (see addObject)
+    * @param obj - the object
+    * @param b - bounding box of the object (min x, min y, max x, max y)
+    * @return bool - false if the object lies outside the tree or a leaf at the maximum level is full
+    **/
+    bool insert(const Polygon& obj, const double* b)
+    {
+        Vector<2> c = boundary_.center(), h = boundary_.half();
+        if(b[2]<c[0]-h[0] || b[0]>c[0]+h[0] || b[3]<c[1]-h[1] || b[1]>c[1]+h[1])
+            return false;
+        if(children_[0]!=nullptr)
+        {
+            int i = quadrant(b);
+            if(i<0 || !children_[i]->insert(obj, b))
+                store(obj, b);
+            return true;
+        }
+
+        store(obj, b);
+        if(objects_.size()>max_objects_)
+        {
+            if(!subdivide())
+            {
+                objects_.pop_back();
+                boxes_.resize(boxes_.size()-4);
+                return false;
+            }
+            vector<Polygon> objects;
+            vector<double> boxes;
+            objects.swap(objects_);
+            boxes.swap(boxes_);
+            for(int j=0;j<objects.size();j++)
+            {
+                int i = quadrant(&boxes[4*j]);
+                if(i<0 || !children_[i]->insert(objects[j], &boxes[4*j]))
+                    store(objects[j], &boxes[4*j]);
+            }
+        }
+        return true;
+    }
+
+    void store(const Polygon& obj, const double* b)
+    {
+        objects_.push_back(obj);
+        boxes_.insert(boxes_.end(), b, b+4);
+    }
+
+    static void bounds(const Polygon& obj, double* b)
+    {
+        const vector<Vector<2> >& v = obj.vertices();
+        b[0] = b[1] = std::numeric_limits<double>::infinity();
+        b[2] = b[3] = -std::numeric_limits<double>::infinity();
+        for(unsigned int k=0;k<v.size();k++)
+        {
+            b[0] = std::min(b[0], v[k][0]);
+            b[1] = std::min(b[1], v[k][1]);
+            b[2] = std::max(b[2], v[k][0]);
+            b[3] = std::max(b[3], v[k][1]);
+        }
+    }
+
+    bool overlapBox(const unsigned int& i, const double* b) const
+    {
+        const double* o = &boxes_[4*i];
+        return o[0]<=b[2] && b[0]<=o[2] && o[1]<=b[3] && b[1]<=o[3];
+    }
+
+    /**
+    * Quadrant that contains a bounding box entirely
+    * @param b - bounding box (min x, min y, max x, max y)
+    * @return int - index of the child, -1 if the box straddles quadrants
+    **/
+    int quadrant(const double* b) const
+    {
+        for(int i=0;i<4;i++)
+        {
+            Vector<2> c = children_[i]->boundary_.center(), h = children_[i]->boundary_.half();
+            if(b[0]>=c[0]-h[0] && b[2]<=c[0]+h[0] && b[1]>=c[1]-h[1] && b[3]<=c[1]+h[1])
+                return i;
+        }
+        return -1;
+    }
+
     bool subdivide()
     {
         if((level_+1)>max_level_)
@@ -236,7 +353,8 @@ protected:
         Vector<2> e2 = boundary_.vertices()[3]-p;
         Vector<2> center = p+(e1+e2)/2.0;
         double a = e1.length(), b = e2.length(), a_2 = a/2.0, b_2 = b/2.0;
-        Vector<2> t1{-a_2, -b_2}, t2{a_2, -b_2}, t3{-a_2, b_2}, t4=-t1;
+        //offsets from the center to the centers of the quadrants
+        Vector<2> t1{-a_2/2.0, -b_2/2.0}, t2{a_2/2.0, -b_2/2.0}, t3{-a_2/2.0, b_2/2.0}, t4{a_2/2.0, b_2/2.0};
 
         Rectangle r = Rectangle(center+t1, a_2, b_2);
         children_[0] = new QuadTree(r, level_+1, max_level_, max_objects_);
@@ -255,13 +373,13 @@ protected:
 
     bool canContainObject(const Polygon& obj)
     {
-        Intersection2DInfo* info = intersect(boundary_, Primitives::boundingBox(obj));
-        return (info != nullptr);
+        return overlap(boundary_, Primitives::boundingBox(obj));
     }
 
     void clear()
     {
         objects_.clear();
+        boxes_.clear();
         clearChildren();
     }
 
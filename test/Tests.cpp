@@ -21,21 +21,58 @@ OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISE
 #include <geometric_tools/Math/Transformations/2D/Homogeneous.h>
 #include <geometric_tools/Math/Transformations/3D/Homogeneous.h>
 #include <geometric_tools/Math/Numerical Optimization/1D/GoldenSearchMinimization.h>
+#include <geometric_tools/Math/Numerical Optimization/ND/NelderMead.h>
+#include <geometric_tools/Math/Numerical Optimization/ND/LBFGS.h>
+#include <geometric_tools/Math/Numerical Optimization/ND/MultiStart.h>
+#include <geometric_tools/Math/Numerical Optimization/ND/LevenbergMarquardt.h>
+#include <geometric_tools/Math/LinearSystems/SolveTridiagonal.h>
+#include <geometric_tools/Math/LinearSystems/SolveGauss.h>
+#include <geometric_tools/Math/LinearSystems/SolveLU.h>
+#include <geometric_tools/Math/LinearSystems/SolveLinear.h>
+#include <geometric_tools/Math/LinearSystems/LUDecomposition.h>
+#include <geometric_tools/Math/LinearSystems/QRDecomposition.h>
+#include <geometric_tools/Math/LinearSystems/LeastSquares.h>
+#include <geometric_tools/Math/LinearSystems/SolveCholesky.h>
+#include <geometric_tools/Math/LinearSystems/SVDDecomposition.h>
+#include <geometric_tools/Math/LinearSystems/EigenDecomposition.h>
+#include <geometric_tools/Math/LinearSystems/SolveIterative.h>
+#include <geometric_tools/Math/DynMatrix.h>
 #include <geometric_tools/Primitives/LinearShapes.h>
 #include <geometric_tools/Primitives/Polyline.h>
 #include <geometric_tools/Primitives/2D/Triangle.h>
 #include <geometric_tools/Primitives/2D/Rectangle.h>
 #include <geometric_tools/Primitives/2D/Circle.h>
+#include <geometric_tools/Primitives/Tools/Triangulation.h>
+#include <geometric_tools/Primitives/1D/PolynomialCurve.h>
+#include <geometric_tools/Primitives/1D/HermitePiecewiseCurve.h>
+#include <geometric_tools/Primitives/1D/CardinalPiecewiseCurve.h>
+#include <geometric_tools/Primitives/1D/PiecewisePolynomialCurve.h>
+#include <geometric_tools/Primitives/1D/CubicSplineCurve.h>
+#include <geometric_tools/Primitives/1D/BezierCurve.h>
+#include <geometric_tools/Primitives/1D/BSplineCurve.h>
+#include <geometric_tools/Primitives/2D/PlaneCurve.h>
+#include <geometric_tools/Primitives/Tools/CurveSubdivision.h>
+#include <geometric_tools/Primitives/Tools/ArcLength.h>
+#include <geometric_tools/Primitives/Tools/CurveFitting.h>
 #include <geometric_tools/Distances/PointToLinear.h>
+#include <geometric_tools/Distances/PointToCurve.h>
 #include <geometric_tools/Distances/LinearToLinear.h>
 #include <geometric_tools/Distances/LinearToPolyline.h>
 #include <geometric_tools/Intersections/IntersectionInfo.h>
 #include <geometric_tools/Intersections/2D/LinearToLinear.h>
 #include <geometric_tools/Intersections/2D/LinearToPolygon.h>
+#include <geometric_tools/Intersections/ConvexToConvex.h>
+#include <geometric_tools/Intersections/2D/SegmentSweep.h>
+#include <geometric_tools/Intersections/2D/SegmentBatch.h>
+#include <geometric_tools/Intersections/2D/RayScene.h>
+#include <geometric_tools/Intersections/2D/PointInPolygon.h>
+#include <geometric_tools/Intersections/2D/CurveToCurve.h>
+#include <geometric_tools/Distances/ConvexToConvex.h>
 #include <geometric_tools/Primitives/Tools/BoundingBox.h>
 #include <geometric_tools/SpacePartitioning/2D/QuadTree.h>
 
 #include <vector>
+#include <random>
 
 TEST(MathTest, VectorTests)
 {
@@ -126,8 +163,740 @@ TEST(LinearAlgebraTest, FunctionMin1D)
     std::tie(min, fmin) = goldenSearchMinimize(wrapper::f2, 0.0, 0.5, 1.0, tau);
     EXPECT_NEAR(min, 0.0, tau);
     EXPECT_NEAR(fmin, 2.0, tau);
+    // minimum at 0: the relative test alone never stops
+    std::tie(min, fmin) = goldenSearchMinimize([](double x) {return x*x;}, -1.0, 0.0, 1.0);
+    EXPECT_NEAR(min, 0.0, tau);
+    EXPECT_NEAR(fmin, 0.0, tau);
+}
+
+TEST(LinearAlgebraTest, BrentMin1D)
+{
+    using namespace GeometricTools::Math::NumericalOptimization;
+    // squared distance from a point to the parabola (t, t^2): a capturing lambda that counts its evaluations
+    const double px = 1.0, py = 0.5;
+    unsigned int evaluations = 0;
+    auto dist = [&](double t) {
+        evaluations++;
+        return (t-px)*(t-px)+(t*t-py)*(t*t-py);
+    };
+    // closest point: 2*t^3 + (1-2*py)*t - px = 0 -> t = 0.7937005259840998 (cube root of 0.5)
+    const double ts = std::cbrt(0.5);
+    double a, b, c, t, ft;
+    std::tie(a, b, c) = getBracket(dist, 0.0, 0.1);
+    // every point is evaluated once: the two starting points plus one per step
+    EXPECT_LE(evaluations, 6u);
+    EXPECT_LT(a, ts);
+    EXPECT_GT(c, ts);
+    EXPECT_LE(dist(b), std::min(dist(a), dist(c)));
+
+    evaluations = 0;
+    std::tie(t, ft) = goldenSearchMinimize(dist, a, b, c, 1e-12);
+    unsigned int goldenEvaluations = evaluations;
+    EXPECT_NEAR(t, ts, 1e-5);
+    EXPECT_NEAR(ft, dist(ts), 1e-10);
+
+    evaluations = 0;
+    std::tie(t, ft) = brentMinimize(dist, a, b, c, 1e-12);
+    EXPECT_NEAR(t, ts, 1e-6);
+    EXPECT_NEAR(ft, dist(ts), 1e-12);
+    EXPECT_LT(evaluations, goldenEvaluations/2);
+
+    // exact on a parabola, and works with plain function pointers too
+    struct wrapper
+    {
+        static double f(double x)
+        {
+            return x*x-2*x+2;
+        }
+    };
+    std::tie(t, ft) = brentMinimize(wrapper::f, -1.0, 0.0, 3.0);
+    EXPECT_NEAR(t, 1.0, 1e-10);
+    EXPECT_NEAR(ft, 1.0, 1e-15);
+    // minimum at the end of the bracket
+    std::tie(t, ft) = brentMinimize([](double x) {return std::exp(x);}, 0.0, 0.5, 1.0);
+    EXPECT_NEAR(t, 0.0, 1e-5);
+    // non-smooth: falls back to golden section steps
+    std::tie(t, ft) = brentMinimize([](double x) {return std::abs(x-0.7);}, 0.0, 0.5, 1.0, 1e-14);
+    EXPECT_NEAR(t, 0.7, 1e-6);
+    // minimum at 0 converges as fast as anywhere else
+    evaluations = 0;
+    auto square = [&](double x) {
+        evaluations++;
+        return x*x;
+    };
+    std::tie(t, ft) = brentMinimize(square, -1.0, 0.3, 1.0);
+    EXPECT_NEAR(t, 0.0, 1e-10);
+    EXPECT_LE(evaluations, 10u);
+}
+
+TEST(LinearAlgebraTest, FunctionMinND)
+{
+    using namespace GeometricTools::Math;
+    using namespace GeometricTools::Math::NumericalOptimization;
+    // chained Rosenbrock function and its gradient, for fixed and dynamic vectors
+    auto rosenbrock = [](const double* x, double* g, unsigned int n) {
+        double f = 0.0;
+        for(unsigned int i=0;i<n;i++)
+            g[i] = 0.0;
+        for(unsigned int i=0;i+1<n;i++)
+        {
+            double a = x[i+1]-x[i]*x[i], b = 1.0-x[i];
+            f += 100.0*a*a+b*b;
+            g[i] += -400.0*a*x[i]-2.0*b;
+            g[i+1] += 200.0*a;
+        }
+        return f;
+    };
+    auto rosenbrock2 = [&](const Vector<2>& x, Vector<2>& g) {return rosenbrock(x.data(), g.data(), 2);};
+    auto rosenbrockN = [&](const DynVector& x, DynVector& g) {return rosenbrock(x.data(), g.data(), x.size());};
+
+    // line search: strong Wolfe conditions along the steepest descent
+    Vector<2> x0(-1.2, 1.0), g0, d, x, g;
+    double f0 = rosenbrock2(x0, g0), fx, stp = 1e-3;
+    d = -g0;
+    unsigned int evaluations = 0;
+    EXPECT_TRUE(moreThuenteLineSearch(rosenbrock2, x0, f0, g0, d, stp, x, fx, g, evaluations));
+    EXPECT_LE(fx, f0+1e-4*stp*(g0*d));
+    EXPECT_LE(std::abs(g*d), 0.9*std::abs(g0*d));
+    EXPECT_NEAR((x-(x0+stp*d)).length(), 0.0, 1e-15);
+    EXPECT_GT(evaluations, 0u);
+
+    x = x0;
+    MinimizeInfo info = lbfgsMinimize(rosenbrock2, x);
+    EXPECT_TRUE(info.converged);
+    EXPECT_NEAR((x-Vector<2>(1.0, 1.0)).length(), 0.0, 1e-7);
+    EXPECT_NEAR(info.value, 0.0, 1e-14);
+
+    DynVector xn(20);
+    for(unsigned int i=0;i<20;i++)
+        xn[i] = (i%2)? 1.0 : -1.2;
+    info = lbfgsMinimize(rosenbrockN, xn, 1e-10);
+    EXPECT_TRUE(info.converged);
+    EXPECT_NEAR((xn-DynVector(20, 1.0)).length(), 0.0, 1e-7);
+
+    // derivative free: Nelder-Mead on the same problems, and on a capturing lambda
+    x = x0;
+    info = nelderMeadMinimize([&](const Vector<2>& v) {return rosenbrock2(v, g);}, x);
+    EXPECT_TRUE(info.converged);
+    EXPECT_NEAR((x-Vector<2>(1.0, 1.0)).length(), 0.0, 1e-6);
+    Vector<3> target(0.5, -2.0, 3.0), y;
+    auto quadratic = [&target](const Vector<3>& v) {return (v-target)*(v-target)+0.5*(v[0]-target[0])*(v[1]-target[1]);};
+    info = nelderMeadMinimize(quadratic, y, 1.0);
+    EXPECT_TRUE(info.converged);
+    EXPECT_NEAR((y-target).length(), 0.0, 1e-8);
+    DynVector xd(10);
+    for(unsigned int i=0;i<10;i++)
+        xd[i] = (i%2)? 1.0 : -1.2;
+    info = nelderMeadMinimize([&](const DynVector& v) {DynVector gv(v.size()); return rosenbrockN(v, gv);}, xd, 0.5, 1e-14);
+    EXPECT_TRUE(info.converged);
+    EXPECT_NEAR((xd-DynVector(10, 1.0)).length(), 0.0, 1e-6);
+    // the iteration budget is honoured
+    y = Vector<3>();
+    info = nelderMeadMinimize(quadratic, y, 1.0, 1e-10, 5);
+    EXPECT_FALSE(info.converged);
+    EXPECT_EQ(info.iterations, 5u);
+
+    // multi-start on the (multimodal) Rastrigin function: local searches from a grid of starts find the global minimum
+    auto rastrigin = [](const Vector<2>& v, Vector<2>& gv) {
+        double f = 20.0;
+        for(unsigned int i=0;i<2;i++)
+        {
+            f += v[i]*v[i]-10.0*std::cos(2.0*M_PI*v[i]);
+            gv[i] = 2.0*v[i]+20.0*M_PI*std::sin(2.0*M_PI*v[i]);
+        }
+        return f;
+    };
+    x = Vector<2>(2.3, -1.4);
+    info = lbfgsMinimize(rastrigin, x);
+    EXPECT_GT(info.value, 1.0);
+    vector<Vector<2> > starts;
+    for(int i=-3;i<=3;i++)
+        for(int j=-3;j<=3;j++)
+            starts.push_back(Vector<2>(i+0.3, j-0.4));
+    vector<Vector<2> > startsCopy = starts;
+    info = multiStartMinimize([&](Vector<2>& v) {return lbfgsMinimize(rastrigin, v);}, starts, x, 4);
+    EXPECT_NEAR(info.value, 0.0, 1e-12);
+    EXPECT_NEAR(x.length(), 0.0, 1e-6);
+    Vector<2> serial;
+    MinimizeInfo serialInfo = multiStartMinimize([&](Vector<2>& v) {return lbfgsMinimize(rastrigin, v);}, startsCopy, serial, 1);
+    EXPECT_EQ(serialInfo.evaluations, info.evaluations);
+    EXPECT_EQ(serial, x);
+}
+
+TEST(LinearAlgebraTest, LevenbergMarquardtTest)
+{
+    using namespace GeometricTools::Math;
+    using namespace GeometricTools::Math::NumericalOptimization;
+    std::mt19937 gen(17);
+    std::uniform_real_distribution<double> U(-5.0, 5.0);
+
+    // 2D registration: pose (angle, tx, ty) mapping the scan p onto the map q, 10 of the 60 matches are outliers
+    namespace T2 = Transformations2D;
+    Matrix<3,3> T = T2::translation(0.7, -1.2)*T2::rotation(0.4);
+    vector<Vector<3> > p(60), q(60);
+    for(unsigned int i=0;i<60;i++)
+    {
+        p[i] = Vector<3>(U(gen), U(gen), 1.0);
+        q[i] = T*p[i];
+        if(i%6==0)
+            q[i] = q[i]+Vector<3>(U(gen), U(gen), 0.0);
+    }
+    auto residual2D = [&](unsigned int i, const Vector<3>& x, double* r, double* J) {
+        Vector<3> e = T2::translation(x[1], x[2])*T2::rotation(x[0])*p[i]-q[i];
+        Vector<3> d = T2::rotation(x[0]+M_PI/2.0)*p[i];
+        for(unsigned int k=0;k<2;k++)
+        {
+            r[k] = e[k];
+            J[k*3] = d[k];
+            J[k*3+1] = (k==0)? 1.0 : 0.0;
+            J[k*3+2] = (k==1)? 1.0 : 0.0;
+        }
+    };
+    Vector<3> truth(0.4, 0.7, -1.2), x;
+    // least squares on the inliers only recovers the pose exactly
+    auto inliers = [&](unsigned int i, const Vector<3>& v, double* r, double* J) {residual2D(i+i/5+1, v, r, J);};
+    MinimizeInfo info = levenbergMarquardt(inliers, 50, 2, x);
+    EXPECT_TRUE(info.converged);
+    EXPECT_NEAR((x-truth).length(), 0.0, 1e-9);
+    EXPECT_NEAR(info.value, 0.0, 1e-15);
+    // the outliers bias plain least squares, a robust loss ignores them
+    x = Vector<3>();
+    levenbergMarquardt(residual2D, 60, 2, x);
+    EXPECT_GT((x-truth).length(), 1e-2);
+    x = Vector<3>();
+    info = levenbergMarquardt(residual2D, 60, 2, x, RobustLoss(RobustLoss::Cauchy, 0.01));
+    EXPECT_TRUE(info.converged);
+    EXPECT_NEAR((x-truth).length(), 0.0, 1e-6);
+    // the parallel evaluation gives the same answer
+    Vector<3> xs;
+    levenbergMarquardt(residual2D, 60, 2, xs, RobustLoss(RobustLoss::Cauchy, 0.01), 1e-10, 100, 1);
+    Vector<3> xp;
+    levenbergMarquardt(residual2D, 60, 2, xp, RobustLoss(RobustLoss::Cauchy, 0.01), 1e-10, 100, 4);
+    EXPECT_NEAR((xs-xp).length(), 0.0, 1e-12);
+
+    // 3D registration: pose (rx, ry, rz, tx, ty, tz) over DynVector, T = translation*Rz*Ry*Rx
+    namespace T3 = Transformations3D;
+    Matrix<4,4> T4 = T3::translation(1.0, 2.0, -0.5)*T3::rotationZ(-0.3)*T3::rotationY(0.2)*T3::rotationX(0.5);
+    vector<Vector<4> > p3(40), q3(40);
+    for(unsigned int i=0;i<40;i++)
+    {
+        p3[i] = Vector<4>(U(gen), U(gen), U(gen), 1.0);
+        q3[i] = T4*p3[i];
+        if(i%8==0)
+            q3[i] = q3[i]+Vector<4>(U(gen), U(gen), U(gen), 0.0);
+    }
+    // derivative of a rotation matrix: rotation by a+pi/2 without the fixed axis
+    auto dRotation = [](Matrix<4,4> R, unsigned int axis) {
+        R(axis, axis) = 0.0;
+        R(3, 3) = 0.0;
+        return R;
+    };
+    auto residual3D = [&](unsigned int i, const DynVector& v, double* r, double* J) {
+        Matrix<4,4> Rx = T3::rotationX(v[0]), Ry = T3::rotationY(v[1]), Rz = T3::rotationZ(v[2]);
+        Matrix<4,4> R = Rz*Ry*Rx;
+        Vector<4> e = T3::translation(v[3], v[4], v[5])*R*p3[i]-q3[i];
+        Vector<4> d0 = Rz*Ry*dRotation(T3::rotationX(v[0]+M_PI/2.0), 0)*p3[i];
+        Vector<4> d1 = Rz*dRotation(T3::rotationY(v[1]+M_PI/2.0), 1)*Rx*p3[i];
+        Vector<4> d2 = dRotation(T3::rotationZ(v[2]+M_PI/2.0), 2)*Ry*Rx*p3[i];
+        for(unsigned int k=0;k<3;k++)
+        {
+            r[k] = e[k];
+            double row[6] = {d0[k], d1[k], d2[k], (k==0)? 1.0 : 0.0, (k==1)? 1.0 : 0.0, (k==2)? 1.0 : 0.0};
+            std::copy(row, row+6, J+k*6);
+        }
+    };
+    DynVector truth3 = {0.5, 0.2, -0.3, 1.0, 2.0, -0.5}, x3(6);
+    info = levenbergMarquardt(residual3D, 40, 3, x3, RobustLoss(RobustLoss::Huber, 0.1));
+    EXPECT_TRUE(info.converged);
+    // Huber keeps a small influence of the outliers
+    EXPECT_NEAR((x3-truth3).length(), 0.0, 2e-2);
+    x3 = DynVector(6);
+    info = levenbergMarquardt(residual3D, 40, 3, x3, RobustLoss(RobustLoss::Cauchy, 0.01));
+    EXPECT_TRUE(info.converged);
+    EXPECT_NEAR((x3-truth3).length(), 0.0, 1e-5);
+    // robust losses: value and weight
+    double rho, w;
+    RobustLoss(RobustLoss::Huber, 2.0).evaluate(9.0, rho, w);
+    EXPECT_NEAR(rho, 2.0*2.0*3.0-4.0, 1e-15);
+    EXPECT_NEAR(w, 2.0/3.0, 1e-15);
+    RobustLoss(RobustLoss::SoftL1, 1.0).evaluate(3.0, rho, w);
+    EXPECT_NEAR(rho, 2.0, 1e-15);
+    EXPECT_NEAR(w, 0.5, 1e-15);
+    RobustLoss().evaluate(3.0, rho, w);
+    EXPECT_EQ(rho, 3.0);
+    EXPECT_EQ(w, 1.0);
 }
 
+TEST(LinearAlgebraTest, TridiagonalTest)
+{
+    using namespace GeometricTools::Math::LinearSystems;
+    vector<double> a = {0, 1, 1, 2, 1}, b = {4, 5, 6, 5, 4}, c = {1, 2, 1, 1, 0}, x = {1, -2, 3, 0.5, -1};
+    vector<double> d(5);
+    for(int i=0;i<5;i++)
+        d[i] = (i>0? a[i]*x[i-1] : 0.0)+b[i]*x[i]+(i<4? c[i]*x[i+1] : 0.0);
+    vector<double> sol = solveTridiagonal(a, b, c, d);
+    ASSERT_EQ(sol.size(), 5u);
+    for(int i=0;i<5;i++)
+        EXPECT_NEAR(sol[i], x[i], 1e-12);
+    // cyclic: corners a[0] (row 0, column 4) and c[4] (row 4, column 0)
+    a[0] = 0.5;
+    c[4] = 1.5;
+    for(int i=0;i<5;i++)
+        d[i] = a[i]*x[(i+4)%5]+b[i]*x[i]+c[i]*x[(i+1)%5];
+    sol = solveCyclicTridiagonal(a, b, c, d);
+    ASSERT_EQ(sol.size(), 5u);
+    for(int i=0;i<5;i++)
+        EXPECT_NEAR(sol[i], x[i], 1e-12);
+}
+
+TEST(LinearAlgebraTest, DenseSolversTest)
+{
+    using namespace GeometricTools::Math;
+    using namespace GeometricTools::Math::LinearSystems;
+    // non-square products
+    Matrix<2,3> M{1,2,3,4,5,6};
+    Matrix<3,2> N{1,0,0,1,1,1};
+    EXPECT_EQ(M*Vector<3>(1,1,1), Vector<2>(6,15));
+    EXPECT_EQ(Vector<2>(1,1)*M, Vector<3>(5,7,9));
+    EXPECT_EQ(M*N, (Matrix<2,2>(4,5,10,11)));
+    // determinant (needs a row exchange) and inverse
+    Matrix<3,3> A{0,2,1,1,1,0,3,0,1}, I;
+    I.identity();
+    EXPECT_NEAR(determinant(A), -5.0, 1e-12);
+    EXPECT_NEAR(determinant(Matrix<1,1>(7.0)), 7.0, 1e-12);
+    EXPECT_NEAR((A*inverse(A)-I).norm(), 0.0, 1e-12);
+    EXPECT_EQ(inverse(Matrix<2,2>(1,2,2,4)), (Matrix<2,2>()));
+
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> U(-1.0, 1.0);
+    Matrix<8,8> B;
+    Vector<8> x;
+    for(unsigned int i=0;i<8;i++)
+    {
+        x[i] = U(gen);
+        for(unsigned int j=0;j<8;j++)
+            B(i,j) = U(gen);
+    }
+    Vector<8> b = B*x;
+    EXPECT_NEAR((solveGauss(B, b)-x).length(), 0.0, 1e-10);
+    EXPECT_NEAR((solveLU(B, b)-x).length(), 0.0, 1e-10);
+    EXPECT_NEAR((solveLinear(B, b)-x).length(), 0.0, 1e-10);
+    // B = P*L*U
+    Matrix<8,8> L, R, P, Q, E;
+    E.identity();
+    LUDecomposition(B, L, R, P);
+    EXPECT_NEAR((P*L*R-B).norm(), 0.0, 1e-12);
+    for(unsigned int i=0;i<8;i++)
+        for(unsigned int j=0;j<i;j++)
+            EXPECT_EQ(R(i,j), 0.0);
+    // B = Q*R with orthogonal Q
+    QRDecomposition(B, Q, R);
+    EXPECT_NEAR((Q*R-B).norm(), 0.0, 1e-12);
+    EXPECT_NEAR((Q.transpose()*Q-E).norm(), 0.0, 1e-12);
+    for(unsigned int i=0;i<8;i++)
+        for(unsigned int j=0;j<i;j++)
+            EXPECT_EQ(R(i,j), 0.0);
+}
+
+TEST(LinearAlgebraTest, DynMatrixTest)
+{
+    using namespace GeometricTools::Math;
+    using namespace GeometricTools::Math::LinearSystems;
+    // sizes above the block sizes so that every blocked path is taken
+    const unsigned int n = 150, m = 300;
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> U(-1.0, 1.0);
+    DynMatrix A(n, n), B(n, m), C(m, n);
+    DynVector x(n);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(A.data())%64, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(x.data())%64, 0u);
+    for(unsigned int i=0;i<n;i++)
+    {
+        x[i] = U(gen);
+        for(unsigned int j=0;j<n;j++)
+            A(i,j) = U(gen);
+        for(unsigned int j=0;j<m;j++)
+        {
+            B(i,j) = U(gen);
+            C(j,i) = U(gen);
+        }
+    }
+    // blocked product against the naive triple loop
+    DynMatrix BC = B*C;
+    double err = 0.0;
+    for(unsigned int i=0;i<n;i++)
+        for(unsigned int j=0;j<n;j++)
+        {
+            double s = 0.0;
+            for(unsigned int k=0;k<m;k++)
+                s += B(i,k)*C(k,j);
+            err = std::max(err, std::abs(s-BC(i,j)));
+        }
+    EXPECT_NEAR(err, 0.0, 1e-12);
+    EXPECT_NEAR(((B*C).transpose()-C.transpose()*B.transpose()).norm(), 0.0, 1e-11);
+
+    DynVector b = A*x;
+    EXPECT_NEAR((solveLU(A, b)-x).length(), 0.0, 1e-9);
+    EXPECT_NEAR((solveLinear(A, b)-x).length(), 0.0, 1e-9);
+    EXPECT_NEAR((A*inverse(A)-DynMatrix::identity(n)).norm(), 0.0, 1e-9);
+    DynMatrix L, R, P, Q;
+    LUDecomposition(A, L, R, P);
+    EXPECT_NEAR((P*L*R-A).norm(), 0.0, 1e-10);
+    // symmetric positive definite system
+    DynMatrix S = A.transpose()*A+DynMatrix::identity(n);
+    EXPECT_TRUE(CholeskyDecomposition(S, L));
+    EXPECT_NEAR((L*L.transpose()-S).norm(), 0.0, 1e-10);
+    EXPECT_NEAR((solveCholesky(S, S*x)-x).length(), 0.0, 1e-9);
+    EXPECT_FALSE(CholeskyDecomposition(-S, L));
+    // tall QR and least squares against the normal equations
+    QRDecomposition(C, Q, R);
+    EXPECT_NEAR((Q*R-C).norm(), 0.0, 1e-10);
+    EXPECT_NEAR((Q.transpose()*Q-DynMatrix::identity(m)).norm(), 0.0, 1e-10);
+    DynVector c(m);
+    for(unsigned int i=0;i<m;i++)
+        c[i] = U(gen);
+    DynMatrix Ct = C.transpose();
+    EXPECT_NEAR((solveQR(C, c)-solveCholesky(Ct*C, Ct*c)).length(), 0.0, 1e-9);
+
+    // interop with the fixed-size types
+    Matrix<3,3> F{0,2,1,1,1,0,3,0,1};
+    DynMatrix D(F);
+    EXPECT_NEAR(determinant(D), -5.0, 1e-12);
+    EXPECT_EQ((D.block<3,3>()), F);
+    EXPECT_EQ((A.block<2,2>(4,5)), (Matrix<2,2>(A(4,5),A(4,6),A(5,5),A(5,6))));
+    A.setBlock(1, 2, F);
+    EXPECT_EQ(A(3,2), 3.0);
+    MatrixView v = A.view(1, 2, 3, 3);
+    EXPECT_EQ(DynMatrix(v), D);
+    MatrixView w(F);
+    w(0,0) = 4.0;
+    EXPECT_EQ(F(0,0), 4.0);
+    EXPECT_EQ((DynVector(Vector<3>(1,2,3)).fixed<3>()), Vector<3>(1,2,3));
+    EXPECT_EQ((D*DynVector{1,1,1}), DynVector(Vector<3>(3,2,4)));
+}
+
+TEST(LinearAlgebraTest, CholeskyTest)
+{
+    using namespace GeometricTools::Math;
+    using namespace GeometricTools::Math::LinearSystems;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> U(-1.0, 1.0);
+    // A = R^T*R+I is symmetric positive definite
+    Matrix<4,4> R, A, L, E;
+    for(unsigned int i=0;i<4;i++)
+        for(unsigned int j=0;j<4;j++)
+            R(i,j) = U(gen);
+    E.identity();
+    A = R.transpose()*R+E;
+    Vector<4> x(U(gen), U(gen), U(gen), U(gen)), b = A*x, d;
+    EXPECT_TRUE(CholeskyDecomposition(A, L));
+    EXPECT_NEAR((L*L.transpose()-A).norm(), 0.0, 1e-12);
+    EXPECT_EQ(L(0,3), 0.0);
+    EXPECT_NEAR((solveCholesky(A, b)-x).length(), 0.0, 1e-12);
+    EXPECT_NEAR((choleskySolve(L, b)-x).length(), 0.0, 1e-12);
+    EXPECT_FALSE(CholeskyDecomposition(-1.0*A, L));
+
+    // above GEOMETRIC_TOOLS_CHOLESKY_UNROLL the blocked kernel factors the system
+    Matrix<12,12> R12, A12, L12, E12;
+    for(unsigned int i=0;i<12;i++)
+        for(unsigned int j=0;j<12;j++)
+            R12(i,j) = U(gen);
+    E12.identity();
+    A12 = R12.transpose()*R12+E12;
+    Vector<12> x12;
+    for(unsigned int i=0;i<12;i++)
+        x12[i] = U(gen);
+    EXPECT_TRUE(CholeskyDecomposition(A12, L12));
+    EXPECT_NEAR((L12*L12.transpose()-A12).norm(), 0.0, 1e-10);
+    EXPECT_NEAR((solveCholesky(A12, A12*x12)-x12).length(), 0.0, 1e-10);
+
+    // rank-1 update/downdate against refactorization
+    EXPECT_TRUE(CholeskyDecomposition(A, L));
+    Vector<4> v(0.5, -1.0, 2.0, 0.25);
+    choleskyUpdate(L, v);
+    Matrix<4,4> Av = A+v*(~v), Lv;
+    CholeskyDecomposition(Av, Lv);
+    EXPECT_NEAR((L-Lv).norm(), 0.0, 1e-12);
+    EXPECT_TRUE(choleskyDowndate(L, v));
+    EXPECT_NEAR((L*L.transpose()-A).norm(), 0.0, 1e-12);
+    Lv = L;
+    EXPECT_FALSE(choleskyDowndate(L, 10.0*v));
+    EXPECT_EQ(L, Lv);
+
+    // LDL^T of a symmetric indefinite matrix
+    Matrix<3,3> S{4,2,1, 2,-3,0, 1,0,2}, Ls, Ds;
+    Vector<3> ds, y(1,2,3);
+    EXPECT_TRUE(LDLTDecomposition(S, Ls, ds));
+    for(unsigned int i=0;i<3;i++)
+        Ds(i,i) = ds[i];
+    EXPECT_NEAR((Ls*Ds*Ls.transpose()-S).norm(), 0.0, 1e-12);
+    EXPECT_LT(ds[1], 0.0);
+    EXPECT_NEAR((solveLDLT(S, S*y)-y).length(), 0.0, 1e-12);
+    EXPECT_NEAR((ldltSolve(Ls, ds, S*y)-y).length(), 0.0, 1e-12);
+    EXPECT_TRUE(LDLTDecomposition(A, L, d));
+    EXPECT_TRUE(ldltUpdate(L, d, v, -0.5));
+    EXPECT_NEAR((ldltSolve(L, d, b-0.5*(v*x)*v)-x).length(), 0.0, 1e-10);
+
+    // batched solves (the last tile is partial), one system is not positive definite
+    const unsigned int n = 1001;
+    vector<Matrix<3,3> > As(n);
+    vector<Vector<3> > Bs(n);
+    for(unsigned int s=0;s<n;s++)
+    {
+        Matrix<3,3> Q;
+        for(unsigned int i=0;i<3;i++)
+        {
+            Bs[s][i] = U(gen);
+            for(unsigned int j=0;j<3;j++)
+                Q(i,j) = U(gen);
+        }
+        As[s] = Q*Q.transpose();
+        for(unsigned int i=0;i<3;i++)
+            As[s](i,i) += 0.1;
+    }
+    As[17] = -1.0*As[17];
+    CholeskyBatch<3> batch(n);
+    for(unsigned int s=0;s<n;s++)
+        batch.set(s, As[s], Bs[s]);
+    EXPECT_EQ(batch.solve(2), n-1);
+    EXPECT_FALSE(batch.ok(17));
+    vector<Vector<3> > Xs = solveCholesky(As, Bs);
+    double err = 0.0;
+    for(unsigned int s=0;s<n;s++)
+    {
+        if(s==17)
+            continue;
+        EXPECT_TRUE(batch.ok(s));
+        err = std::max(err, (batch.solution(s)-solveLU(As[s], Bs[s])).length());
+        err = std::max(err, (Xs[s]-batch.solution(s)).length());
+    }
+    EXPECT_NEAR(err, 0.0, 1e-9);
+    EXPECT_EQ(Xs[17], Bs[17]);
+
+    // dynamic sizes
+    DynMatrix Ad(A), Ld;
+    DynVector dd;
+    EXPECT_TRUE(CholeskyDecomposition(Ad, Ld));
+    EXPECT_TRUE(choleskyUpdate(Ld, DynVector(v)));
+    EXPECT_NEAR((Ld*Ld.transpose()-DynMatrix(Av)).norm(), 0.0, 1e-12);
+    EXPECT_FALSE(choleskyUpdate(Ld, DynVector(100.0*v), -1.0));
+    EXPECT_TRUE(LDLTDecomposition(DynMatrix(S), Ld, dd));
+    EXPECT_NEAR((solveLDLT(DynMatrix(S), DynVector(S*y))-DynVector(y)).length(), 0.0, 1e-12);
+}
+
+TEST(LinearAlgebraTest, SVDEigenTest)
+{
+    using namespace GeometricTools::Math;
+    using namespace GeometricTools::Math::LinearSystems;
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> U(-1.0, 1.0);
+    Matrix<3,3> A, Ua, Sa, Va, I3;
+    Matrix<5,3> B, Ub;
+    Matrix<4,4> C, Uc, Sc, Vc, I4;
+    I3.identity();
+    I4.identity();
+    for(unsigned int i=0;i<5;i++)
+        for(unsigned int j=0;j<3;j++)
+            B(i,j) = U(gen);
+    for(unsigned int i=0;i<4;i++)
+        for(unsigned int j=0;j<4;j++)
+            C(i,j) = U(gen);
+    A = B.transpose()*B;
+
+    SVDDecomposition(C, Uc, Sc, Vc);
+    EXPECT_NEAR((Uc*Sc*Vc.transpose()-C).norm(), 0.0, 1e-12);
+    EXPECT_NEAR((Uc.transpose()*Uc-I4).norm(), 0.0, 1e-12);
+    EXPECT_NEAR((Vc.transpose()*Vc-I4).norm(), 0.0, 1e-12);
+    for(unsigned int i=0;i+1<4;i++)
+        EXPECT_GE(Sc(i,i), Sc(i+1,i+1));
+    // thin SVD of a tall matrix
+    Vector<3> s;
+    EXPECT_TRUE(SVDDecomposition(B, Ub, s, Va));
+    for(unsigned int i=0;i<3;i++)
+        for(unsigned int j=0;j<3;j++)
+            Sa(i,j) = (i==j) ? s[i] : 0.0;
+    EXPECT_NEAR((Ub*Sa*Va.transpose()-B).norm(), 0.0, 1e-12);
+    EXPECT_NEAR((Ub.transpose()*Ub-I3).norm(), 0.0, 1e-12);
+    // rank 1: U is still orthogonal
+    Vector<3> a(1,2,3), b(-1,0.5,2);
+    SVDDecomposition(Matrix<3,3>(a*(~b)), Ua, Sa, Va);
+    EXPECT_NEAR(Sa(0,0), a.length()*b.length(), 1e-12);
+    EXPECT_NEAR(Sa(1,1), 0.0, 1e-12);
+    EXPECT_NEAR((Ua.transpose()*Ua-I3).norm(), 0.0, 1e-12);
+    EXPECT_NEAR((Ua*Sa*Va.transpose()-a*(~b)).norm(), 0.0, 1e-12);
+    // wide dynamic matrix
+    DynMatrix W = DynMatrix(B).transpose(), Uw, Vw;
+    DynVector sw;
+    EXPECT_TRUE(SVDDecomposition(W, Uw, sw, Vw));
+    EXPECT_EQ(Uw.rows(), 3u);
+    EXPECT_EQ(Vw.rows(), 5u);
+    EXPECT_NEAR((sw-DynVector(s)).length(), 0.0, 1e-12);
+    DynMatrix Sw(3, 3);
+    for(unsigned int i=0;i<3;i++)
+        Sw(i,i) = sw[i];
+    EXPECT_NEAR((Uw*Sw*Vw.transpose()-W).norm(), 0.0, 1e-12);
+
+    // symmetric eigen decomposition, closed form 3x3 against Jacobi
+    Vector<3> w, wj;
+    Matrix<3,3> V, Vj, D;
+    EXPECT_TRUE(EigenDecomposition(A, w, V));
+    EXPECT_TRUE(EigenDecomposition<3>(A, wj, Vj));
+    EXPECT_NEAR((w-wj).length(), 0.0, 1e-12);
+    EXPECT_NEAR((w-Vector<3>(s[0]*s[0], s[1]*s[1], s[2]*s[2])).length(), 0.0, 1e-12);
+    for(unsigned int i=0;i<3;i++)
+        D(i,i) = w[i];
+    EXPECT_NEAR((V*D*V.transpose()-A).norm(), 0.0, 1e-12);
+    EXPECT_NEAR((V.transpose()*V-I3).norm(), 0.0, 1e-12);
+    // repeated eigenvalue and degenerate inputs
+    Matrix<3,3> R = Ua;
+    Matrix<3,3> M = R*Matrix<3,3>(2,0,0, 0,5,0, 0,0,2)*R.transpose();
+    EigenDecomposition(M, w, V);
+    EXPECT_NEAR((w-Vector<3>(5,2,2)).length(), 0.0, 1e-12);
+    D.zero();
+    for(unsigned int i=0;i<3;i++)
+        D(i,i) = w[i];
+    EXPECT_NEAR((V*D*V.transpose()-M).norm(), 0.0, 1e-12);
+    EXPECT_NEAR((V.transpose()*V-I3).norm(), 0.0, 1e-12);
+    EigenDecomposition(Matrix<3,3>(), w, V);
+    EXPECT_EQ(w, Vector<3>(0,0,0));
+    EigenDecomposition(3.0*I3, w, V);
+    EXPECT_EQ(w, Vector<3>(3,3,3));
+    EXPECT_EQ(V, I3);
+    // Jacobi for other sizes
+    Vector<4> w4;
+    Matrix<4,4> V4, D4, S4 = C+C.transpose();
+    EXPECT_TRUE(EigenDecomposition(S4, w4, V4));
+    for(unsigned int i=0;i<4;i++)
+        D4(i,i) = w4[i];
+    EXPECT_NEAR((V4*D4*V4.transpose()-S4).norm(), 0.0, 1e-12);
+    EXPECT_NEAR((V4.transpose()*V4-I4).norm(), 0.0, 1e-12);
+    DynVector wd;
+    DynMatrix Vd;
+    EXPECT_TRUE(EigenDecomposition(DynMatrix(S4), wd, Vd));
+    EXPECT_NEAR((wd-DynVector(w4)).length(), 0.0, 1e-12);
+}
+
+
+TEST(LinearAlgebraTest, SparseSolverTest)
+{
+    using namespace GeometricTools::Math;
+    using namespace GeometricTools::Math::LinearSystems;
+    // 2D grid Laplacian (Dirichlet boundary) assembled edge by edge - the diagonal is built from duplicates
+    auto laplacian = [](unsigned int m, double convection) {
+        TripletBuilder T(m*m, m*m);
+        T.reserve(5*m*m);
+        for(unsigned int i=0;i<m;i++)
+            for(unsigned int j=0;j<m;j++)
+            {
+                unsigned int k = i*m+j;
+                for(unsigned int e=0;e<4;e++)
+                    T.add(k, k, 1.0);
+                if(j+1<m)
+                {
+                    T.add(k, k+1, -1.0+convection);
+                    T.add(k+1, k, -1.0-convection);
+                }
+                if(i+1<m)
+                {
+                    T.add(k, k+m, -1.0);
+                    T.add(k+m, k, -1.0);
+                }
+            }
+        return T.build();
+    };
+    SparseMatrix A = laplacian(20, 0.0);
+    EXPECT_EQ(A.rows(), 400u);
+    EXPECT_EQ(A.nonZeros(), size_t(400+4*20*19));
+    EXPECT_EQ(A(21, 21), 4.0);
+    EXPECT_EQ(A(21, 22), -1.0);
+    EXPECT_EQ(A(21, 41), -1.0);
+    EXPECT_EQ(A(21, 23), 0.0);
+    EXPECT_EQ(A.find(21, 23), A.nonZeros());
+    DynMatrix Ad = A.toDense();
+    EXPECT_EQ(Ad, A.transpose().toDense());
+
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> U(-1.0, 1.0);
+    DynVector b(400), x;
+    for(unsigned int i=0;i<400;i++)
+        b[i] = U(gen);
+    EXPECT_NEAR((A*b-Ad*b).length(), 0.0, 1e-12);
+
+    IterativeInfo plain = solveCG(A, b, x, 1e-10);
+    EXPECT_TRUE(plain.converged);
+    EXPECT_NEAR((A*x-b).length()/b.length(), 0.0, 1e-9);
+    // warm start from the solution
+    IterativeInfo warm = solveCG(A, b, x, 1e-8);
+    EXPECT_TRUE(warm.converged);
+    EXPECT_EQ(warm.iterations, 0u);
+
+    JacobiPreconditioner J(A);
+    x = DynVector();
+    IterativeInfo jacobi = solveCG(A, b, x, J, 1e-10);
+    EXPECT_TRUE(jacobi.converged);
+    EXPECT_NEAR((A*x-b).length()/b.length(), 0.0, 1e-9);
+
+    IC0Preconditioner IC(A);
+    EXPECT_TRUE(IC.ok());
+    EXPECT_EQ(IC.shift(), 0.0);
+    x = DynVector();
+    IterativeInfo ic = solveCG(A, b, x, IC, 1e-10);
+    EXPECT_TRUE(ic.converged);
+    EXPECT_NEAR((A*x-b).length()/b.length(), 0.0, 1e-9);
+    EXPECT_LT(ic.iterations, plain.iterations/2);
+    // IC(0) of a tridiagonal matrix has no dropped fill-in: it is the exact Cholesky factor
+    TripletBuilder T3(50, 50);
+    for(unsigned int i=0;i<50;i++)
+    {
+        T3.add(i, i, 3.0);
+        if(i>0)
+        {
+            T3.add(i, i-1, -1.0);
+            T3.add(i-1, i, -1.0);
+        }
+    }
+    SparseMatrix A3 = T3.build();
+    DynVector b3(50, 1.0), x3;
+    IterativeInfo exact = solveCG(A3, b3, x3, IC0Preconditioner(A3), 1e-12);
+    EXPECT_TRUE(exact.converged);
+    EXPECT_EQ(exact.iterations, 1u);
+    // not positive definite: shifted, then Jacobi fallback
+    TripletBuilder T2(2, 2);
+    T2.add(0, 0, 1.0); T2.add(0, 1, 2.0);
+    T2.add(1, 0, 2.0); T2.add(1, 1, 1.0);
+    EXPECT_FALSE(IC0Preconditioner(T2.build()).ok());
+    T2.add(0, 1, -0.95); T2.add(1, 0, -0.95);
+    IC0Preconditioner shifted(T2.build());
+    EXPECT_TRUE(shifted.ok());
+    EXPECT_GT(shifted.shift(), 0.0);
+
+    // nonsymmetric convection-diffusion
+    SparseMatrix C = laplacian(20, 0.4);
+    EXPECT_NE(C(21, 22), C(22, 21));
+    x = DynVector();
+    IterativeInfo bicg = solveBiCGSTAB(C, b, x, 1e-10);
+    EXPECT_TRUE(bicg.converged);
+    EXPECT_NEAR((C*x-b).length()/b.length(), 0.0, 1e-9);
+    x = DynVector();
+    bicg = solveBiCGSTAB(C, b, x, JacobiPreconditioner(C), 1e-10);
+    EXPECT_TRUE(bicg.converged);
+    EXPECT_NEAR((C*x-b).length()/b.length(), 0.0, 1e-9);
+    x = DynVector();
+    bicg = solveBiCGSTAB(A, b, x, IC, 1e-10);
+    EXPECT_TRUE(bicg.converged);
+    EXPECT_NEAR((A*x-b).length()/b.length(), 0.0, 1e-9);
+
+    // the parallel product matches the serial one
+    SparseMatrix L = laplacian(200, 0.1);
+    DynVector v(L.cols()), y1(L.rows()), y4(L.rows());
+    for(unsigned int i=0;i<v.size();i++)
+        v[i] = U(gen);
+    L.multiply(v.data(), y1.data(), 1);
+    L.multiply(v.data(), y4.data(), 4);
+    EXPECT_EQ(y1, y4);
+    EXPECT_EQ(solveCG(L, DynVector(L.rows()), x).iterations, 0u);
+    EXPECT_EQ(x, DynVector(L.rows()));
+}
 TEST(ShapeTest, LinearShapesTest)
 {
     using namespace GeometricTools::Primitives;
@@ -166,6 +935,572 @@ TEST(ShapeTest, Shapes2DTest)
     EXPECT_EQ(r.vertices().size(), 4);
 }
 
+TEST(ShapeTest, TriangulationTest)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Math;
+    using GeometricTools::Intersections::contains;
+    // checks n-2 counter-clockwise triangles inside the polygon covering its area
+    auto check = [](Polygon& poly, const vector<TriangleIndices>& triangles, const unsigned int& n) {
+        double total = 0.0;
+        EXPECT_EQ(triangles.size(), n-2);
+        for(const Triangle& t : triangleList(poly, triangles))
+        {
+            const vector<Vector<2> >& v = t.vertices();
+            double a = 0.5*((v[1][0]-v[0][0])*(v[2][1]-v[0][1])-(v[1][1]-v[0][1])*(v[2][0]-v[0][0]));
+            EXPECT_GT(a, 0.0);
+            total += a;
+            EXPECT_TRUE(contains(poly, Vector<2>((v[0][0]+v[1][0]+v[2][0])/3.0, (v[0][1]+v[1][1]+v[2][1])/3.0)));
+        }
+        EXPECT_NEAR(total, std::fabs(poly.area()), 1e-9*std::fabs(poly.area()));
+    };
+
+    // square with the closing point repeated, clockwise
+    Polygon square;
+    square.addPoint({0,0});
+    square.addPoint({0,1});
+    square.addPoint({1,1});
+    square.addPoint({1,0});
+    square.addPoint({0,0});
+    vector<TriangleIndices> triangles = triangulate(square);
+    EXPECT_EQ(triangles.size(), 2);
+    for(const TriangleIndices& t : triangles)
+        for(unsigned int k=0;k<3;k++)
+            EXPECT_LT(t[k], 4);
+
+    // comb (concave, horizontal edges, merge and split vertices for the sweep)
+    Polygon comb;
+    comb.addPoint({0,0});
+    comb.addPoint({9,0});
+    for(unsigned int i=0;i<5;i++)
+    {
+        comb.addPoint({9.0-2.0*i, 3.0+i%2});
+        comb.addPoint({8.0-2.0*i, 3.0+i%2});
+        if(i<4)
+            comb.addPoint({8.0-2.0*i, 1.0});
+    }
+    const unsigned int n = comb.vertices().size();
+    triangles.clear();
+    EXPECT_TRUE(triangulateEarClipping(comb.vertices(), triangles));
+    check(comb, triangles, n);
+    triangles.clear();
+    triangulateMonotone(comb.vertices(), triangles);
+    check(comb, triangles, n);
+    // the same comb upside down exchanges split and merge vertices
+    Polygon flipped;
+    for(const Vector<2>& p : comb.vertices())
+        flipped.addPoint({p[0], -p[1]});
+    triangles.clear();
+    triangulateMonotone(flipped.vertices(), triangles);
+    check(flipped, triangles, n);
+
+    // large spiky star shaped polygon: the ear clipping budget runs out and the monotone partition takes over
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> R(0.2, 1.0);
+    Polygon star;
+    for(unsigned int i=0;i<3000;i++)
+    {
+        double a = 2.0*M_PI*i/3000.0, r = R(gen);
+        star.addPoint({r*std::cos(a), r*std::sin(a)});
+    }
+    triangles.clear();
+    EXPECT_FALSE(triangulateEarClipping(star.vertices(), triangles, 3000));
+    EXPECT_TRUE(triangles.empty());
+    EXPECT_TRUE(triangulateEarClipping(star.vertices(), triangles));
+    check(star, triangles, 3000);
+    check(star, triangulate(star), 3000);
+    // smaller spiky polygon: ear clipping stays within its budget
+    Polygon small;
+    for(unsigned int i=0;i<500;i++)
+    {
+        double a = 2.0*M_PI*i/500.0, r = R(gen);
+        small.addPoint({r*std::cos(a), r*std::sin(a)});
+    }
+    check(small, triangulate(small), 500);
+}
+
+TEST(ShapeTest, CurveEvaluationTest)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Math;
+    // p(u) = 2u^3-u^2+3u-5
+    CubicPolynomialCurve cubic(Vector<4>({2,-1,3,-5}));
+    vector<double> u, out(101), d(101), dd(101);
+    for(int i=0;i<=100;i++)
+        u.push_back(-1.0+0.02*i);
+    cubic.getPoints(u.data(), out.data(), u.size());
+    cubic.getDerivatives(u.data(), d.data(), u.size());
+    cubic.getDerivatives(u.data(), dd.data(), u.size(), 2);
+    for(unsigned int i=0;i<u.size();i++)
+    {
+        double x = u[i];
+        EXPECT_NEAR(cubic.getPoint(x), 2*x*x*x-x*x+3*x-5, 1e-12);
+        EXPECT_NEAR(out[i], cubic.getPoint(x), 1e-12);
+        EXPECT_NEAR(d[i], 6*x*x-2*x+3, 1e-12);
+        EXPECT_NEAR(cubic.getDerivative(x), d[i], 1e-12);
+        EXPECT_NEAR(dd[i], 12*x-2, 1e-12);
+    }
+    EXPECT_EQ(cubic.getDerivative(0.3, 4), 0.0);
+
+    // in-place batch on a piecewise curve matches point evaluation and the numerical derivative
+    CardinalPiecewiseCurve cardinal(0.0);
+    double pts[] = {1, 2, 7, 3, 0, -2, 4};
+    for(int i=0;i<7;i++)
+        cardinal.addPoint(pts[i]);
+    vector<double> v(u.size());
+    for(unsigned int i=0;i<u.size();i++)
+        v[i] = (u[i]+1.0)/2.0;
+    vector<double> w = v;
+    cardinal.getPoints(w.data(), w.data(), w.size());
+    for(unsigned int i=0;i<v.size();i++)
+    {
+        EXPECT_NEAR(w[i], cardinal.getPoint(v[i]), 1e-12);
+        if(v[i]>0.01 && v[i]<0.99 && std::abs(v[i]*4.0-std::round(v[i]*4.0))>0.01)
+        {
+            EXPECT_NEAR(cardinal.getDerivative(v[i]), (cardinal.getPoint(v[i]+1e-6)-cardinal.getPoint(v[i]-1e-6))/2e-6, 1e-5);
+        }
+    }
+
+    PlaneCurve<HermitePiecewiseCurve,HermitePiecewiseCurve> hermite;
+    hermite.addDotPoint({1,2,0,1});
+    hermite.addDotPoint({2,7,1,2});
+    hermite.addDotPoint({3,0,-1,-2});
+    Polyline<2> poly = uniformSubdivision(hermite, 20);
+    ASSERT_EQ(poly.vertices().size(), 21u);
+    for(int i=0;i<=20;i++)
+    {
+        EXPECT_NEAR(poly.vertices()[i][0], hermite.getPoint(i/20.0)[0], 1e-12);
+        EXPECT_NEAR(poly.vertices()[i][1], hermite.getPoint(i/20.0)[1], 1e-12);
+    }
+}
+
+TEST(ShapeTest, PiecewisePolynomialCurveTest)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Math;
+    HermitePiecewiseCurve hermite;
+    hermite.addDotPoint({1,2});
+    hermite.addDotPoint({2,7});
+    hermite.addDotPoint({3,0});
+    hermite.addDotPoint({2,-3});
+    PiecewiseCubicCurve flat(hermite);
+    EXPECT_EQ(flat.pieces(), 3u);
+    EXPECT_EQ(flat.coeff(), hermite.coeff());
+    vector<double> u, out(201);
+    for(int i=0;i<=200;i++)
+        u.push_back(-0.1+1.2*i/200.0);
+    flat.getPoints(u.data(), out.data(), u.size());
+    for(unsigned int i=0;i<u.size();i++)
+    {
+        EXPECT_NEAR(flat.getPoint(u[i]), hermite.getPoint(u[i]), 1e-12);
+        EXPECT_NEAR(out[i], hermite.getPoint(u[i]), 1e-12);
+        EXPECT_NEAR(flat.getDerivative(u[i]), hermite.getDerivative(u[i]), 1e-9);
+    }
+    PiecewiseLinearCurve line;
+    line.addPiece(Vector<2>({1,0}));
+    line.addPiece(Vector<2>({-2,1}));
+    EXPECT_DOUBLE_EQ(line.getPoint(0.25), 0.5);
+    EXPECT_DOUBLE_EQ(line.getPoint(0.75), 0.0);
+    EXPECT_DOUBLE_EQ(line.getDerivative(0.75), -4.0);
+
+    // non-uniform knots: pieces over [0,1], [1,4] and [4,5]
+    PiecewiseLinearCurve ramp;
+    ramp.addPiece(Vector<2>({1,0}), 1.0);
+    ramp.addPiece(Vector<2>({3,1}), 4.0);
+    ramp.addPiece(Vector<2>({-4,4}), 5.0);
+    EXPECT_FALSE(ramp.uniformKnots());
+    EXPECT_EQ(ramp.knots(), vector<double>({0,1,4,5}));
+    EXPECT_EQ(ramp.findPiece(-1.0), 0u);
+    EXPECT_EQ(ramp.findPiece(1.0), 1u);
+    EXPECT_EQ(ramp.findPiece(4.5), 2u);
+    EXPECT_EQ(ramp.findPiece(7.0), 2u);
+    EXPECT_DOUBLE_EQ(ramp.getPoint(0.5), 0.5);
+    EXPECT_DOUBLE_EQ(ramp.getPoint(2.5), 2.5);
+    EXPECT_DOUBLE_EQ(ramp.getPoint(4.5), 2.0);
+    EXPECT_DOUBLE_EQ(ramp.getDerivative(2.5), 1.0);
+    EXPECT_DOUBLE_EQ(ramp.getDerivative(4.5), -4.0);
+    PiecewiseLinearCurve::Cursor cursor = ramp.cursor();
+    vector<double> us = {0.2, 0.9, 1.5, 3.9, 4.0, 4.7, 0.1, 4.9};
+    vector<double> values(us.size());
+    ramp.getPoints(us.data(), values.data(), us.size());
+    for(unsigned int i=0;i<us.size();i++)
+    {
+        EXPECT_DOUBLE_EQ(cursor.getPoint(us[i]), ramp.getPoint(us[i]));
+        EXPECT_EQ(cursor.piece(), ramp.findPiece(us[i]));
+        EXPECT_DOUBLE_EQ(values[i], ramp.getPoint(us[i]));
+    }
+    ramp.setKnots({0, 2, 4, 6});
+    EXPECT_TRUE(ramp.uniformKnots());
+    EXPECT_EQ(ramp.findPiece(3.0), 1u);
+}
+
+TEST(ShapeTest, CubicSplineCurveTest)
+{
+    using namespace GeometricTools::Primitives;
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> U(0.1, 1.0);
+    vector<double> knots = {0.0}, values;
+    for(int i=0;i<2000;i++)
+        knots.push_back(knots.back()+U(gen));
+    // a clamped spline reproduces a cubic exactly
+    auto f = [](double t) { return 0.001*t*t*t-0.2*t*t+t-3.0; };
+    auto df = [](double t) { return 0.003*t*t-0.4*t+1.0; };
+    for(unsigned int i=0;i<knots.size();i++)
+        values.push_back(f(knots[i]));
+    CubicSplineCurve clamped(knots, values, CubicSplineCurve::Clamped, df(knots.front()), df(knots.back()));
+    EXPECT_EQ(clamped.pieces(), 2000u);
+    for(double t=0.0;t<knots.back();t+=0.37)
+        EXPECT_NEAR(clamped.getPoint(t), f(t), 1e-6*std::max(1.0, std::abs(f(t))));
+
+    // natural spline: interpolates, C2 at the knots, zero curvature at the ends
+    CubicSplineCurve natural(knots, values);
+    for(unsigned int i=1;i+1<knots.size();i+=37)
+    {
+        EXPECT_NEAR(natural.getPoint(knots[i]), values[i], 1e-6*std::max(1.0, std::abs(values[i])));
+        for(unsigned int order=0;order<3;order++)
+            EXPECT_NEAR(natural.derivativePiece(i-1, knots[i], order), natural.derivativePiece(i, knots[i], order), 1e-6*std::max(1.0, std::abs(natural.derivativePiece(i, knots[i], order))));
+    }
+    EXPECT_NEAR(natural.getDerivative(knots.front(), 2), 0.0, 1e-9);
+    EXPECT_NEAR(natural.getDerivative(knots.back(), 2), 0.0, 1e-9);
+
+    // periodic spline through a sampled circle coordinate
+    vector<double> pk, pv;
+    for(int i=0;i<=16;i++)
+    {
+        pk.push_back(i/16.0);
+        pv.push_back(std::cos(2.0*M_PI*i/16.0));
+    }
+    CubicSplineCurve periodic(pk, pv, CubicSplineCurve::Periodic);
+    for(unsigned int order=0;order<3;order++)
+        EXPECT_NEAR(periodic.getDerivative(0.0, order), periodic.getDerivative(1.0, order), 1e-9);
+    for(double t=0.0;t<=1.0;t+=0.01)
+        EXPECT_NEAR(periodic.getPoint(t), std::cos(2.0*M_PI*t), 1e-3);
+    EXPECT_FALSE(CubicSplineCurve().interpolate({0, 1, 1}, {0, 1, 2}));
+}
+
+TEST(ShapeTest, PiecewiseCurveEditingTest)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Math;
+    GeometricTools::Helper::GapBuffer<int> buffer;
+    for(int i=0;i<10;i++)
+        buffer.push_back(i);
+    buffer.insert(3, 100);
+    buffer.insert(4, 101);
+    buffer.erase(0);
+    buffer.insert(10, 102);
+    EXPECT_EQ(buffer.toVector(), vector<int>({1, 2, 100, 101, 3, 4, 5, 6, 7, 8, 102, 9}));
+    int sum = 0;
+    for(int v : buffer)
+        sum += v;
+    EXPECT_EQ(sum, 348);
+
+    HermitePiecewiseCurve hermite;
+    vector<CurveChange> changes;
+    hermite.addChangeListener([&](const CurveChange& change) { changes.push_back(change); });
+    for(int i=0;i<6;i++)
+        hermite.addDotPoint({double(i), double(i%2)});
+    EXPECT_EQ(changes.size(), 5u);
+    changes.clear();
+    hermite.addDotPointInPlace({2.5, 1.0}, 3);
+    ASSERT_EQ(changes.size(), 1u);
+    EXPECT_EQ(changes[0].first, 2u);
+    EXPECT_EQ(changes[0].last, 4u);
+    EXPECT_EQ(changes[0].inserted, 1);
+    EXPECT_DOUBLE_EQ(changes[0].u_min, 2.0/6.0);
+    EXPECT_DOUBLE_EQ(changes[0].u_max, 4.0/6.0);
+    hermite.replaceDotPoint({0.0, -1.0}, 0);
+    EXPECT_EQ(changes[1].first, 0u);
+    EXPECT_EQ(changes[1].last, 1u);
+    HermitePiecewiseCurve rebuilt;
+    double xs[] = {0, 1, 2, 2.5, 3, 4, 5}, ys[] = {-1, 1, 0, 1, 1, 0, 1};
+    for(int i=0;i<7;i++)
+        rebuilt.addDotPoint({xs[i], ys[i]});
+    EXPECT_EQ(hermite.coeff(), rebuilt.coeff());
+    const vector<Vector<2> >& dots = hermite.getDotPoints();
+    EXPECT_EQ(dots.size(), 7u);
+    EXPECT_EQ(dots[3], Vector<2>(2.5, 1.0));
+
+    CardinalPiecewiseCurve cardinal(0.5), expected(0.5);
+    double pts[] = {0, 3, 1, 4, 1, 5, 9};
+    for(int i=0;i<7;i++)
+        if(i!=4)
+            cardinal.addPoint(pts[i]);
+    cardinal.addPointInPlace(1, 4);
+    cardinal.replacePoint(2, 6);
+    pts[6] = 2;
+    for(int i=0;i<7;i++)
+        expected.addPoint(pts[i]);
+    EXPECT_EQ(cardinal.pieces(), 4u);
+    EXPECT_EQ(cardinal.coeff(), expected.coeff());
+    EXPECT_EQ(cardinal.getPoints(), vector<double>(pts, pts+7));
+    cardinal.replacePoint(7, 0);
+    EXPECT_EQ(cardinal.getPoints()[0], 7.0);
+}
+
+TEST(ShapeTest, BezierCurveTest)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Math;
+    CubicBezierCurve bezier(Vector<4>(1,-2,3,0.5));
+    vector<double> c = bezier.coeff();
+    ASSERT_EQ(c.size(), 4u);
+    vector<double> u, out(101), dout(101);
+    for(int i=0;i<=100;i++)
+        u.push_back(i/100.0);
+    bezier.getPoints(u.data(), out.data(), u.size());
+    bezier.getDerivatives(u.data(), dout.data(), u.size(), 2);
+    CubicBezierCurve left, right;
+    bezier.subdivide(0.4, left, right);
+    QuadraticBezierCurve added;
+    added.addPoint(0);
+    added.addPoint(1);
+    added.addPoint(0);
+    for(unsigned int i=0;i<u.size();i++)
+    {
+        EXPECT_NEAR(bezier.getPoint(u[i]), horner(c.data(), 3, u[i]), 1e-12);
+        EXPECT_EQ(out[i], bezier.getPoint(u[i]));
+        EXPECT_NEAR(dout[i], hornerDerivative(c.data(), 3, u[i], 2), 1e-12);
+        EXPECT_NEAR(bezier.getDerivative(u[i]), hornerDerivative(c.data(), 3, u[i]), 1e-12);
+        double v = (u[i]<=0.4)? left.getPoint(u[i]/0.4) : right.getPoint((u[i]-0.4)/0.6);
+        EXPECT_NEAR(v, bezier.getPoint(u[i]), 1e-12);
+        EXPECT_NEAR(bezier.elevate().getPoint(u[i]), bezier.getPoint(u[i]), 1e-12);
+        EXPECT_NEAR(added.getPoint(u[i]), 2.0*u[i]*(1.0-u[i]), 1e-12);
+    }
+    EXPECT_EQ(bezier.getPoint(0.0), 1.0);
+    EXPECT_EQ(bezier.getPoint(1.0), 0.5);
+}
+
+TEST(ShapeTest, BSplineCurveTest)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Math;
+    vector<double> P = {0.3, -1.0, 2.0, 0.5, 1.5, -0.7, 0.2, 1.0, -0.4};
+    vector<double> knots = {0,0,0,0,0.1,0.5,0.5,0.7,1.3,2,2,2,2};
+    vector<double> u, out(201), dout(201);
+    for(int i=0;i<=200;i++)
+        u.push_back(i/200.0);
+    for(int type=0;type<3;type++)
+    {
+        CubicBSplineCurve spline = (type==2)? CubicBSplineCurve(P, knots) : CubicBSplineCurve(P, CubicBSplineCurve::KnotType(type));
+        spline.getPoints(u.data(), out.data(), u.size());
+        spline.getDerivatives(u.data(), dout.data(), u.size());
+
+        // knot insertion and refinement do not change the curve
+        CubicBSplineCurve refined(spline);
+        Vector<2> d = spline.domain();
+        refined.insertKnot(d[0]+0.37*(d[1]-d[0]), 2);
+        refined.subdivide();
+        EXPECT_EQ(refined.knotType(), CubicBSplineCurve::NonUniform);
+        EXPECT_EQ(refined.control().size()+4, refined.knots().size());
+
+        CubicBSplineCurve left, right;
+        spline.split(0.3, left, right);
+
+        // conversion to a flat piecewise polynomial
+        PiecewiseCubicCurve flat(spline.coeff(), spline.breakpoints());
+        EXPECT_EQ(flat.pieces(), (type==2)? 5u : 6u);
+
+        for(unsigned int i=0;i<u.size();i++)
+        {
+            EXPECT_EQ(out[i], spline.getPoint(u[i]));
+            EXPECT_NEAR(dout[i], spline.getDerivative(u[i]), 1e-12);
+            if(u[i]>0.01 && u[i]<0.99)
+            {
+                EXPECT_NEAR(spline.getDerivative(u[i]), (spline.getPoint(u[i]+1e-6)-spline.getPoint(u[i]-1e-6))/2e-6, 1e-3);
+            }
+            EXPECT_NEAR(refined.getPoint(u[i]), out[i], 1e-12);
+            double v = (u[i]<=0.3)? left.getPoint(u[i]/0.3) : right.getPoint((u[i]-0.3)/0.7);
+            EXPECT_NEAR(v, out[i], 1e-12);
+            EXPECT_NEAR(flat.getPoint(u[i]), out[i], 1e-12);
+        }
+    }
+
+    // clamped curves interpolate the end points and work as plane curves
+    PlaneCurve<QuadraticBSplineCurve,QuadraticBSplineCurve> path;
+    path.addPoint({0,0});
+    path.addPoint({1,2});
+    path.addPoint({3,2});
+    path.addPoint({4,0});
+    Polyline<2> poly = uniformSubdivision(path, 10);
+    ASSERT_EQ(poly.vertices().size(), 11u);
+    EXPECT_NEAR(poly.vertices().front()[0], 0.0, 1e-12);
+    EXPECT_NEAR(poly.vertices().back()[0], 4.0, 1e-12);
+    EXPECT_NEAR(poly.vertices()[5][0], 2.0, 1e-12);
+}
+
+TEST(ShapeTest, CurveFittingTest)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Math;
+    using namespace GeometricTools::Math::LinearSystems;
+    // line fit y = 2x+1 through noisy points: both solvers agree with the closed form
+    double xs[5] = {0,1,2,3,4}, ys[5] = {1.1,2.9,5.2,6.8,9.1};
+    LeastSquares qr(2);
+    BandedNormalEquations ne(2);
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for(int i=0;i<5;i++)
+    {
+        double a[2] = {xs[i], 1.0};
+        qr.addRow(0, a, &ys[i]);
+        ne.addRow(0, a, &ys[i]);
+        sx += xs[i]; sy += ys[i]; sxx += xs[i]*xs[i]; sxy += xs[i]*ys[i];
+    }
+    double slope = (5*sxy-sx*sy)/(5*sxx-sx*sx), offset = (sy-slope*sx)/5;
+    double x1[2], x2[2];
+    ASSERT_TRUE(qr.solve(x1));
+    ASSERT_TRUE(ne.solve(x2));
+    EXPECT_NEAR(x1[0], slope, 1e-12);
+    EXPECT_NEAR(x1[1], offset, 1e-12);
+    EXPECT_NEAR(x2[0], slope, 1e-12);
+    EXPECT_NEAR(x2[1], offset, 1e-12);
+    double rss = 0;
+    for(int i=0;i<5;i++)
+        rss += (ys[i]-slope*xs[i]-offset)*(ys[i]-slope*xs[i]-offset);
+    EXPECT_NEAR(qr.residual(), rss, 1e-12);
+    EXPECT_NEAR(ne.residual(x2), rss, 1e-12);
+
+    // exact data is reproduced
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> U(0.0, 1.0);
+    Vector<6> c(1.0, -2.0, 0.5, 3.0, -1.0, 0.25);
+    PolynomialFit<5> pfit;
+    for(int i=0;i<1000;i++)
+    {
+        double u = U(gen);
+        pfit.addSample(u, horner(c.data(), 5, u));
+    }
+    Vector<6> r = pfit.coefficients();
+    for(int i=0;i<6;i++)
+        EXPECT_NEAR(r[i], c[i], 1e-9);
+
+    vector<double> P = {0.3, -1.0, 2.0, 0.5, 1.5, -0.7, 0.2, 1.0, -0.4};
+    CubicBSplineCurve spline(P, CubicBSplineCurve::ClampedUniform);
+    BSplineFit<3> bfit(6);
+    for(int i=0;i<500;i++)
+    {
+        double u = U(gen);
+        bfit.addSample(u, spline.getPoint(u));
+    }
+    EXPECT_EQ(bfit.samples(), 500u);
+    CubicBSplineCurve fitted = bfit.curve();
+    ASSERT_EQ(fitted.control().size(), 9u);
+    for(int i=0;i<9;i++)
+        EXPECT_NEAR(fitted.control()[i], P[i], 1e-9);
+    EXPECT_NEAR(bfit.residual(), 0.0, 1e-12);
+
+    // noisy closed path, fit error close to the noise level
+    std::normal_distribution<double> noise(0.0, 0.01);
+    vector<Vector<2> > points;
+    for(int i=0;i<20000;i++)
+    {
+        double t = 6.0*i/19999.0;
+        points.push_back(Vector<2>(std::cos(t)+noise(gen), std::sin(2.0*t)+noise(gen)));
+    }
+    vector<double> u = chordLengthParameters(points);
+    EXPECT_EQ(u.front(), 0.0);
+    EXPECT_EQ(u.back(), 1.0);
+    PlaneCurve<CubicBSplineCurve,CubicBSplineCurve> path;
+    ASSERT_TRUE(fitPlaneCurve<3>(points, 30, path, 1e-4));
+    double err = 0;
+    for(int i=0;i<20000;i+=10)
+        err += (path.getPoint(u[i])-points[i]).lengthSq();
+    EXPECT_LT(std::sqrt(err/2000), 0.02);
+
+    // repeated values are parameterized by their index
+    QuadraticPolynomialCurve q;
+    q.addPoint(1.0);
+    q.addPoint(0.0);
+    q.addPoint(1.0);
+    EXPECT_NEAR(q.getPoint(0.25), 0.25, 1e-12);
+    // so are slope and curvature constraints: p(0)=p(1)=1, p'(0)=2, p'(1)=-2
+    CubicPolynomialCurve slopes;
+    slopes.addDotPoint({1.0, 2.0});
+    slopes.addDotPoint({1.0, -2.0});
+    EXPECT_NEAR(slopes.getPoint(0.5), 1.5, 1e-12);
+    EXPECT_NEAR(slopes.getDerivative(0.0), 2.0, 1e-12);
+    EXPECT_NEAR(slopes.getDerivative(1.0), -2.0, 1e-12);
+    CubicPolynomialCurve curvature;
+    curvature.addDDotPoint({1.0, 6.0});
+    curvature.addPoint(0.0);
+    curvature.addPoint(1.0);
+    EXPECT_NEAR(curvature.getPoint(0.0), 1.0, 1e-12);
+    EXPECT_NEAR(curvature.getPoint(0.5), 0.0, 1e-12);
+    EXPECT_NEAR(curvature.getPoint(1.0), 1.0, 1e-12);
+    EXPECT_NEAR(curvature.getDerivative(0.0, 2), 6.0, 1e-12);
+    // inserting in place shifts the constraints of the later points
+    CubicPolynomialCurve insertedSlopes, insertedCurvature;
+    insertedSlopes.addDotPoint({1.0, -2.0});
+    insertedSlopes.addDotPointInPlace({1.0, 2.0}, 0);
+    EXPECT_NEAR(insertedSlopes.getDerivative(0.0), 2.0, 1e-12);
+    EXPECT_NEAR(insertedSlopes.getDerivative(1.0), -2.0, 1e-12);
+    insertedCurvature.addPoint(0.0);
+    insertedCurvature.addPoint(1.0);
+    insertedCurvature.addDDotPointInPlace({1.0, 6.0}, 0);
+    EXPECT_NEAR(insertedCurvature.getPoint(0.5), 0.0, 1e-12);
+    EXPECT_NEAR(insertedCurvature.getDerivative(0.0, 2), 6.0, 1e-12);
+}
+
+TEST(ShapeTest, ArcLengthTest)
+{
+    using namespace GeometricTools::Primitives;
+    // x(u) = u, y(u) = u^2
+    PlaneCurve<QuadraticPolynomialCurve,QuadraticPolynomialCurve> parabola;
+    parabola.addPoint({0,0});
+    parabola.addPoint({0.5,0.25});
+    parabola.addPoint({1,1});
+    auto L = [](double u) { return u*std::sqrt(1.0+4.0*u*u)/2.0+std::asinh(2.0*u)/4.0; };
+    ArcLengthTable<PlaneCurve<QuadraticPolynomialCurve,QuadraticPolynomialCurve> > table(parabola);
+    EXPECT_NEAR(table.length(), L(1.0), 1e-12);
+    for(double u=0.0;u<=1.0;u+=0.05)
+    {
+        EXPECT_NEAR(table.arcLength(u), L(u), 1e-12);
+        EXPECT_NEAR(table.parameter(L(u)), u, 1e-10);
+    }
+    EXPECT_EQ(table.parameter(-1.0), 0.0);
+    EXPECT_EQ(table.parameter(10.0), 1.0);
+
+    Polyline<2> poly = arcLengthSubdivision(parabola, 10);
+    ASSERT_EQ(poly.vertices().size(), 11u);
+    for(int i=0;i<=10;i++)
+        EXPECT_NEAR(L(poly.vertices()[i][0]), L(1.0)*i/10.0, 1e-9);
+}
+
+TEST(ShapeTest, AdaptiveSubdivisionTest)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Math;
+    // x(u) = u, y(u) = u^2
+    PlaneCurve<QuadraticPolynomialCurve,QuadraticPolynomialCurve> parabola;
+    parabola.addPoint({0,0});
+    parabola.addPoint({0.5,0.25});
+    parabola.addPoint({1,1});
+
+    Polyline<2> poly;
+    double err = adaptiveSubdivision(parabola, 1e-4, poly);
+    EXPECT_LE(err, 1e-4);
+    const vector<Vector<2> >& v = poly.vertices();
+    ASSERT_GE(v.size(), 2u);
+    EXPECT_NEAR(v.front()[0], 0.0, 1e-12);
+    EXPECT_NEAR(v.back()[0], 1.0, 1e-12);
+    for(unsigned int i=1;i<v.size();i++)
+    {
+        ASSERT_GT(v[i][0], v[i-1][0]);
+        EXPECT_NEAR(v[i][1], v[i][0]*v[i][0], 1e-12);
+        // a parabola deviates most from its chord at the middle parameter
+        double um = 0.5*(v[i][0]+v[i-1][0]);
+        EXPECT_LE(chordDeviation(Vector<2>(um, um*um), v[i-1], v[i]), 1e-4+1e-12);
+    }
+
+    // Reusing the buffer, a straight line needs only the initial spans
+    PlaneCurve<LinearPolynomialCurve,LinearPolynomialCurve> line;
+    line.addPoint({0,0});
+    line.addPoint({2,1});
+    err = adaptiveSubdivision(line, 1e-6, poly, 0.0, 1.0, 4);
+    EXPECT_NEAR(err, 0.0, 1e-12);
+    EXPECT_EQ(poly.vertices().size(), 5u);
+}
+
 TEST(ShapeTest, BoundingBox2DTest)
 {
     using namespace GeometricTools::Primitives;
@@ -197,6 +1532,89 @@ TEST(DistanceTest, PointToLinearTest)
     EXPECT_DOUBLE_EQ(distance(p,s), 0.5);
 }
 
+TEST(DistanceTest, PointToCurveTest)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Distances;
+    using namespace GeometricTools::Math;
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> U(-5.0, 5.0);
+    PlaneCurve<CardinalPiecewiseCurve,CardinalPiecewiseCurve> cardinal(0.3);
+    for(int i=0;i<12;i++)
+        cardinal.addPoint({U(gen), U(gen)});
+    PlaneCurve<CubicBSplineCurve,CubicBSplineCurve> spline;
+    for(int i=0;i<10;i++)
+        spline.addPoint({U(gen), U(gen)});
+
+    BezierPieces pieces(cardinal), spline_pieces(spline);
+    EXPECT_EQ(pieces.pieces(), 9u);
+    EXPECT_EQ(pieces.degree(), 3u);
+    for(int k=0;k<=100;k++)
+    {
+        double u = k/100.0;
+        unsigned int i = std::min((unsigned int)(u*9), 8u);
+        double s = (u-pieces.knot(i))/(pieces.knot(i+1)-pieces.knot(i));
+        EXPECT_NEAR((pieces.point(i, s)-cardinal.getPoint(u)).length(), 0.0, 1e-12);
+    }
+
+    const int N = 20000;
+    vector<Vector<2> > dense(N+1);
+    for(int k=0;k<=N;k++)
+        dense[k] = spline.getPoint(k/double(N));
+    for(int q=0;q<50;q++)
+    {
+        Vector<2> p(U(gen), U(gen));
+        CurvePoint c = closestPoint(spline_pieces, p);
+        double d = std::numeric_limits<double>::infinity();
+        for(int k=0;k<=N;k++)
+            d = std::min(d, (dense[k]-p).length());
+        EXPECT_LE(c.distance, d+1e-12);
+        EXPECT_GE(c.distance, d-1e-2);
+        // interior minimum: the offset is orthogonal to the tangent
+        if(c.u>0.0 && c.u<1.0)
+        {
+            Vector<2> t = spline.getDerivative(c.u);
+            EXPECT_NEAR((c.point-p)*t/t.length(), 0.0, 1e-9);
+        }
+        EXPECT_NEAR((spline.getPoint(c.u)-c.point).length(), 0.0, 1e-12);
+        EXPECT_NEAR(distance(p, spline), c.distance, 1e-12);
+    }
+}
+
+TEST(DistanceTest, ConvexToConvexTest)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Math;
+    using namespace GeometricTools::Distances;
+    Rectangle r1({0,0}, 2.0, 2.0), r2({4,0.5}, 2.0, 2.0);
+    EXPECT_NEAR(convexDistance(r1, r2), 2.0, 1e-9);
+    Circle c({0,4}, 1.0);
+    EXPECT_NEAR(convexDistance(c, r1), 2.0, 1e-6);
+    GJKInfo<2> info;
+    EXPECT_FALSE(gjk(Triangle({0,0}, {1,0}, {0,1}), Segment<2>({1,1}, {2,2}), info));
+    EXPECT_NEAR(info.distanceSq, 0.5, 1e-9);
+    EXPECT_EQ(info.pointA, Vector<2>(0.5,0.5));
+    EXPECT_EQ(info.pointB, Vector<2>(1,1));
+    EXPECT_EQ(support(vector<Vector<2> >(), Vector<2>(1,0)), Vector<2>(0,0));
+    // 3D
+    Segment<3> s1({0,0,0}, {1,0,0}), s2({0.5,-1,1}, {0.5,1,2});
+    EXPECT_NEAR(convexDistanceSq(s1, s2), distanceSq(s1, s2), 1e-9);
+    vector<Vector<3> > cube1, cube2;
+    for(int i=0;i<8;i++)
+    {
+        cube1.push_back(Vector<3>(i&1, (i>>1)&1, (i>>2)&1));
+        cube2.push_back(Vector<3>(i&1, (i>>1)&1, (i>>2)&1)+Vector<3>(0.5,0.5,3.0));
+    }
+    EXPECT_NEAR(convexDistance(cube1, cube2), 2.0, 1e-9);
+    // warm start - moving shape
+    GJKSimplex<2> cache;
+    GJKInfo<2> warm;
+    gjk(r1, r2, warm, &cache);
+    gjk(r1, Rectangle({4.1,0.6}, 2.0, 2.0), warm, &cache);
+    EXPECT_NEAR(warm.distanceSq, 2.1*2.1, 1e-9);
+    EXPECT_LE(warm.iterations, 2);
+}
+
 TEST(IntersectionTest, LinearToLinearTest)
 {
     using namespace GeometricTools::Primitives;
@@ -214,6 +1632,153 @@ TEST(IntersectionTest, LinearToLinearTest)
     EXPECT_TRUE(info != nullptr);
     EXPECT_EQ(info->point, Vector<2>(0.5,0));
     EXPECT_EQ(info->delta, Vector<2>(1,0)-Vector<2>(0.5,0));
+    info = intersect(Segment<2>({0,0}, {4,0}), Segment<2>({1,1}, {1,-1}));
+    EXPECT_TRUE(info != nullptr);
+    EXPECT_EQ(info->point, Vector<2>(1,0));
+}
+
+TEST(IntersectionTest, SegmentBatchTest)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Math;
+    using namespace GeometricTools::Intersections;
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> U(-10.0, 10.0);
+    SegmentArray walls;
+    for(int i=0;i<1001;i++)
+        walls.addSegment(Segment<2>({U(gen), U(gen)}, {U(gen), U(gen)}));
+    // parallel and collinear walls
+    walls.addSegment(Segment<2>({-5,1}, {5,1}));
+    walls.addSegment(Segment<2>({-5,0}, {-2,0}));
+    Segment<2> query({-8,0}, {8,0});
+    SegmentHits hits;
+    unsigned int count = intersectBatch(query, walls, hits);
+    unsigned int expected = 0;
+    for(unsigned int i=0;i<walls.size();i++)
+    {
+        Intersection2DInfo* info = intersect(query, walls.segment(i));
+        EXPECT_EQ(bool(hits.hit[i]), info!=nullptr);
+        if(info!=nullptr)
+        {
+            expected++;
+            EXPECT_NEAR(hits.x[i], info->point[0], 1e-9);
+            EXPECT_NEAR(hits.y[i], info->point[1], 1e-9);
+            EXPECT_NEAR(hits.x[i], -8.0+16.0*hits.s[i], 1e-9);
+            delete info;
+        }
+    }
+    EXPECT_EQ(count, expected);
+    EXPECT_FALSE(hits.hit[1001]);
+    EXPECT_TRUE(hits.hit[1002]);
+}
+
+TEST(IntersectionTest, RaySceneTest)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Math;
+    using namespace GeometricTools::Intersections;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> U(-20.0, 20.0);
+    std::uniform_real_distribution<double> A(0.0, 2.0*M_PI);
+    vector<Polygon> polygons;
+    for(int p=0;p<200;p++)
+    {
+        Polygon poly;
+        double cx = U(gen), cy = U(gen);
+        for(int i=0;i<5;i++)
+            poly.addPoint(Vector<2>({cx+std::cos(2.0*M_PI*i/5.0), cy+std::sin(2.0*M_PI*i/5.0)}));
+        poly.addPoint(poly.vertices()[0]);
+        polygons.push_back(poly);
+    }
+    Polygon box;
+    box.addPoint({-30,-30}); box.addPoint({30,-30}); box.addPoint({30,30}); box.addPoint({-30,30}); box.addPoint({-30,-30});
+    polygons.push_back(box);
+    RayScene scene(polygons);
+    vector<Ray<2> > rays;
+    for(int i=0;i<500;i++)
+    {
+        double a = A(gen);
+        rays.push_back(Ray<2>({U(gen), U(gen)}, {std::cos(a), std::sin(a)}));
+    }
+    rays.push_back(Ray<2>({0,0}, {1,0}));
+    vector<RayHit> hits;
+    EXPECT_EQ(scene.castRays(rays, hits, std::numeric_limits<double>::infinity(), 2), rays.size());
+    for(unsigned int r=0;r<rays.size();r++)
+    {
+        double best = std::numeric_limits<double>::infinity();
+        for(unsigned int p=0;p<polygons.size();p++)
+        {
+            for(unsigned int i=0;i+1<polygons[p].vertices().size();i++)
+            {
+                Segment<2> edge(polygons[p].vertices()[i], polygons[p].vertices()[i+1]);
+                Intersection2DInfo* info = intersect(Segment<2>(rays[r].p(), rays[r].p()+100.0*rays[r].d()), edge);
+                if(info!=nullptr)
+                {
+                    best = std::min(best, (info->point-rays[r].p()).length());
+                    delete info;
+                }
+            }
+        }
+        EXPECT_TRUE(hits[r].hit);
+        EXPECT_NEAR(hits[r].distance, best, 1e-6);
+        EXPECT_NEAR((hits[r].point-rays[r].p()).length(), hits[r].distance, 1e-9);
+    }
+    RayHit hit;
+    EXPECT_FALSE(scene.castRay(Ray<2>({40,40}, {1,0}), hit));
+    EXPECT_TRUE(scene.castRay(Ray<2>({-40,0}, {1,0}), hit));
+    EXPECT_EQ(hit.polygon, polygons.size()-1);
+    EXPECT_EQ(hit.edge, 3u);
+    EXPECT_NEAR(hit.distance, 10.0, 1e-9);
+}
+
+TEST(IntersectionTest, PointInPolygonTest)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Math;
+    using namespace GeometricTools::Intersections;
+    // L-shaped polygon (closed, counter-clockwise)
+    Polygon L;
+    L.addPoint({0,0}); L.addPoint({4,0}); L.addPoint({4,1}); L.addPoint({1,1}); L.addPoint({1,3}); L.addPoint({0,3}); L.addPoint({0,0});
+    EXPECT_TRUE(contains(L, Vector<2>({0.5,2})));
+    EXPECT_TRUE(contains(L, Vector<2>({3,0.5})));
+    EXPECT_FALSE(contains(L, Vector<2>({2,2})));
+    EXPECT_TRUE(contains(L, Vector<2>({2,1})));
+    EXPECT_TRUE(contains(L, Vector<2>({0,0})));
+    EXPECT_EQ(windingNumber(L, Vector<2>({0.5,0.5})), 1);
+    PreparedPolygon prepared(L);
+    EXPECT_TRUE(prepared.contains(0.5, 2));
+    EXPECT_FALSE(prepared.contains(2, 2));
+    EXPECT_TRUE(prepared.contains(1, 2));
+    EXPECT_FALSE(prepared.contains(-1, 0.5));
+
+    // star polygon (self-intersecting pentagram: the center has winding number 2)
+    Polygon star;
+    for(int i=0;i<5;i++)
+        star.addPoint(Vector<2>({std::cos(4.0*M_PI*i/5.0), std::sin(4.0*M_PI*i/5.0)}));
+    EXPECT_EQ(windingNumber(star, Vector<2>({0,0})), 2);
+    EXPECT_EQ(PreparedPolygon(star).windingNumber(0, 0), 2);
+
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> U(0.0, 1.0);
+    Polygon blob;
+    for(int i=0;i<300;i++)
+    {
+        double a = 2.0*M_PI*i/300.0, r = 0.3+0.7*U(gen);
+        blob.addPoint(Vector<2>({r*std::cos(a), r*std::sin(a)}));
+    }
+    PreparedPolygon fence(blob);
+    vector<Vector<2> > points;
+    for(int i=0;i<5000;i++)
+        points.push_back(Vector<2>({2.2*U(gen)-1.1, 2.2*U(gen)-1.1}));
+    vector<unsigned char> inside;
+    unsigned int count = fence.containsBatch(points, inside, 2), expected = 0;
+    for(unsigned int i=0;i<points.size();i++)
+    {
+        bool in = contains(blob, points[i]);
+        expected += in;
+        EXPECT_EQ(bool(inside[i]), in);
+    }
+    EXPECT_EQ(count, expected);
 }
 
 TEST(IntersectionTest, LinearToPolygonTest)
@@ -231,6 +1796,135 @@ TEST(IntersectionTest, LinearToPolygonTest)
     EXPECT_EQ(info->delta, Vector<2>(1.5, 1)-Vector<2>(-1.5, 1));
 }
 
+TEST(IntersectionTest, ConvexToConvexTest)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Math;
+    using namespace GeometricTools::Intersections;
+    Polygon p1 = Rectangle({0,0}, 2.0, 2.0);
+    Polygon p2 = Triangle({0.5,-3}, {3,0}, {0.5,3});
+    Intersection2DInfo* info = intersect(p1, p2);
+    ASSERT_TRUE(info != nullptr);
+    EXPECT_NEAR(info->delta[0], 0.5, 1e-9);
+    EXPECT_NEAR(info->delta[1], 0.0, 1e-9);
+    delete info;
+    EXPECT_TRUE(intersect(p1, Polygon(Triangle({5,5}, {6,5}, {5,6}))) == nullptr);
+    PenetrationInfo<2> pen;
+    EXPECT_TRUE(penetration(Circle({0,0}, 1.0), Circle({1.5,0}, 1.0), pen));
+    EXPECT_NEAR(pen.depth, 0.5, 1e-6);
+    EXPECT_NEAR(pen.normal[0], 1.0, 1e-6);
+    // 3D
+    vector<Vector<3> > cube1, cube2;
+    for(int i=0;i<8;i++)
+    {
+        cube1.push_back(Vector<3>(i&1, (i>>1)&1, (i>>2)&1));
+        cube2.push_back(Vector<3>(i&1, (i>>1)&1, (i>>2)&1)*2.0+Vector<3>(-0.5,-0.5,0.75));
+    }
+    PenetrationInfo<3> pen3;
+    EXPECT_TRUE(penetration(cube1, cube2, pen3));
+    EXPECT_NEAR(pen3.depth, 0.25, 1e-9);
+    EXPECT_EQ(pen3.normal, Vector<3>(0,0,1));
+    EXPECT_FALSE(overlap(cube1, Segment<3>({2,2,2}, {3,3,3})));
+}
+
+TEST(IntersectionTest, CurveToCurveTest)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Intersections;
+    // y = x^2 with x = 2u-1
+    PlaneCurve<QuadraticBezierCurve,QuadraticBezierCurve> parabola;
+    parabola.addPoint({-1,1});
+    parabola.addPoint({0,-1});
+    parabola.addPoint({1,1});
+    PlaneCurve<LinearBezierCurve,LinearBezierCurve> line;
+    line.addPoint({-2,0.25});
+    line.addPoint({2,0.25});
+    vector<CurveIntersection> result;
+    ASSERT_EQ(intersect(parabola, line, result), 2u);
+    EXPECT_NEAR(result[0].point[0], -0.5, 1e-12);
+    EXPECT_NEAR(result[1].point[0], 0.5, 1e-12);
+    EXPECT_NEAR(result[0].u, 0.25, 1e-12);
+    EXPECT_NEAR(result[1].v, 0.625, 1e-12);
+
+    // tangential contact and collinear overlap
+    PlaneCurve<LinearBezierCurve,LinearBezierCurve> axis, overlap;
+    axis.addPoint({-2,0});
+    axis.addPoint({2,0});
+    overlap.addPoint({-1,0});
+    overlap.addPoint({3,0});
+    ASSERT_EQ(intersect(parabola, axis, result), 1u);
+    EXPECT_NEAR(result[0].point[0], 0.0, 1e-6);
+    ASSERT_EQ(intersect(overlap, axis, result), 2u);
+    EXPECT_NEAR(result[0].point[0], -1.0, 1e-12);
+    EXPECT_NEAR(result[1].point[0], 2.0, 1e-12);
+
+    // random curves against dense polylines
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> U(-5.0, 5.0);
+    PlaneCurve<CardinalPiecewiseCurve,CardinalPiecewiseCurve> a(0.3);
+    PlaneCurve<CubicBSplineCurve,CubicBSplineCurve> b;
+    for(int i=0;i<10;i++)
+    {
+        a.addPoint({U(gen), U(gen)});
+        b.addPoint({U(gen), U(gen)});
+    }
+    unsigned int n = intersect(a, b, result);
+    for(unsigned int k=0;k<n;k++)
+        EXPECT_NEAR((a.getPoint(result[k].u)-b.getPoint(result[k].v)).length(), 0.0, 1e-10);
+    Polyline<2> pa = uniformSubdivision(a, 4000), pb = uniformSubdivision(b, 4000);
+    vector<Segment<2> > segments;
+    for(unsigned int k=0;k<4000;k++)
+        segments.push_back(Segment<2>(pa.vertices()[k], pa.vertices()[k+1]));
+    for(unsigned int k=0;k<4000;k++)
+        segments.push_back(Segment<2>(pb.vertices()[k], pb.vertices()[k+1]));
+    vector<SegmentIntersection> crossings;
+    intersectAll(segments, crossings);
+    unsigned int dense = 0;
+    for(unsigned int k=0;k<crossings.size();k++)
+        dense += (crossings[k].first<4000 && crossings[k].second>=4000);
+    EXPECT_EQ(n, dense);
+}
+
+TEST(IntersectionTest, SegmentSweepTest)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Math;
+    using namespace GeometricTools::Intersections;
+    vector<Segment<2> > segs;
+    segs.push_back(Segment<2>({0,0}, {4,4}));
+    segs.push_back(Segment<2>({0,4}, {4,0}));
+    segs.push_back(Segment<2>({2,-1}, {2,5}));
+    segs.push_back(Segment<2>({5,0}, {6,1}));
+    segs.push_back(Segment<2>({0,1}, {4,1}));
+    vector<SegmentIntersection> result;
+    // 3 segments through (2,2) and the horizontal one crosses the other three
+    EXPECT_EQ(intersectAll(segs, result), 6);
+    unsigned int at_center = 0;
+    for(unsigned int i=0;i<result.size();i++)
+    {
+        EXPECT_LT(result[i].first, result[i].second);
+        if(result[i].point==Vector<2>(2,2))
+            at_center++;
+        EXPECT_TRUE(result[i].first!=3 && result[i].second!=3);
+    }
+    EXPECT_EQ(at_center, 3);
+    Polyline<2> line;
+    line.addPoint({0,0});
+    line.addPoint({2,0});
+    line.addPoint({2,2});
+    line.addPoint({1,-1});
+    EXPECT_EQ(selfIntersections(line, result), 1);
+    EXPECT_EQ(result[0].point, Vector<2>(4.0/3.0,0));
+    Polygon square = Rectangle({0,0}, 2.0, 2.0);
+    EXPECT_TRUE(isSimple(square));
+    Polygon bowtie;
+    bowtie.addPoint({0,0});
+    bowtie.addPoint({1,1});
+    bowtie.addPoint({1,0});
+    bowtie.addPoint({0,1});
+    EXPECT_FALSE(isSimple(bowtie));
+}
+
 TEST(QuadTreeTest, SimpleQuadTree)
 {
     using namespace GeometricTools::Primitives;
@@ -247,6 +1941,52 @@ TEST(QuadTreeTest, SimpleQuadTree)
     EXPECT_EQ(tree.queryObject(Triangle({10000,0}, {100000,1}, {100000,2})), false);
 }
 
+TEST(QuadTreeTest, RangeQueries)
+{
+    using namespace GeometricTools::Primitives;
+    using namespace GeometricTools::Math;
+    using namespace GeometricTools::SpacePartitioning;
+    using std::vector;
+    QuadTree tree(Rectangle({0,0}, 16, 16), 0, 4);
+    for(int i=0;i<4;i++)
+        for(int j=0;j<4;j++)
+            EXPECT_TRUE(tree.addObject(Triangle({-7.0+4*i,-7.0+4*j}, {-5.0+4*i,-7.0+4*j}, {-7.0+4*i,-5.0+4*j})));
+    vector<Polygon> found;
+    EXPECT_EQ(tree.queryRange(Rectangle({0,0}, 16, 16), found), 16u);
+    found.clear();
+    EXPECT_EQ(tree.queryRange(Rectangle({-6,-6}, 1, 1), found), 1u);
+    found.clear();
+    EXPECT_EQ(tree.queryRange(Rectangle({-4,-4}, 1, 1), found), 0u);
+    found.clear();
+    EXPECT_EQ(tree.queryPoint({-6.5,-6.5}, found), 1u);
+    found.clear();
+    EXPECT_EQ(tree.queryPoint({-5.2,-5.2}, found), 0u);
+    found.clear();
+    EXPECT_EQ(tree.queryPoint({20,20}, found), 0u);
+
+    // objects straddling quadrants are found from every quadrant they cover
+    QuadTree split(Rectangle({0,0}, 16, 16), 0, 4);
+    Triangle straddling({-3,-3}, {5,-3}, {-3,5});
+    EXPECT_TRUE(split.addObject(Triangle({-7,-7}, {-6,-7}, {-7,-6})));
+    EXPECT_TRUE(split.addObject(Triangle({6,6}, {7,6}, {6,7})));
+    EXPECT_TRUE(split.addObject(straddling));
+    found.clear();
+    EXPECT_EQ(split.queryPoint({1,1}, found), 1u);
+    found.clear();
+    EXPECT_EQ(split.queryPoint({-2,-2}, found), 1u);
+    found.clear();
+    EXPECT_EQ(split.queryPoint({-2,3}, found), 1u);
+    found.clear();
+    EXPECT_EQ(split.queryRange(Rectangle({3,-2}, 1, 1), found), 1u);
+    found.clear();
+    EXPECT_EQ(split.queryRange(Rectangle({0,0}, 16, 16), found), 3u);
+    EXPECT_TRUE(split.queryObject(Triangle({4,-2}, {4.5,-2}, {4,-1.5})));
+    EXPECT_TRUE(split.removeObject(straddling));
+    EXPECT_FALSE(split.removeObject(straddling));
+    found.clear();
+    EXPECT_EQ(split.queryPoint({1,1}, found), 0u);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();